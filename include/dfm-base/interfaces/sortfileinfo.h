@@ -58,6 +58,8 @@ public:
     qint64 createTime() const;
     QString highlightContent() const;
     QVariant customData(const QString &key) const;
+    // 文件名的排序键，第一次比较时生成并缓存
+    QByteArray fileNameSortKey() const;
 
     // 信息完整性查询方法
     bool isInfoCompleted() const;
@@ -14,6 +14,8 @@
 #include <dfm-base/utils/loggerrules.h>
 #include <dfm-base/utils/windowutils.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+#include <dfm-base/base/standardpaths.h>
+#include <dfm-base/mimetype/mimetypecache.h>
 
 #include <dfm-framework/dpf.h>
 
@@ -332,6 +334,16 @@ static void autoReleaseMemory()
     timer.start(kTimerInterval);
 }
 
+static void initMimeTypeCache()
+{
+    bool persistent = DConfigManager::instance()->value(kDefaultCfgPath, kMimeTypeCachePersistent, true).toBool();
+    if (!persistent)
+        return;
+
+    const QString &cacheFile = QString("%1/%2").arg(StandardPaths::location(StandardPaths::kCachePath), "MimeTypeCache.dat");
+    MimeTypeCache::instance()->setPersistentFile(cacheFile);
+}
+
 int main(int argc, char *argv[])
 {
     initEnv();
@@ -395,6 +407,7 @@ int main(int argc, char *argv[])
         qCInfo(logAppFileManager) << "main: Running as primary instance";
         // check upgrade
         checkUpgrade(&a);
+        initMimeTypeCache();
 
         if (!pluginsLoad()) {
             qCCritical(logAppFileManager) << "main: Failed to load plugins, terminating application";
@@ -421,6 +434,7 @@ int main(int argc, char *argv[])
     mo->unRegisterDBus();
     a.closeServer();
     DPF_NAMESPACE::LifeCycle::shutdownPlugins();
+    MimeTypeCache::instance()->save();
 
     bool enableHeadless { DConfigManager::instance()->value(kDefaultCfgPath, "dfm.headless", false).toBool() };
     bool isSigterm { qApp->property("SIGTERM").toBool() };
@@ -22,6 +22,10 @@ namespace BaseConfig {
 inline constexpr char kTreeViewEnable[] { "dfm.treeview.enable" };
 inline constexpr char kDisplayPreviewVisibleKey[] { "dfm.displaypreview.visible" };
 inline constexpr char kOpenFolderWindowsInASeparateProcess[] { "dfm.open.in.single.process" };
+inline constexpr char kParallelSortThreshold[] { "dfm.sort.parallel.threshold" };
+inline constexpr char kThumbnailWorkerCount[] { "dfm.thumbnail.worker.count" };
+inline constexpr char kThumbnailMimeConcurrency[] { "dfm.thumbnail.mime.concurrency" };
+inline constexpr char kMimeTypeCachePersistent[] { "dfm.mimetype.cache.persistent" };
 }   // namespace BaseConfig
 
 /*!
@@ -8,6 +8,10 @@
 #include <dfm-base/dfm_base_global.h>
 
 #include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
 #include <QtSql>
 
 DFMBASE_BEGIN_NAMESPACE
@@ -18,9 +22,20 @@ public:
     SqliteConnectionPoolPrivate();
     QString makeConnectionName(const QString &databaseName);
     QSqlDatabase createConnection(const QString &databaseName, const QString &connectionName);
+    void configureConnection(QSqlDatabase &db);
+    void releaseStatements(const QString &connectionName);
 
 public:
     QString connectionName;
+
+    // 连接名 -> (SQL -> 预编译语句)，连接按线程区分，锁只保护容器本身
+    // 语句取出期间不在缓存中，同一条语句不会被两处同时使用
+    QMutex statementMutex;
+    QHash<QString, QHash<QString, QSharedPointer<QSqlQuery>>> statementCache;
+
+    // 使用 WAL 的数据库，其余数据库保持 SQLite 默认的日志模式
+    QMutex walMutex;
+    QSet<QString> walDatabases;
 };
 
 DFMBASE_END_NAMESPACE
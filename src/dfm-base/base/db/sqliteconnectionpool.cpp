@@ -14,7 +14,7 @@
 DFMBASE_USE_NAMESPACE
 
 static constexpr char kDatabaseType[] { "QSQLITE" };
-static constexpr char kTestSql[] { "SELECT 1" };
+static constexpr int kMaxCachedStatements { 64 };
 
 SqliteConnectionPoolPrivate::SqliteConnectionPoolPrivate()
 {
@@ -37,6 +37,11 @@ QSqlDatabase SqliteConnectionPoolPrivate::createConnection(const QString &databa
     if (db.open()) {
         qCInfo(logDFMBase) << "SQLite connection created successfully - name:" << connectionName 
                            << "database:" << databaseName << "serial number:" << (++sn);
+        QMutexLocker lk(&walMutex);
+        const bool useWal = walDatabases.contains(databaseName);
+        lk.unlock();
+        if (useWal)
+            configureConnection(db);
         return db;
     } else {
         qCCritical(logDFMBase) << "Failed to create SQLite connection - name:" << connectionName 
@@ -45,6 +50,23 @@ QSqlDatabase SqliteConnectionPoolPrivate::createConnection(const QString &databa
     }
 }
 
+void SqliteConnectionPoolPrivate::configureConnection(QSqlDatabase &db)
+{
+    // WAL 模式下读写互不阻塞，配合 synchronous=NORMAL 每次提交不再同步刷盘日志，
+    // 仅在检查点时同步，掉电最多丢失最近的提交而不会损坏数据库
+    QSqlQuery query { db };
+    if (!query.exec("PRAGMA journal_mode=WAL;"))
+        qCWarning(logDFMBase) << "Failed to enable WAL mode:" << db.databaseName() << query.lastError().text();
+    if (!query.exec("PRAGMA synchronous=NORMAL;"))
+        qCWarning(logDFMBase) << "Failed to set synchronous mode:" << db.databaseName() << query.lastError().text();
+}
+
+void SqliteConnectionPoolPrivate::releaseStatements(const QString &connectionName)
+{
+    QMutexLocker lk(&statementMutex);
+    statementCache.remove(connectionName);
+}
+
 SqliteConnectionPool::SqliteConnectionPool(QObject *parent)
     : QObject(parent), d(new SqliteConnectionPoolPrivate)
 {
@@ -69,11 +91,9 @@ QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
     QString fullConnectionName = baseConnectionName + "_" + d->makeConnectionName(databaseName);
 
     if (QSqlDatabase::contains(fullConnectionName)) {
-        QSqlDatabase existingDb = QSqlDatabase::database(fullConnectionName);
-        qCDebug(logDFMBase) << "Testing existing SQLite connection - connection:" << fullConnectionName 
-                            << "test query:" << kTestSql;
-        QSqlQuery query(kTestSql, existingDb);
-        if (query.lastError().type() != QSqlError::NoError && !existingDb.open()) {
+        // 已打开的连接直接复用，不额外执行探测语句
+        QSqlDatabase existingDb = QSqlDatabase::database(fullConnectionName, false);
+        if (!existingDb.isOpen() && !existingDb.open()) {
             qCCritical(logDFMBase) << "Failed to open existing SQLite database connection - connection:" 
                                    << fullConnectionName << "error:" << existingDb.lastError().text();
             return QSqlDatabase();
@@ -82,7 +102,8 @@ QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
         return existingDb;
     } else {
         if (qApp != nullptr) {
-            QObject::connect(QThread::currentThread(), &QThread::finished, qApp, [fullConnectionName] {
+            QObject::connect(QThread::currentThread(), &QThread::finished, qApp, [this, fullConnectionName] {
+                d->releaseStatements(fullConnectionName);
                 if (QSqlDatabase::contains(fullConnectionName)) {
                     QSqlDatabase::removeDatabase(fullConnectionName);
                     qCInfo(logDFMBase) << "SQLite connection removed on thread cleanup:" << fullConnectionName;
@@ -91,6 +112,48 @@ QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
         }
 
         qCDebug(logDFMBase) << "Creating new SQLite connection - name:" << fullConnectionName << "database:" << databaseName;
+        // 同名连接可能已被移除后重建，旧连接上的预编译语句不能再用
+        d->releaseStatements(fullConnectionName);
         return d->createConnection(databaseName, fullConnectionName);
     }
 }
+
+void SqliteConnectionPool::enableWriteAheadLog(const QString &databaseName)
+{
+    // 只对数据库的所有者开启：journal_mode 会写入数据库文件，
+    // 升级工具等只读取旧数据库的程序不应改变其日志模式
+    QMutexLocker lk(&d->walMutex);
+    d->walDatabases.insert(databaseName);
+}
+
+QSharedPointer<QSqlQuery> SqliteConnectionPool::takeQuery(const QSqlDatabase &db, const QString &sql)
+{
+    {
+        QMutexLocker lk(&d->statementMutex);
+        auto &statements = d->statementCache[db.connectionName()];
+        QSharedPointer<QSqlQuery> cached = statements.take(sql);
+        if (cached)
+            return cached;
+    }
+
+    QSharedPointer<QSqlQuery> query { new QSqlQuery(db) };
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        qCWarning(logDFMBase).noquote() << "Failed to prepare SQL:" << sql << query->lastError().text().trimmed();
+        return nullptr;
+    }
+    return query;
+}
+
+void SqliteConnectionPool::recycleQuery(const QSqlDatabase &db, const QString &sql, const QSharedPointer<QSqlQuery> &query)
+{
+    if (!query)
+        return;
+
+    QMutexLocker lk(&d->statementMutex);
+    auto &statements = d->statementCache[db.connectionName()];
+    // IN 查询等语句的形状随参数数量变化，超出上限时整体丢弃重新积累
+    if (statements.size() >= kMaxCachedStatements)
+        statements.clear();
+    statements.insert(sql, query);
+}
@@ -8,6 +8,7 @@
 #include <dfm-base/dfm_base_global.h>
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QtSql>
 
 DFMBASE_BEGIN_NAMESPACE
@@ -21,6 +22,11 @@ class SqliteConnectionPool : public QObject
 public:
     static SqliteConnectionPool &instance();
     QSqlDatabase openConnection(const QString &databaseName);
+    void enableWriteAheadLog(const QString &databaseName);
+
+    // 预编译语句由调用方独占使用，用完后放回缓存；预编译失败时返回空指针
+    QSharedPointer<QSqlQuery> takeQuery(const QSqlDatabase &db, const QString &sql);
+    void recycleQuery(const QSqlDatabase &db, const QString &sql, const QSharedPointer<QSqlQuery> &query);
 
 private:
     explicit SqliteConnectionPool(QObject *parent = nullptr);
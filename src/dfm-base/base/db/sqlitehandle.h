@@ -10,6 +10,7 @@
 #include <dfm-base/base/db/sqlitequeryable.h>
 
 #include <QObject>
+#include <QPair>
 #include <QDebug>
 
 DFMBASE_BEGIN_NAMESPACE
@@ -78,59 +79,54 @@ public:
     int insert(const T &entity, bool customPK = false)
     {
         static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
-        const QStringList &fieldNames { SqliteHelper::fieldNames<T>() };
-        Q_ASSERT(!fieldNames.isEmpty());
-
-        QString fmtFields;
-        QString fmtValues;
-
-        auto serializeValue = [&entity](const QString &field) -> QString {
-            QVariant &&variant { entity.property(field.toLocal8Bit().data()) };
-            QString &&typeStr { SqliteHelper::typeString(variant.type()) };
-            QString out;
-            if (typeStr.contains("TEXT")) {
-                SerializationHelper::serialize(&out, variant.toString());
-            } else {
-                SerializationHelper::serialize(&out, variant);
-            }
-            return out;
-        };
-
-        int startIndex { 1 };
-        if (customPK)
-            startIndex = 0;
-
-        for (int i = startIndex; i != fieldNames.size(); ++i) {
-            fmtFields += (fieldNames[i] + ",");
-            fmtValues += (serializeValue(fieldNames[i]) + ",");
-        }
-
-        if (fmtFields.endsWith(","))
-            fmtFields.chop(1);
-        if (fmtValues.endsWith(","))
-            fmtValues.chop(1);
-
-        Q_ASSERT(!fmtFields.isEmpty() && !fmtValues.isEmpty());
         int lastId { -1 };
-        if (!excute("INSERT INTO " + SqliteHelper::tableName<T>()
-                            + "(" + fmtFields + ") VALUES (" + fmtValues + ");",
-                    [&lastId](QSqlQuery *query) {
-                        Q_ASSERT(query);
-                        lastId = query->lastInsertId().toInt();
-                    }))
+        if (!excutePrepared(insertSql<T>(customPK), insertValues<T>(entity, customPK),
+                            [&lastId](QSqlQuery *query) {
+                                Q_ASSERT(query);
+                                lastId = query->lastInsertId().toInt();
+                            }))
             return -1;
 
         return lastId;
     }
 
+    // Batch insert: 所有实体复用同一条预编译语句，调用方可包在 transaction() 中以减少提交次数
+    template<typename T>
+    bool insertBatch(const QList<QSharedPointer<T>> &entities, bool customPK = false)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        const QString &sql { insertSql<T>(customPK) };
+        for (const auto &entity : entities) {
+            Q_ASSERT(entity);
+            if (!excutePrepared(sql, insertValues<T>(*entity, customPK)))
+                return false;
+        }
+
+        return true;
+    }
+
     // U: Update
     template<typename T>
     bool update(const Expression::SetExpr &setExpr, const Expression::Expr &whereExpr)
     {
         static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
-        return excute("UPDATE " + SqliteHelper::tableName<T>()
-                      + " SET " + setExpr.toString()
-                      + " WHERE " + whereExpr.toString());
+        return excutePrepared("UPDATE " + SqliteHelper::tableName<T>()
+                                      + " SET " + setExpr.preparedString()
+                                      + " WHERE " + whereExpr.preparedString() + ";",
+                              setExpr.bindValues() + whereExpr.bindValues());
+    }
+
+    // Batch update: 依次执行多组 SET/WHERE，形状相同的语句共享预编译结果
+    template<typename T>
+    bool updateBatch(const QList<QPair<Expression::SetExpr, Expression::Expr>> &updates)
+    {
+        static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
+        for (const auto &update : updates) {
+            if (!this->update<T>(update.first, update.second))
+                return false;
+        }
+
+        return true;
     }
 
     // R: Query
@@ -161,8 +157,9 @@ public:
     {
         static_assert(std::is_base_of<QObject, T>::value, "Template type T must be derived QObject");
 
-        return excute("DELETE FROM " + SqliteHelper::tableName<T>()
-                      + " WHERE " + whereExpr.toString() + ";");
+        return excutePrepared("DELETE FROM " + SqliteHelper::tableName<T>()
+                                      + " WHERE " + whereExpr.preparedString() + ";",
+                              whereExpr.bindValues());
     }
 
     inline bool excute(const QString &sql, std::function<void(QSqlQuery *)> fn = nullptr)
@@ -170,12 +167,46 @@ public:
         return SqliteHelper::excute(databaseName, sql, &lastExcutedSql, fn);
     }
 
+    inline bool excutePrepared(const QString &sql, const QVariantList &bindValues, std::function<void(QSqlQuery *)> fn = nullptr)
+    {
+        return SqliteHelper::excutePrepared(databaseName, sql, bindValues, &lastExcutedSql, fn);
+    }
+
     inline QString lastQuery() const
     {
         return lastExcutedSql;
     }
 
 private:
+    template<typename T>
+    static QString insertSql(bool customPK)
+    {
+        const QStringList &fieldNames { SqliteHelper::fieldNames<T>() };
+        Q_ASSERT(!fieldNames.isEmpty());
+
+        const QStringList &fields { fieldNames.mid(customPK ? 0 : 1) };
+        Q_ASSERT(!fields.isEmpty());
+        QStringList placeholders;
+        for (int i = 0; i != fields.size(); ++i)
+            placeholders.append("?");
+
+        return "INSERT INTO " + SqliteHelper::tableName<T>()
+                + "(" + fields.join(",") + ") VALUES (" + placeholders.join(",") + ");";
+    }
+
+    template<typename T>
+    static QVariantList insertValues(const T &entity, bool customPK)
+    {
+        const QStringList &fieldNames { SqliteHelper::fieldNames<T>() };
+        QVariantList values;
+        for (int i = customPK ? 0 : 1; i < fieldNames.size(); ++i) {
+            const QVariant &variant { entity.property(fieldNames[i].toLocal8Bit().data()) };
+            values.append(SqliteHelper::typeString(variant.type()).contains("TEXT") ? QVariant { variant.toString() }
+                                                                                    : variant);
+        }
+        return values;
+    }
+
     QString databaseName;
     QString lastExcutedSql;
 };
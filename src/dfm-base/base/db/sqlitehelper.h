@@ -31,8 +31,9 @@ struct SerializationHelper
         if (!v.canConvert<QString>())
             return false;
 
+        // 单引号需转义为两个单引号，否则路径等文本中的引号会破坏语句
         if (v.type() == QVariant::Type::String)
-            *out = "'" + v.toString() + "'";
+            *out = "'" + v.toString().replace('\'', QLatin1String("''")) + "'";
         else
             *out = v.toString();
 
@@ -56,11 +57,19 @@ struct SerializationHelper
 
 namespace Expression {
 
+// 表达式同时保存两种形式：toString() 为值内联的完整 SQL，
+// preparedString() 以 `?` 占位、值在 bindValues() 中，用于预编译语句的缓存与复用
+
 // SetExpr
 struct SetExpr
 {
     SetExpr(const QString &fieldOpVal)
-        : expr(fieldOpVal)
+        : expr(fieldOpVal), prepared(fieldOpVal)
+    {
+    }
+
+    SetExpr(const QString &fieldOpVal, const QString &preparedFieldOp, const QVariantList &values)
+        : expr(fieldOpVal), prepared(preparedFieldOp), values(values)
     {
     }
 
@@ -69,15 +78,32 @@ struct SetExpr
         return expr;
     }
 
+    QString preparedString() const
+    {
+        return prepared;
+    }
+
+    QVariantList bindValues() const
+    {
+        return values;
+    }
+
     inline SetExpr operator&&(const SetExpr &rhs) const
     {
-        return SetExpr { expr + "," + rhs.expr };
+        return SetExpr { expr + "," + rhs.expr, prepared + "," + rhs.prepared, values + rhs.values };
     }
 
 private:
     QString expr;
+    QString prepared;
+    QVariantList values;
 };
 
+inline QVariant bindValue(const QVariant &value)
+{
+    return value.type() == QVariant::Type::String ? QVariant { value.toString() } : value;
+}
+
 // Field
 struct ExprField
 {
@@ -94,8 +120,7 @@ struct ExprField
         QString out;
         value.type() == QVariant::Type::String ? SerializationHelper::serialize(&out, value.toString())
                                                : SerializationHelper::serialize(&out, value);
-        out = fieldName + "=" + out;
-        return SetExpr(out);
+        return SetExpr(fieldName + "=" + out, fieldName + "=?", { bindValue(value) });
     }
 };
 
@@ -116,7 +141,12 @@ struct Aggregate : public ExprField
 struct Expr
 {
     Expr(const QString &fieldName, const QString &op)
-        : expr(fieldName + op)
+        : expr(fieldName + op), prepared(expr)
+    {
+    }
+
+    Expr(const QString &fieldOp, const QString &preparedFieldOp, const QVariantList &values)
+        : expr(fieldOp), prepared(preparedFieldOp), values(values)
     {
     }
 
@@ -132,6 +162,8 @@ struct Expr
         val.type() == QVariant::Type::String ? SerializationHelper::serialize(&suffix, val.toString())
                                              : SerializationHelper::serialize(&suffix, val);
         expr = prefix + suffix;
+        prepared = prefix + "?";
+        values = { bindValue(val) };
     }
 
     Expr(const ExprField &field, const QString &op, const QVariant &val)
@@ -144,6 +176,16 @@ struct Expr
         return expr;
     }
 
+    QString preparedString() const
+    {
+        return prepared;
+    }
+
+    QVariantList bindValues() const
+    {
+        return values;
+    }
+
     inline Expr operator&&(const Expr &rhs) const
     {
         return andOr(rhs, " AND ");
@@ -160,10 +202,14 @@ private:
         ret.expr = "(" + ret.expr;
         ret.expr += logOp;
         ret.expr += rhs.expr + ")";
+        ret.prepared = "(" + ret.prepared + logOp + rhs.prepared + ")";
+        ret.values += rhs.values;
         return ret;
     }
 
     QString expr;
+    QString prepared;
+    QVariantList values;
 };
 
 // operator (==, !=, >, <, >=, <=)
@@ -219,6 +265,26 @@ inline Expr operator|(const ExprField &op, const QString &value)
     return Expr { op, " NOT LIKE ", value };
 }
 
+// operator ( IN (...) )
+inline Expr in(const ExprField &op, const QVariantList &values)
+{
+    QStringList items;
+    QStringList placeholders;
+    QVariantList bindValues;
+    items.reserve(values.size());
+    for (const QVariant &val : values) {
+        QString item;
+        val.type() == QVariant::Type::String ? SerializationHelper::serialize(&item, val.toString())
+                                             : SerializationHelper::serialize(&item, val);
+        items.append(item);
+        placeholders.append("?");
+        bindValues.append(bindValue(val));
+    }
+    return Expr { op.fieldName + " IN (" + items.join(",") + ")",
+                  op.fieldName + " IN (" + placeholders.join(",") + ")",
+                  bindValues };
+}
+
 template<typename T>
 inline ExprField Field(const QString &fieldName)
 {
@@ -465,6 +531,38 @@ public:
 
         return ret;
     }
+
+    // 使用连接上缓存的预编译语句执行，sql 中以 `?` 占位，按顺序绑定 bindValues
+    static inline bool excutePrepared(const QString &databaseName, const QString &sql, const QVariantList &bindValues,
+                                      QString *lastQuery = nullptr, std::function<void(QSqlQuery *)> fn = nullptr)
+    {
+        QSqlDatabase db { SqliteConnectionPool::instance().openConnection(databaseName) };
+        const QSharedPointer<QSqlQuery> &query { SqliteConnectionPool::instance().takeQuery(db, sql) };
+        if (lastQuery) {
+            *lastQuery = sql;
+            qCDebug(logDFMBase).noquote() << "SQL Query:" << sql << bindValues;
+        }
+        if (!query)
+            return false;
+
+        for (int i = 0; i != bindValues.size(); ++i)
+            query->bindValue(i, bindValues.at(i));
+        query->exec();
+
+        bool ret { true };
+        if (query->lastError().type() != QSqlError::NoError) {
+            qCWarning(logDFMBase).noquote() << "SQL Error: " << query->lastError().text().trimmed() << "SQL:" << sql;
+            ret = false;
+        }
+
+        if (fn)
+            fn(query.data());
+
+        // 重置语句以释放读锁，否则未结束的语句会阻止事务提交和 WAL 检查点
+        query->finish();
+        SqliteConnectionPool::instance().recycleQuery(db, sql, query);
+        return ret;
+    }
 };
 
 DFMBASE_END_NAMESPACE
@@ -51,6 +51,8 @@ public:
     inline SqliteQueryable<T> &where(const Expression::Expr &whereExpr)
     {
         sqlWhere = " WHERE " + whereExpr.toString();
+        preparedWhere = " WHERE " + whereExpr.preparedString();
+        whereValues = whereExpr.bindValues();
         return *this;
     }
 
@@ -63,6 +65,8 @@ public:
     inline SqliteQueryable<T> &having(const Expression::Expr &expr)
     {
         sqlHaving = " HAVING " + expr.toString();
+        preparedHaving = " HAVING " + expr.preparedString();
+        havingValues = expr.bindValues();
         return *this;
     }
 
@@ -123,10 +127,10 @@ public:
 
     inline QList<QVariantMap> toMaps() const
     {
-        const QString &sql { sqlSelect + sqlTarget + getFromSql() + getLimit() + ";" };
+        const QString &sql { sqlSelect + sqlTarget + getPreparedFromSql() + getLimit() + ";" };
         QString lastQuery;
         QList<QVariantMap> maps;
-        SqliteHelper::excute(databaseName, sql, &lastQuery, [&maps](QSqlQuery *query) {
+        SqliteHelper::excutePrepared(databaseName, sql, whereValues + havingValues, &lastQuery, [&maps](QSqlQuery *query) {
             Q_ASSERT(query);
             maps = SqliteQueryable::queryToMaps(query);
         });
@@ -135,11 +139,11 @@ public:
 
     inline QVariant aggregate(const Expression::Aggregate &agg) const
     {
-        const QString &sql { sqlSelect + agg.fieldName + getFromSql() + getLimit() + ";" };
+        const QString &sql { sqlSelect + agg.fieldName + getPreparedFromSql() + getLimit() + ";" };
         QString lastQuery;
         QVariant result;
 
-        SqliteHelper::excute(databaseName, sql, &lastQuery, [&result](QSqlQuery *query) {
+        SqliteHelper::excutePrepared(databaseName, sql, whereValues + havingValues, &lastQuery, [&result](QSqlQuery *query) {
             if (query->next())
                 result = query->value(0);
         });
@@ -154,6 +158,12 @@ private:
         return sqlFrom + sqlWhere + sqlGroupBy + sqlHaving;
     }
 
+    // FROM part with `?` placeholders, values bound from whereValues and havingValues
+    inline QString getPreparedFromSql() const
+    {
+        return sqlFrom + preparedWhere + sqlGroupBy + preparedHaving;
+    }
+
     // Return ORDER BY & LIMIT part for Query
     inline QString getLimit() const
     {
@@ -192,6 +202,11 @@ private:
     QString sqlOrderBy;
     QString sqlLimit;
     QString sqlOffset;
+
+    QString preparedWhere;
+    QString preparedHaving;
+    QVariantList whereValues;
+    QVariantList havingValues;
 };
 DFMBASE_END_NAMESPACE
 
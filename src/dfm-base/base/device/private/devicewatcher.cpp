@@ -16,6 +16,8 @@
 #include <QDebug>
 #include <QStorageInfo>
 #include <QtConcurrent>
+#include <QPointer>
+#include <QSet>
 
 #include <dfm-mount/dmount.h>
 #include <dfm-burn/dopticaldiscinfo.h>
@@ -38,31 +40,160 @@ DeviceWatcher::~DeviceWatcher()
 
 void DeviceWatcher::startPollingUsage()
 {
-    if (d->pollingTimer.isActive())
+    if (d->isPolling)
         return;
-    d->queryUsageAsync();
+    d->isPolling = true;
+    d->pollingTimer.setSingleShot(true);
     connect(&d->pollingTimer, &QTimer::timeout, d.data(), &DeviceWatcherPrivate::queryUsageAsync);
-    d->pollingTimer.start(d->kPollingInterval);
+    d->queryUsageAsync();
 }
 
 void DeviceWatcher::stopPollingUsage()
 {
+    d->isPolling = false;
     d->pollingTimer.stop();
     disconnect(&d->pollingTimer);
+
+    const auto &metrics = d->usageMetrics;
+    qCInfo(logDFMBase) << "Device usage polling stopped - dispatched:" << metrics.dispatched
+                       << "skipped:" << metrics.skipped << "timed out:" << metrics.timedOut
+                       << "unchanged:" << metrics.unchanged;
 }
 
+/*!
+ * \brief DeviceWatcherPrivate::queryUsageAsync
+ * each mounted device is queried on its own in usagePool, a device is skipped while its last query
+ * is still running, so a hung network mount only delays itself. the interval of a device doubles
+ * every time its usage is unchanged or its query times out, and resets when the usage changes.
+ */
 void DeviceWatcherPrivate::queryUsageAsync()
 {
-    QtConcurrent::run([this] {
-        auto blocks = allBlockInfos;
-        auto protocols = allProtocolInfos;
-        std::for_each(blocks.cbegin(), blocks.cend(),
-                      [this](const QVariantMap &item) { queryUsageOfItem(item, DeviceType::kBlockDevice); });
-        std::for_each(protocols.cbegin(), protocols.cend(),
-                      [this](const QVariantMap &item) { queryUsageOfItem(item, DeviceType::kProtocolDevice); });
+    const qint64 now = usageClock.elapsed();
+    QSet<QString> presentIds;
+
+    auto visit = [&](const QHash<QString, QVariantMap> &container, DeviceType type) {
+        for (auto iter = container.cbegin(); iter != container.cend(); ++iter) {
+            if (iter.value().value(DeviceProperty::kMountPoint).toString().isEmpty())
+                continue;
+
+            const QString &id = iter.key();
+            presentIds.insert(id);
+            UsageQueryState &state = usageStates[id];
+            if (state.startedAt >= 0) {
+                if (!state.timedOut && now - state.startedAt >= kUsageQueryTimeout) {
+                    // 卡住的查询无法取消，额外放开一个线程，不占用其他设备的并发名额
+                    state.timedOut = true;
+                    ++usageMetrics.timedOut;
+                    usagePool->setMaxThreadCount(usagePool->maxThreadCount() + 1);
+                    qCWarning(logDFMBase) << "Device usage query timed out:" << id
+                                          << "total timed out:" << usageMetrics.timedOut;
+                }
+                if (now >= state.nextDue)
+                    ++usageMetrics.skipped;
+                continue;
+            }
+
+            if (now >= state.nextDue)
+                dispatchUsageQuery(id, iter.value(), type, now);
+        }
+    };
+    visit(allBlockInfos, DeviceType::kBlockDevice);
+    visit(allProtocolInfos, DeviceType::kProtocolDevice);
+
+    // 已移除或卸载的设备不再调度，仍在运行的查询返回时再清理
+    for (auto iter = usageStates.begin(); iter != usageStates.end();) {
+        if (!presentIds.contains(iter.key()) && iter->startedAt < 0)
+            iter = usageStates.erase(iter);
+        else
+            ++iter;
+    }
+
+    scheduleUsagePolling();
+}
+
+void DeviceWatcherPrivate::dispatchUsageQuery(const QString &id, const QVariantMap &itemData, DeviceType type, qint64 now)
+{
+    UsageQueryState &state = usageStates[id];
+    state.startedAt = now;
+    ++usageMetrics.dispatched;
+
+    QPointer<DeviceWatcherPrivate> guard { this };
+    usagePool->start([guard, id, itemData, type] {
+        // 查询函数不依赖成员状态，对象销毁后仍在运行的查询只丢弃结果
+        const DevStorage storage = (type == DeviceType::kBlockDevice)
+                ? DeviceWatcherPrivate::queryUsageOfBlock(itemData)
+                : DeviceWatcherPrivate::queryUsageOfProtocol(itemData);
+        if (guard)
+            QMetaObject::invokeMethod(guard.data(), [guard, id, type, storage] {
+                if (guard)
+                    guard->onUsageQueried(id, type, storage);
+            }, Qt::QueuedConnection);
     });
 }
 
+void DeviceWatcherPrivate::onUsageQueried(const QString &id, DeviceType type, const DevStorage &storage)
+{
+    auto iter = usageStates.find(id);
+    if (iter == usageStates.end())
+        return;
+
+    UsageQueryState &state = iter.value();
+    if (state.timedOut) {
+        usagePool->setMaxThreadCount(usagePool->maxThreadCount() - 1);
+        qCInfo(logDFMBase) << "Timed out device usage query returned:" << id
+                           << "after" << usageClock.elapsed() - state.startedAt << "ms";
+    }
+
+    const int maxInterval = (type == DeviceType::kBlockDevice) ? kMaxBlockPollingInterval
+                                                                : kMaxProtocolPollingInterval;
+    DevStorage result = storage;
+    if (state.timedOut || (result.isValid() && result == state.last)) {
+        if (!state.timedOut)
+            ++usageMetrics.unchanged;
+        state.interval = qMin(qMax(state.interval, kPollingInterval) * 2, maxInterval);
+    } else {
+        state.interval = kPollingInterval;
+    }
+
+    state.timedOut = false;
+    state.startedAt = -1;
+    state.last = result;
+    state.nextDue = usageClock.elapsed() + state.interval;
+
+    if (result.isValid())
+        emit DevMngIns->devSizeChanged(id, result.total, result.avai);
+
+    scheduleUsagePolling();
+}
+
+void DeviceWatcherPrivate::resetUsageInterval(const QString &id)
+{
+    // 新设备的状态在此创建，下次调度时立即查询
+    UsageQueryState &state = usageStates[id];
+    state.interval = kPollingInterval;
+    state.nextDue = qMin(state.nextDue, usageClock.elapsed() + kPollingInterval);
+    scheduleUsagePolling();
+}
+
+void DeviceWatcherPrivate::scheduleUsagePolling()
+{
+    if (!isPolling)
+        return;
+
+    // 只在最近一个设备到期或最近一个查询可能超时的时候唤醒，空闲时不再固定周期轮询
+    const qint64 now = usageClock.elapsed();
+    qint64 next = now + kMaxProtocolPollingInterval;
+    // 已超时的查询返回时会重新调度，这里不再为它唤醒
+    for (const auto &state : qAsConst(usageStates)) {
+        if (state.startedAt < 0)
+            next = qMin(next, state.nextDue);
+        else if (!state.timedOut)
+            next = qMin(next, state.startedAt + kUsageQueryTimeout);
+    }
+
+    pollingTimer.start(static_cast<int>(qMax<qint64>(next - now, 1000)));
+}
+
 void DeviceWatcherPrivate::updateStorage(const QString &id, quint64 total, quint64 avai)
 {
     auto update = [&](QHash<QString, QVariantMap> &container) {
@@ -348,6 +479,7 @@ void DeviceWatcher::onBlkDevRemoved(const QString &id)
 
 void DeviceWatcher::onBlkDevMounted(const QString &id, const QString &mpt)
 {
+    d->resetUsageInterval(id);
     const QVariantMap &info = d->allBlockInfos.value(id);
     // query info async avoid blocking main thread when disks' IO load is too high.
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
@@ -456,6 +588,7 @@ void DeviceWatcher::onProtoDevRemoved(const QString &id)
 void DeviceWatcher::onProtoDevMounted(const QString &id, const QString &mpt)
 {
     d->allProtocolInfos.insert(id, DeviceHelper::loadProtocolInfo(id));
+    d->resetUsageInterval(id);
 
     emit DevMngIns->protocolDevMounted(id, mpt);
 }
@@ -534,8 +667,20 @@ QStringList DeviceWatcher::getSiblings(const QString &id)
 }
 
 DeviceWatcherPrivate::DeviceWatcherPrivate(DeviceWatcher *qq)
-    : QObject(qq), q(qq)
+    : QObject(qq), q(qq), usagePool(new QThreadPool)
 {
+    usagePool->setMaxThreadCount(4);
+    usageClock.start();
     connect(DevProxyMng, &DeviceProxyManager::devSizeChanged, this, &DeviceWatcherPrivate::updateStorage, Qt::QueuedConnection);
     DConfigManager::instance()->addConfig("org.deepin.dde.file-manager.mount");
 }
+
+DeviceWatcherPrivate::~DeviceWatcherPrivate()
+{
+    usagePool->clear();
+    // 卡在网络挂载上的查询可能永远不返回，此时不等待线程池，避免退出时被阻塞
+    if (usagePool->waitForDone(1000))
+        delete usagePool;
+    else
+        qCWarning(logDFMBase) << "Device usage queries still running on exit, leaving them detached";
+}
@@ -8,6 +8,8 @@
 #include <QTimer>
 #include <QMutex>
 #include <QHash>
+#include <QThreadPool>
+#include <QElapsedTimer>
 #include <QtCore/qobjectdefs.h>
 
 #include <dfm-mount/base/dmount_global.h>
@@ -34,6 +36,24 @@ struct DevStorage
     }
 };
 
+// 单个设备的用量查询调度状态，只在主线程访问
+struct UsageQueryState
+{
+    qint64 nextDue { 0 };   // 下次查询的时间点，相对 usageClock 的毫秒数
+    qint64 startedAt { -1 };   // 正在查询时为开始时间，否则为 -1
+    int interval { 0 };
+    bool timedOut { false };
+    DevStorage last;
+};
+
+struct UsageQueryMetrics
+{
+    quint64 dispatched { 0 };
+    quint64 skipped { 0 };   // 到期时上一次查询仍未返回
+    quint64 timedOut { 0 };
+    quint64 unchanged { 0 };
+};
+
 class DeviceWatcher;
 class DeviceWatcherPrivate : public QObject
 {
@@ -42,6 +62,7 @@ class DeviceWatcherPrivate : public QObject
 
 public:
     explicit DeviceWatcherPrivate(DeviceWatcher *qq);
+    ~DeviceWatcherPrivate() override;
 
 private Q_SLOTS:
     void queryUsageAsync();
@@ -49,14 +70,30 @@ private Q_SLOTS:
 
 private:
     void queryUsageOfItem(const QVariantMap &itemData, DFMMOUNT::DeviceType type);
-    DevStorage queryUsageOfBlock(const QVariantMap &itemData);
-    DevStorage queryUsageOfProtocol(const QVariantMap &itemData);
+    static DevStorage queryUsageOfBlock(const QVariantMap &itemData);
+    static DevStorage queryUsageOfProtocol(const QVariantMap &itemData);
+
+    void dispatchUsageQuery(const QString &id, const QVariantMap &itemData, DFMMOUNT::DeviceType type, qint64 now);
+    void onUsageQueried(const QString &id, DFMMOUNT::DeviceType type, const DevStorage &storage);
+    void resetUsageInterval(const QString &id);
+    void scheduleUsagePolling();
 
 private:
     DeviceWatcher *q { nullptr };
 
     QTimer pollingTimer;
     const int kPollingInterval = 10000;
+    // 用量不变时查询间隔逐次翻倍的上限，块设备另有挂载等事件触发刷新
+    const int kMaxBlockPollingInterval = 60000;
+    const int kMaxProtocolPollingInterval = 300000;
+    // 单个设备查询超过该时长视为超时，后续查询退避，不影响其他设备
+    const int kUsageQueryTimeout = 5000;
+
+    bool isPolling { false };
+    QThreadPool *usagePool { nullptr };
+    QElapsedTimer usageClock;
+    QHash<QString, UsageQueryState> usageStates;
+    UsageQueryMetrics usageMetrics;
 
     QHash<QString, QVariantMap> allBlockInfos;
     QHash<QString, QVariantMap> allProtocolInfos;
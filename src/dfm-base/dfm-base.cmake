@@ -8,6 +8,7 @@ find_package(PkgConfig REQUIRED)
 pkg_check_modules(gio REQUIRED gio-unix-2.0 IMPORTED_TARGET)
 pkg_check_modules(mount REQUIRED mount IMPORTED_TARGET)
 pkg_check_modules(LIBHEIF REQUIRED libheif)
+find_package(ICU COMPONENTS i18n uc REQUIRED)
 
 pkg_search_module(X11 REQUIRED x11 IMPORTED_TARGET)
 if(${QT_VERSION_MAJOR} EQUAL "6")
@@ -102,6 +103,9 @@ target_link_libraries(${BIN_NAME}
         poppler-cpp
         ${DFM_EXTRA_LIBRARIES}
         ${LIBHEIF_LIBRARIES}
+    PRIVATE
+        ICU::i18n
+        ICU::uc
 )
 
 target_include_directories(${BIN_NAME} 
@@ -9,6 +9,7 @@
 
 #include <QPointer>
 #include <QMutex>
+#include <QAtomicInt>
 
 namespace dfmbase {
 class SortFileInfoPrivate
@@ -20,6 +21,10 @@ public:
 public:
     SortFileInfo *const q;   // SortFileInfo实例对象
     QUrl url;
+    // 排序键在第一次使用时生成，只显示不排序的条目（如虚拟目录、远程文件）不必计算
+    mutable QByteArray nameSortKey;
+    mutable QAtomicInt nameSortKeyReady { 0 };
+    mutable QMutex nameSortKeyMutex;
     qint64 filesize { 0 };
     bool file { false };
     bool dir { false };
@@ -4,6 +4,7 @@
 
 #include <dfm-base/interfaces/private/sortfileinfo_p.h>
 #include <dfm-base/mimetype/mimetypedisplaymanager.h>
+#include <dfm-base/utils/sortutils.h>
 
 #include <QtConcurrent>
 #include <QMutexLocker>
@@ -23,6 +24,8 @@ SortFileInfo::~SortFileInfo()
 void SortFileInfo::setUrl(const QUrl &url)
 {
     d->url = url;
+    d->nameSortKey.clear();
+    d->nameSortKeyReady.storeRelease(0);
 }
 
 void SortFileInfo::setSize(const qint64 size)
@@ -105,6 +108,19 @@ QUrl SortFileInfo::fileUrl() const
     return d->url;
 }
 
+QByteArray SortFileInfo::fileNameSortKey() const
+{
+    // 并行排序时多个线程可能同时比较同一个条目
+    if (!d->nameSortKeyReady.loadAcquire()) {
+        QMutexLocker locker(&d->nameSortKeyMutex);
+        if (!d->nameSortKeyReady.loadRelaxed()) {
+            d->nameSortKey = SortUtils::fileNameSortKey(d->url.fileName());
+            d->nameSortKeyReady.storeRelease(1);
+        }
+    }
+    return d->nameSortKey;
+}
+
 qint64 SortFileInfo::fileSize() const
 {
     return d->filesize;
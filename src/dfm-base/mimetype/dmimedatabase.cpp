@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dmimedatabase.h"
+#include "mimetypecache.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/utils/networkutils.h>
@@ -76,7 +77,7 @@ QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeD
     if (isMatchExtension || ProtocolUtils::isRemoteFile(QUrl::fromLocalFile(path))) {
         result = QMimeDatabase::mimeTypeForFile(fileInfo->pathOf(PathInfoType::kFilePath), QMimeDatabase::MatchExtension);
     } else {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo->pathOf(PathInfoType::kFilePath), mode);
+        result = mimeTypeForLocalFile(fileInfo->pathOf(PathInfoType::kFilePath), mode);
     }
 
     // temporary dirty fix, once WPS get installed, the whole mimetype database thing get fscked up.
@@ -98,10 +99,6 @@ QMimeType DMimeDatabase::mimeTypeForFile(const FileInfoPointer &fileInfo, QMimeD
 
 QMimeType DMimeDatabase::mimeTypeForFile(const QString &fileName, QMimeDatabase::MatchMode mode, const QString &inod, const bool isGvfs) const
 {
-    if (!inod.isEmpty() && inodMimetypeCache.contains(inod)) {
-        return inodMimetypeCache.value(inod);
-    }
-
     QUrl url = QUrl::fromLocalFile(fileName);
     if (!ProtocolUtils::isLocalFile(url) && NetworkUtils::instance()->checkFtpOrSmbBusy(url))
         return QMimeType();
@@ -114,12 +111,9 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QString &fileName, QMimeDatabase:
 
 QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabase::MatchMode mode, const QString &inod, const bool isGvfs) const
 {
+    Q_UNUSED(inod)
     Q_UNUSED(isGvfs)
     // 如果是低速设备，则先从扩展名去获取mime信息；对于本地文件，保持默认的获取策略
-    bool canCache = !inod.isEmpty();
-    if (!inod.isEmpty() && inodMimetypeCache.contains(inod)) {
-        return inodMimetypeCache.value(inod);
-    }
     if (fileInfo.isDir()) {
         return QMimeDatabase::mimeTypeForFile(QFileInfo("/home"), mode);
     }
@@ -160,7 +154,7 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (isMatchExtension || ProtocolUtils::isRemoteFile(QUrl::fromLocalFile(path))) {
         result = QMimeDatabase::mimeTypeForFile(fileInfo, QMimeDatabase::MatchExtension);
     } else {
-        result = QMimeDatabase::mimeTypeForFile(fileInfo, mode);
+        result = mimeTypeForLocalFile(fileInfo.absoluteFilePath(), mode);
     }
 
     // temporary dirty fix, once WPS get installed, the whole mimetype database thing get fscked up.
@@ -173,18 +167,32 @@ QMimeType DMimeDatabase::mimeTypeForFile(const QFileInfo &fileInfo, QMimeDatabas
     if (officeSuffixList.contains(fileInfo.suffix()) && wrongMimeTypeNames.contains(result.name())) {
         QList<QMimeType> results = QMimeDatabase::mimeTypesForFileName(fileInfo.fileName());
         if (!results.isEmpty()) {
-            if (canCache) {
-                const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, results.first());
-            }
             return results.first();
         }
     }
-    if (canCache) {
-        const_cast<DMimeDatabase *>(this)->inodMimetypeCache.insert(inod, result);
-    }
     return result;
 }
 
+QMimeType DMimeDatabase::mimeTypeForLocalFile(const QString &filePath, QMimeDatabase::MatchMode mode) const
+{
+    // 按扩展名匹配的开销很小，只缓存需要读取文件内容的结果
+    if (mode == QMimeDatabase::MatchExtension)
+        return QMimeDatabase::mimeTypeForFile(filePath, mode);
+
+    const QByteArray &key = MimeTypeCache::makeKey(filePath, mode);
+    QString name;
+    if (!key.isEmpty() && MimeTypeCache::instance()->find(key, &name)) {
+        const QMimeType &type = QMimeDatabase::mimeTypeForName(name);
+        if (type.isValid())
+            return type;
+    }
+
+    const QMimeType &type = QMimeDatabase::mimeTypeForFile(filePath, mode);
+    if (!key.isEmpty() && type.isValid())
+        MimeTypeCache::instance()->insert(key, type.name());
+    return type;
+}
+
 QMimeType DMimeDatabase::mimeTypeForUrl(const QUrl &url) const
 {
     if (url.isLocalFile())
@@ -26,9 +26,7 @@ public:
 
 private:
     QMimeType mimeTypeForFile(const QFileInfo &fileInfo, MatchMode mode, const QString &inod, const bool isGvfs = false) const;
-
-private:
-    QHash<QString, QMimeType> inodMimetypeCache;
+    QMimeType mimeTypeForLocalFile(const QString &filePath, MatchMode mode) const;
 };
 
 }
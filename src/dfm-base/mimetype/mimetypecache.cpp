@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mimetypecache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <sys/stat.h>
+
+using namespace dfmbase;
+
+static constexpr int kMimeTypeCacheCapacity { 65536 };
+static constexpr quint32 kPersistentMagic { 0x444d5443 };   // "DMTC"
+static constexpr quint32 kPersistentVersion { 1 };
+
+template<typename T>
+static inline void appendValue(QByteArray *key, T value)
+{
+    key->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+MimeTypeCache::MimeTypeCache()
+    : cache(kMimeTypeCacheCapacity)
+{
+}
+
+MimeTypeCache *MimeTypeCache::instance()
+{
+    static MimeTypeCache ins;
+    return &ins;
+}
+
+/*!
+ * \brief MimeTypeCache::makeKey Build the cache key of a local file
+ * \param filePath local file path, symbolic links are followed like QMimeDatabase does
+ * \param mode match mode used to resolve the mime type
+ * \return empty if the file can not be stat
+ */
+QByteArray MimeTypeCache::makeKey(const QString &filePath, QMimeDatabase::MatchMode mode)
+{
+    struct stat st;
+    if (::stat(QFile::encodeName(filePath).constData(), &st) != 0)
+        return QByteArray();
+
+    // 重命名不改变 inode 和修改时间，按扩展名匹配的结果依赖文件名
+    const QByteArray &name = filePath.mid(filePath.lastIndexOf('/') + 1).toUtf8();
+    QByteArray key;
+    key.reserve(static_cast<int>(sizeof(quint64) * 5 + sizeof(qint32)) + name.size());
+    appendValue<quint64>(&key, st.st_dev);
+    appendValue<quint64>(&key, st.st_ino);
+    appendValue<qint64>(&key, st.st_mtim.tv_sec);
+    appendValue<qint64>(&key, st.st_mtim.tv_nsec);
+    appendValue<qint64>(&key, st.st_size);
+    appendValue<qint32>(&key, mode);
+    key.append(name);
+    return key;
+}
+
+bool MimeTypeCache::find(const QByteArray &key, QString *name)
+{
+    QMutexLocker locker(&mutex);
+    const QString *cached = cache.object(key);
+    if (!cached)
+        return false;
+
+    if (name)
+        *name = *cached;
+    return true;
+}
+
+void MimeTypeCache::insert(const QByteArray &key, const QString &name)
+{
+    if (key.isEmpty() || name.isEmpty())
+        return;
+
+    QMutexLocker locker(&mutex);
+    cache.insert(key, new QString(name));
+    dirty = true;
+}
+
+void MimeTypeCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    cache.clear();
+    dirty = true;
+}
+
+int MimeTypeCache::count()
+{
+    QMutexLocker locker(&mutex);
+    return cache.count();
+}
+
+/*!
+ * \brief MimeTypeCache::setPersistentFile Keep the cache in \a filePath across sessions,
+ * entries saved by the previous session are loaded immediately, call save() before quit
+ */
+void MimeTypeCache::setPersistentFile(const QString &filePath)
+{
+    {
+        QMutexLocker locker(&mutex);
+        persistentFile = filePath;
+    }
+
+    if (!filePath.isEmpty())
+        load();
+}
+
+bool MimeTypeCache::save()
+{
+    QMutexLocker locker(&mutex);
+    if (persistentFile.isEmpty() || !dirty)
+        return false;
+
+    QSaveFile file(persistentFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "MimeTypeCache: failed to open" << persistentFile << file.errorString();
+        return false;
+    }
+
+    const auto &keys = cache.keys();
+    QDataStream stream(&file);
+    stream << kPersistentMagic << kPersistentVersion << databaseFingerprint()
+           << static_cast<qint32>(keys.size());
+    for (const QByteArray &key : keys)
+        stream << key << *cache.object(key);
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(logDFMBase) << "MimeTypeCache: failed to save" << persistentFile;
+        return false;
+    }
+
+    dirty = false;
+    qCInfo(logDFMBase) << "MimeTypeCache: saved" << keys.size() << "entries to" << persistentFile;
+    return true;
+}
+
+bool MimeTypeCache::load()
+{
+    QMutexLocker locker(&mutex);
+    QFile file(persistentFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic { 0 };
+    quint32 version { 0 };
+    QByteArray fingerprint;
+    qint32 size { 0 };
+    stream >> magic >> version >> fingerprint >> size;
+    // 系统 mime 数据库更新后旧的结果不再可信
+    if (magic != kPersistentMagic || version != kPersistentVersion || fingerprint != databaseFingerprint()) {
+        qCInfo(logDFMBase) << "MimeTypeCache: discard outdated cache file" << persistentFile;
+        return false;
+    }
+
+    int loaded = 0;
+    for (qint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        QByteArray key;
+        QString name;
+        stream >> key >> name;
+        if (stream.status() != QDataStream::Ok || key.isEmpty() || name.isEmpty())
+            break;
+        if (!cache.contains(key)) {
+            cache.insert(key, new QString(name));
+            ++loaded;
+        }
+    }
+
+    qCInfo(logDFMBase) << "MimeTypeCache: loaded" << loaded << "entries from" << persistentFile;
+    return loaded > 0;
+}
+
+QByteArray MimeTypeCache::databaseFingerprint()
+{
+    QByteArray fingerprint(QT_VERSION_STR);
+    const auto &files = QStandardPaths::locateAll(QStandardPaths::GenericDataLocation, "mime/mime.cache");
+    for (const QString &path : files) {
+        const QFileInfo info(path);
+        fingerprint.append(';').append(QFile::encodeName(path)).append(':');
+        fingerprint.append(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    }
+    return fingerprint;
+}
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMETYPECACHE_H
+#define MIMETYPECACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QCache>
+#include <QMimeDatabase>
+#include <QMutex>
+
+namespace dfmbase {
+
+/*!
+ * \brief The MimeTypeCache class caches content based mime type names of local files for
+ * all DMimeDatabase instances. Entries are keyed by device, inode, modification time, size,
+ * file name and match mode, so a changed file never hits a stale entry.
+ */
+class MimeTypeCache
+{
+    Q_DISABLE_COPY(MimeTypeCache)
+
+public:
+    static MimeTypeCache *instance();
+    static QByteArray makeKey(const QString &filePath, QMimeDatabase::MatchMode mode);
+
+    bool find(const QByteArray &key, QString *name);
+    void insert(const QByteArray &key, const QString &name);
+    void clear();
+    int count();
+
+    void setPersistentFile(const QString &filePath);
+    bool save();
+
+private:
+    MimeTypeCache();
+    bool load();
+    static QByteArray databaseFingerprint();
+
+    QMutex mutex;
+    QCache<QByteArray, QString> cache;
+    QString persistentFile;
+    bool dirty { false };
+};
+
+}
+
+#endif   // MIMETYPECACHE_H
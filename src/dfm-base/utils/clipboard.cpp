@@ -29,7 +29,7 @@
 using namespace dfmbase;
 
 namespace GlobalData {
-static QList<QUrl> clipboardFileUrls;
+static ClipBoard::SnapshotPointer clipboardSnapshot { new ClipBoard::Snapshot };
 static QMutex clipboardFileUrlsMutex;
 static QAtomicInt remoteCurrentCount = 0;
 static ClipBoard::ClipboardAction clipboardAction = ClipBoard::kUnknownAction;
@@ -40,36 +40,76 @@ static constexpr char kRemoteCopyKey[] = "uos/remote-copy";
 static constexpr char kGnomeCopyKey[] = "x-special/gnome-copied-files";
 static constexpr char kRemoteAssistanceCopyKey[] = "uos/remote-copied-files";
 
-void onClipboardDataChanged()
+ClipBoard::SnapshotPointer currentSnapshot()
 {
-    if (!canReadClipboard)
-        return;
-
     QMutexLocker lk(&clipboardFileUrlsMutex);
-    clipboardFileUrls.clear();
+    return clipboardSnapshot;
+}
+
+/*!
+ * \brief publishSnapshot Replace the clipboard snapshot
+ * \return URLs whose cut state differs between the old and the new snapshot
+ */
+QList<QUrl> publishSnapshot(const QList<QUrl> &urls)
+{
+    QSharedPointer<ClipBoard::Snapshot> snapshot(new ClipBoard::Snapshot);
+    snapshot->action = clipboardAction;
+    snapshot->urls = urls;
+    snapshot->urlSet.reserve(urls.size());
+    for (const QUrl &url : urls)
+        snapshot->urlSet.insert(url);
+
+    ClipBoard::SnapshotPointer old;
+    {
+        QMutexLocker lk(&clipboardFileUrlsMutex);
+        old = clipboardSnapshot;
+        snapshot->version = old->version + 1;
+        clipboardSnapshot = snapshot;
+    }
+
+    static const QSet<QUrl> kEmpty;
+    const QSet<QUrl> &oldCut = old->action == ClipBoard::kCutAction ? old->urlSet : kEmpty;
+    const QSet<QUrl> &newCut = snapshot->action == ClipBoard::kCutAction ? snapshot->urlSet : kEmpty;
+
+    QList<QUrl> changed;
+    for (const QUrl &url : oldCut) {
+        if (!newCut.contains(url))
+            changed << url;
+    }
+    for (const QUrl &url : newCut) {
+        if (!oldCut.contains(url))
+            changed << url;
+    }
+    return changed;
+}
+
+QList<QUrl> onClipboardDataChanged()
+{
+    if (!canReadClipboard)
+        return {};
 
     const QMimeData *mimeData = qApp->clipboard()->mimeData();
     if (!mimeData || mimeData->formats().isEmpty()) {
         qCWarning(logDFMBase) << "get null mimeData from QClipBoard or remote formats is null!";
-        return;
+        return publishSnapshot({});
     }
     if (mimeData->hasFormat(kRemoteCopyKey)) {
         qCWarning(logDFMBase) << "clipboard use other !";
         clipboardAction = ClipBoard::kRemoteAction;
         remoteCurrentCount++;
-        return;
+        return publishSnapshot({});
     }
     // 远程协助功能
     if (mimeData->hasFormat(kRemoteAssistanceCopyKey)) {
         qCInfo(logDFMBase) << "Remote copy: set remote copy action";
         clipboardAction = ClipBoard::kRemoteCopiedAction;
-        return;
+        return publishSnapshot({});
     }
     // 没有文件拷贝
     if (!mimeData->hasFormat(kGnomeCopyKey)) {
         qCWarning(logDFMBase) << "no kGnomeCopyKey target in mimedata formats!";
         clipboardAction = ClipBoard::kUnknownAction;
-        return;
+        return publishSnapshot({});
     }
     const QString &data = mimeData->data(kGnomeCopyKey);
     const static QRegularExpression regCut("cut\nfile://"), regCopy("copy\nfile://");
@@ -82,10 +122,12 @@ void onClipboardDataChanged()
         clipboardAction = ClipBoard::kUnknownAction;
     }
 
+    QList<QUrl> urls;
     for (const auto &url : mimeData->urls()) {
         if (url.isValid() && !url.scheme().isEmpty())
-            clipboardFileUrls << url;
+            urls << url;
     }
+    return publishSnapshot(urls);
 }
 }   // namespace GlobalData
 
@@ -96,6 +138,7 @@ ClipBoard::ClipBoard(QObject *parent)
         onClipboardDataChanged();
         emit clipboardDataChanged();
     });
+    qRegisterMetaType<QList<QUrl>>();
 
     connect(&FileManagerWindowsManager::instance(),
             &FileManagerWindowsManager::windowCreated, this, [] {
@@ -267,8 +310,7 @@ QList<QUrl> ClipBoard::getRemoteUrls()
  */
 QList<QUrl> ClipBoard::clipboardFileUrlList() const
 {
-    QMutexLocker lk(&GlobalData::clipboardFileUrlsMutex);
-    return GlobalData::clipboardFileUrls;
+    return GlobalData::currentSnapshot()->urls;
 }
 /*!
  * \brief ClipBoard::clipboardAction Gets the current operation of the clipboard
@@ -278,10 +320,36 @@ ClipBoard::ClipboardAction ClipBoard::clipboardAction() const
 {
     return GlobalData::clipboardAction;
 }
+/*!
+ * \brief ClipBoard::snapshot Gets the current clipboard content without copying the url list
+ * \return
+ */
+ClipBoard::SnapshotPointer ClipBoard::snapshot() const
+{
+    return GlobalData::currentSnapshot();
+}
+/*!
+ * \brief ClipBoard::clipboardVersion Increases every time the clipboard content is replaced
+ * \return
+ */
+quint64 ClipBoard::clipboardVersion() const
+{
+    return GlobalData::currentSnapshot()->version;
+}
+/*!
+ * \brief ClipBoard::isCutUrl Check whether the url is cut to the clipboard
+ * \param url
+ * \return
+ */
+bool ClipBoard::isCutUrl(const QUrl &url) const
+{
+    const auto &current = GlobalData::currentSnapshot();
+    return current->action == kCutAction && current->urlSet.contains(url);
+}
 
 void ClipBoard::removeUrls(const QList<QUrl> &urls)
 {
-    QList<QUrl> clipboardUrls = GlobalData::clipboardFileUrls;
+    QList<QUrl> clipboardUrls = clipboardFileUrlList();
     ClipBoard::ClipboardAction action = GlobalData::clipboardAction;
 
     if (!clipboardUrls.isEmpty() && action != ClipBoard::kUnknownAction) {
@@ -301,7 +369,7 @@ void ClipBoard::removeUrls(const QList<QUrl> &urls)
 
 void ClipBoard::replaceClipboardUrl(const QUrl &oldUrl, const QUrl &newUrl)
 {
-    QList<QUrl> clipboardUrls = GlobalData::clipboardFileUrls;
+    QList<QUrl> clipboardUrls = clipboardFileUrlList();
     ClipBoard::ClipboardAction action = GlobalData::clipboardAction;
     if (clipboardUrls.isEmpty() || action == ClipBoard::kUnknownAction)
         return;
@@ -442,9 +510,7 @@ QList<QUrl> ClipBoard::getUrlsByX11()
     }
 
     if (GlobalData::clipboardAction == kRemoteAction && currentCount == GlobalData::remoteCurrentCount) {
-        QMutexLocker lk(&GlobalData::clipboardFileUrlsMutex);
-        GlobalData::clipboardFileUrls.clear();
-        GlobalData::clipboardFileUrls = clipboardFileUrls;
+        GlobalData::publishSnapshot(clipboardFileUrls);
         GlobalData::remoteCurrentCount = 0;
     }
 
@@ -453,5 +519,7 @@ QList<QUrl> ClipBoard::getUrlsByX11()
 
 void ClipBoard::onClipboardDataChanged()
 {
-    GlobalData::onClipboardDataChanged();
+    const QList<QUrl> &changed = GlobalData::onClipboardDataChanged();
+    if (!changed.isEmpty())
+        emit cutStateChanged(changed);
 }
@@ -8,8 +8,11 @@
 #include <dfm-base/dfm_base_global.h>
 
 #include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QUrl>
+
 class QMimeData;
-class QUrl;
 namespace dfmbase {
 class ClipBoard : public QObject
 {
@@ -26,6 +29,16 @@ public:
         kUnknownAction = 255
     };
 
+    // 剪贴板内容的只读快照，内容变化时整体替换并递增版本号
+    struct Snapshot
+    {
+        quint64 version { 0 };
+        ClipboardAction action { kUnknownAction };
+        QList<QUrl> urls;
+        QSet<QUrl> urlSet;
+    };
+    using SnapshotPointer = QSharedPointer<const Snapshot>;
+
 public:
     static ClipBoard *instance();
     static QList<QUrl> getRemoteUrls();
@@ -38,6 +51,9 @@ public:
 
     QList<QUrl> clipboardFileUrlList() const;
     ClipboardAction clipboardAction() const;
+    SnapshotPointer snapshot() const;
+    quint64 clipboardVersion() const;
+    bool isCutUrl(const QUrl &url) const;
     void removeUrls(const QList<QUrl> &urls);
     void replaceClipboardUrl(const QUrl &oldUrl, const QUrl &newUrl);
 
@@ -48,6 +64,8 @@ private:
 
 Q_SIGNALS:
     void clipboardDataChanged();
+    // 剪切状态发生变化的文件
+    void cutStateChanged(const QList<QUrl> &urls);
 
 public Q_SLOTS:
     void onClipboardDataChanged();
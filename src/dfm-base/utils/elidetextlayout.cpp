@@ -10,19 +10,52 @@
 #include <QTextDocument>
 #include <QTextLayout>
 #include <QTextBlock>
+#include <QCache>
+#include <QThread>
+#include <QGuiApplication>
 #include <QDebug>
 
+#include <DGuiApplicationHelper>
+
 #include <dfm-base/dfm_base_global.h>
 
+#include <mutex>
+
 using namespace dfmbase;
+DGUI_USE_NAMESPACE
 
-ElideTextLayout::ElideTextLayout(const QString &text)
-    : document(new QTextDocument)
+// 缓存的排版结果，行位置以(0, 0)为原点，绘制时再平移到目标区域
+struct ElideTextLayout::LayoutLines
+{
+    QScopedPointer<QTextLayout> ownedBody;
+    QTextLayout *body { nullptr };
+    int bodyLineCount { 0 };   // body中需要绘制的行数
+    QScopedPointer<QTextLayout> elided;
+    QString text;
+    QString elideText;
+    QList<QPair<int, int>> matches;   // 未省略行的高亮区间
+    QList<QPair<int, int>> elideMatches;   // 省略行的高亮区间
+};
+
+static constexpr int kLayoutCacheCapacity { 8192 };
+
+// QTextDocument::setPlainText 会按段落分隔符拆分文本，排版只使用第一段
+static QString firstBlockText(const QString &text)
 {
-    document->setPlainText(text);
+    for (int i = 0; i < text.size(); ++i) {
+        const QChar ch = text.at(i);
+        if (ch == QLatin1Char('\n') || ch == QLatin1Char('\r') || ch == QChar::ParagraphSeparator)
+            return text.left(i);
+    }
+    return text;
+}
 
-    attributes.insert(kFont, document->defaultFont());
-    attributes.insert(kLineHeight, QFontMetrics(document->defaultFont()).height());
+ElideTextLayout::ElideTextLayout(const QString &text)
+    : plainText(text)
+{
+    const QFont font;
+    attributes.insert(kFont, font);
+    attributes.insert(kLineHeight, QFontMetrics(font).height());
     attributes.insert(kBackgroundRadius, 0);
     attributes.insert(kAlignment, Qt::AlignHCenter);
     attributes.insert(kWrapMode, (uint)QTextOption::WrapAtWordBoundaryOrAnywhere);
@@ -37,12 +70,84 @@ ElideTextLayout::~ElideTextLayout()
 
 void ElideTextLayout::setText(const QString &text)
 {
-    document->setPlainText(text);
+    plainText = text;
+    if (document)
+        document->setPlainText(text);
 }
 
 QString ElideTextLayout::text() const
 {
-    return document->toPlainText();
+    return document ? document->toPlainText() : plainText;
+}
+
+QTextDocument *ElideTextLayout::documentHandle()
+{
+    if (!document) {
+        document = new QTextDocument;
+        document->setPlainText(plainText);
+    }
+    return document;
+}
+
+void ElideTextLayout::clearLayoutCache()
+{
+    layoutCache()->clear();
+}
+
+QCache<QString, ElideTextLayout::LayoutLines> *ElideTextLayout::layoutCache()
+{
+    // 有意不释放：QTextLayout 持有的字体资源不能晚于 QGuiApplication 析构
+    static auto cache = new QCache<QString, LayoutLines>(kLayoutCacheCapacity);
+    static std::once_flag connected;
+    if (!qGuiApp)
+        return cache;
+
+    std::call_once(connected, []() {
+        auto clear = []() {
+            ElideTextLayout::clearLayoutCache();
+        };
+        QObject::connect(qGuiApp, &QGuiApplication::fontChanged, qGuiApp, clear);
+        QObject::connect(qGuiApp, &QGuiApplication::fontDatabaseChanged, qGuiApp, clear);
+        QObject::connect(qGuiApp, &QGuiApplication::aboutToQuit, qGuiApp, clear);
+        QObject::connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, qGuiApp, clear);
+    });
+    return cache;
+}
+
+QString ElideTextLayout::cacheKey(const QSizeF &size, Qt::TextElideMode elideMode) const
+{
+    // 缓存的 QTextLayout 只能在GUI线程中复用
+    if (!qGuiApp || QThread::currentThread() != qGuiApp->thread())
+        return QString();
+
+    const int lineHeight = attribute<int>(kLineHeight);
+    if (lineHeight <= 0 || size.width() <= 0)
+        return QString();
+
+    // 排版结果只与可容纳的行数有关，与区域的具体高度无关
+    const qreal lines = qMin<qreal>(size.height() / lineHeight, INT_MAX);
+    const int maxLines = qMax(1, qFloor(lines));
+
+    const QChar sep(0x1f);
+    QString key;
+    key.reserve(plainText.size() + 96);
+    key.append(QString::number(size.width(), 'f', 2)).append(sep)
+            .append(QString::number(maxLines)).append(sep)
+            .append(QString::number(lineHeight)).append(sep)
+            .append(QString::number(attribute<uint>(kWrapMode))).append(sep)
+            .append(QString::number(attribute<uint>(kAlignment))).append(sep)
+            .append(QString::number(attribute<int>(kTextDirection))).append(sep)
+            .append(QString::number(elideMode)).append(sep)
+            .append(attribute<QFont>(kFont).key()).append(sep);
+    if (highlightActive())
+        key.append(highlightKeywords.join(sep));
+    key.append(sep).append(plainText);
+    return key;
+}
+
+bool ElideTextLayout::highlightActive() const
+{
+    return enableHighlight && highlightColor.isValid() && !highlightKeywords.isEmpty();
 }
 
 QList<QPair<int, int>> ElideTextLayout::findKeywordMatches(const QString &text) const
@@ -278,82 +383,54 @@ QList<QPair<int, int>> ElideTextLayout::calculateElideHighlightMatches(
 
 QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background, QStringList *textLines)
 {
-    QList<QRectF> ret;
-    QTextLayout *lay = document->firstBlock().layout();
-    if (!lay) {
-        qCWarning(logDFMBase) << "invaild block" << document->firstBlock().text();
-        return ret;
-    }
+    // 文档可能已被外部修改（如插入标签对象），直接使用文档排版
+    if (document) {
+        QTextLayout *lay = document->firstBlock().layout();
+        if (!lay) {
+            qCWarning(logDFMBase) << "invaild block" << document->firstBlock().text();
+            return {};
+        }
 
-    initLayoutOption(lay);
-    int textLineHeight = attribute<int>(kLineHeight);
-    QSizeF size = rect.size();
-    QPointF offset = rect.topLeft();
-    qreal curHeight = 0;
+        LayoutLines lines;
+        lines.body = lay;
+        lines.text = text();
+        layoutLines(lay, rect.size(), rect.topLeft(), elideMode, &lines);
+        return drawLines(lines, QPointF(0, 0), painter, background, textLines);
+    }
 
-    // for draw background.
-    QRectF lastLineRect;
-    QString elideText;
-    QString curText = text();
-    bool paintLineWithHighlight = enableHighlight && highlightColor.isValid() && !highlightKeywords.isEmpty();
-    
-    // 预处理整个文本中的所有关键词匹配位置
-    QList<QPair<int, int>> allMatches; // 保存所有匹配位置: <开始位置, 长度>
-    if (paintLineWithHighlight) {
-        allMatches = findKeywordMatches(curText);
+    const QString &key = cacheKey(rect.size(), elideMode);
+    if (!key.isEmpty()) {
+        if (LayoutLines *cached = layoutCache()->object(key))
+            return drawLines(*cached, rect.topLeft(), painter, background, textLines);
     }
-    
-    // 一个更新后的匹配列表，用于处理elideText情况
-    QList<QPair<int, int>> currentMatches = allMatches;
 
-    auto processLine = [this, &ret, painter, &lastLineRect, background, textLineHeight, &curText, textLines, 
-                        paintLineWithHighlight, &currentMatches](QTextLine &line) {
-        QRectF lRect = line.naturalTextRect();
-        lRect.setHeight(textLineHeight);
+    QScopedPointer<LayoutLines> lines(new LayoutLines);
+    lines->text = plainText;
+    lines->ownedBody.reset(new QTextLayout(firstBlockText(plainText)));
+    lines->body = lines->ownedBody.data();
+    layoutLines(lines->body, rect.size(), QPointF(0, 0), elideMode, lines.data());
 
-        ret.append(lRect);
-        if (textLines) {
-            const auto &t = curText.mid(line.textStart(), line.textLength());
-            textLines->append(t);
-        }
+    const QList<QRectF> &ret = drawLines(*lines, rect.topLeft(), painter, background, textLines);
+    if (!key.isEmpty())
+        layoutCache()->insert(key, lines.take());
 
-        // draw
-        if (painter) {
-            // draw background
-            if (background.style() != Qt::NoBrush) {
-                lastLineRect = drawLineBackground(painter, lRect, lastLineRect, background);
-            }
-            
-            // 获取当前行的文本范围
-            int lineStart = line.textStart();
-            int lineEnd = lineStart + line.textLength();
-            
-            // 检查当前行是否需要高亮显示（检查是否有任何关键词与当前行有重叠）
-            bool needHighlight = false;
-            if (paintLineWithHighlight) {
-                for (const auto &match : currentMatches) {
-                    int matchStart = match.first;
-                    int matchEnd = matchStart + match.second;
-                    
-                    // 如果匹配区域与当前行有任何重叠
-                    if (matchEnd > lineStart && matchStart < lineEnd) {
-                        needHighlight = true;
-                        break;
-                    }
-                }
-            }
+    return ret;
+}
 
-            if (!paintLineWithHighlight || !needHighlight) {
-                // draw text line without highlight
-                line.draw(painter, QPoint(0, 0));
-                return;
-            }
+void ElideTextLayout::layoutLines(QTextLayout *lay, const QSizeF &size, const QPointF &origin, Qt::TextElideMode elideMode, LayoutLines *lines)
+{
+    initLayoutOption(lay);
+    int textLineHeight = attribute<int>(kLineHeight);
+    QPointF offset = origin;
+    qreal curHeight = 0;
+    bool paintLineWithHighlight = highlightActive();
 
-            // 获取当前行文本
-            QString lineText = curText.mid(lineStart, line.textLength());
-            drawTextWithHighlight(painter, line, lineText, lRect, lineStart, currentMatches);
-        }
-    };
+    // 预处理整个文本中的所有关键词匹配位置
+    if (paintLineWithHighlight)
+        lines->matches = findKeywordMatches(lines->text);
+
+    // 一个更新后的匹配列表，用于处理elideText情况
+    lines->elideMatches = lines->matches;
 
     {
         lay->beginLayout();
@@ -369,30 +446,30 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
                 if (nextLine.isValid()) {
                     // elide current line.
                     QFontMetrics fm(lay->font());
-                    QString originalText = text().mid(line.textStart());
-                    elideText = fm.elidedText(originalText, elideMode, qRound(size.width()));
-                    
+                    QString originalText = lines->text.mid(line.textStart());
+                    QString elideText = fm.elidedText(originalText, elideMode, qRound(size.width()));
+
                     // 判断文本是否被省略以及省略位置
                     bool isElided = elideText != originalText;
                     int elidePos = 0;
-                    
+
                     if (isElided) {
                         // 使用改进的方法确定省略位置
                         elidePos = determineElidePosition(elideText, originalText, elideMode);
                         if (elidePos < 0) // 如果没有省略（虽然不太可能发生）
                             elidePos = 0;
                     }
-                    
-                    curText = elideText;
-                    
+
+                    lines->elideText = elideText;
+
                     // 如果有省略，需要处理高亮匹配位置
                     if (isElided && paintLineWithHighlight) {
                         // 重新计算省略文本中的高亮匹配位置
-                        currentMatches = calculateElideHighlightMatches(
-                            elideText, 
-                            elidePos, 
-                            elideMode, 
-                            allMatches, 
+                        lines->elideMatches = calculateElideHighlightMatches(
+                            elideText,
+                            elidePos,
+                            elideMode,
+                            lines->matches,
                             line.textStart()
                         );
                     }
@@ -401,7 +478,7 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
                 // next line is empty.
             }
 
-            processLine(line);
+            ++lines->bodyLineCount;
 
             // next line
             line = lay->createLine();
@@ -412,27 +489,92 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
     }
 
     // process last elided line.
-    if (!elideText.isEmpty()) {
-        QTextLayout newlay;
-        newlay.setFont(lay->font());
+    if (!lines->elideText.isEmpty()) {
+        QTextLayout *newlay = new QTextLayout;
+        lines->elided.reset(newlay);
+        newlay->setFont(lay->font());
         {
             auto oldWrap = static_cast<QTextOption::WrapMode>(attribute<uint>(kWrapMode));
             setAttribute(kWrapMode, static_cast<uint>(QTextOption::NoWrap));
-            initLayoutOption(&newlay);
+            initLayoutOption(newlay);
 
             // restore
             setAttribute(kWrapMode, oldWrap);
         }
 
-        newlay.setText(elideText);
-        newlay.beginLayout();
-        auto line = newlay.createLine();
+        newlay->setText(lines->elideText);
+        newlay->beginLayout();
+        auto line = newlay->createLine();
         line.setLineWidth(size.width() - 1);
         line.setPosition(offset);
-
-        processLine(line);
-        newlay.endLayout();
+        newlay->endLayout();
     }
+}
+
+QList<QRectF> ElideTextLayout::drawLines(const LayoutLines &lines, const QPointF &delta, QPainter *painter, const QBrush &background, QStringList *textLines)
+{
+    QList<QRectF> ret;
+    int textLineHeight = attribute<int>(kLineHeight);
+    bool paintLineWithHighlight = highlightActive();
+
+    // for draw background.
+    QRectF lastLineRect;
+
+    auto processLine = [this, &ret, painter, &lastLineRect, &background, textLineHeight, textLines,
+                        paintLineWithHighlight, &delta](const QTextLine &line, const QString &curText,
+                                                        const QList<QPair<int, int>> &currentMatches) {
+        QRectF lRect = line.naturalTextRect().translated(delta);
+        lRect.setHeight(textLineHeight);
+
+        ret.append(lRect);
+        if (textLines) {
+            const auto &t = curText.mid(line.textStart(), line.textLength());
+            textLines->append(t);
+        }
+
+        // draw
+        if (painter) {
+            // draw background
+            if (background.style() != Qt::NoBrush) {
+                lastLineRect = drawLineBackground(painter, lRect, lastLineRect, background);
+            }
+
+            // 获取当前行的文本范围
+            int lineStart = line.textStart();
+            int lineEnd = lineStart + line.textLength();
+
+            // 检查当前行是否需要高亮显示（检查是否有任何关键词与当前行有重叠）
+            bool needHighlight = false;
+            if (paintLineWithHighlight) {
+                for (const auto &match : currentMatches) {
+                    int matchStart = match.first;
+                    int matchEnd = matchStart + match.second;
+
+                    // 如果匹配区域与当前行有任何重叠
+                    if (matchEnd > lineStart && matchStart < lineEnd) {
+                        needHighlight = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!paintLineWithHighlight || !needHighlight) {
+                // draw text line without highlight
+                line.draw(painter, delta);
+                return;
+            }
+
+            // 获取当前行文本
+            QString lineText = curText.mid(lineStart, line.textLength());
+            drawTextWithHighlight(painter, line, lineText, lRect, lineStart, currentMatches);
+        }
+    };
+
+    for (int i = 0; i < lines.bodyLineCount; ++i)
+        processLine(lines.body->lineAt(i), lines.text, lines.matches);
+
+    if (lines.elided && lines.elided->lineCount() > 0)
+        processLine(lines.elided->lineAt(0), lines.elideText, lines.elideMatches);
 
     return ret;
 }
@@ -499,7 +641,8 @@ void ElideTextLayout::drawTextWithHighlight(QPainter *painter, const QTextLine &
                                            const QRectF &rect, int lineStartPos, const QList<QPair<int, int>> &allMatches)
 {
     // 1. 先绘制整行普通文本
-    painter->drawText(rect, lineText, QTextOption(document->defaultTextOption().alignment()));
+    const QTextOption textOption(Qt::AlignLeft);
+    painter->drawText(rect, lineText, textOption);
     
     // 2. 仅在匹配区域上绘制高亮文本
     if (!allMatches.isEmpty()) {
@@ -534,7 +677,7 @@ void ElideTextLayout::drawTextWithHighlight(QPainter *painter, const QTextLine &
             QString highlightText(lineText.mid(highlightStart, highlightLength));
             painter->drawText(highlightRect,
                              highlightText,
-                             QTextOption(document->defaultTextOption().alignment()));
+                             textOption);
         }
         
         painter->restore();
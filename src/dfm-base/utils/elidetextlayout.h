@@ -10,6 +10,8 @@
 #include <QVariant>
 #include <QTextLine>
 
+template<class Key, class T>
+class QCache;
 class QPainter;
 class QTextDocument;
 class QTextLayout;
@@ -33,10 +35,12 @@ public:
     void setText(const QString &text);
     QString text() const;
     QList<QRectF> layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter = nullptr, const QBrush &background = Qt::NoBrush, QStringList *textLines = nullptr);
+
+    // 清空共享的排版缓存，字体、主题变化时会自动调用
+    static void clearLayoutCache();
 public:
-    inline QTextDocument *documentHandle() {
-        return document;
-    }
+    // 获取文档后调用方可能修改其内容或格式，此后该对象不再使用排版缓存
+    QTextDocument *documentHandle();
 
     inline void setAttribute(Attribute attr, const QVariant &value) {
         attributes.insert(attr, value);
@@ -69,6 +73,15 @@ protected:
     virtual void initLayoutOption(QTextLayout *lay);
 
 private:
+    struct LayoutLines;
+    static QCache<QString, LayoutLines> *layoutCache();
+
+    // 排版缓存的键，不可缓存时返回空串
+    QString cacheKey(const QSizeF &size, Qt::TextElideMode elideMode) const;
+    bool highlightActive() const;
+    void layoutLines(QTextLayout *lay, const QSizeF &size, const QPointF &origin, Qt::TextElideMode elideMode, LayoutLines *lines);
+    QList<QRectF> drawLines(const LayoutLines &lines, const QPointF &delta, QPainter *painter, const QBrush &background, QStringList *textLines);
+
     // 查找文本中所有关键词匹配的位置
     QList<QPair<int, int>> findKeywordMatches(const QString &text) const;
 
@@ -87,7 +100,8 @@ private:
         Qt::TextElideMode elideMode) const;
 
 protected:
-    QTextDocument *document { nullptr };
+    QString plainText;
+    QTextDocument *document { nullptr };   // 按需创建
     QMap<Attribute, QVariant> attributes {};
 
     QStringList highlightKeywords {};  // 需要高亮的关键字
@@ -21,14 +21,68 @@
 #include <QElapsedTimer>
 #include <QDebug>
 #include <QApplication>
+#include <QThreadPool>
+#include <QFile>
 
 #include <fts.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
 #include <dirent.h>
 
 namespace dfmbase {
 
 static constexpr uint16_t kSizeChangeinterval { 200 };
+static constexpr int kDirentBufferSize { 32 * 1024 };
+static constexpr int kMaxWalkThreadCount { 8 };
+
+struct LinuxDirent64
+{
+    ino64_t d_ino;
+    off64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+struct EntryStat
+{
+    mode_t mode { 0 };
+    quint64 device { 0 };
+    quint64 inode { 0 };
+    qint64 size { 0 };
+};
+
+// 相对目录fd获取文件属性，内核不支持 statx 时回退到 fstatat
+static bool entryStat(int dirfd, const char *name, bool followLink, EntryStat *st)
+{
+    static std::atomic_bool statxUnsupported { false };
+    if (!statxUnsupported) {
+        struct statx stx;
+        const int flags = AT_NO_AUTOMOUNT | (followLink ? 0 : AT_SYMLINK_NOFOLLOW);
+        if (::statx(dirfd, name, flags, STATX_TYPE | STATX_MODE | STATX_INO | STATX_SIZE, &stx) == 0) {
+            st->mode = stx.stx_mode;
+            st->device = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+            st->inode = stx.stx_ino;
+            st->size = static_cast<qint64>(stx.stx_size);
+            return true;
+        }
+        if (errno != ENOSYS)
+            return false;
+        statxUnsupported = true;
+    }
+
+    struct stat64 statBuffer;
+    if (::fstatat64(dirfd, name, &statBuffer, followLink ? 0 : AT_SYMLINK_NOFOLLOW) != 0)
+        return false;
+    st->mode = statBuffer.st_mode;
+    st->device = statBuffer.st_dev;
+    st->inode = statBuffer.st_ino;
+    st->size = statBuffer.st_size;
+    return true;
+}
 
 FileStatisticsJobPrivate::FileStatisticsJobPrivate(FileStatisticsJob *qq)
     : QObject(nullptr), q(qq), notifyDataTimer(nullptr)
@@ -225,7 +279,7 @@ void FileStatisticsJobPrivate::processFile(const QUrl &url, struct stat64 *statB
     if (!statBuffer)
         return;
     bool isDir = S_ISDIR(statBuffer->st_mode);
-    if (!checkInode(statBuffer->st_ino, url.path()))
+    if (!checkInode(statBuffer->st_dev, statBuffer->st_ino))
         return;
     if (isDir) {
         processDirectory(url, followLink, directoryQueue);
@@ -236,10 +290,11 @@ void FileStatisticsJobPrivate::processFile(const QUrl &url, struct stat64 *statB
 
 void FileStatisticsJobPrivate::emitSizeChanged()
 {
-    if (elapsedTimer.elapsed() > kSizeChangeinterval) {
+    // 多个遍历线程同时调用时只有一个线程发送信号
+    const qint64 now = elapsedTimer.elapsed();
+    qint64 last = lastSizeNotify;
+    if (now - last > kSizeChangeinterval && lastSizeNotify.compare_exchange_strong(last, now))
         Q_EMIT q->sizeChanged(totalSize);
-        elapsedTimer.restart();
-    }
 }
 
 int FileStatisticsJobPrivate::countFileCount(const char *name)
@@ -309,13 +364,19 @@ bool FileStatisticsJobPrivate::checkInode(const FileInfoPointer info)
     return true;
 }
 
-bool FileStatisticsJobPrivate::checkInode(const __ino64_t innode, const QString &path)
+bool FileStatisticsJobPrivate::checkInode(const quint64 device, const quint64 inode)
 {
-    QString key = innode > 0 ? QString::number(innode) : QString::number(innode) + ":" + path;
-    if (inodeAndPath.contains(key))
+    // 部分文件系统不提供inode，无法去重
+    if (inode == 0)
+        return true;
+
+    InodeShard &shard = inodeShards[(inode ^ device) % inodeShards.size()];
+    const auto &key = qMakePair(device, inode);
+    QMutexLocker lk(&shard.mutex);
+    if (shard.keys.contains(key))
         return false;
 
-    inodeAndPath.insert(key);
+    shard.keys.insert(key);
     return true;
 }
 
@@ -383,6 +444,155 @@ void FileStatisticsJobPrivate::processRegularFile(const QUrl &url, struct stat64
     ++filesCount;
 }
 
+void FileStatisticsJobPrivate::walkLocalDirectories(const QList<QUrl> &directories, bool followLink)
+{
+    std::vector<std::unique_ptr<StatisticsDirTask>> roots;
+    QThreadPool pool;
+    pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), kMaxWalkThreadCount));
+
+    for (const QUrl &url : directories) {
+        roots.emplace_back(new StatisticsDirTask);
+        StatisticsDirTask *task = roots.back().get();
+        task->path = QFile::encodeName(url.path());
+        pool.start([this, task, &pool, followLink]() {
+            walkDirectoryTask(task, &pool, followLink);
+        });
+    }
+    pool.waitForDone();
+
+    if (sizeInfo.isNull())
+        return;
+
+    // 深度优先汇总，目录总在其子项之前
+    std::vector<StatisticsDirTask *> stack;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+        stack.push_back(it->get());
+    while (!stack.empty()) {
+        StatisticsDirTask *task = stack.back();
+        stack.pop_back();
+        sizeInfo->allFiles << task->entries;
+        for (auto it = task->children.rbegin(); it != task->children.rend(); ++it)
+            stack.push_back(it->get());
+    }
+}
+
+void FileStatisticsJobPrivate::walkDirectoryTask(StatisticsDirTask *task, QThreadPool *pool, bool followLink)
+{
+    // 子目录优先在本线程内深度优先处理，线程池有空闲线程时把最早入栈（通常子树最大）的目录交出去
+    std::deque<StatisticsDirTask *> pending { task };
+    while (!pending.empty()) {
+        if (!stateCheck())
+            return;
+
+        while (pending.size() > 1 && pool->activeThreadCount() < pool->maxThreadCount()) {
+            StatisticsDirTask *shared = pending.front();
+            pending.pop_front();
+            pool->start([this, shared, pool, followLink]() {
+                walkDirectoryTask(shared, pool, followLink);
+            });
+        }
+
+        StatisticsDirTask *current = pending.back();
+        pending.pop_back();
+        scanDirectory(current, &pending, followLink);
+    }
+}
+
+void FileStatisticsJobPrivate::scanDirectory(StatisticsDirTask *task, std::deque<StatisticsDirTask *> *pending, bool followLink)
+{
+    const int dirfd = ::open(task->path.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirfd < 0)
+        return;
+
+    const quint16 pageSize = FileUtils::getMemoryPageSize();
+    const QByteArray prefix = task->path.endsWith('/') ? task->path : task->path + '/';
+    qint64 size = 0;
+    qint64 progressSize = 0;
+    int files = 0;
+    int directories = 0;
+
+    alignas(LinuxDirent64) char buffer[kDirentBufferSize];
+    bool stopped = false;
+    while (!stopped) {
+        const long count = ::syscall(SYS_getdents64, dirfd, buffer, sizeof(buffer));
+        if (count <= 0)
+            break;
+
+        for (long offset = 0; offset < count;) {
+            const auto *entry = reinterpret_cast<const LinuxDirent64 *>(buffer + offset);
+            offset += entry->d_reclen;
+
+            const char *name = entry->d_name;
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+                continue;
+
+            EntryStat st;
+            if (!entryStat(dirfd, name, false, &st))
+                continue;
+
+            const QByteArray path = prefix + name;
+            QString target;
+            const bool isSymlink = S_ISLNK(st.mode);
+            if (isSymlink) {
+                // 与 stat64 的行为一致，按链接目标统计，失效的链接直接跳过
+                if (!entryStat(dirfd, name, true, &st))
+                    continue;
+                target = FileUtils::resolveSymlink(QUrl::fromLocalFile(QFile::decodeName(path)));
+            }
+
+            if (!sizeInfo.isNull())
+                task->entries << QUrl::fromLocalFile(QFile::decodeName(path));
+
+            if (!checkInode(st.device, st.inode))
+                continue;
+
+            if (S_ISDIR(st.mode)) {
+                progressSize += pageSize;
+                ++directories;
+                if (isSymlink && !followLink)
+                    continue;
+                if (!(fileHints & (FileStatisticsJob::kDontSkipAVFSDStorage | FileStatisticsJob::kDontSkipPROCStorage))) {
+                    if (!fileHints.testFlag(FileStatisticsJob::kDontSkipPROCStorage) && target.startsWith("/proc"))
+                        continue;
+                    if (!fileHints.testFlag(FileStatisticsJob::kDontSkipAVFSDStorage) && target.startsWith("/avfsd"))
+                        continue;
+                }
+
+                task->children.emplace_back(new StatisticsDirTask);
+                task->children.back()->path = path;
+                pending->push_back(task->children.back().get());
+                continue;
+            }
+
+            if (isSymlink && !followLink) {
+                ++files;
+                continue;
+            }
+            // Skip specific system files early
+            if (path == "/proc/kcore" || path == "/dev/core" || target == "/proc/kcore" || target == "/dev/core")
+                continue;
+            if (!checkFileType(fileType(st.mode)))
+                continue;
+
+            if (st.size > 0)
+                size += isSymlink ? 0 : st.size;
+            progressSize += (st.size <= 0 || isSymlink) ? pageSize : st.size;
+            ++files;
+        }
+
+        stopped = !stateCheck();
+    }
+    ::close(dirfd);
+
+    // 每个目录汇总一次，减少原子操作
+    totalSize += size;
+    totalProgressSize += progressSize;
+    filesCount += files;
+    directoryCount += directories;
+    if (size > 0)
+        emitSizeChanged();
+}
+
 FileStatisticsJob::FileStatisticsJob(QObject *parent)
     : QThread(parent), d(new FileStatisticsJobPrivate(this))
 {
@@ -515,7 +725,10 @@ void FileStatisticsJob::run()
     d->totalSize = 0;
     d->filesCount = 0;
     d->directoryCount = 0;
+    d->lastSizeNotify = 0;
     d->inodelist.clear();
+    for (auto &shard : d->inodeShards)
+        shard.keys.clear();
     if (d->sourceUrlList.isEmpty())
         return;
 
@@ -676,7 +889,7 @@ void FileStatisticsJob::statisticsRealPathSingle()
                 continue;
 
             bool isDir = S_ISDIR(statBuffer.st_mode);
-            if (!d->checkInode(statBuffer.st_ino, url.path()))
+            if (!d->checkInode(statBuffer.st_dev, statBuffer.st_ino))
                 continue;
 
             if (isDir && d->fileHints.testFlag(kSingleDepth)) {
@@ -735,46 +948,7 @@ void FileStatisticsJob::statisticsRealPathSingle()
         return;
     }
 
-    while (!directory_queue.isEmpty()) {
-
-        if (!d->stateCheck()) {
-            d->setState(kStoppedState);
-            setSizeInfo();
-            return;
-        }
-
-        const QUrl &directory_url = directory_queue.dequeue();
-
-        DIR *dir { nullptr };
-        struct dirent *entry { nullptr };
-
-        if (!(dir = opendir(directory_url.path().toStdString().data())))
-            continue;
-
-        while ((entry = readdir(dir))) {
-            if (!d->stateCheck()) {
-                d->setState(kStoppedState);
-                setSizeInfo();
-                closedir(dir);
-                return;
-            }
-            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
-                continue;
-
-            struct stat64 statBuffer;
-            QString currentPath = directory_url.path() + QDir::separator() + entry->d_name;
-            if (::stat64(currentPath.toStdString().data(), &statBuffer) != 0)
-                continue;
-
-            QUrl currentFile = QUrl::fromLocalFile(currentPath);
-
-            d->processFile(currentFile, &statBuffer, followLink, directory_queue);
-
-            if (!d->sizeInfo.isNull())
-                d->sizeInfo->allFiles << currentFile;
-        }
-        closedir(dir);
-    }
+    d->walkLocalDirectories(directory_queue, followLink);
     setSizeInfo();
     d->setState(kStoppedState);
 }
@@ -9,10 +9,28 @@
 #include <dfm-base/interfaces/abstractdiriterator.h>
 
 #include <QObject>
+#include <QMutex>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
 
 #include <fts.h>
 
+class QThreadPool;
+
 namespace dfmbase {
+
+// 本地目录的遍历任务，遍历结束后按深度优先顺序汇总文件列表，保证目录总在其子项之前
+struct StatisticsDirTask
+{
+    QByteArray path;
+    QList<QUrl> entries;
+    std::vector<std::unique_ptr<StatisticsDirTask>> children;
+};
+
 class FileStatisticsJobPrivate : public QObject
 {
 public:
@@ -31,10 +49,13 @@ public:
     int countFileCount(const char *name);
     bool checkFileType(const FileInfo::FileType &fileType);
     bool checkInode(const FileInfoPointer info);
-    bool checkInode(const __ino64_t innode, const QString &path);
+    bool checkInode(const quint64 device, const quint64 inode);
     FileInfo::FileType fileType(const __mode_t fileMode);
     void processDirectory(const QUrl &url, bool followLink, QQueue<QUrl> &directoryQueue);
     void processRegularFile(const QUrl &url, struct stat64 *statBuffer, bool followLink);
+    void walkLocalDirectories(const QList<QUrl> &directories, bool followLink);
+    void walkDirectoryTask(StatisticsDirTask *task, QThreadPool *pool, bool followLink);
+    void scanDirectory(StatisticsDirTask *task, std::deque<StatisticsDirTask *> *pending, bool followLink);
 
     FileStatisticsJob *q;
     QTimer *notifyDataTimer;
@@ -55,7 +76,14 @@ public:
     QSet<QUrl> allFiles;
     QSet<QString> skipPath;
     QSet<quint64> inodelist;
-    QSet<QString> inodeAndPath;
+    // 按 inode 分片的 (dev, ino) 集合，供多个遍历线程去重硬链接
+    struct InodeShard
+    {
+        QMutex mutex;
+        QSet<QPair<quint64, quint64>> keys;
+    };
+    std::array<InodeShard, 16> inodeShards;
+    std::atomic<qint64> lastSizeNotify { 0 };
     AbstractDirIteratorPointer iterator { nullptr };
     std::atomic_bool iteratorCanStop { false };
 };
@@ -9,6 +9,9 @@
 
 #include <QCollator>
 #include <QChar>
+#include <QLocale>
+
+#include <unicode/ucol.h>
 
 DFMBASE_BEGIN_NAMESPACE
 
@@ -27,6 +30,74 @@ public:
     }
 };
 
+// 与 DCollator 配置一致的 ICU 排序器，用于生成可按字节比较的单字符排序键
+class SortKeyCollator
+{
+public:
+    SortKeyCollator()
+    {
+        const QLocale locale;
+        if (locale.language() == QLocale::C)
+            return;
+
+        UErrorCode status = U_ZERO_ERROR;
+        const QByteArray &name = locale.bcp47Name().replace('-', '_').toLatin1();
+        collator = ucol_open(name.constData(), &status);
+        if (U_FAILURE(status)) {
+            ucol_close(collator);
+            collator = nullptr;
+            return;
+        }
+
+        // 对应 QCollator 的 CaseInsensitive 与 numericMode 设置
+        ucol_setAttribute(collator, UCOL_NORMALIZATION_MODE, UCOL_ON, &status);
+        ucol_setAttribute(collator, UCOL_STRENGTH, UCOL_SECONDARY, &status);
+        ucol_setAttribute(collator, UCOL_NUMERIC_COLLATION, UCOL_ON, &status);
+        ucol_setAttribute(collator, UCOL_ALTERNATE_HANDLING, UCOL_NON_IGNORABLE, &status);
+    }
+
+    ~SortKeyCollator()
+    {
+        if (collator)
+            ucol_close(collator);
+    }
+
+    // 返回以 0 结尾的排序键，不同字符的键互不为前缀
+    const QByteArray &characterKey(char32_t ucs4)
+    {
+        auto it = cache.constFind(ucs4);
+        if (it != cache.constEnd())
+            return it.value();
+
+        QByteArray key;
+        if (collator) {
+            const QString &str = QString::fromUcs4(&ucs4, 1);
+            const auto *text = reinterpret_cast<const UChar *>(str.utf16());
+            key.resize(32);
+            int32_t len = ucol_getSortKey(collator, text, str.size(),
+                                          reinterpret_cast<uint8_t *>(key.data()), key.size());
+            if (len > key.size()) {
+                key.resize(len);
+                len = ucol_getSortKey(collator, text, str.size(),
+                                      reinterpret_cast<uint8_t *>(key.data()), key.size());
+            }
+            key.resize(len);
+        } else {
+            // C locale 下 QCollator 退化为忽略大小写的码点比较
+            const char32_t folded = QChar::toCaseFolded(ucs4);
+            key.append(static_cast<char>((folded >> 16) & 0xFF));
+            key.append(static_cast<char>((folded >> 8) & 0xFF));
+            key.append(static_cast<char>(folded & 0xFF));
+        }
+
+        return cache.insert(ucs4, key).value();
+    }
+
+private:
+    UCollator *collator { nullptr };
+    QHash<uint, QByteArray> cache;
+};
+
 bool compareString(const QString &str1, const QString &str2, Qt::SortOrder order)
 {
     return !((order == Qt::AscendingOrder) ^ compareStringForFileName(str1, str2));
@@ -182,6 +253,93 @@ bool compareStringForFileName(const QString &str1, const QString &str2)
     return compareUnified(suf1, suf2) < 0;
 }
 
+// 将 compareStringForFileName 中 compareUnified 的逐段比较规则编码为字节序列：
+// 每段以类型标记开头（数字 < 字母 < 汉字 < 符号），字符串以 0 结尾，
+// 因此较短的前缀排在前面
+static void appendUnifiedSortKey(QByteArray &key, const QString &str, SortKeyCollator &collator)
+{
+    enum KeyTag : char {
+        EndTag = 0,
+        NumberTag = 1,
+        LetterTag = 2,
+        HanTag = 3,
+        SymbolTag = 4
+    };
+
+    const int total = str.size();
+    int pos = 0;
+    while (pos < total) {
+        const QChar ch = str.at(pos);
+        int len = 1;
+        char32_t unicode = ch.unicode();
+        if (ch.isHighSurrogate() && pos + 1 < total) {
+            unicode = QChar::surrogateToUcs4(ch, str.at(pos + 1));
+            len = 2;
+        }
+
+        // 代理对形式的数字无法按数字块提取，按符号处理
+        if (len == 1 && QChar::isDigit(unicode)) {
+            // 数值大小按有效位数和逐位数值比较，数值相同时原始长度更长的排前面
+            int rawLen = 0;
+            QByteArray digits;
+            while (pos + rawLen < total && isNumber(str.at(pos + rawLen))) {
+                const int value = str.at(pos + rawLen).digitValue();
+                if (!digits.isEmpty() || value != 0)
+                    digits.append(static_cast<char>('0' + value));
+                ++rawLen;
+            }
+
+            key.append(NumberTag);
+            key.append(static_cast<char>((digits.size() >> 8) & 0xFF));
+            key.append(static_cast<char>(digits.size() & 0xFF));
+            key.append(digits);
+            const int lengthRank = 0xFFFF - qMin(rawLen, 0xFFFF);
+            key.append(static_cast<char>((lengthRank >> 8) & 0xFF));
+            key.append(static_cast<char>(lengthRank & 0xFF));
+            pos += rawLen;
+            continue;
+        }
+
+        const QChar::Script script = QChar::script(unicode);
+        if (script == QChar::Script_Han || QChar::isLetter(unicode)) {
+            key.append(script == QChar::Script_Han ? HanTag : LetterTag);
+            key.append(collator.characterKey(unicode));
+            // 排序器忽略大小写，相同字母时小写排在前面
+            key.append(static_cast<char>(QChar::isLower(unicode) ? 1 : 2));
+        } else {
+            key.append(SymbolTag);
+            key.append(static_cast<char>((unicode >> 16) & 0xFF));
+            key.append(static_cast<char>((unicode >> 8) & 0xFF));
+            key.append(static_cast<char>(unicode & 0xFF));
+        }
+        pos += len;
+    }
+
+    key.append(EndTag);
+}
+
+QByteArray fileNameSortKey(const QString &name)
+{
+    thread_local static SortKeyCollator collator;
+
+    QByteArray key;
+    key.reserve(name.size() * 8);
+
+    // 与 compareStringForFileName 相同：先比较主文件名，无后缀的排前面，再比较后缀
+    const int dotPos = name.lastIndexOf('.');
+    if (dotPos <= 0) {
+        appendUnifiedSortKey(key, name, collator);
+        return key;
+    }
+
+    appendUnifiedSortKey(key, name.left(dotPos), collator);
+    if (dotPos + 1 < name.size()) {
+        key.append(static_cast<char>(1));
+        appendUnifiedSortKey(key, name.mid(dotPos + 1), collator);
+    }
+    return key;
+}
+
 bool compareStringForTime(const QString &str1, const QString &str2)
 {
     // 固定的、期望的字符串长度
@@ -393,11 +551,8 @@ bool compareForSize(const SortInfoPointer info1, const SortInfoPointer info2)
     qint64 size1 = getEffectiveSize(info1);
     qint64 size2 = getEffectiveSize(info2);
 
-    if (size1 == size2) {
-        QString leftName = info1->fileUrl().fileName();
-        QString rightName = info2->fileUrl().fileName();
-        return SortUtils::compareStringForFileName(leftName, rightName);
-    }
+    if (size1 == size2)
+        return info1->fileNameSortKey() < info2->fileNameSortKey();
 
     return size1 < size2;
 }
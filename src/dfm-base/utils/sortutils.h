@@ -18,6 +18,9 @@ bool compareStringForMimeType(const QString &str1, const QString &str2);
 bool compareForSize(const SortInfoPointer info1, const SortInfoPointer info2);
 bool compareForSize(const qint64 size1, const qint64 size2);
 
+// 预计算的文件名排序键，按字节比较的结果与 compareStringForFileName 一致
+QByteArray fileNameSortKey(const QString &name);
+
 QString displayType(const QUrl &url);
 QString fastMimeType(const QUrl &url);
 
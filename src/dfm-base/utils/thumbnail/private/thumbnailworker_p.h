@@ -9,6 +9,7 @@
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/utils/thumbnail/thumbnailworker.h>
 #include <dfm-base/utils/thumbnail/thumbnailhelper.h>
+#include <dfm-base/utils/thumbnail/thumbnailtaskqueue.h>
 #include <dfm-base/mimetype/dmimedatabase.h>
 
 #include <QFuture>
@@ -23,6 +24,7 @@ public:
     QString createThumbnail(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
     bool checkFileStable(const QUrl &url);
     void startDelayWork();
+    void retryDelayedTasks();
 
     QUrl setCheckCount(const QUrl &url, int count);
     int checkCount(const QUrl &url);
@@ -36,6 +38,7 @@ public:
     std::atomic_bool isStoped = false;
     QTimer *delayTimer { nullptr };
     ThumbnailWorker::ThumbnailTaskMap delayTaskMap;
+    ThumbnailTaskQueue *taskQueue { nullptr };
 };
 
 }   // namespace dfmbase
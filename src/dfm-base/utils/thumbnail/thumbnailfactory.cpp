@@ -10,22 +10,38 @@
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/device/deviceproxymanager.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+#include <dfm-base/base/configs/dconfig/global_dconf_defines.h>
 
 #include <QGuiApplication>
 
+#include <algorithm>
+
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
 
 static constexpr int kMaxCountLimit { 50 };
 static constexpr int kPushInterval { 100 };   // ms
+static constexpr int kMaxWorkerCount { 4 };
 
 ThumbnailFactory::ThumbnailFactory(QObject *parent)
-    : QObject(parent),
-      thread(new QThread),
-      worker(new ThumbnailWorker)
+    : QObject(parent)
 {
     qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory initializing with" << QThread::idealThreadCount() << "ideal thread count";
 
+    // 0 表示根据 CPU 核数自动选择，缩略图生成以 IO 和解码为主，不占满所有核心
+    int workerCount = DConfigManager::instance()->value(GlobalDConfDefines::ConfigPath::kViewDConfName,
+                                                        GlobalDConfDefines::BaseConfig::kThumbnailWorkerCount, 0)
+                              .toInt();
+    if (workerCount <= 0)
+        workerCount = qBound(1, QThread::idealThreadCount() / 2, kMaxWorkerCount);
+
+    for (int i = 0; i < workerCount; ++i) {
+        threads.append(QSharedPointer<QThread>(new QThread));
+        workers.append(QSharedPointer<ThumbnailWorker>(new ThumbnailWorker));
+        workers.last()->setTaskQueue(&taskQueue);
+    }
+
     registerThumbnailCreator(Mime::kTypeImageVDjvu, ThumbnailCreators::djvuThumbnailCreator);
     registerThumbnailCreator(Mime::kTypeImageVDMultipage, ThumbnailCreators::djvuThumbnailCreator);
     registerThumbnailCreator(Mime::kTypeTextPlain, ThumbnailCreators::textThumbnailCreator);
@@ -37,13 +53,14 @@ ThumbnailFactory::ThumbnailFactory(QObject *parent)
     registerThumbnailCreator(Mime::kTypeAppAppimage, ThumbnailCreators::appimageThumbnailCreator);
     registerThumbnailCreator(Mime::kTypeAppPptx, ThumbnailCreators::pptxThumbnailCreator);
 
+    initConcurrencyLimits();
     init();
 }
 
 ThumbnailFactory::~ThumbnailFactory()
 {
     qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory destructor called";
-    if (thread->isRunning())
+    if (std::any_of(threads.cbegin(), threads.cend(), [](const QSharedPointer<QThread> &thread) { return thread->isRunning(); }))
         onAboutToQuit();
 }
 
@@ -57,14 +74,36 @@ void ThumbnailFactory::init()
     connect(this, &ThumbnailFactory::thumbnailJob, this, &ThumbnailFactory::doJoinThumbnailJob, Qt::QueuedConnection);
     connect(qApp, &QGuiApplication::aboutToQuit, this, &ThumbnailFactory::onAboutToQuit);
 
-    connect(this, &ThumbnailFactory::addTask, worker.data(), &ThumbnailWorker::onTaskAdded, Qt::QueuedConnection);
-    connect(worker.data(), &ThumbnailWorker::thumbnailCreateFinished, this, &ThumbnailFactory::produceFinished, Qt::QueuedConnection);
-    connect(worker.data(), &ThumbnailWorker::thumbnailCreateFailed, this, &ThumbnailFactory::produceFailed, Qt::QueuedConnection);
+    for (int i = 0; i < workers.size(); ++i) {
+        const auto &worker = workers.at(i);
+        connect(this, &ThumbnailFactory::taskQueued, worker.data(), &ThumbnailWorker::onTaskQueued, Qt::QueuedConnection);
+        connect(worker.data(), &ThumbnailWorker::thumbnailCreateFinished, this, &ThumbnailFactory::produceFinished, Qt::QueuedConnection);
+        connect(worker.data(), &ThumbnailWorker::thumbnailCreateFailed, this, &ThumbnailFactory::produceFailed, Qt::QueuedConnection);
 
-    worker->moveToThread(thread.data());
-    thread->start();
+        worker->moveToThread(threads.at(i).data());
+        threads.at(i)->start();
+    }
 
-    qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory initialized, worker thread started";
+    qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory initialized," << workers.size() << "worker threads started";
+}
+
+void ThumbnailFactory::initConcurrencyLimits()
+{
+    // 视频、音频依赖 ffmpeg 等外部进程，同时运行过多会抢占 CPU 与磁盘带宽
+    const QVariantMap defaultLimits {
+        { "video/*", 1 },
+        { Mime::kTypeAppVRRMedia, 1 },
+        { "audio/*", 2 },
+        { Mime::kTypeAppPdf, 2 }
+    };
+    const auto &limits = DConfigManager::instance()->value(GlobalDConfDefines::ConfigPath::kViewDConfName,
+                                                           GlobalDConfDefines::BaseConfig::kThumbnailMimeConcurrency,
+                                                           defaultLimits)
+                                 .toMap();
+    for (auto it = limits.cbegin(); it != limits.cend(); ++it) {
+        taskQueue.setConcurrencyLimit(it.key(), it.value().toInt());
+        qCDebug(logDFMBase) << "thumbnail: concurrency limit" << it.value().toInt() << "for mime type:" << it.key();
+    }
 }
 
 void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
@@ -80,7 +119,10 @@ void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
 bool ThumbnailFactory::registerThumbnailCreator(const QString &mimeType, ThumbnailCreator creator)
 {
     Q_ASSERT(creator);
-    bool success = worker->registerCreator(mimeType, creator);
+    bool success = true;
+    for (const auto &worker : std::as_const(workers))
+        success = worker->registerCreator(mimeType, creator) && success;
+
     if (success) {
         qCDebug(logDFMBase) << "thumbnail: registered creator for mime type:" << mimeType;
     } else {
@@ -91,24 +133,29 @@ bool ThumbnailFactory::registerThumbnailCreator(const QString &mimeType, Thumbna
 
 void ThumbnailFactory::onAboutToQuit()
 {
-    qCInfo(logDFMBase) << "thumbnail: application about to quit, stopping worker and thread";
-    worker->stop();
-    thread->quit();
-    bool finished = thread->wait(3000);
-    if (!finished) {
-        qCWarning(logDFMBase) << "thumbnail: worker thread did not finish within 3 seconds, forcing termination";
-        thread->terminate();
-        thread->wait(1000);
-    } else {
-        qCInfo(logDFMBase) << "thumbnail: worker thread stopped gracefully";
+    qCInfo(logDFMBase) << "thumbnail: application about to quit, stopping workers and threads";
+    taskQueue.clear();
+    for (const auto &worker : std::as_const(workers))
+        worker->stop();
+
+    for (const auto &thread : std::as_const(threads)) {
+        thread->quit();
+        bool finished = thread->wait(3000);
+        if (!finished) {
+            qCWarning(logDFMBase) << "thumbnail: worker thread did not finish within 3 seconds, forcing termination";
+            thread->terminate();
+            thread->wait(1000);
+        }
     }
+    qCInfo(logDFMBase) << "thumbnail: worker threads stopped";
 }
 
 void ThumbnailFactory::pushTask()
 {
-    auto map = std::move(taskMap);
-    qCDebug(logDFMBase) << "thumbnail: pushing" << map.size() << "tasks to worker thread";
-    emit addTask(map);
+    qCDebug(logDFMBase) << "thumbnail: notifying workers of" << queuedCount << "new tasks," << taskQueue.size() << "pending";
+    queuedCount = 0;
+    taskPushTimer.stop();
+    emit taskQueued();
 }
 
 void ThumbnailFactory::doJoinThumbnailJob(const QUrl &url, ThumbnailSize size)
@@ -118,17 +165,15 @@ void ThumbnailFactory::doJoinThumbnailJob(const QUrl &url, ThumbnailSize size)
         return;
     }
 
-    if (taskMap.contains(url)) {
-        return;
-    }
-
-    if (taskMap.isEmpty()) {
+    if (queuedCount == 0) {
         taskPushTimer.start();
     }
 
-    taskMap.insert(url, size);
+    // 重复请求会把任务提到队首，最近绘制的条目优先生成
+    taskQueue.push(url, size);
+    ++queuedCount;
 
-    if (taskMap.size() < kMaxCountLimit)
+    if (queuedCount < kMaxCountLimit)
         return;
 
     qCDebug(logDFMBase) << "thumbnail: task queue reached limit" << kMaxCountLimit << ", pushing immediately";
@@ -6,6 +6,7 @@
 #define THUMBNAILFACTORY_H
 
 #include "thumbnailworker.h"
+#include "thumbnailtaskqueue.h"
 
 #include <dfm-base/dfm_base_global.h>
 #include <dfm-base/dfm_global_defines.h>
@@ -33,7 +34,7 @@ Q_SIGNALS:
     void produceFinished(const QUrl &src, const QString &thumb);
     void produceFailed(const QUrl &src);
 
-    void addTask(const ThumbnailWorker::ThumbnailTaskMap &taskMap);
+    void taskQueued();
     void thumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 private Q_SLOTS:
     void onAboutToQuit();
@@ -44,11 +45,13 @@ protected:
     explicit ThumbnailFactory(QObject *parent = nullptr);
     ~ThumbnailFactory() override;
     void init();
+    void initConcurrencyLimits();
 
 private:
-    ThumbnailWorker::ThumbnailTaskMap taskMap;
-    QSharedPointer<QThread> thread { nullptr };
-    QSharedPointer<ThumbnailWorker> worker { nullptr };
+    ThumbnailTaskQueue taskQueue;
+    int queuedCount { 0 };
+    QList<QSharedPointer<QThread>> threads;
+    QList<QSharedPointer<ThumbnailWorker>> workers;
     QTimer taskPushTimer;
 };
 }   // namespace dfmbase
@@ -17,6 +17,7 @@
 #include <dfm-io/dfmio_utils.h>
 
 #include <QImageReader>
+#include <QSaveFile>
 #include <QDir>
 
 #include <sys/stat.h>
@@ -179,20 +180,22 @@ QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, Thumb
 
     qCDebug(logDFMBase) << "thumbnail: saving thumbnail to:" << thumbnailFilePath << "for file:" << url;
 
-    QMetaObject::invokeMethod(
-            QCoreApplication::instance(), [img, thumbnailFilePath, fileUrl, fileModify]() {
-                Q_ASSERT(QThread::currentThread() == qApp->thread());
-                QImage tmpImg = img;
-                tmpImg.setText(QT_STRINGIFY(Thumb::URL), fileUrl);
-                tmpImg.setText(QT_STRINGIFY(Thumb::MTime), QString::number(fileModify));
-                if (!tmpImg.save(thumbnailFilePath, Q_NULLPTR, 50)) {
-                    qCWarning(logDFMBase) << "thumbnail: failed to save thumbnail file:" << thumbnailFilePath << "for:" << fileUrl;
-                } else {
-                    qCDebug(logDFMBase) << "thumbnail: successfully saved thumbnail:" << thumbnailFilePath;
-                }
-            },
-            Qt::QueuedConnection);
+    // encode and write on the calling worker thread, QSaveFile renames the file into place
+    // only once it is complete so readers never see a partially written thumbnail
+    QImage tmpImg = img;
+    tmpImg.setText(QT_STRINGIFY(Thumb::URL), fileUrl);
+    tmpImg.setText(QT_STRINGIFY(Thumb::MTime), QString::number(fileModify));
+
+    QSaveFile file(thumbnailFilePath);
+    if (!file.open(QIODevice::WriteOnly)
+        || !tmpImg.save(&file, QByteArray(kFormat).mid(1).constData(), 50)
+        || !file.commit()) {
+        qCWarning(logDFMBase) << "thumbnail: failed to save thumbnail file:" << thumbnailFilePath << "for:" << fileUrl
+                              << file.errorString();
+        return "";
+    }
 
+    qCDebug(logDFMBase) << "thumbnail: successfully saved thumbnail:" << thumbnailFilePath;
     return thumbnailFilePath;
 }
 
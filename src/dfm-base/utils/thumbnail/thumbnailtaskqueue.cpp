@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnailtaskqueue.h"
+
+#include <climits>
+
+using namespace dfmbase;
+DFMGLOBAL_USE_NAMESPACE
+
+void ThumbnailTaskQueue::setConcurrencyLimit(const QString &mimePattern, int limit)
+{
+    QMutexLocker lk(&mutex);
+    if (limit <= 0) {
+        limitPatterns.removeAll(mimePattern);
+        limits.remove(mimePattern);
+        return;
+    }
+
+    if (!limits.contains(mimePattern))
+        limitPatterns.append(mimePattern);
+    limits.insert(mimePattern, limit);
+}
+
+void ThumbnailTaskQueue::push(const QUrl &url, ThumbnailSize size)
+{
+    const QString &group = groupOf(url);
+
+    QMutexLocker lk(&mutex);
+    // 已在队列中的任务以新序号重新入栈，旧条目在取出时作废
+    const quint64 seq = ++nextSeq;
+    pending.insert(url, seq);
+    stacks[group].append({ url, size, seq });
+}
+
+bool ThumbnailTaskQueue::take(Task *task)
+{
+    Q_ASSERT(task);
+
+    QMutexLocker lk(&mutex);
+    QString bestGroup;
+    quint64 bestSeq = 0;
+    for (auto it = stacks.begin(); it != stacks.end(); ++it) {
+        auto &stack = it.value();
+        while (!stack.isEmpty() && pending.value(stack.last().url) != stack.last().seq)
+            stack.removeLast();
+        if (stack.isEmpty())
+            continue;
+
+        if (!it.key().isEmpty() && running.value(it.key()) >= limits.value(it.key(), INT_MAX))
+            continue;
+
+        if (stack.last().seq > bestSeq) {
+            bestSeq = stack.last().seq;
+            bestGroup = it.key();
+        }
+    }
+
+    if (bestSeq == 0)
+        return false;
+
+    const Entry entry = stacks[bestGroup].takeLast();
+    pending.remove(entry.url);
+    if (!bestGroup.isEmpty())
+        ++running[bestGroup];
+
+    task->url = entry.url;
+    task->size = entry.size;
+    task->group = bestGroup;
+    return true;
+}
+
+void ThumbnailTaskQueue::finish(const Task &task)
+{
+    if (task.group.isEmpty())
+        return;
+
+    QMutexLocker lk(&mutex);
+    auto it = running.find(task.group);
+    if (it != running.end() && --it.value() <= 0)
+        running.erase(it);
+}
+
+void ThumbnailTaskQueue::clear()
+{
+    QMutexLocker lk(&mutex);
+    stacks.clear();
+    pending.clear();
+}
+
+int ThumbnailTaskQueue::size() const
+{
+    QMutexLocker lk(&mutex);
+    return pending.size();
+}
+
+QString ThumbnailTaskQueue::groupOf(const QUrl &url) const
+{
+    QStringList patterns;
+    {
+        QMutexLocker lk(&mutex);
+        if (limitPatterns.isEmpty())
+            return {};
+        patterns = limitPatterns;
+    }
+
+    // 仅按文件名匹配，避免在界面线程读取文件内容
+    const QString &mimeName = mimeDb.mimeTypeForFile(url.fileName(), QMimeDatabase::MatchExtension).name();
+    if (patterns.contains(mimeName))
+        return mimeName;
+
+    for (const QString &pattern : patterns) {
+        if (pattern.endsWith(QLatin1String("/*")) && mimeName.startsWith(pattern.chopped(1)))
+            return pattern;
+    }
+
+    return {};
+}
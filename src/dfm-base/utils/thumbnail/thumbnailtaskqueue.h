@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef THUMBNAILTASKQUEUE_H
+#define THUMBNAILTASKQUEUE_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QHash>
+#include <QMimeDatabase>
+#include <QMutex>
+#include <QUrl>
+
+namespace dfmbase {
+
+/*!
+ * \brief Pending thumbnail tasks shared by all thumbnail workers
+ *
+ * Views request thumbnails while painting, so the latest requests belong to
+ * the items currently on screen. Tasks are therefore handed out newest first,
+ * and requesting a pending url again moves it to the front.
+ * Mime types can be given a concurrency limit, a task of a limited type is
+ * only handed out while fewer workers than the limit are running that type.
+ */
+class ThumbnailTaskQueue
+{
+public:
+    struct Task
+    {
+        QUrl url;
+        DFMGLOBAL_NAMESPACE::ThumbnailSize size { DFMGLOBAL_NAMESPACE::kNormal };
+        QString group;
+    };
+
+    // mimePattern is a mime name or a "type/*" wildcard, limit <= 0 removes the limit
+    void setConcurrencyLimit(const QString &mimePattern, int limit);
+
+    void push(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    bool take(Task *task);
+    void finish(const Task &task);
+    void clear();
+    int size() const;
+
+private:
+    struct Entry
+    {
+        QUrl url;
+        DFMGLOBAL_NAMESPACE::ThumbnailSize size;
+        quint64 seq;
+    };
+
+    QString groupOf(const QUrl &url) const;
+
+    mutable QMutex mutex;
+    QMimeDatabase mimeDb;
+    QStringList limitPatterns;
+    QHash<QString, int> limits;
+    QHash<QString, QList<Entry>> stacks;
+    QHash<QString, int> running;
+    QHash<QUrl, quint64> pending;
+    quint64 nextSeq { 0 };
+};
+
+}   // namespace dfmbase
+
+#endif   // THUMBNAILTASKQUEUE_H
@@ -11,6 +11,8 @@
 #include <dfm-base/base/urlroute.h>
 
 #include <QtConcurrent>
+#include <QMutex>
+#include <QElapsedTimer>
 #include <QPainter>
 #include <QDebug>
 
@@ -63,6 +65,9 @@ QString ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::Thumbna
     // default image generator if cannot create by customized function
     if (img.isNull()) {
         qCDebug(logDFMBase) << "thumbnail: using default creator for:" << url;
+        // DThumbnailProvider is a shared instance, don't drive it from several workers at once
+        static QMutex defaultCreatorMutex;
+        QMutexLocker lk(&defaultCreatorMutex);
         img = ThumbnailCreators::defaultThumbnailCreator(absoluteFilePath, size);
     }
 
@@ -112,7 +117,7 @@ void ThumbnailWorkerPrivate::startDelayWork()
         delayTimer->setInterval(2 * 1000);
         delayTimer->setSingleShot(true);
         q->connect(
-                delayTimer, &QTimer::timeout, q, [this] { q->onTaskAdded(delayTaskMap); }, Qt::QueuedConnection);
+                delayTimer, &QTimer::timeout, q, [this] { retryDelayedTasks(); }, Qt::QueuedConnection);
         qCDebug(logDFMBase) << "thumbnail: delay timer initialized with 2 second interval";
     }
 
@@ -120,6 +125,20 @@ void ThumbnailWorkerPrivate::startDelayWork()
     qCDebug(logDFMBase) << "thumbnail: delay timer started for" << delayTaskMap.size() << "tasks";
 }
 
+void ThumbnailWorkerPrivate::retryDelayedTasks()
+{
+    if (!taskQueue) {
+        q->onTaskAdded(delayTaskMap);
+        return;
+    }
+
+    // 重试的任务同样经过共享队列，遵守按类型的并发限制和可见项优先的顺序
+    for (auto it = delayTaskMap.cbegin(); it != delayTaskMap.cend(); ++it)
+        taskQueue->push(it.key(), it.value());
+    qCDebug(logDFMBase) << "thumbnail: re-queued" << delayTaskMap.size() << "delayed tasks";
+    q->onTaskQueued();
+}
+
 QUrl ThumbnailWorkerPrivate::setCheckCount(const QUrl &url, int count)
 {
     QUrl tmpUrl(url);
@@ -177,6 +196,11 @@ bool ThumbnailWorker::registerCreator(const QString &mimeType, ThumbnailWorker::
     return true;
 }
 
+void ThumbnailWorker::setTaskQueue(ThumbnailTaskQueue *queue)
+{
+    d->taskQueue = queue;
+}
+
 void ThumbnailWorker::stop()
 {
     d->isStoped = true;
@@ -195,19 +219,43 @@ void ThumbnailWorker::onTaskAdded(const ThumbnailTaskMap &taskMap)
     QMapIterator<QUrl, Global::ThumbnailSize> iter(taskMap);
     while (iter.hasNext()) {
         iter.next();
-        QUrl fileUrl = d->originalUrl = iter.key();
-        if (!d->thumbHelper.checkThumbEnable(fileUrl)) {
-            continue;
-        }
+        processTask(iter.key(), iter.value());
+    }
+}
 
-        const auto &img = d->thumbHelper.thumbnailImage(fileUrl, iter.value());
-        if (!img.isNull()) {
-            Q_EMIT thumbnailCreateFinished(iter.key(), img.text(QT_STRINGIFY(Thumb::Path)));
-            continue;
-        }
+void ThumbnailWorker::onTaskQueued()
+{
+    if (!d->taskQueue)
+        return;
+
+    // 持续从共享队列取任务，受并发限制的任务由释放名额的线程继续处理
+    QElapsedTimer timer;
+    timer.start();
+    int processed = 0;
+    ThumbnailTaskQueue::Task task;
+    while (!d->isStoped && d->taskQueue->take(&task)) {
+        processTask(task.url, task.size);
+        d->taskQueue->finish(task);
+        ++processed;
+    }
+
+    if (processed > 0)
+        qCDebug(logDFMBase) << "thumbnail: worker processed" << processed << "tasks in" << timer.elapsed() << "ms";
+}
+
+void ThumbnailWorker::processTask(const QUrl &url, Global::ThumbnailSize size)
+{
+    QUrl fileUrl = d->originalUrl = url;
+    if (!d->thumbHelper.checkThumbEnable(fileUrl))
+        return;
 
-        createThumbnail(fileUrl, iter.value());
+    const auto &img = d->thumbHelper.thumbnailImage(fileUrl, size);
+    if (!img.isNull()) {
+        Q_EMIT thumbnailCreateFinished(url, img.text(QT_STRINGIFY(Thumb::Path)));
+        return;
     }
+
+    createThumbnail(fileUrl, size);
 }
 
 void ThumbnailWorker::createThumbnail(const QUrl &url, Global::ThumbnailSize size)
@@ -235,6 +283,8 @@ void ThumbnailWorker::createThumbnail(const QUrl &url, Global::ThumbnailSize siz
         d->startDelayWork();
         return;
     } else if (d->originalUrl.hasQuery()) {
+        // 文件已稳定，不再随下一次延时重试
+        d->delayTaskMap.remove(d->originalUrl);
         d->originalUrl = d->clearCheckCount(d->originalUrl);
         qCDebug(logDFMBase) << "thumbnail: file is now stable, cleared check count for:" << d->originalUrl;
     }
@@ -14,6 +14,7 @@
 
 namespace dfmbase {
 
+class ThumbnailTaskQueue;
 class ThumbnailWorkerPrivate;
 class ThumbnailWorker : public QObject
 {
@@ -26,16 +27,19 @@ public:
 
     using ThumbnailCreator = std::function<QImage(const QString &, DFMGLOBAL_NAMESPACE::ThumbnailSize)>;
     bool registerCreator(const QString &mimeType, ThumbnailCreator creator);
+    void setTaskQueue(ThumbnailTaskQueue *queue);
     void stop();
 
 public Q_SLOTS:
     void onTaskAdded(const ThumbnailTaskMap &taskMap);
+    void onTaskQueued();
 
 Q_SIGNALS:
     void thumbnailCreateFinished(const QUrl &url, const QString &thumbnail);
     void thumbnailCreateFailed(const QUrl &url);
 
 private:
+    void processTask(const QUrl &url, Global::ThumbnailSize size);
     void createThumbnail(const QUrl &url, Global::ThumbnailSize size);
 
 private:
@@ -3,10 +3,16 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dodeletefilesworker.h"
+#include "localdeleteengine.h"
+
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/finallyutil.h>
+#include <dfm-base/utils/protocolutils.h>
 
 #include <QUrl>
 
+#include <algorithm>
+
 
 DPFILEOPERATIONS_USE_NAMESPACE
 DoDeleteFilesWorker::DoDeleteFilesWorker(QObject *parent)
@@ -43,9 +49,49 @@ void DoDeleteFilesWorker::stop()
     AbstractWorker::stop();
 }
 
+/*!
+ * \brief DoDeleteFilesWorker::statisticsFilesSize Local sources are counted by LocalDeleteEngine in the
+ * same walk that removes them, only the other sources are counted before deleting
+ * \return false if there is nothing to delete
+ */
+bool DoDeleteFilesWorker::statisticsFilesSize()
+{
+    if (sourceUrls.isEmpty()) {
+        fmWarning() << "Source files list is empty, cannot calculate statistics";
+        return false;
+    }
+
+    const bool allLocal = std::all_of(sourceUrls.cbegin(), sourceUrls.cend(),
+                                      [this](const QUrl &url) { return canDeleteByEngine(url); });
+    if (!allLocal) {
+        const bool ok = AbstractWorker::statisticsFilesSize();
+        // 混合的源文件逐个判断删除方式
+        isSourceFileLocal = false;
+        return ok;
+    }
+
+    isSourceFileLocal = true;
+    sourceFilesCount = sourceUrls.count();
+    fmInfo() << "All sources are local, files are counted while deleting";
+    return true;
+}
+
 void DoDeleteFilesWorker::onUpdateProgress()
 {
-    emitProgressChangedNotify(deleteFilesCount);
+    if (!isSourceFileLocal) {
+        emitProgressChangedNotify(deleteFilesCount);
+        return;
+    }
+
+    // 总数由删除引擎边遍历边统计，遍历结束前按统计中处理
+    JobInfoPointer info(new QMap<quint8, QVariant>);
+    info->insert(AbstractJobHandler::NotifyInfoKey::kJobtypeKey, QVariant::fromValue(jobType));
+    info->insert(AbstractJobHandler::NotifyInfoKey::kTotalSizeKey, QVariant::fromValue(qint64(foundFilesCount)));
+    info->insert(AbstractJobHandler::NotifyInfoKey::kStatisticStateKey,
+                 QVariant::fromValue(engineWalkFinished.loadAcquire() ? AbstractJobHandler::StatisticState::kStopState
+                                                                      : AbstractJobHandler::StatisticState::kRunningState));
+    info->insert(AbstractJobHandler::NotifyInfoKey::kCurrentProgressKey, QVariant::fromValue(qint64(deleteFilesCount)));
+    emit progressChangedNotify(info);
 }
 
 /*!
@@ -56,71 +102,63 @@ bool DoDeleteFilesWorker::deleteAllFiles()
 {
     fmDebug() << "Delete all files - source file local:" << isSourceFileLocal;
     // sources file list is checked
-    // delete files on can't remove device
+    // all sources are local paths, whatever the file system and device
     if (isSourceFileLocal) {
         return deleteFilesOnCanNotRemoveDevice();
     }
     return deleteFilesOnOtherDevice();
 }
 /*!
- * \brief DoDeleteFilesWorker::deleteFilesOnCanNotRemoveDevice Delete files on non removable devices
+ * \brief DoDeleteFilesWorker::deleteFilesOnCanNotRemoveDevice Delete files on local file systems of any
+ * type, including removable devices, every source tree is removed by LocalDeleteEngine through directory
+ * fds with a bounded thread pool
  * \return delete file success
  */
 bool DoDeleteFilesWorker::deleteFilesOnCanNotRemoveDevice()
 {
-    fmDebug() << "Deleting files on non-removable device, file count:" << allFilesList.count();
-    
-    if (allFilesList.count() == 1 && isConvert) {
-        auto info = InfoFactory::create<FileInfo>(allFilesList.first(), Global::CreateFileInfoType::kCreateFileInfoSync);
+    fmDebug() << "Deleting local files, source count:" << sourceUrls.count();
+    FinallyUtil finally([this]() { engineWalkFinished.storeRelease(1); });
+
+    if (sourceUrls.count() == 1 && isConvert) {
+        auto info = InfoFactory::create<FileInfo>(sourceUrls.first(), Global::CreateFileInfoType::kCreateFileInfoSync);
         if (info) {
             deleteFirstFileSize = info->size();
             fmDebug() << "Single file deletion, size:" << deleteFirstFileSize;
         }
     }
 
-    AbstractJobHandler::SupportAction action { AbstractJobHandler::SupportAction::kNoAction };
-    for (QList<QUrl>::iterator it = --allFilesList.end(); it != --allFilesList.begin(); --it) {
+    LocalDeleteEngine engine;
+    initDeleteEngine(&engine);
+    engine.setFoundCounter(&foundFilesCount);
+
+    for (const QUrl &url : sourceUrls) {
         if (!stateCheck())
             return false;
-        const QUrl &url = *it;
-        auto info = InfoFactory::create<FileInfo>(url, Global::CreateFileInfoType::kCreateFileInfoSync);
-        emitCurrentTaskNotify(url, QUrl());
-        do {
-            action = AbstractJobHandler::SupportAction::kNoAction;
-            if (!localFileHandler->deleteFile(url)) {
-                fmWarning() << "Failed to delete file:" << url << "error:" << localFileHandler->errorString();
-                action = doHandleErrorAndWait(url, AbstractJobHandler::JobErrorType::kDeleteFileError,
-                                              localFileHandler->errorString());
-            } else {
-                fmDebug() << "Successfully deleted file:" << url;
-            }
-        } while (!isStopped() && action == AbstractJobHandler::SupportAction::kRetryAction);
-
-        if (sourceUrls.contains(url)) {
-            if (action == AbstractJobHandler::SupportAction::kNoAction) {
-                completeSourceFiles.append(url);
-                completeTargetFiles.append(url);
-            }
-        }
-
-        deleteFilesCount++;
 
+        const auto action = engine.remove(url.path());
         if (action == AbstractJobHandler::SupportAction::kSkipAction) {
             fmInfo() << "Skipped deleting file:" << url;
             continue;
         }
 
-        if (action != AbstractJobHandler::SupportAction::kNoAction)
+        if (action != AbstractJobHandler::SupportAction::kNoAction) {
+            fmWarning() << "Delete cancelled at:" << url;
             return false;
+        }
 
+        completeSourceFiles.append(url);
+        completeTargetFiles.append(url);
         emit fileDeleted(url);
+        fmDebug() << "Successfully deleted item:" << url;
     }
-    
-    fmInfo() << "Completed deletion on non-removable device, deleted count:" << deleteFilesCount;
+
+    fmInfo() << "Completed deletion of local files, deleted count:" << deleteFilesCount
+             << "found count:" << foundFilesCount << "threads:" << engine.maxThreadCount();
     return true;
 }
 /*!
- * \brief DoDeleteFilesWorker::deleteFilesOnOtherDevice Delete files on removable devices and other
+ * \brief DoDeleteFilesWorker::deleteFilesOnOtherDevice Delete files when the sources are not all local,
+ * local sources are still removed by LocalDeleteEngine, the others through the file handler
  * \return delete file success
  */
 bool DoDeleteFilesWorker::deleteFilesOnOtherDevice()
@@ -136,7 +174,28 @@ bool DoDeleteFilesWorker::deleteFilesOnOtherDevice()
         }
     }
     
+    LocalDeleteEngine engine;
+    initDeleteEngine(&engine);
+
     for (auto &url : sourceUrls) {
+        if (canDeleteByEngine(url)) {
+            const auto action = engine.remove(url.path());
+            if (action == AbstractJobHandler::SupportAction::kSkipAction) {
+                fmInfo() << "Skipped deleting file:" << url;
+                continue;
+            }
+            if (action != AbstractJobHandler::SupportAction::kNoAction) {
+                fmWarning() << "Delete cancelled at:" << url;
+                return false;
+            }
+
+            completeTargetFiles.append(url);
+            completeSourceFiles.append(url);
+            emit fileDeleted(url);
+            fmDebug() << "Successfully deleted local item:" << url;
+            continue;
+        }
+
         const auto &info = InfoFactory::create<FileInfo>(url, Global::CreateFileInfoType::kCreateFileInfoSync);
         if (!info) {
             fmCritical() << "Failed to create file info for:" << url;
@@ -204,7 +263,8 @@ bool DoDeleteFilesWorker::deleteFileOnOtherDevice(const QUrl &url)
     return action == AbstractJobHandler::SupportAction::kNoAction;
 }
 /*!
- * \brief DoDeleteFilesWorker::deleteDirOnOtherDevice Delete dir on removable devices and other
+ * \brief DoDeleteFilesWorker::deleteDirOnOtherDevice Delete dir on remote devices through the file handler,
+ * local dirs are removed by LocalDeleteEngine
  * \param dir delete dir
  * \return delete success
  */
@@ -213,6 +273,15 @@ bool DoDeleteFilesWorker::deleteDirOnOtherDevice(const FileInfoPointer &dir)
     if (!stateCheck())
         return false;
 
+    const QUrl &dirUrl = dir->urlOf(UrlInfoType::kUrl);
+    if (canDeleteByEngine(dirUrl)) {
+        LocalDeleteEngine engine;
+        initDeleteEngine(&engine);
+        const auto action = engine.remove(dirUrl.path());
+        return action == AbstractJobHandler::SupportAction::kNoAction
+                || action == AbstractJobHandler::SupportAction::kSkipAction;
+    }
+
     fmDebug() << "Deleting directory on other device:" << dir->urlOf(UrlInfoType::kUrl);
 
     if (dir->countChildFile() < 0) {
@@ -275,6 +344,26 @@ bool DoDeleteFilesWorker::deleteDirOnOtherDevice(const FileInfoPointer &dir)
     // delete self dir
     return deleteFileOnOtherDevice(dir->urlOf(UrlInfoType::kUrl));
 }
+/*!
+ * \brief DoDeleteFilesWorker::canDeleteByEngine Local paths on any file system can be removed by
+ * LocalDeleteEngine, paths mounted by gvfs are removed through the file handler
+ */
+bool DoDeleteFilesWorker::canDeleteByEngine(const QUrl &url) const
+{
+    return url.isLocalFile() && !ProtocolUtils::isRemoteFile(url);
+}
+
+void DoDeleteFilesWorker::initDeleteEngine(LocalDeleteEngine *engine)
+{
+    engine->setStateCheck([this]() { return stateCheck(); });
+    engine->setErrorHandler([this](const QUrl &url, const QString &errorMsg) {
+        const auto action = doHandleErrorAndWait(url, AbstractJobHandler::JobErrorType::kDeleteFileError, errorMsg);
+        return isStopped() ? AbstractJobHandler::SupportAction::kCancelAction : action;
+    });
+    engine->setTaskNotifier([this](const QUrl &url) { emitCurrentTaskNotify(url, QUrl()); });
+    engine->setDeletedCounter(&deleteFilesCount);
+}
+
 /*!
  * \brief DoCopyFilesWorker::doHandleErrorAndWait Blocking handles errors and returns
  * actions supported by the operation
@@ -15,6 +15,7 @@
 
 DPFILEOPERATIONS_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
+class LocalDeleteEngine;
 class DoDeleteFilesWorker : public AbstractWorker
 {
     friend class DeleteFiles;
@@ -27,6 +28,7 @@ public:
 protected:
     bool doWork() override;
     void stop() override;
+    bool statisticsFilesSize() override;
     void onUpdateProgress() override;
 
 protected:
@@ -35,12 +37,16 @@ protected:
     bool deleteFilesOnOtherDevice();
     bool deleteFileOnOtherDevice(const QUrl &url);
     bool deleteDirOnOtherDevice(const FileInfoPointer &dir);
+    bool canDeleteByEngine(const QUrl &url) const;
+    void initDeleteEngine(LocalDeleteEngine *engine);
     AbstractJobHandler::SupportAction doHandleErrorAndWait(const QUrl &from,
                                                            const AbstractJobHandler::JobErrorType &error,
                                                            const QString &errorMsg = QString());
 
 private:
     QAtomicInteger<qint64> deleteFilesCount { 0 };
+    QAtomicInteger<qint64> foundFilesCount { 0 };   // files found by the delete engine while walking
+    QAtomicInt engineWalkFinished { 0 };
 };
 DPFILEOPERATIONS_END_NAMESPACE
 
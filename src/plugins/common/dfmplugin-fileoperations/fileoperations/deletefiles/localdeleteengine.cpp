@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localdeleteengine.h"
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/limits.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+using SupportAction = LocalDeleteEngine::SupportAction;
+
+static constexpr int kMaxThreadCount { 8 };
+static constexpr int kDentsBufferSize { 32 * 1024 };
+// 线程池繁忙时子目录在当前线程处理，超过该深度后仍交给线程池，避免同时持有过多的目录 fd
+static constexpr int kMaxInlineDepth { 32 };
+static constexpr int kMaxHandOffPathLength { PATH_MAX / 2 };
+static constexpr int kDirOpenFlags { O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC };
+
+struct LocalDeleteEngine::DirNode
+{
+    QByteArray path;
+    QByteArray name;
+    DirNodePointer parent;
+    // 自身的扫描加上尚未删除完成的子目录
+    QAtomicInt pending { 1 };
+    QAtomicInt skipped { 0 };
+};
+
+static inline bool isDotOrDotDot(const char *name)
+{
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+template<typename Operation>
+SupportAction LocalDeleteEngine::perform(const QByteArray &dirPath, const char *name, Operation operation)
+{
+    forever {
+        // 已经不存在的文件视为删除成功
+        if (operation() == 0 || errno == ENOENT)
+            return SupportAction::kNoAction;
+
+        const int error = errno;
+        const SupportAction action = handleError(name ? dirPath + '/' + name : dirPath, error);
+        if (action != SupportAction::kRetryAction)
+            return action;
+    }
+}
+
+LocalDeleteEngine::LocalDeleteEngine(int maxThreadCount)
+{
+    threadPool.setMaxThreadCount(maxThreadCount > 0 ? maxThreadCount
+                                                    : qBound(1, QThread::idealThreadCount(), kMaxThreadCount));
+}
+
+LocalDeleteEngine::~LocalDeleteEngine()
+{
+    aborted.storeRelease(1);
+    threadPool.waitForDone();
+}
+
+void LocalDeleteEngine::setStateCheck(const StateCheck &check)
+{
+    stateCheck = check;
+}
+
+void LocalDeleteEngine::setErrorHandler(const ErrorHandler &handler)
+{
+    errorHandler = handler;
+}
+
+void LocalDeleteEngine::setTaskNotifier(const TaskNotifier &notifier)
+{
+    taskNotifier = notifier;
+}
+
+void LocalDeleteEngine::setDeletedCounter(QAtomicInteger<qint64> *counter)
+{
+    deletedCounter = counter;
+}
+
+/*!
+ * \brief LocalDeleteEngine::setFoundCounter Set the counter of entries found by the walk, including
+ * the removed root, entries that are skipped later are counted as well
+ */
+void LocalDeleteEngine::setFoundCounter(QAtomicInteger<qint64> *counter)
+{
+    foundCounter = counter;
+}
+
+int LocalDeleteEngine::maxThreadCount() const
+{
+    return threadPool.maxThreadCount();
+}
+
+/*!
+ * \brief LocalDeleteEngine::remove Remove a file or a whole directory tree, symbolic links are not followed
+ * \param path local path
+ * \return kNoAction if removed or not existed, kSkipAction if some entries were skipped by the error
+ * handler, kCancelAction if the state check failed or the error handler cancelled
+ */
+SupportAction LocalDeleteEngine::remove(const QString &path)
+{
+    aborted.storeRelease(0);
+    rootAction = SupportAction::kNoAction;
+    if (!checkState())
+        return SupportAction::kCancelAction;
+
+    const QByteArray &localPath = QFile::encodeName(path);
+    struct stat st;
+    bool exists { false };
+    const SupportAction action = perform(localPath, nullptr, [&]() {
+        const int ret = ::lstat(localPath.constData(), &st);
+        exists = ret == 0;
+        return ret;
+    });
+    if (action != SupportAction::kNoAction || !exists)
+        return action;
+
+    countFound();
+    if (!S_ISDIR(st.st_mode)) {
+        if (taskNotifier)
+            taskNotifier(QUrl::fromLocalFile(path));
+        const SupportAction result = perform(localPath, nullptr, [&]() { return ::unlink(localPath.constData()); });
+        if (result == SupportAction::kNoAction)
+            countDeleted();
+        return result;
+    }
+
+    auto root = DirNodePointer::create();
+    root->path = localPath;
+    removeDir(root, -1, 0);
+    threadPool.waitForDone();
+
+    return aborted.loadAcquire() ? SupportAction::kCancelAction : rootAction;
+}
+
+/*!
+ * \brief LocalDeleteEngine::removeDir Remove the children of a directory, the directory itself is
+ * removed by finishDir once its last handed off sub directory is done
+ * \param node directory to remove
+ * \param parentFd fd of the parent directory when removed inline, -1 to open node->path
+ * \param depth inline recursion depth of the current thread
+ */
+void LocalDeleteEngine::removeDir(const DirNodePointer &node, int parentFd, int depth)
+{
+    if (checkState()) {
+        if (taskNotifier)
+            taskNotifier(QUrl::fromLocalFile(QFile::decodeName(node->path)));
+
+        int fd = -1;
+        const SupportAction action = perform(node->path, nullptr, [&]() {
+            fd = parentFd >= 0 ? ::openat(parentFd, node->name.constData(), kDirOpenFlags)
+                               : ::open(node->path.constData(), kDirOpenFlags);
+            return fd < 0 ? -1 : 0;
+        });
+
+        if (fd >= 0) {
+            removeChildren(fd, node, depth);
+            ::close(fd);
+        } else if (action == SupportAction::kSkipAction) {
+            node->skipped.storeRelease(1);
+        }
+    }
+
+    finishDir(node, parentFd);
+}
+
+void LocalDeleteEngine::removeChildren(int dirFd, const DirNodePointer &node, int depth)
+{
+    QByteArray buffer(kDentsBufferSize, Qt::Uninitialized);
+    forever {
+        if (aborted.loadAcquire())
+            return;
+
+        long size = -1;
+        const SupportAction action = perform(node->path, nullptr, [&]() {
+            size = ::syscall(SYS_getdents64, dirFd, buffer.data(), buffer.size());
+            return size < 0 ? -1 : 0;
+        });
+        if (size <= 0) {
+            if (action == SupportAction::kSkipAction)
+                node->skipped.storeRelease(1);
+            return;
+        }
+
+        for (long offset = 0; offset < size;) {
+            const auto *entry = reinterpret_cast<const struct dirent64 *>(buffer.constData() + offset);
+            offset += entry->d_reclen;
+
+            const char *name = entry->d_name;
+            if (isDotOrDotDot(name))
+                continue;
+            countFound();
+
+            unsigned char type = entry->d_type;
+            if (type == DT_UNKNOWN) {
+                struct stat st;
+                if (::fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) == 0 && S_ISDIR(st.st_mode))
+                    type = DT_DIR;
+            }
+
+            if (type != DT_DIR) {
+                const SupportAction result = perform(node->path, name, [&]() { return ::unlinkat(dirFd, name, 0); });
+                if (result == SupportAction::kCancelAction)
+                    return;
+                if (result == SupportAction::kSkipAction)
+                    node->skipped.storeRelease(1);
+                else
+                    countDeleted();
+                continue;
+            }
+
+            auto child = DirNodePointer::create();
+            child->path = node->path + '/' + name;
+            child->name = name;
+            child->parent = node;
+            node->pending.ref();
+
+            if (handOff(child->path, depth)) {
+                queuedTasks.ref();
+                threadPool.start([this, child]() {
+                    queuedTasks.deref();
+                    removeDir(child, -1, 0);
+                });
+            } else {
+                removeDir(child, dirFd, depth + 1);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief LocalDeleteEngine::finishDir Release one pending reference of the directory and remove
+ * it and the ancestors that have no pending sub directories left
+ */
+void LocalDeleteEngine::finishDir(const DirNodePointer &node, int parentFd)
+{
+    DirNodePointer current = node;
+    int fd = parentFd;
+    while (current && !current->pending.deref()) {
+        SupportAction action { SupportAction::kCancelAction };
+        if (!aborted.loadAcquire()) {
+            if (current->skipped.loadAcquire()) {
+                action = SupportAction::kSkipAction;
+            } else if (fd >= 0) {
+                action = perform(current->path, nullptr, [&]() { return ::unlinkat(fd, current->name.constData(), AT_REMOVEDIR); });
+            } else {
+                action = perform(current->path, nullptr, [&]() { return ::rmdir(current->path.constData()); });
+            }
+            if (action == SupportAction::kNoAction)
+                countDeleted();
+        }
+
+        // 有内容未删除的目录的上级目录同样无法删除
+        if (action != SupportAction::kNoAction && current->parent)
+            current->parent->skipped.storeRelease(1);
+        if (!current->parent)
+            rootAction = action;
+
+        // 上级目录的 fd 已在其它线程关闭，按路径删除
+        current = current->parent;
+        fd = -1;
+    }
+}
+
+bool LocalDeleteEngine::handOff(const QByteArray &childPath, int depth)
+{
+    // 交给线程池的目录按路径重新打开，过长的路径只能在当前线程相对父目录的 fd 处理
+    if (threadPool.maxThreadCount() <= 1 || childPath.size() >= kMaxHandOffPathLength)
+        return false;
+
+    return depth >= kMaxInlineDepth || queuedTasks.loadAcquire() < threadPool.maxThreadCount();
+}
+
+bool LocalDeleteEngine::checkState()
+{
+    if (aborted.loadAcquire())
+        return false;
+    if (!stateCheck)
+        return true;
+
+    QMutexLocker locker(&callbackMutex);
+    if (aborted.loadAcquire())
+        return false;
+    if (stateCheck())
+        return true;
+
+    aborted.storeRelease(1);
+    return false;
+}
+
+SupportAction LocalDeleteEngine::handleError(const QByteArray &path, int error)
+{
+    const QString &errorMsg = QString::fromLocal8Bit(strerror(error));
+    fmWarning() << "Failed to delete:" << path << "error:" << errorMsg;
+
+    // 同一时间只向用户询问一个错误
+    QMutexLocker locker(&callbackMutex);
+    if (aborted.loadAcquire())
+        return SupportAction::kCancelAction;
+
+    const SupportAction action = errorHandler ? errorHandler(QUrl::fromLocalFile(QFile::decodeName(path)), errorMsg)
+                                              : SupportAction::kCancelAction;
+    if (action == SupportAction::kRetryAction || action == SupportAction::kSkipAction)
+        return action;
+
+    aborted.storeRelease(1);
+    return SupportAction::kCancelAction;
+}
+
+void LocalDeleteEngine::countDeleted()
+{
+    if (deletedCounter)
+        deletedCounter->fetchAndAddRelaxed(1);
+}
+
+void LocalDeleteEngine::countFound()
+{
+    if (foundCounter)
+        foundCounter->fetchAndAddRelaxed(1);
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALDELETEENGINE_H
+#define LOCALDELETEENGINE_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <dfm-base/interfaces/abstractjobhandler.h>
+
+#include <QAtomicInteger>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QUrl>
+
+#include <functional>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The LocalDeleteEngine class removes trees on local file systems through directory fds.
+ * Entries are read by getdents64 and unlinked relative to the fd of their directory. A sub directory
+ * is handed off to a bounded thread pool while the pool has room, otherwise it is removed in the
+ * current thread through openat. Callbacks are serialized, so they may block to wait for the user.
+ * Entries are counted while they are read, so the caller does not need to walk the tree beforehand.
+ */
+class LocalDeleteEngine
+{
+    Q_DISABLE_COPY(LocalDeleteEngine)
+
+public:
+    using SupportAction = DFMBASE_NAMESPACE::AbstractJobHandler::SupportAction;
+    using StateCheck = std::function<bool()>;
+    using ErrorHandler = std::function<SupportAction(const QUrl &url, const QString &errorMsg)>;
+    using TaskNotifier = std::function<void(const QUrl &url)>;
+
+    explicit LocalDeleteEngine(int maxThreadCount = 0);
+    ~LocalDeleteEngine();
+
+    void setStateCheck(const StateCheck &check);
+    void setErrorHandler(const ErrorHandler &handler);
+    void setTaskNotifier(const TaskNotifier &notifier);
+    void setDeletedCounter(QAtomicInteger<qint64> *counter);
+    void setFoundCounter(QAtomicInteger<qint64> *counter);
+
+    SupportAction remove(const QString &path);
+    int maxThreadCount() const;
+
+private:
+    struct DirNode;
+    using DirNodePointer = QSharedPointer<DirNode>;
+
+    void removeDir(const DirNodePointer &node, int parentFd, int depth);
+    void removeChildren(int dirFd, const DirNodePointer &node, int depth);
+    void finishDir(const DirNodePointer &node, int parentFd);
+    bool handOff(const QByteArray &childPath, int depth);
+    bool checkState();
+    SupportAction handleError(const QByteArray &path, int error);
+    void countDeleted();
+    void countFound();
+    template<typename Operation>
+    SupportAction perform(const QByteArray &dirPath, const char *name, Operation operation);
+
+    QThreadPool threadPool;
+    QMutex callbackMutex;
+    StateCheck stateCheck;
+    ErrorHandler errorHandler;
+    TaskNotifier taskNotifier;
+    QAtomicInteger<qint64> *deletedCounter { nullptr };
+    QAtomicInteger<qint64> *foundCounter { nullptr };
+    QAtomicInt aborted { 0 };
+    QAtomicInt queuedTasks { 0 };
+    SupportAction rootAction { SupportAction::kNoAction };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // LOCALDELETEENGINE_H
@@ -5,6 +5,7 @@
 #include "abstractworker.h"
 #include "workerdata.h"
 #include "errormessageandaction.h"
+#include "copyscheduler.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/schemefactory.h>
@@ -29,8 +30,6 @@
 
 DPFILEOPERATIONS_USE_NAMESPACE
 
-std::atomic_bool AbstractWorker::bigFileCopy { false };
-
 /*!
  * \brief setWorkArgs 设置当前任务的参数
  * \param args 参数
@@ -490,6 +489,8 @@ void AbstractWorker::stopAllThread()
         worker->stop();
     }
     stop();
+    // 唤醒等待大文件拷贝预算的线程
+    CopyScheduler::instance()->wakeAll();
 }
 
 void AbstractWorker::checkRetry()
@@ -192,7 +192,6 @@ public:
     int threadCount { 8 };
     std::atomic_bool retry { false };
     QSharedPointer<QThreadPool> threadPool { nullptr };
-    static std::atomic_bool bigFileCopy;
     QAtomicInteger<qint64> bigFileSize { 0 };   // bigger than this is big file
     QElapsedTimer *speedtimer { nullptr };   // time eslape
     std::atomic_int64_t elapsed { 0 };
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "copyscheduler.h"
+
+#include <QFile>
+
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+CopyScheduler::Ticket::Ticket(CopyScheduler *scheduler, const QHash<dev_t, int> &costs, bool sameDevice)
+    : scheduler(scheduler), costs(costs), sameDevice(sameDevice)
+{
+}
+
+CopyScheduler::Ticket::~Ticket()
+{
+    scheduler->release(costs);
+}
+
+CopyScheduler *CopyScheduler::instance()
+{
+    static CopyScheduler ins;
+    return &ins;
+}
+
+/*!
+ * \brief CopyScheduler::acquire Block until the devices of fromPath and toPath have budget for one more big file copy
+ * \param fromPath source file path
+ * \param toPath target directory path
+ * \param policy budgets of the current job
+ * \param isStopped return true when the job stopped, checked before every wait
+ * \return the ticket holding the budget until it is released, null if the job stopped
+ */
+CopyScheduler::TicketPointer CopyScheduler::acquire(const QString &fromPath, const QString &toPath,
+                                                    const WorkerData::CopyAdmissionPolicy &policy,
+                                                    const std::function<bool()> &isStopped)
+{
+    struct stat fromStat;
+    struct stat toStat;
+    const bool fromOk = ::stat(QFile::encodeName(fromPath).constData(), &fromStat) == 0;
+    const bool toOk = ::stat(QFile::encodeName(toPath).constData(), &toStat) == 0;
+
+    QHash<dev_t, int> costs;
+    const bool sameDevice = fromOk && toOk && fromStat.st_dev == toStat.st_dev;
+    if (sameDevice) {
+        costs.insert(fromStat.st_dev, qMax(1, policy.sameDeviceWeight));
+    } else {
+        if (fromOk)
+            costs.insert(fromStat.st_dev, 1);
+        if (toOk)
+            costs.insert(toStat.st_dev, 1);
+    }
+
+    QMutexLocker locker(&mutex);
+    while (!admissible(costs, policy)) {
+        if (isStopped && isStopped())
+            return nullptr;
+        condition.wait(&mutex);
+    }
+    if (isStopped && isStopped())
+        return nullptr;
+
+    for (auto it = costs.cbegin(); it != costs.cend(); ++it)
+        streams[it.key()] += it.value();
+
+    return TicketPointer(new Ticket(this, costs, sameDevice));
+}
+
+void CopyScheduler::wakeAll()
+{
+    QMutexLocker locker(&mutex);
+    condition.wakeAll();
+}
+
+int CopyScheduler::deviceBudget(dev_t device, const WorkerData::CopyAdmissionPolicy &policy)
+{
+    QMutexLocker locker(&mutex);
+    return budgetOf(device, policy);
+}
+
+int CopyScheduler::activeStreams(dev_t device)
+{
+    QMutexLocker locker(&mutex);
+    return streams.value(device);
+}
+
+/*!
+ * \brief CopyScheduler::resolveBlockDevice Find the block device backing a filesystem with an anonymous device number
+ * \param device st_dev of the filesystem, major is 0 for btrfs, overlay, tmpfs and so on
+ * \param memoryBacked set to true when the filesystem keeps its data in memory
+ * \return the block device number, 0 if there is none or it cannot be resolved
+ */
+dev_t CopyScheduler::resolveBlockDevice(dev_t device, bool *memoryBacked)
+{
+    QFile file("/proc/self/mountinfo");
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+
+    const QByteArray &id = QByteArray::number(major(device)) + ':' + QByteArray::number(minor(device));
+    while (!file.atEnd()) {
+        // 格式：id parent major:minor root mountpoint options [optional...] - fstype source superoptions
+        const QList<QByteArray> &fields = file.readLine().trimmed().split(' ');
+        if (fields.size() < 3 || fields.at(2) != id)
+            continue;
+
+        const int separator = fields.indexOf("-");
+        if (separator < 0 || separator + 2 >= fields.size())
+            return 0;
+
+        const QByteArray &type = fields.at(separator + 1);
+        if (type == "tmpfs" || type == "ramfs") {
+            if (memoryBacked)
+                *memoryBacked = true;
+            return 0;
+        }
+
+        // btrfs 等文件系统的挂载源即为所在的块设备，overlay、fuse、网络文件系统没有块设备
+        QByteArray source = fields.at(separator + 2);
+        source.replace("\\040", " ");
+        struct stat st;
+        if (source.startsWith("/dev/") && ::stat(source.constData(), &st) == 0 && S_ISBLK(st.st_mode))
+            return st.st_rdev;
+        return 0;
+    }
+
+    return 0;
+}
+
+bool CopyScheduler::isRotational(dev_t device)
+{
+    if (major(device) == 0) {
+        bool memoryBacked = false;
+        device = resolveBlockDevice(device, &memoryBacked);
+        // tmpfs、ramfs 的数据在内存中，按非机械盘处理
+        if (memoryBacked)
+            return false;
+        // 找不到块设备时按机械盘处理，保持串行拷贝
+        if (major(device) == 0)
+            return true;
+    }
+
+    const QString &base = QString("/sys/dev/block/%1:%2").arg(major(device)).arg(minor(device));
+    // 分区没有 queue 目录，取所在磁盘的属性
+    for (const QString &path : { base + "/queue/rotational", base + "/../queue/rotational" }) {
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly))
+            return file.readAll().trimmed() == "1";
+    }
+
+    // 无法判断时按机械盘处理，保持串行拷贝
+    return true;
+}
+
+int CopyScheduler::budgetOf(dev_t device, const WorkerData::CopyAdmissionPolicy &policy)
+{
+    auto it = rotationalCache.find(device);
+    if (it == rotationalCache.end()) {
+        it = rotationalCache.insert(device, isRotational(device));
+        fmInfo() << "big file copy device" << major(device) << ":" << minor(device)
+                 << "rotational:" << it.value();
+    }
+
+    return qMax(1, it.value() ? policy.rotationalBudget : policy.solidStateBudget);
+}
+
+bool CopyScheduler::admissible(const QHash<dev_t, int> &costs, const WorkerData::CopyAdmissionPolicy &policy)
+{
+    for (auto it = costs.cbegin(); it != costs.cend(); ++it) {
+        const int active = streams.value(it.key());
+        // 设备空闲时总是放行，避免代价大于预算的拷贝永远等待
+        if (active > 0 && active + it.value() > budgetOf(it.key(), policy))
+            return false;
+    }
+    return true;
+}
+
+void CopyScheduler::release(const QHash<dev_t, int> &costs)
+{
+    QMutexLocker locker(&mutex);
+    for (auto it = costs.cbegin(); it != costs.cend(); ++it) {
+        auto stream = streams.find(it.key());
+        if (stream == streams.end())
+            continue;
+        stream.value() -= it.value();
+        if (stream.value() <= 0)
+            streams.erase(stream);
+    }
+    condition.wakeAll();
+}
@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COPYSCHEDULER_H
+#define COPYSCHEDULER_H
+
+#include "dfmplugin_fileoperations_global.h"
+#include "workerdata.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QWaitCondition>
+
+#include <functional>
+
+#include <sys/types.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The CopyScheduler class admits local big file copies of all jobs by per device I/O budgets.
+ * A copy holds one stream on the source and the target device, a copy inside one device holds
+ * WorkerData::CopyAdmissionPolicy::sameDeviceWeight streams on it. Waiters block on a condition
+ * variable and are woken when a copy finishes or a job stops.
+ */
+class CopyScheduler
+{
+public:
+    class Ticket
+    {
+    public:
+        ~Ticket();
+        bool isSameDevice() const { return sameDevice; }
+
+    private:
+        friend class CopyScheduler;
+        Ticket(CopyScheduler *scheduler, const QHash<dev_t, int> &costs, bool sameDevice);
+
+        CopyScheduler *scheduler { nullptr };
+        QHash<dev_t, int> costs;
+        bool sameDevice { false };
+    };
+    using TicketPointer = QSharedPointer<Ticket>;
+
+    static CopyScheduler *instance();
+
+    TicketPointer acquire(const QString &fromPath, const QString &toPath,
+                          const WorkerData::CopyAdmissionPolicy &policy,
+                          const std::function<bool()> &isStopped);
+    void wakeAll();
+
+    int deviceBudget(dev_t device, const WorkerData::CopyAdmissionPolicy &policy);
+    int activeStreams(dev_t device);
+
+private:
+    CopyScheduler() = default;
+    static dev_t resolveBlockDevice(dev_t device, bool *memoryBacked);
+    bool isRotational(dev_t device);
+    int budgetOf(dev_t device, const WorkerData::CopyAdmissionPolicy &policy);
+    bool admissible(const QHash<dev_t, int> &costs, const WorkerData::CopyAdmissionPolicy &policy);
+    void release(const QHash<dev_t, int> &costs);
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QHash<dev_t, int> streams;
+    QHash<dev_t, bool> rotationalCache;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // COPYSCHEDULER_H
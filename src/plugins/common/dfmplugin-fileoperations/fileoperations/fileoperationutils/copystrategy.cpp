@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "copystrategy.h"
+
+#include <QByteArray>
+#include <QFile>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#ifndef FICLONE
+#    define FICLONE _IOW(0x94, 9, int)
+#endif
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+static constexpr int kBufferSize { 1024 * 1024 };
+
+// 支持共享数据块（reflink）的文件系统
+static constexpr quint32 kReflinkFileSystems[] {
+    0x9123683e,   // btrfs
+    0x58465342,   // xfs
+    0xca451a4e,   // bcachefs
+    0x7461636f,   // ocfs2
+    0x6969,   // nfs
+    0xff534d42,   // cifs
+    0xfe534d42,   // smb2
+};
+
+static bool supportsReflink(quint32 type)
+{
+    for (quint32 fsType : kReflinkFileSystems) {
+        if (fsType == type)
+            return true;
+    }
+    return false;
+}
+
+static bool isUnsupportedError(int error)
+{
+    return error == EOPNOTSUPP || error == EXDEV || error == ENOSYS || error == ENOTTY || error == EINVAL;
+}
+
+CopyStrategy::CopyStrategy()
+    : supported(kReadWrite | kCopyFileRange)
+{
+}
+
+/*!
+ * \brief CopyStrategy::probe Decide the methods of a job by the file systems of the source and the target
+ * \param sourcePath first source file of the job
+ * \param targetPath target directory of the job
+ */
+void CopyStrategy::probe(const QString &sourcePath, const QString &targetPath)
+{
+    struct statfs fromFs;
+    struct statfs toFs;
+    if (::statfs(QFile::encodeName(sourcePath).constData(), &fromFs) != 0
+        || ::statfs(QFile::encodeName(targetPath).constData(), &toFs) != 0) {
+        fmWarning() << "Failed to probe copy strategy, keep the default methods, from:" << sourcePath << "to:" << targetPath;
+        return;
+    }
+
+    Methods probed { kReadWrite };
+    const quint32 type = static_cast<quint32>(toFs.f_type);
+    // copy_file_range 只在同类文件系统之间可用，reflink 跨设备时由 ioctl 返回 EXDEV 后停用
+    if (static_cast<quint32>(fromFs.f_type) == type) {
+        probed |= kCopyFileRange;
+        if (supportsReflink(type))
+            probed |= kReflink;
+    }
+
+    setMethods(probed);
+    fmInfo() << "Copy strategy probed, file system type:" << QString::number(type, 16) << "methods:" << int(probed);
+}
+
+CopyStrategy::Methods CopyStrategy::methods() const
+{
+    return Methods(supported.loadAcquire());
+}
+
+void CopyStrategy::setMethods(Methods methods)
+{
+    supported.storeRelease(int(methods | kReadWrite));
+}
+
+/*!
+ * \brief CopyStrategy::reflink Share the data blocks of the source with the target
+ * \return true if the whole file is cloned, otherwise the target is left untouched
+ */
+bool CopyStrategy::reflink(int sourceFd, int targetFd)
+{
+    if (!(supported.loadAcquire() & kReflink))
+        return false;
+
+    if (::ioctl(targetFd, FICLONE, sourceFd) == 0)
+        return true;
+
+    if (isUnsupportedError(errno)) {
+        fmInfo() << "Reflink is not supported, error:" << strerror(errno);
+        disable(kReflink);
+    }
+    return false;
+}
+
+/*!
+ * \brief CopyStrategy::copyRange Copy at most length bytes like copy_file_range, fall back to
+ * buffered read/write when copy_file_range is not usable
+ * \return copied size, 0 at the end of the source, -1 on error with errno set
+ */
+ssize_t CopyStrategy::copyRange(int sourceFd, off_t *offsetIn, int targetFd, off_t *offsetOut, size_t length)
+{
+    if (supported.loadAcquire() & kCopyFileRange) {
+        const ssize_t result = ::copy_file_range(sourceFd, offsetIn, targetFd, offsetOut, length, 0);
+        if (result >= 0 || !isUnsupportedError(errno))
+            return result;
+
+        fmInfo() << "copy_file_range is not supported, error:" << strerror(errno);
+        disable(kCopyFileRange);
+    }
+
+    thread_local QByteArray buffer;
+    const int size = static_cast<int>(qMin<size_t>(length, kBufferSize));
+    if (buffer.size() < size)
+        buffer.resize(size);
+
+    ssize_t readSize = -1;
+    do {
+        readSize = ::pread(sourceFd, buffer.data(), static_cast<size_t>(size), *offsetIn);
+    } while (readSize < 0 && errno == EINTR);
+    if (readSize <= 0)
+        return readSize;
+
+    ssize_t written = 0;
+    while (written < readSize) {
+        const ssize_t result = ::pwrite(targetFd, buffer.constData() + written,
+                                        static_cast<size_t>(readSize - written), *offsetOut + written);
+        if (result < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        written += result;
+    }
+
+    *offsetIn += readSize;
+    *offsetOut += written;
+    return written;
+}
+
+/*!
+ * \brief CopyStrategy::prepare Hint sequential reading and preallocate the target before moving data
+ */
+void CopyStrategy::prepare(int sourceFd, int targetFd, qint64 size)
+{
+    ::posix_fadvise(sourceFd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    // 不支持预分配的文件系统直接忽略
+    if (size > 0)
+        ::fallocate(targetFd, FALLOC_FL_KEEP_SIZE, 0, size);
+}
+
+/*!
+ * \brief CopyStrategy::writeBehind Start writing back a copied range without waiting for it
+ */
+void CopyStrategy::writeBehind(int targetFd, off_t offset, off_t length)
+{
+    if (length > 0)
+        ::sync_file_range(targetFd, offset, length, SYNC_FILE_RANGE_WRITE);
+}
+
+/*!
+ * \brief CopyStrategy::dropCache Wait for a written back range and drop it from the page cache
+ * of both files, so big copies do not evict the cache of other applications
+ */
+void CopyStrategy::dropCache(int sourceFd, int targetFd, off_t offset, off_t length)
+{
+    if (length <= 0)
+        return;
+
+    ::sync_file_range(targetFd, offset, length,
+                      SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    ::posix_fadvise(targetFd, offset, length, POSIX_FADV_DONTNEED);
+    ::posix_fadvise(sourceFd, offset, length, POSIX_FADV_DONTNEED);
+}
+
+void CopyStrategy::disable(Method method)
+{
+    supported.fetchAndAndOrdered(~int(method));
+}
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COPYSTRATEGY_H
+#define COPYSTRATEGY_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QAtomicInt>
+#include <QFlags>
+#include <QString>
+
+#include <sys/types.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The CopyStrategy class picks how file data is moved for one job. The source and target
+ * file systems are probed once, then copies try reflink, copy_file_range and buffered read/write
+ * in that order. A method rejected by the file system at runtime is disabled for the rest of the job.
+ */
+class CopyStrategy
+{
+public:
+    enum Method : quint8 {
+        kReadWrite = 0x01,
+        kCopyFileRange = 0x02,
+        kReflink = 0x04,
+    };
+    Q_DECLARE_FLAGS(Methods, Method)
+
+    CopyStrategy();
+
+    void probe(const QString &sourcePath, const QString &targetPath);
+    Methods methods() const;
+    void setMethods(Methods methods);
+
+    bool reflink(int sourceFd, int targetFd);
+    ssize_t copyRange(int sourceFd, off_t *offsetIn, int targetFd, off_t *offsetOut, size_t length);
+
+    static void prepare(int sourceFd, int targetFd, qint64 size);
+    static void writeBehind(int targetFd, off_t offset, off_t length);
+    static void dropCache(int sourceFd, int targetFd, off_t offset, off_t length);
+
+private:
+    void disable(Method method);
+
+    QAtomicInt supported;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(DPFILEOPERATIONS_NAMESPACE::CopyStrategy::Methods)
+
+#endif   // COPYSTRATEGY_H
@@ -24,6 +24,7 @@
 #include <sys/mman.h>
 
 static const quint32 kMaxBufferLength { 1024 * 1024 * 1 };
+static const off_t kDropBehindLength { 16 * 1024 * 1024 };
 
 DPFILEOPERATIONS_USE_NAMESPACE
 USING_IO_NAMESPACE
@@ -126,9 +127,8 @@ bool DoCopyFileWorker::doDfmioFileCopy(const DFileInfoPointer fromInfo,
     fileOps.removeOneByLock(op);
     auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
     if (!actionOperating(action, fromSize <= 0 ? FileUtils::getMemoryPageSize() : fromSize, skip))
-        workData->currentWriteSize -= workData->everyFileWriteSize.value(fromUrl);
+        workData->currentWriteSize -= data->writtenSize;
 
-    workData->everyFileWriteSize.remove(fromUrl);
     delete data;
     toInfo->initQuerier();
     if (toInfo->exists())
@@ -145,8 +145,8 @@ void DoCopyFileWorker::progressCallback(int64_t current, int64_t total, void *pr
     assert(data->data);
     if (total <= 0)
         data->data->zeroOrlinkOrDirWriteSize += FileUtils::getMemoryPageSize();
-    data->data->currentWriteSize += (current - data->data->everyFileWriteSize.value(data->copyFile));
-    data->data->everyFileWriteSize.insert(data->copyFile, current);
+    data->data->currentWriteSize += (current - data->writtenSize);
+    data->writtenSize = current;
 }
 
 void DoCopyFileWorker::syncBlockFile(const DFileInfoPointer toInfo)
@@ -299,7 +299,8 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
 }
 
 /*!
- * \brief DoCopyFileWorker::doCopyFileByRange
+ * \brief DoCopyFileWorker::doCopyFileByRange Copy by the strategy of the job,
+ * reflink first, then copy_file_range, then buffered read/write
  * \param fromInfo
  * \param toInfo
  * \param skip
@@ -336,21 +337,30 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
             syncfs(targetFd);
         return NextDo::kDoCopyNext;
     }
+    // 同一文件系统优先共享数据块，不需要搬运数据
+    const bool cloned = workData->copyStrategy.reflink(sourcFd, targetFd);
+    if (cloned)
+        workData->currentWriteSize += fromSize;
+    else
+        CopyStrategy::prepare(sourcFd, targetFd, fromSize);
     // 循环读取和写入文件，拷贝
     size_t blockSize = static_cast<size_t>(fromSize > kMaxBufferLength ? kMaxBufferLength : fromSize);
-    off_t offset_in = 0;
-    off_t offset_out = 0;
+    off_t offset_in = cloned ? fromSize : 0;
+    off_t offset_out = offset_in;
+    off_t writtenBack = 0;
+    off_t dropped = 0;
     ssize_t result = -1;
-    size_t left = static_cast<size_t>(fromSize);
+    size_t left = cloned ? 0 : static_cast<size_t>(fromSize);
     AbstractJobHandler::SupportAction action { AbstractJobHandler::SupportAction::kNoAction };
-    do {
+    while (offset_out != fromSize) {
         if (Q_UNLIKELY(!stateCheck()))
             return NextDo::kDoCopyErrorAddCancel;
         do {
             if (Q_UNLIKELY(!stateCheck()))
                 return NextDo::kDoCopyErrorAddCancel;
+            action = AbstractJobHandler::SupportAction::kNoAction;
             blockSize = left < blockSize ? left : blockSize;
-            result = copy_file_range(sourcFd, &offset_in, targetFd, &offset_out, blockSize, 0);
+            result = workData->copyStrategy.copyRange(sourcFd, &offset_in, targetFd, &offset_out, blockSize);
             if (result < 0) {
                 auto lastError = strerror(errno);
                 fmWarning() << "copy file range error, url from: " << fromInfo->uri()
@@ -360,6 +370,18 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
                                               false, lastError);
                 offset_in = qMin(offset_in, offset_out);
                 offset_out = offset_in;
+            } else if (Q_UNLIKELY(result == 0)) {
+                // 源文件在拷贝过程中被截断或删除，未达到预期大小就读到了文件末尾
+                fmWarning() << "copy file range reached end of source early, url from: " << fromInfo->uri()
+                            << " url to: " << toInfo->uri() << " copied: " << offset_out << " expected: " << fromSize;
+                fromInfo->initQuerier();
+                action = doHandleErrorAndWait(fromInfo->uri(), toInfo->uri(),
+                                              fromInfo->exists() ? AbstractJobHandler::JobErrorType::kReadError
+                                                                 : AbstractJobHandler::JobErrorType::kNonexistenceError,
+                                              false);
+                // 没有更多数据可拷贝，不能当作成功继续循环
+                if (action == AbstractJobHandler::SupportAction::kNoAction)
+                    action = AbstractJobHandler::SupportAction::kCancelAction;
             } else {
                 workData->currentWriteSize += result;
                 left -= static_cast<size_t>(result);
@@ -368,7 +390,16 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
         checkRetry();
         if (!actionOperating(action, fromSize - offset_out, skip))
             return NextDo::kDoCopyErrorAddCancel;
-    } while (offset_out != fromSize);
+        // 分段回写已拷贝的数据并移出页缓存，大文件拷贝不挤占其它程序的缓存
+        if (offset_out - writtenBack >= kDropBehindLength) {
+            CopyStrategy::writeBehind(targetFd, writtenBack, offset_out - writtenBack);
+            CopyStrategy::dropCache(sourcFd, targetFd, dropped, writtenBack - dropped);
+            dropped = writtenBack;
+            writtenBack = offset_out;
+        }
+    }
+    if (!cloned)
+        CopyStrategy::dropCache(sourcFd, targetFd, dropped, fromSize - dropped);
     // 对文件加权
     setTargetPermissions(fromInfo->uri(), toInfo->uri());
     if (!stateCheck())
@@ -45,6 +45,7 @@ public:
     struct ProgressData {
         QUrl copyFile;
         QSharedPointer<WorkerData> data{ nullptr };
+        qint64 writtenSize { 0 };   // 当前文件已计入进度的大小，只由拷贝线程访问
     };
 
 public:
@@ -5,6 +5,7 @@
 #include "fileoperatebaseworker.h"
 #include "fileoperations/fileoperationutils/fileoperationsutils.h"
 #include "workerdata.h"
+#include "copyscheduler.h"
 
 #include <dfm-base/interfaces/abstractdiriterator.h>
 #include <dfm-base/base/schemefactory.h>
@@ -648,15 +649,8 @@ bool FileOperateBaseWorker::checkAndCopyFile(const DFileInfoPointer fromInfo, co
         return doCopyOtherFile(fromInfo, toInfo, skip);
 
     if (isSourceFileLocal && isTargetFileLocal && !workData->signalThread) {
-        while (bigFileCopy && !isStopped()) {
-            QThread::msleep(10);
-        }
-        if (fromSize > bigFileSize && FileUtils::isSameDevice(fromInfo->uri(), targetUrl)) {
-            bigFileCopy = true;
-            auto result = doCopyLocalByRange(fromInfo, toInfo, skip);
-            bigFileCopy = false;
-            return result;
-        }
+        if (fromSize > bigFileSize)
+            return doCopyLocalBigFile(fromInfo, toInfo);
         return doCopyLocalFile(fromInfo, toInfo);
     }
 
@@ -767,14 +761,9 @@ bool FileOperateBaseWorker::checkAndCopyDir(const DFileInfoPointer &fromInfo, co
 
 void FileOperateBaseWorker::waitThreadPoolOver()
 {
-    // wait all thread start
-    if (!isStopped() && threadPool) {
-        QThread::msleep(10);
-    }
     // wait thread pool copy local file or copy big file over
-    while (threadPool && threadPool->activeThreadCount() > 0) {
-        QThread::msleep(10);
-    }
+    if (threadPool)
+        threadPool->waitForDone();
 }
 
 void FileOperateBaseWorker::initCopyWay()
@@ -794,6 +783,10 @@ void FileOperateBaseWorker::initCopyWay()
         || workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCountProgressCustomize))
         countWriteType = CountWriteSizeType::kCustomizeType;
 
+    // 本地和 cifs 同设备拷贝按文件系统选择 reflink、copy_file_range 或读写
+    if ((isSourceFileLocal && isTargetFileLocal) || workData->copyFileRange)
+        workData->copyStrategy.probe(sourceUrls.first().path(), targetUrl.path());
+
     if (!workData->signalThread) {
         initThreadCopy();
     }
@@ -902,6 +895,43 @@ bool FileOperateBaseWorker::doCopyLocalFile(const DFileInfoPointer fromInfo, con
     return true;
 }
 
+/*!
+ * \brief FileOperateBaseWorker::doCopyLocalBigFile Copy a local big file in the thread pool once the
+ * devices of the source and the target have budget, data is moved by the copy strategy of the job
+ * \param fromInfo source file information
+ * \param toInfo target file information
+ * \return false if the job stopped while waiting
+ */
+bool FileOperateBaseWorker::doCopyLocalBigFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo)
+{
+    if (!stateCheck())
+        return false;
+
+    auto ticket = CopyScheduler::instance()->acquire(fromInfo->uri().path(), targetUrl.path(),
+                                                     workData->bigFileCopyPolicy,
+                                                     [this]() { return isStopped(); });
+    if (!ticket)
+        return false;
+
+    auto worker = threadCopyWorker[threadCopyFileCount % threadCount];
+    auto data = workData;
+    QtConcurrent::run(threadPool.data(), [worker, data, fromInfo, toInfo, ticket]() mutable {
+        const QUrl &target = toInfo->uri();
+        FileUtils::cacheCopyingFileUrl(target);
+        // 失败或取消的拷贝不计入完成数
+        if (worker->doCopyFileByRange(fromInfo, toInfo, nullptr) == DoCopyFileWorker::NextDo::kDoCopyNext) {
+            FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, target);
+            data->completeFileCount++;
+        }
+        OperatorsFileUtils::instance()->delayRemoveCopyingFile(target);
+        // 拷贝结束立即归还预算，唤醒等待的线程
+        ticket.reset();
+    });
+
+    threadCopyFileCount++;
+    return true;
+}
+
 bool FileOperateBaseWorker::doCopyLocalByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
 {
     waitThreadPoolOver();
@@ -1119,14 +1149,15 @@ qint64 FileOperateBaseWorker::getWriteDataSize()
 
     if (CountWriteSizeType::kTidType == countWriteType) {
         writeSize = getTidWriteSize();
+        const qint64 currentWriteSize = workData->currentWriteSize.load();
 
-        if (writeSize > workData->currentWriteSize && workData->currentWriteSize > 0) {
-            writeSize = workData->currentWriteSize;
+        if (writeSize > currentWriteSize && currentWriteSize > 0) {
+            writeSize = currentWriteSize;
         }
         if (writeSize <= 0)
-            writeSize = workData->currentWriteSize;
+            writeSize = currentWriteSize;
     } else if (CountWriteSizeType::kCustomizeType == countWriteType) {
-        writeSize = workData->currentWriteSize;
+        writeSize = workData->currentWriteSize.load();
     } else if (CountWriteSizeType::kWriteBlockType == countWriteType) {
         qint64 currentSectorsWritten = getSectorsWritten() + workData->blockRenameWriteSize;
         if (currentSectorsWritten > targetDeviceStartSectorsWritten)
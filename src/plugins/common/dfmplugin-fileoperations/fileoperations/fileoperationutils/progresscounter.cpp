@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "progresscounter.h"
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+qint64 ProgressCounter::load() const
+{
+    qint64 sum = 0;
+    for (const Slot &slot : counters)
+        sum += slot.value.load(std::memory_order_relaxed);
+    return sum;
+}
+
+void ProgressCounter::reset()
+{
+    for (Slot &slot : counters)
+        slot.value.store(0, std::memory_order_relaxed);
+}
+
+int ProgressCounter::threadSlotIndex()
+{
+    // 线程首次计数时分配槽位，线程数超过槽位数时多个线程共用一个槽位，计数仍然正确
+    static std::atomic_int nextIndex { 0 };
+    thread_local const int index = nextIndex.fetch_add(1, std::memory_order_relaxed) % kSlotCount;
+    return index;
+}
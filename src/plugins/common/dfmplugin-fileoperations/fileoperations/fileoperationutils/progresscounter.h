@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PROGRESSCOUNTER_H
+#define PROGRESSCOUNTER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QtGlobal>
+
+#include <atomic>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief The ProgressCounter class counts the progress written by many copy threads. Every thread
+ * adds to its own cache line aligned slot without locks, the progress timer sums all slots.
+ */
+class ProgressCounter
+{
+    Q_DISABLE_COPY(ProgressCounter)
+
+public:
+    ProgressCounter() = default;
+
+    inline void add(qint64 value) { counters[threadSlotIndex()].value.fetch_add(value, std::memory_order_relaxed); }
+    qint64 load() const;
+    void reset();
+
+    inline ProgressCounter &operator+=(qint64 value)
+    {
+        add(value);
+        return *this;
+    }
+    inline ProgressCounter &operator-=(qint64 value)
+    {
+        add(-value);
+        return *this;
+    }
+    inline void operator++(int) { add(1); }
+    inline operator qint64() const { return load(); }
+
+private:
+    static constexpr int kSlotCount { 64 };
+    static int threadSlotIndex();
+
+    struct alignas(64) Slot
+    {
+        std::atomic<qint64> value { 0 };
+    };
+    Slot counters[kSlotCount];
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // PROGRESSCOUNTER_H
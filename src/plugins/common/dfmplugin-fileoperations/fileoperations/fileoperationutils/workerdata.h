@@ -5,6 +5,9 @@
 #ifndef WORKERDATA_H
 #define WORKERDATA_H
 #include "dfmplugin_fileoperations_global.h"
+#include "copystrategy.h"
+#include "progresscounter.h"
+
 #include <dfm-base/interfaces/abstractjobhandler.h>
 #include <dfm-base/interfaces/fileinfo.h>
 #include <dfm-base/utils/threadcontainer.h>
@@ -49,6 +52,14 @@ public:
         }
     };
 
+    // 本地大文件并发拷贝的准入策略，预算为每个设备上同时进行的拷贝流数
+    struct CopyAdmissionPolicy
+    {
+        int rotationalBudget { 1 };   // 机械硬盘
+        int solidStateBudget { 4 };   // 固态硬盘、内存文件系统
+        int sameDeviceWeight { 2 };   // 同设备拷贝同时读写，占用的流数
+    };
+
     WorkerData();
 
     quint16 dirSize { 0 };   // size of dir
@@ -59,14 +70,14 @@ public:
     std::atomic_bool isFsTypeVfat { false };
     std::atomic_bool isBlockDevice { false };
     std::atomic_bool copyFileRange { false };
-    std::atomic_int64_t currentWriteSize { 0 };
+    ProgressCounter currentWriteSize;   // 拷贝线程各自计数，更新进度时汇总
     QAtomicInteger<qint64> zeroOrlinkOrDirWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
     QAtomicInteger<qint64> blockRenameWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
     QAtomicInteger<qint64> skipWriteSize { 0 };   // 跳过的文件大
-    QAtomicInteger<qint64> completeFileCount { 0 };   // copy complete file count
+    ProgressCounter completeFileCount;   // copy complete file count
     std::atomic_bool signalThread { true };
-    DThreadMap<QUrl, qint64> everyFileWriteSize;
-    DThreadList<QSharedPointer<DPFILEOPERATIONS_NAMESPACE::WorkerData::BlockFileCopyInfo>> blockCopyInfoQueue;
+    CopyAdmissionPolicy bigFileCopyPolicy;
+    CopyStrategy copyStrategy;   // 每个任务探测一次的数据拷贝方式
 };
 DPFILEOPERATIONS_END_NAMESPACE
 using BlockFileCopyInfoPointer = QSharedPointer<DPFILEOPERATIONS_NAMESPACE::WorkerData::BlockFileCopyInfo>;
@@ -203,7 +203,6 @@ QList<DCustomActionEntry> DCustomActionBuilder::matchFileCombo(const QList<DCust
 QList<DCustomActionEntry> DCustomActionBuilder::matchActions(const QList<QUrl> &selects,
                                                              QList<DCustomActionEntry> oriActions)
 {
-    // todo：细化功能颗粒度，一个函数尽量专职一件事
     /*
      *根据选中内容、配置项、选中项类型匹配合适的菜单项
      *是否action支持的协议
@@ -212,8 +211,21 @@ QList<DCustomActionEntry> DCustomActionBuilder::matchActions(const QList<QUrl> &
      *action支持类型过滤(类型过滤要加上父类型一起过滤)
      */
 
+    QList<ActionMatcher> matchers;
+    matchers.reserve(oriActions.size());
+    for (const DCustomActionEntry &action : oriActions)
+        matchers.append(compileMatcher(action));
+
+    // 协议、后缀、类型相同的选中项只检查一次，大量选中时绝大多数文件都落在少数几类中
+    QSet<QString> checkedClasses;
+    QHash<QString, QPair<QStringList, QStringList>> mimeTypesCache;
+
     //具体配置过滤
-    for (auto &singleUrl : selects) {
+    for (const QUrl &singleUrl : selects) {
+        // 所有菜单项都已被过滤，剩余的选中项无需再检查
+        if (oriActions.isEmpty())
+            break;
+
         //协议、后缀
         QString errString;
         const FileInfoPointer &fileInfo = DFMBASE_NAMESPACE::InfoFactory::create<FileInfo>(singleUrl, Global::CreateFileInfoType::kCreateFileInfoAuto, &errString);
@@ -222,61 +234,39 @@ QList<DCustomActionEntry> DCustomActionBuilder::matchActions(const QList<QUrl> &
             continue;
         }
 
+        SelectionClass selection;
+        selection.scheme = singleUrl.scheme();
+        selection.isDir = fileInfo->isAttributes(OptInfoType::kIsDir);
+        if (!selection.isDir)
+            selection.completeSuffix = fileInfo->nameOf(NameInfoType::kCompleteSuffix);
+        const QMimeType &mimeType = fileInfo->fileMimeType();
+
+        const QString &classKey = QString("%1\n%2\n%3\n%4").arg(selection.scheme, QString::number(selection.isDir), selection.completeSuffix, mimeType.name());
+        if (checkedClasses.contains(classKey))
+            continue;
+        checkedClasses.insert(classKey);
+
         /*
          * 选中文件类型过滤：
-         * fileMimeTypes:包括所有父类型的全量类型集合
-         * fileMimeTypesNoParent:不包含父类mimetype的集合
+         * allMimeTypes:包括所有父类型的全量类型集合
+         * mimeTypesNoParent:不包含父类mimetype的集合
          * 目的是在一些应用对文件的识别支持上有差异：比如xlsx的 parentMimeTypes 是application/zip
          * 归档管理器打开则会被作为解压
          */
+        auto mimeTypes = mimeTypesCache.find(mimeType.name());
+        if (mimeTypes == mimeTypesCache.end()) {
+            QPair<QStringList, QStringList> types;
+            appendAllMimeTypes(mimeType, types.first, types.second);
+            mimeTypes = mimeTypesCache.insert(mimeType.name(), types);
+        }
+        selection.mimeTypesNoParent = mimeTypes->first;
+        selection.allMimeTypes = mimeTypes->second;
 
-        QStringList fileMimeTypes;
-        QStringList fileMimeTypesNoParent;
-        //        fileMimeTypes.append(fileInfo->mimeType().name());
-        //        fileMimeTypes.append(fileInfo->mimeType().aliases());
-        //        const QMimeType &mt = fileInfo->mimeType();
-        //        fileMimeTypesNoParent = fileMimeTypes;
-        //        appendParentMimeType(mt.parentMimeTypes(), fileMimeTypes);
-        //        fileMimeTypes.removeAll({});
-        //        fileMimeTypesNoParent.removeAll({});
-
-        appendAllMimeTypes(fileInfo, fileMimeTypesNoParent, fileMimeTypes);
-        for (auto it = oriActions.begin(); it != oriActions.end();) {
-            DCustomActionEntry &tempAction = *it;
-            //协议，后缀
-            if (!isSchemeSupport(tempAction, singleUrl) || !isSuffixSupport(tempAction, fileInfo)) {
-                it = oriActions.erase(it);   //不支持的action移除
-                continue;
-            }
-
-            //不支持的mimetypes,使用不包含父类型的mimetype集合过滤
-            if (isMimeTypeMatch(fileMimeTypesNoParent, tempAction.excludeMimeTypes())) {
-                it = oriActions.erase(it);
-                continue;
-            }
-
-            // MimeType在原有oem中，未指明或Mimetype=*都作为支持所有类型
-            if (tempAction.mimeTypes().isEmpty()) {
-                ++it;
-                continue;
-            }
-
-            //支持的mimetype,使用包含父类型的mimetype集合过滤
-            QStringList supportMimeTypes = tempAction.mimeTypes();
-            supportMimeTypes.removeAll({});
-            auto match = isMimeTypeMatch(fileMimeTypes, supportMimeTypes);
-
-//在自定义右键菜中有作用域限制，此类情况不显示自定义菜单，故可屏蔽，若后续有作用域的调整再考虑是否开放
-#if 0
-            //部分mtp挂载设备目录下文件属性不符合规范(普通目录mimetype被认为是octet-stream)，暂时做特殊处理-
-            if (singleUrl.path().contains("/mtp:host") && supportMimeTypes.contains("application/octet-stream") && fileMimeTypes.contains("application/octet-stream"))
-                match = false;
-#endif
-            if (!match) {
-                it = oriActions.erase(it);
-                continue;
+        for (int i = oriActions.size() - 1; i >= 0; --i) {
+            if (!isActionMatch(matchers.at(i), selection)) {
+                oriActions.removeAt(i);   //不支持的action移除
+                matchers.removeAt(i);
             }
-            ++it;
         }
     }
 
@@ -421,78 +411,112 @@ QStringList DCustomActionBuilder::splitCommand(const QString &cmd)
     return args;
 }
 
-bool DCustomActionBuilder::isMimeTypeSupport(const QString &mt, const QStringList &fileMimeTypes)
+DCustomActionBuilder::ActionMatcher DCustomActionBuilder::compileMatcher(const DCustomActionEntry &action)
 {
-    foreach (const QString &fmt, fileMimeTypes) {
-        if (fmt.contains(mt, Qt::CaseInsensitive)) {
-            return true;
-        }
+    ActionMatcher matcher;
+
+    // X-DFM-SupportSchemes not exist
+    const QStringList &schemes = action.surpportSchemes();
+    matcher.allSchemes = schemes.contains("*") || schemes.isEmpty();   //支持所有协议: 未特殊指明X-DFM-SupportSchemes或者"X-DFM-SupportSchemes=*"
+    for (const QString &scheme : schemes)
+        matcher.schemes.insert(scheme.toLower());
+
+    const QStringList &suffixes = action.supportStuffix();
+    matcher.allSuffixes = suffixes.isEmpty() || suffixes.contains("*");   //未特殊指明支持项或者包含*为支持所有
+    for (const QString &suffix : suffixes) {
+        matcher.suffixes.insert(suffix.toLower());
+        int endPos = suffix.lastIndexOf("*");   // 例如：7z.*
+        if (endPos >= 0)
+            matcher.suffixPrefixes.append(suffix.left(endPos));
     }
-    return false;
+
+    compileMimeTypes(action.excludeMimeTypes(), &matcher.excludeMimeTypes, &matcher.excludeMimePrefixes);
+
+    // MimeType在原有oem中，未指明或Mimetype=*都作为支持所有类型
+    matcher.allMimeTypes = action.mimeTypes().isEmpty();
+    compileMimeTypes(action.mimeTypes(), &matcher.mimeTypes, &matcher.mimePrefixes);
+
+    return matcher;
 }
 
-bool DCustomActionBuilder::isMimeTypeMatch(const QStringList &fileMimeTypes, const QStringList &supportMimeTypes)
+void DCustomActionBuilder::compileMimeTypes(const QStringList &mimeTypes, QSet<QString> *types, QStringList *prefixes)
 {
-    bool match = false;
-    for (const QString &mt : supportMimeTypes) {
-        if (fileMimeTypes.contains(mt, Qt::CaseInsensitive)) {
-            match = true;
-            break;
-        }
+    for (const QString &mt : mimeTypes) {
+        if (mt.isEmpty())
+            continue;
 
+        types->insert(mt.toLower());
         int starPos = mt.indexOf("*");
-        if (starPos >= 0 && isMimeTypeSupport(mt.left(starPos), fileMimeTypes)) {
-            match = true;
-            break;
-        }
+        if (starPos >= 0)
+            prefixes->append(mt.left(starPos).toLower());
     }
-    return match;
 }
 
-bool DCustomActionBuilder::isSchemeSupport(const DCustomActionEntry &action, const QUrl &url)
+bool DCustomActionBuilder::isActionMatch(const ActionMatcher &matcher, const SelectionClass &selection)
 {
-    // X-DFM-SupportSchemes not exist
-    auto supportList = action.surpportSchemes();
-    if (supportList.contains("*") || supportList.isEmpty())
-        return true;   //支持所有协议: 未特殊指明X-DFM-SupportSchemes或者"X-DFM-SupportSchemes=*"
-    return supportList.contains(url.scheme(), Qt::CaseInsensitive);
+    //协议，后缀
+    if (!matcher.allSchemes && !matcher.schemes.contains(selection.scheme.toLower()))
+        return false;
+    if (!isSuffixSupport(matcher, selection))
+        return false;
+
+    //不支持的mimetypes,使用不包含父类型的mimetype集合过滤
+    if (isMimeTypeMatch(selection.mimeTypesNoParent, matcher.excludeMimeTypes, matcher.excludeMimePrefixes))
+        return false;
+
+    if (matcher.allMimeTypes)
+        return true;
+
+    //支持的mimetype,使用包含父类型的mimetype集合过滤
+    return isMimeTypeMatch(selection.allMimeTypes, matcher.mimeTypes, matcher.mimePrefixes);
 }
 
-bool DCustomActionBuilder::isSuffixSupport(const DCustomActionEntry &action, FileInfoPointer fileInfo)
+bool DCustomActionBuilder::isMimeTypeMatch(const QStringList &fileMimeTypes, const QSet<QString> &types, const QStringList &prefixes)
 {
-    QString errString;
-    auto supportList = action.supportStuffix();
-    if (!fileInfo || fileInfo->isAttributes(OptInfoType::kIsDir) || supportList.isEmpty() || supportList.contains("*")) {
-        return true;   //未特殊指明支持项或者包含*为支持所有
+    for (const QString &fmt : fileMimeTypes) {
+        if (types.contains(fmt))
+            return true;
     }
 
+    for (const QString &prefix : prefixes) {
+        for (const QString &fmt : fileMimeTypes) {
+            if (fmt.contains(prefix))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool DCustomActionBuilder::isSuffixSupport(const ActionMatcher &matcher, const SelectionClass &selection)
+{
+    if (selection.isDir || matcher.allSuffixes)
+        return true;
+
     //例如： 7z.001,7z.002, 7z.003 ... 7z.xxx
-    QString cs = fileInfo->nameOf(NameInfoType::kCompleteSuffix);
-    if (supportList.contains(cs, Qt::CaseInsensitive)) {
+    const QString &cs = selection.completeSuffix;
+    if (matcher.suffixes.contains(cs.toLower()))
         return true;
-    }
 
-    bool match = false;
-    for (const QString &suffix : supportList) {
-        auto tempSuffix = suffix;
-        int endPos = tempSuffix.lastIndexOf("*");   // 例如：7z.*
-        if (endPos >= 0 && cs.length() > endPos && tempSuffix.left(endPos) == cs.left(endPos)) {
-            match = true;
-            break;
-        }
+    for (const QString &prefix : matcher.suffixPrefixes) {
+        if (cs.length() > prefix.length() && cs.startsWith(prefix))
+            return true;
     }
-    return match;
+    return false;
 }
 
-void DCustomActionBuilder::appendAllMimeTypes(const FileInfoPointer &fileInfo, QStringList &noParentmimeTypes, QStringList &allMimeTypes)
+void DCustomActionBuilder::appendAllMimeTypes(const QMimeType &mimeType, QStringList &noParentmimeTypes, QStringList &allMimeTypes)
 {
-    noParentmimeTypes.append(fileInfo->fileMimeType().name());
-    noParentmimeTypes.append(fileInfo->fileMimeType().aliases());
-    const QMimeType &mt = fileInfo->fileMimeType();
+    noParentmimeTypes.append(mimeType.name());
+    noParentmimeTypes.append(mimeType.aliases());
     allMimeTypes = noParentmimeTypes;
-    appendParentMimeType(mt.parentMimeTypes(), allMimeTypes);
+    appendParentMimeType(mimeType.parentMimeTypes(), allMimeTypes);
     noParentmimeTypes.removeAll({});
     allMimeTypes.removeAll({});
+    // 匹配不区分大小写
+    for (QString &mt : noParentmimeTypes)
+        mt = mt.toLower();
+    for (QString &mt : allMimeTypes)
+        mt = mt.toLower();
 }
 
 void DCustomActionBuilder::appendParentMimeType(const QStringList &parentmimeTypes, QStringList &mimeTypes)
@@ -500,8 +524,8 @@ void DCustomActionBuilder::appendParentMimeType(const QStringList &parentmimeTyp
     if (parentmimeTypes.size() == 0)
         return;
 
+    QMimeDatabase db;
     for (const QString &mtName : parentmimeTypes) {
-        DFMBASE_NAMESPACE::DMimeDatabase db;
         QMimeType mt = db.mimeTypeForName(mtName);
         mimeTypes.append(mt.name());
         mimeTypes.append(mt.aliases());
@@ -16,6 +16,7 @@
 #include <QUrl>
 #include <QAction>
 #include <QMenu>
+#include <QSet>
 
 namespace dfmplugin_menu {
 
@@ -39,11 +40,37 @@ public:
     static QStringList splitCommand(const QString &cmd);
 
 private:
-    static bool isMimeTypeSupport(const QString &mt, const QStringList &fileMimeTypes);
-    static bool isMimeTypeMatch(const QStringList &fileMimeTypes, const QStringList &supportMimeTypes);
-    static bool isSchemeSupport(const DCustomActionEntry &action, const QUrl &url);
-    static bool isSuffixSupport(const DCustomActionEntry &action, FileInfoPointer fileInfo);
-    static void appendAllMimeTypes(const FileInfoPointer &fileInfo, QStringList &noParentmimeTypes, QStringList &allMimeTypes);
+    // 预先编译的菜单项匹配条件，类型和后缀均已转为小写
+    struct ActionMatcher
+    {
+        bool allSchemes { true };
+        QSet<QString> schemes;
+        bool allSuffixes { true };
+        QSet<QString> suffixes;
+        QStringList suffixPrefixes;   // 例如：7z.* 的 7z.
+        QSet<QString> excludeMimeTypes;
+        QStringList excludeMimePrefixes;
+        bool allMimeTypes { true };
+        QSet<QString> mimeTypes;
+        QStringList mimePrefixes;   // 例如：image/* 的 image/
+    };
+
+    // 协议、后缀和文件类型都相同的选中项匹配结果相同
+    struct SelectionClass
+    {
+        QString scheme;
+        bool isDir { false };
+        QString completeSuffix;
+        QStringList mimeTypesNoParent;
+        QStringList allMimeTypes;
+    };
+
+    static ActionMatcher compileMatcher(const DCustomActionEntry &action);
+    static void compileMimeTypes(const QStringList &mimeTypes, QSet<QString> *types, QStringList *prefixes);
+    static bool isActionMatch(const ActionMatcher &matcher, const SelectionClass &selection);
+    static bool isMimeTypeMatch(const QStringList &fileMimeTypes, const QSet<QString> &types, const QStringList &prefixes);
+    static bool isSuffixSupport(const ActionMatcher &matcher, const SelectionClass &selection);
+    static void appendAllMimeTypes(const QMimeType &mimeType, QStringList &noParentmimeTypes, QStringList &allMimeTypes);
     static void appendParentMimeType(const QStringList &parentmimeTypes, QStringList &mimeTypes);
 
 protected:
@@ -12,22 +12,54 @@
 #include <dfm-base/utils/protocolutils.h>
 
 #include <QCoreApplication>
+#include <QCryptographicHash>
 #include <QThread>
 #include <QDebug>
 #include <QFile>
 #include <QXmlStreamReader>
 #include <QUrl>
 
+#include <sys/stat.h>
+
 SERVERRECENTMANAGER_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
 using namespace GlobalServerDefines;
 
+namespace {
+constexpr char kBookmarkStart[] { "<bookmark " };
+constexpr char kBookmarkEnd[] { "</bookmark>" };
+constexpr char kHrefAttr[] { " href=\"" };
+constexpr char kXbelEnd[] { "</xbel>" };
+
+QByteArray extractHref(const QByteArray &chunk, int tagEnd)
+{
+    const int begin = chunk.indexOf(kHrefAttr);
+    if (begin < 0 || begin > tagEnd)
+        return {};
+
+    const int valueBegin = begin + int(sizeof(kHrefAttr)) - 1;
+    const int valueEnd = chunk.indexOf('"', valueBegin);
+    if (valueEnd < 0 || valueEnd > tagEnd)
+        return {};
+
+    return chunk.mid(valueBegin, valueEnd - valueBegin);
+}
+
+QByteArray chunkHash(const QByteArray &chunk)
+{
+    // 误判为未变会保留过期的条目，用 SHA-1 而不是 qHash
+    return QCryptographicHash::hash(chunk, QCryptographicHash::Sha1);
+}
+}   // namespace
+
 RecentIterateWorker::RecentIterateWorker(QObject *parent)
     : QObject(parent)
 {
 }
 
 // 对 xbel 的增删改都会触发本函数重新扫描 xbel 文件
+// 文件未变化时不再解析；变化时按 <bookmark> 元素切分，只解析原文有变化的元素，
+// 其余沿用上次的结果，只重新检查文件是否存在
 void RecentIterateWorker::onRequestReload(const QString &xbelPath, qint64 timestamp)
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
@@ -35,40 +67,119 @@ void RecentIterateWorker::onRequestReload(const QString &xbelPath, qint64 timest
         emit reloadFinished(timestamp);
     });
 
+    XbelState state;
+    if (!readXbelState(xbelPath, &state)) {
+        fmCritical() << "[RecentIterateWorker::onRequestReload] Failed to stat recent file:" << xbelPath;
+        return;
+    }
+
+    if (state == lastState) {
+        fmDebug() << "[RecentIterateWorker::onRequestReload] Recent file unchanged, revalidating cached items only";
+        revalidateEntries();
+        applyEntries();
+        return;
+    }
+
     QFile file(xbelPath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         fmCritical() << "[RecentIterateWorker::onRequestReload] Failed to open recent file:" << xbelPath;
         return;
     }
     fmDebug() << "[RecentIterateWorker::onRequestReload] Successfully opened recent file:" << xbelPath;
 
-    QStringList curPathList;
-    const QStringList cachedPathList = itemsInfo.keys();
+    const QByteArray content = file.readAll();
+    file.close();
+    if (!content.trimmed().endsWith(kXbelEnd) && !content.trimmed().isEmpty()) {
+        // 文件正在被写入，等待下一次变化通知
+        fmWarning() << "[RecentIterateWorker::onRequestReload] Incomplete recent file, skip:" << xbelPath;
+        return;
+    }
 
-    QXmlStreamReader reader(&file);
-    while (!reader.atEnd() && !reader.hasError()) {
-        if (reader.readNext() == QXmlStreamReader::EndDocument)
-            continue;
+    QHash<QByteArray, BookmarkEntry> curBookmarks;
+    curBookmarks.reserve(bookmarks.size());
+    QVector<QByteArray> curOrder;
+    curOrder.reserve(bookmarkOrder.size());
+    int parsedCount = 0;
+
+    int pos = 0;
+    while ((pos = content.indexOf(kBookmarkStart, pos)) >= 0) {
+        const int begin = pos;
+        const int tagEnd = content.indexOf('>', begin);
+        if (tagEnd < 0)
+            break;
+
+        int end = tagEnd + 1;
+        if (content.at(tagEnd - 1) != '/') {
+            const int closeTag = content.indexOf(kBookmarkEnd, tagEnd);
+            if (closeTag < 0)
+                break;
+            end = closeTag + int(sizeof(kBookmarkEnd)) - 1;
+        }
+
+        const QByteArray chunk = QByteArray::fromRawData(content.constData() + begin, end - begin);
+        pos = end;
 
-        if (!reader.isStartElement() || reader.name() != QString("bookmark"))
+        const QByteArray href = extractHref(chunk, tagEnd - begin);
+        if (href.isEmpty())
             continue;
 
-        processBookmarkElement(reader, curPathList);
+        const QByteArray &hash = chunkHash(chunk);
+        BookmarkEntry entry;
+        auto cached = bookmarks.constFind(href);
+        if (cached != bookmarks.constEnd() && cached->hash == hash) {
+            entry = cached.value();
+            if (!entry.bindPath.isEmpty())
+                validateEntry(&entry);
+        } else {
+            if (!parseBookmarkChunk(chunk, &entry))
+                continue;
+            entry.hash = hash;
+            ++parsedCount;
+        }
+
+        if (!curBookmarks.contains(href))
+            curOrder.append(href);
+        curBookmarks.insert(href, entry);
     }
 
-    if (reader.hasError()) {
-        fmCritical() << "[RecentIterateWorker::onRequestReload] Error reading recent XML file:" << xbelPath 
-                     << "error:" << reader.errorString();
-        return;
+    bookmarks.swap(curBookmarks);
+    bookmarkOrder.swap(curOrder);
+    lastState = state;
+
+    fmInfo() << "[RecentIterateWorker::onRequestReload] Successfully processed recent file:" << xbelPath
+             << "bookmarks:" << bookmarkOrder.size() << "parsed:" << parsedCount << "cached items:" << itemsInfo.size();
+
+    applyEntries();
+}
+
+bool RecentIterateWorker::readXbelState(const QString &xbelPath, XbelState *state) const
+{
+    struct stat st;
+    if (::stat(QFile::encodeName(xbelPath).constData(), &st) != 0)
+        return false;
+
+    state->inode = st.st_ino;
+    state->size = st.st_size;
+    state->mtimeNsec = qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    return true;
+}
+
+bool RecentIterateWorker::parseBookmarkChunk(const QByteArray &chunk, BookmarkEntry *entry) const
+{
+    // 单独的元素片段中子元素的命名空间前缀未声明，只读取 bookmark 自身的属性
+    QXmlStreamReader reader(chunk);
+    while (!reader.atEnd()) {
+        if (reader.readNext() != QXmlStreamReader::StartElement)
+            continue;
+        if (reader.name() != QString("bookmark"))
+            return false;
+        return parseBookmarkElement(reader, entry);
     }
-    
-    fmInfo() << "[RecentIterateWorker::onRequestReload] Successfully processed recent file:" << xbelPath 
-             << "current items:" << curPathList.size() << "cached items:" << cachedPathList.size();
 
-    removeOutdatedItems(cachedPathList, curPathList);
+    return false;
 }
 
-void RecentIterateWorker::processBookmarkElement(QXmlStreamReader &reader, QStringList &curPathList)
+bool RecentIterateWorker::parseBookmarkElement(QXmlStreamReader &reader, BookmarkEntry *entry) const
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
 
@@ -76,47 +187,77 @@ void RecentIterateWorker::processBookmarkElement(QXmlStreamReader &reader, QStri
     const QString readTime = reader.attributes().value("modified").toString();
 
     if (location.isEmpty())
-        return;
+        return false;
 
+    // 非本地文件同样记录下来，原文未变时不必再次判断
     const QUrl url(location);
-    if (!url.isLocalFile())
-        return;
-    if (ProtocolUtils::isRemoteFile(url))
-        return;
+    if (!url.isLocalFile() || ProtocolUtils::isRemoteFile(url))
+        return true;
+
+    entry->localPath = QFileInfo(url.toLocalFile()).absoluteFilePath();
+    entry->bindPath = FileUtils::bindPathTransform(entry->localPath, false);
+    entry->item = { location, QDateTime::fromString(readTime, Qt::ISODate).toSecsSinceEpoch() };
+    validateEntry(entry);
+    return true;
+}
 
-    QFileInfo info(url.toLocalFile());
-    if (!info.exists() || !info.isFile())
-        return;
+void RecentIterateWorker::validateEntry(BookmarkEntry *entry) const
+{
+    const QFileInfo info(entry->localPath);
+    entry->exists = info.exists() && info.isFile();
+}
+
+void RecentIterateWorker::revalidateEntries()
+{
+    for (auto it = bookmarks.begin(); it != bookmarks.end(); ++it) {
+        if (!it->bindPath.isEmpty())
+            validateEntry(&it.value());
+    }
+}
 
-    const auto bindPath = FileUtils::bindPathTransform(info.absoluteFilePath(), false);
-    qint64 readTimeSecs = QDateTime::fromString(readTime, Qt::ISODate).toSecsSinceEpoch();
+void RecentIterateWorker::applyEntries()
+{
+    Q_ASSERT(qApp->thread() != QThread::currentThread());
+
+    QSet<QString> curPaths;
+    curPaths.reserve(bookmarkOrder.size());
+    for (const auto &href : qAsConst(bookmarkOrder)) {
+        const BookmarkEntry &entry = bookmarks.constFind(href).value();
+        if (entry.bindPath.isEmpty() || !entry.exists)
+            continue;
 
-    curPathList.append(bindPath);
-    if (itemsInfo.contains(bindPath)) {
-        if (itemsInfo[bindPath].modified != readTimeSecs) {
-            fmDebug() << "[RecentIterateWorker::processBookmarkElement] Item modified:" << bindPath 
-                      << "old time:" << itemsInfo[bindPath].modified << "new time:" << readTimeSecs;
-            itemsInfo[bindPath].modified = readTimeSecs;
-            emit itemChanged(bindPath, itemsInfo[bindPath]);
+        const QString &bindPath = entry.bindPath;
+        curPaths.insert(bindPath);
+        auto it = itemsInfo.find(bindPath);
+        if (it != itemsInfo.end()) {
+            if (it->modified != entry.item.modified) {
+                fmDebug() << "[RecentIterateWorker::applyEntries] Item modified:" << bindPath
+                          << "old time:" << it->modified << "new time:" << entry.item.modified;
+                it->modified = entry.item.modified;
+                emit itemChanged(bindPath, it.value());
+            }
+        } else {
+            fmDebug() << "[RecentIterateWorker::applyEntries] New item added:" << bindPath
+                      << "modified time:" << entry.item.modified;
+            itemsInfo.insert(bindPath, entry.item);
+            emit itemAdded(bindPath, entry.item);
         }
-    } else {
-        fmDebug() << "[RecentIterateWorker::processBookmarkElement] New item added:" << bindPath 
-                  << "modified time:" << readTimeSecs;
-        RecentItem item { location, readTimeSecs };
-        itemsInfo.insert(bindPath, item);
-        emit itemAdded(bindPath, item);
     }
+
+    removeOutdatedItems(curPaths);
 }
 
-void RecentIterateWorker::removeOutdatedItems(const QStringList &cachedPathList, const QStringList &curPathList)
+void RecentIterateWorker::removeOutdatedItems(const QSet<QString> &curPaths)
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
 
     QStringList removedPathList;
-    for (const auto &cachedPath : cachedPathList) {
-        if (!curPathList.contains(cachedPath)) {
-            itemsInfo.remove(cachedPath);
-            removedPathList << cachedPath;
+    for (auto it = itemsInfo.begin(); it != itemsInfo.end();) {
+        if (!curPaths.contains(it.key())) {
+            removedPathList << it.key();
+            it = itemsInfo.erase(it);
+        } else {
+            ++it;
         }
     }
 
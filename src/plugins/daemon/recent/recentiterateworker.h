@@ -10,6 +10,9 @@
 #include <DRecentManager>
 
 #include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QVector>
 #include <QXmlStreamReader>
 
 SERVERRECENTMANAGER_BEGIN_NAMESPACE
@@ -34,11 +37,43 @@ Q_SIGNALS:
     void itemChanged(const QString &path, const RecentItem &item);
 
 private:
-    void processBookmarkElement(QXmlStreamReader &reader, QStringList &curPathList);
-    void removeOutdatedItems(const QStringList &cachedPathList, const QStringList &curPathList);
+    // 一个 <bookmark> 元素的解析结果，以元素原文的哈希判断是否变化
+    struct BookmarkEntry
+    {
+        QByteArray hash;
+        QString localPath;
+        QString bindPath;   // 为空表示不是本地文件
+        RecentItem item;
+        bool exists { false };
+    };
+
+    // 上次解析时 xbel 文件的状态，未变化时跳过解析
+    struct XbelState
+    {
+        quint64 inode { 0 };
+        qint64 size { -1 };
+        qint64 mtimeNsec { -1 };
+
+        bool operator==(const XbelState &other) const
+        {
+            return inode == other.inode && size == other.size && mtimeNsec == other.mtimeNsec;
+        }
+    };
+
+    bool readXbelState(const QString &xbelPath, XbelState *state) const;
+    bool parseBookmarkChunk(const QByteArray &chunk, BookmarkEntry *entry) const;
+    bool parseBookmarkElement(QXmlStreamReader &reader, BookmarkEntry *entry) const;
+    void validateEntry(BookmarkEntry *entry) const;
+    void revalidateEntries();
+    void applyEntries();
+    void removeOutdatedItems(const QSet<QString> &curPaths);
 
 private:
     QMap<QString, RecentItem> itemsInfo;
+
+    QHash<QByteArray, BookmarkEntry> bookmarks;   // href 原文 -> 解析结果
+    QVector<QByteArray> bookmarkOrder;   // 文件中的书签顺序
+    XbelState lastState;
 };
 
 SERVERRECENTMANAGER_END_NAMESPACE
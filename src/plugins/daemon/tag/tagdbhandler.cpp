@@ -17,6 +17,7 @@
 
 #include <QDir>
 #include <QFile>
+#include <QHash>
 #include <QDebug>
 #include <QProcess>
 #include <QVariant>
@@ -26,6 +27,22 @@ DAEMONPTAG_BEGIN_NAMESPACE
 
 static constexpr char kTagTableFileTags[] = "file_tags";
 static constexpr char kTagTableTagProperty[] = "tag_property";
+// 单条 IN 查询携带的最大参数数量，避免语句过长
+static constexpr int kBatchSize = 500;
+
+static QList<QVariantList> splitBatches(const QStringList &values)
+{
+    QList<QVariantList> batches;
+    for (int i = 0; i < values.size(); i += kBatchSize) {
+        QVariantList batch;
+        const int end = qMin(i + kBatchSize, values.size());
+        batch.reserve(end - i);
+        for (int j = i; j < end; ++j)
+            batch.append(values.at(j));
+        batches.append(batch);
+    }
+    return batches;
+}
 
 TagDbHandler *TagDbHandler::instance()
 {
@@ -65,11 +82,13 @@ QVariantMap TagDbHandler::getTagsColor(const QStringList &tags)
     // query
     const auto &field = Expression::Field<TagProperty>;
     QVariantMap tagColorsMap;
-    for (auto &tag : tags) {
-        const auto &beanList = handle->query<TagProperty>().where(field("tagName") == tag).toBeans();
-        const auto &color = beanList.isEmpty() ? "" : beanList.first()->getTagColor();
-        if (!color.isEmpty())
-            tagColorsMap.insert(tag, QVariant { QVariant { color } });
+    for (const auto &batch : splitBatches(tags)) {
+        const auto &beanList = handle->query<TagProperty>().where(Expression::in(field("tagName"), batch)).toBeans();
+        for (const auto &bean : beanList) {
+            const auto &color = bean->getTagColor();
+            if (!color.isEmpty() && !tagColorsMap.contains(bean->getTagName()))
+                tagColorsMap.insert(bean->getTagName(), QVariant { color });
+        }
     }
 
     fmDebug() << "TagDbHandler::getTagsColor: Retrieved colors for" << tagColorsMap.size() << "out of" << tags.size() << "requested tags";
@@ -86,20 +105,22 @@ QVariantMap TagDbHandler::getTagsByUrls(const QStringList &urlList)
         return {};
     }
 
-    // query
+    // 按批使用 IN 查询，结果按文件汇总，保持每个文件内标记的插入顺序
     const auto &field = Expression::Field<FileTagInfo>;
-    QVariantMap allFileTags;
-    for (auto &path : urlList) {
-        const auto &beanList = handle->query<FileTagInfo>().where(field("filePath") == path).toBeans();
-
-        QStringList fileTags;
-        for (auto oneBean : beanList)
-            fileTags.append(oneBean->getTagName());
-
-        if (!fileTags.isEmpty())
-            allFileTags.insert(path, fileTags);
+    QHash<QString, QStringList> fileTagsHash;
+    for (const auto &batch : splitBatches(urlList)) {
+        const auto &beanList = handle->query<FileTagInfo>()
+                                       .where(Expression::in(field("filePath"), batch))
+                                       .orderBy(field("fileIndex"))
+                                       .toBeans();
+        for (const auto &bean : beanList)
+            fileTagsHash[bean->getFilePath()].append(bean->getTagName());
     }
 
+    QVariantMap allFileTags;
+    for (auto it = fileTagsHash.cbegin(); it != fileTagsHash.cend(); ++it)
+        allFileTags.insert(it.key(), it.value());
+
     fmDebug() << "TagDbHandler::getTagsByUrls: Retrieved tags for" << allFileTags.size() << "out of" << urlList.size() << "requested files";
     finally.dismiss();
     return allFileTags;
@@ -149,16 +170,21 @@ QVariantMap TagDbHandler::getFilesByTag(const QStringList &tags)
 
     // query
     const auto &field = Expression::Field<FileTagInfo>;
-    QVariantMap allTagFiles;
-    for (auto &tag : tags) {
-        const auto &obj = handle->query<FileTagInfo>().where(field("tagName") == tag).toBeans();
-        QStringList files;
-        for (auto tempBean : obj)
-            files.append(tempBean->getFilePath());
-
-        allTagFiles.insert(tag, QVariant { files });
+    QHash<QString, QStringList> tagFilesHash;
+    for (const auto &batch : splitBatches(tags)) {
+        const auto &beanList = handle->query<FileTagInfo>()
+                                       .where(Expression::in(field("tagName"), batch))
+                                       .orderBy(field("fileIndex"))
+                                       .toBeans();
+        for (const auto &bean : beanList)
+            tagFilesHash[bean->getTagName()].append(bean->getFilePath());
     }
 
+    // 没有文件的标记也返回空列表
+    QVariantMap allTagFiles;
+    for (const auto &tag : tags)
+        allTagFiles.insert(tag, QVariant { tagFilesHash.value(tag) });
+
     fmDebug() << "TagDbHandler::getFilesByTag: Retrieved files for" << tags.size() << "tags";
     finally.dismiss();
     return allTagFiles;
@@ -258,16 +284,7 @@ bool TagDbHandler::addTagsForFiles(const QVariantMap &data)
     }
 
     // insert file--tags
-    bool ret = handle->transaction([tmpData, this]() -> bool {
-        for (auto dataIt = tmpData.begin(); dataIt != tmpData.end(); ++dataIt) {
-            bool ret = tagFile(dataIt.key(), dataIt.value());
-            if (!ret) {
-                fmCritical() << "TagDbHandler::addTagsForFiles: Failed to tag file:" << dataIt.key();
-                return ret;
-            }
-        }
-        return true;
-    });
+    bool ret = tagFiles(tmpData);
 
     if (!ret) {
         fmCritical() << "TagDbHandler::addTagsForFiles: Transaction failed while adding tags for files";
@@ -362,12 +379,19 @@ bool TagDbHandler::deleteFiles(const QStringList &urls)
     fmInfo() << "TagDbHandler::deleteFiles: Deleting tag information for" << urls.size() << "files";
 
     auto field = Expression::Field<FileTagInfo>;
-    for (const auto &url : urls) {
-        if (!handle->remove<FileTagInfo>(field("filePath") == url)) {
-            fmCritical() << "TagDbHandler::deleteFiles: Failed to delete tag information for file:" << url;
-            return false;
+    const auto &batches = splitBatches(urls);
+    bool ret = handle->transaction([&batches, &field, this]() -> bool {
+        for (const auto &batch : batches) {
+            if (!handle->remove<FileTagInfo>(Expression::in(field("filePath"), batch))) {
+                fmCritical() << "TagDbHandler::deleteFiles: Failed to delete tag information for files:" << batch.first().toString() << "...";
+                return false;
+            }
         }
-    }
+        return true;
+    });
+
+    if (!ret)
+        return false;
 
     fmInfo() << "TagDbHandler::deleteFiles: Successfully deleted tag information for" << urls.size() << "files";
     finally.dismiss();
@@ -493,6 +517,8 @@ void TagDbHandler::initialize()
     const auto &dbFilePath = DFMUtils::buildFilePath(dbPath.toLocal8Bit(),
                                                      Global::DataBase::kDfmDBName,
                                                      nullptr);
+    // 标记数据库由守护进程持有，读写并发时使用 WAL
+    SqliteConnectionPool::instance().enableWriteAheadLog(dbFilePath);
     handle.reset(new SqliteHandle(dbFilePath));
     QSqlDatabase db { SqliteConnectionPool::instance().openConnection(dbFilePath) };
     if (!db.isValid() || db.isOpenError()) {
@@ -513,6 +539,8 @@ void TagDbHandler::initialize()
         fmDebug() << "TagDbHandler::initialize: Table created or verified:" << kTagTableTagProperty;
     }
 
+    createIndexes();
+
     fmInfo() << "TagDbHandler::initialize: Tag database handler initialized successfully";
 }
 
@@ -538,6 +566,21 @@ bool TagDbHandler::createTable(const QString &tableName)
     return ret;
 }
 
+void TagDbHandler::createIndexes()
+{
+    // 按路径、标记名的查询和路径前缀替换都依赖索引，旧数据库升级后同样补建
+    static const QStringList kIndexSqls {
+        QString("CREATE INDEX IF NOT EXISTS idx_file_tags_filePath ON %1(filePath);").arg(kTagTableFileTags),
+        QString("CREATE INDEX IF NOT EXISTS idx_file_tags_tagName ON %1(tagName);").arg(kTagTableFileTags),
+        QString("CREATE INDEX IF NOT EXISTS idx_tag_property_tagName ON %1(tagName);").arg(kTagTableTagProperty)
+    };
+
+    for (const auto &sql : kIndexSqls) {
+        if (!handle->excute(sql))
+            fmWarning() << "TagDbHandler::createIndexes: Failed to create index:" << sql;
+    }
+}
+
 bool TagDbHandler::checkTag(const QString &tag)
 {
     return handle->query<TagProperty>().where(Expression::Field<TagProperty>("tagName") == tag).toBeans().size() > 0;
@@ -571,38 +614,40 @@ bool TagDbHandler::insertTagProperty(const QString &name, const QVariant &value)
     return true;
 }
 
-bool TagDbHandler::tagFile(const QString &file, const QVariant &tags)
+bool TagDbHandler::tagFiles(const QVariantMap &fileTags)
 {
     DFMBASE_NAMESPACE::FinallyUtil finally([&]() { lastErr.clear(); });
 
-    if (file.isEmpty() || tags.isNull()) {
-        lastErr = "input parameter is empty!";
-        fmWarning() << "TagDbHandler::tagFile: Empty parameters provided - file:" << file << "tags:" << tags;
-        return false;
-    }
+    QList<QSharedPointer<FileTagInfo>> beans;
+    for (auto it = fileTags.begin(); it != fileTags.end(); ++it) {
+        if (it.key().isEmpty() || it.value().isNull()) {
+            lastErr = "input parameter is empty!";
+            fmWarning() << "TagDbHandler::tagFiles: Empty parameters provided - file:" << it.key() << "tags:" << it.value();
+            return false;
+        }
 
-    // insert file--tags
-    const QStringList &tempTags = tags.toStringList();
-    int suc = tempTags.count();
-    for (const auto &tag : tempTags) {
-        FileTagInfo temp;
-        temp.setFilePath(file);
-        temp.setTagName(tag);
-        temp.setTagOrder(0);
-        temp.setFuture("null");
-        if (-1 == handle->insert<FileTagInfo>(temp)) {
-            fmCritical() << "TagDbHandler::tagFile: Failed to insert file tag - file:" << file << "tag:" << tag;
-            break;
+        const QStringList &tempTags = it.value().toStringList();
+        for (const auto &tag : tempTags) {
+            QSharedPointer<FileTagInfo> temp { new FileTagInfo };
+            temp->setFilePath(it.key());
+            temp->setTagName(tag);
+            temp->setTagOrder(0);
+            temp->setFuture("null");
+            beans.append(temp);
         }
-        suc--;
     }
 
-    if (0 < suc) {
-        lastErr = QString("Tag file failed! file: %1, tagName: %2").arg(file).arg(tempTags.at(--suc));
+    // insert file--tags，所有文件的标记在一个事务中写入
+    bool ret = handle->transaction([&beans, this]() -> bool {
+        return handle->insertBatch<FileTagInfo>(beans);
+    });
+    if (!ret) {
+        lastErr = QString("Tag files failed! files: %1").arg(fileTags.keys().join(","));
+        fmCritical() << "TagDbHandler::tagFiles: Failed to insert file tags for" << fileTags.size() << "files";
         return false;
     }
 
-    fmDebug() << "TagDbHandler::tagFile: Successfully tagged file:" << file << "with" << tempTags.size() << "tags";
+    fmDebug() << "TagDbHandler::tagFiles: Successfully inserted" << beans.size() << "tags for" << fileTags.size() << "files";
     finally.dismiss();
     return true;
 }
@@ -706,8 +751,38 @@ bool TagDbHandler::changeFilePath(const QString &oldPath, const QString &newPath
         return false;
     }
 
+    // 一条语句同时替换该路径及其所有子路径的前缀，目录重命名后子文件的标记随之更新
+    // 子路径用 [old/, old0) 的范围匹配（'0' 紧随 '/'），可以走索引且不受 LIKE 通配符影响
+    auto trimmed = [](QString path) {
+        while (path.size() > 1 && path.endsWith('/'))
+            path.chop(1);
+        return path;
+    };
+    const QString &oldPrefix { trimmed(oldPath) };
+    const QString &newPrefix { trimmed(newPath) };
+    // 根目录的子路径以 "/" 开头而不是 "//"，拼接时父路径部分按空串处理
+    const QString &oldBase { oldPrefix == "/" ? QString("") : oldPrefix };
+    const QString &newBase { newPrefix == "/" ? QString("") : newPrefix };
+    const QString &childLower { oldBase + '/' };
+    const QString &childUpper { oldBase + '0' };
+
+    QString newValue;
+    QString newBaseValue;
+    QString oldValue;
+    QString oldBaseValue;
+    SerializationHelper::serialize(&newValue, newPrefix);
+    SerializationHelper::serialize(&newBaseValue, newBase);
+    SerializationHelper::serialize(&oldValue, oldPrefix);
+    SerializationHelper::serialize(&oldBaseValue, oldBase);
+    const Expression::SetExpr setExpr { QString("filePath=CASE WHEN filePath=%1 THEN %2 ELSE %3||substr(filePath,length(%4)+1) END")
+                                                .arg(oldValue, newValue, newBaseValue, oldBaseValue),
+                                        "filePath=CASE WHEN filePath=? THEN ? ELSE ?||substr(filePath,length(?)+1) END",
+                                        { oldPrefix, newPrefix, newBase, oldBase } };
+
     const auto &field = Expression::Field<FileTagInfo>;
-    if (!handle->update<FileTagInfo>(field("filePath") = newPath, field("filePath") == oldPath)) {
+    const auto &whereExpr = (field("filePath") == oldPrefix)
+            || ((field("filePath") >= childLower) && (field("filePath") < childUpper));
+    if (!handle->update<FileTagInfo>(setExpr, whereExpr)) {
         lastErr = QString("Change file path failed! oldPath: %1, newPath: %2").arg(oldPath).arg(newPath);
         fmCritical() << "TagDbHandler::changeFilePath: Failed to update file path - oldPath:" << oldPath << "newPath:" << newPath;
         return false;
@@ -61,9 +61,10 @@ private:
     explicit TagDbHandler(QObject *parent = nullptr);
     void initialize();
     bool createTable(const QString &tableName);
+    void createIndexes();
     bool checkTag(const QString &tag);
     bool insertTagProperty(const QString &name, const QVariant &value);
-    bool tagFile(const QString &file, const QVariant &tags);
+    bool tagFiles(const QVariantMap &fileTags);
     bool removeSpecifiedTagOfFile(const QString &url, const QVariant &val);
     bool changeTagColor(const QString &tagName, const QString &newTagColor);
     bool changeTagNameWithFile(const QString &tagName, const QString &newName);
@@ -101,7 +101,7 @@ CanvasItemDelegate::CanvasItemDelegate(QAbstractItemView *parentPtr)
     setIconLevel(iconLv);
     d->textLineHeight = parent()->fontMetrics().height();
 
-    connect(ClipBoard::instance(), &ClipBoard::clipboardDataChanged, this, &CanvasItemDelegate::clipboardDataChanged);
+    connect(ClipBoard::instance(), &ClipBoard::cutStateChanged, this, &CanvasItemDelegate::clipboardCutStateChanged);
 }
 
 CanvasItemDelegate::~CanvasItemDelegate()
@@ -418,7 +418,7 @@ bool CanvasItemDelegate::isTransparent(const QModelIndex &index) const
         if (!file.get())
             return false;
 
-        if (ClipBoard::instance()->clipboardFileUrlList().contains(file->urlOf(UrlInfoType::kUrl)))
+        if (ClipBoard::instance()->isCutUrl(file->urlOf(UrlInfoType::kUrl)))
             return true;
     }
     return false;
@@ -664,7 +664,7 @@ void CanvasItemDelegate::revertAndcloseEditor()
         view->closePersistentEditor(index);
 }
 
-void CanvasItemDelegate::clipboardDataChanged()
+void CanvasItemDelegate::clipboardCutStateChanged(const QList<QUrl> &urls)
 {
     auto index = parent()->currentIndex();
     if (parent()->isPersistentEditorOpen(index)) {
@@ -672,7 +672,13 @@ void CanvasItemDelegate::clipboardDataChanged()
             wid->setOpacity(isTransparent(index) ? 0.3 : 1);
     }
 
-    parent()->update();
+    // only repaint the items whose cut state is changed.
+    auto model = parent()->model();
+    for (const QUrl &url : urls) {
+        const QModelIndex &changed = model->index(url);
+        if (changed.isValid())
+            parent()->update(changed);
+    }
 }
 
 void CanvasItemDelegate::initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const
@@ -83,7 +83,7 @@ public slots:
     void commitDataAndCloseEditor();
     void revertAndcloseEditor();
 protected slots:
-    void clipboardDataChanged();
+    void clipboardCutStateChanged(const QList<QUrl> &urls);
 
 public:
     static const int kTextPadding;
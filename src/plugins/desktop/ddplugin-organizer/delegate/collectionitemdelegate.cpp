@@ -411,7 +411,7 @@ bool CollectionItemDelegate::isTransparent(const QModelIndex &index) const
         if (!file.get())
             return false;
 
-        if (ClipBoard::instance()->clipboardFileUrlList().contains(file->urlOf(UrlInfoType::kUrl)))
+        if (ClipBoard::instance()->isCutUrl(file->urlOf(UrlInfoType::kUrl)))
             return true;
     }
     return false;
@@ -84,12 +84,10 @@ void SearchDirIteratorPrivate::doSearch()
 void SearchDirIteratorPrivate::onMatched(const QString &id)
 {
     if (taskId == id) {
-        // 直接在主线程更新结果，但使用高效的双缓冲机制
-        const auto &results = SearchManager::instance()->matchedResults(taskId);
-        if (!results.isEmpty()) {
-            resultBuffer.updateResults(results);
-            hasConsumedResults.store(false, std::memory_order_release);   // 标记有新数据
-        }
+        // 只取上次之后新增或更新的结果
+        const auto &results = SearchManager::instance()->matchedResultsSince(taskId, resultSequence, &resultSequence);
+        if (!results.isEmpty())
+            resultBuffer.appendResults(results);
 
         // 通知等待的消费者
         QMutexLocker lk(&waitMutex);
@@ -176,25 +174,18 @@ QList<QSharedPointer<SortFileInfo>> SearchDirIterator::sortFileInfoList()
     // 等待搜索结果或搜索完成/停止
     {
         QMutexLocker lk(&d->waitMutex);
-        while ((d->resultBuffer.isEmpty() || d->hasConsumedResults.load(std::memory_order_acquire)) && !d->searchStoped.load(std::memory_order_acquire)) {
+        while (d->resultBuffer.isEmpty() && !d->searchStoped.load(std::memory_order_acquire)) {
             if (d->searchFinished.load(std::memory_order_acquire))
                 break;
             d->resultWaitCond.wait(&d->waitMutex);
         }
     }
 
-    // 修复：搜索完成时，仍需检查是否有未消费的结果
-    // 只有在搜索完成且缓冲区为空且已消费过结果的情况下才返回空
-    if (d->searchFinished.load(std::memory_order_acquire) && d->resultBuffer.isEmpty() && d->hasConsumedResults.load(std::memory_order_acquire))
-        return {};
-
+    // 每次只处理新增或更新的结果，已有条目由视图按 URL 更新
     const auto results = d->resultBuffer.consumeResults();
-
-    // 如果没有新结果且搜索已完成，返回空
-    if (results.isEmpty() && d->searchFinished.load(std::memory_order_acquire))
+    if (results.isEmpty())
         return {};
 
-    // TODO (perf) : 存在性能问题，重复获取全量数据
     // 在子线程中处理数据，不影响主线程
     // 使用两个QList分别装载文件夹和文件，然后合并
     // 时间复杂度：O(n)，空间复杂度：O(n)，性能优于stable_partition
@@ -206,10 +197,10 @@ QList<QSharedPointer<SortFileInfo>> SearchDirIterator::sortFileInfoList()
     dirs.reserve(totalCount / 4);   // 估算文件夹占比约25%
     files.reserve(totalCount);   // 文件可能占大部分
 
-    for (auto it = results.begin(); it != results.end(); ++it) {
+    for (const auto &searchResult : results) {
         auto sortInfo = QSharedPointer<SortFileInfo>(new SortFileInfo());
-        sortInfo->setUrl(it.key());
-        sortInfo->setHighlightContent(it->highlightedContent());
+        sortInfo->setUrl(searchResult.url());
+        sortInfo->setHighlightContent(searchResult.highlightedContent());
         doCompleteSortInfo(sortInfo);
 
         if (sortInfo->isDir()) {
@@ -223,9 +214,6 @@ QList<QSharedPointer<SortFileInfo>> SearchDirIterator::sortFileInfoList()
     result = std::move(dirs);
     result.append(files);
 
-    // 标记结果已被消费，避免重复处理
-    d->hasConsumedResults.store(true, std::memory_order_release);
-
     return result;
 }
 
@@ -302,42 +290,24 @@ void SearchDirIterator::doCompleteSortInfo(SortInfoPointer sortInfo)
 
 // ======== SearchResultBuffer 实现 ========
 
-void SearchResultBuffer::updateResults(const DFMSearchResultMap &newResults)
+void SearchResultBuffer::appendResults(const DFMSearchResultList &newResults)
 {
-    QMutexLocker lock(&writerMutex);
-
-    // 写入非活跃缓冲区
-    if (useBufferA.load(std::memory_order_acquire)) {
-        bufferB = newResults;
-        useBufferA.store(false, std::memory_order_release);   // 原子切换
-    } else {
-        bufferA = newResults;
-        useBufferA.store(true, std::memory_order_release);   // 原子切换
-    }
+    QMutexLocker lock(&mutex);
+    pending.append(newResults);
 }
 
-DFMSearchResultMap SearchResultBuffer::getResults() const
+DFMSearchResultList SearchResultBuffer::consumeResults()
 {
-    // 无锁读取活跃缓冲区
-    return useBufferA.load(std::memory_order_acquire) ? bufferA : bufferB;
-}
-
-DFMSearchResultMap SearchResultBuffer::consumeResults()
-{
-    QMutexLocker lock(&writerMutex);
-    DFMSearchResultMap results;
-    if (useBufferA.load(std::memory_order_acquire)) {
-        results.swap(bufferA);
-    } else {
-        results.swap(bufferB);
-    }
+    QMutexLocker lock(&mutex);
+    DFMSearchResultList results;
+    results.swap(pending);
     return results;
 }
 
 bool SearchResultBuffer::isEmpty() const
 {
-    // 检查当前活跃缓冲区是否为空
-    return useBufferA.load(std::memory_order_acquire) ? bufferA.isEmpty() : bufferB.isEmpty();
+    QMutexLocker lock(&mutex);
+    return pending.isEmpty();
 }
 
 }
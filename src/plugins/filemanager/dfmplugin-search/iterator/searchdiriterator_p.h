@@ -24,30 +24,25 @@ DFMBASE_USE_NAMESPACE
 
 namespace dfmplugin_search {
 
-// 双缓冲搜索结果管理器
+// 增量搜索结果缓冲，主线程追加，遍历线程取走
 class SearchResultBuffer
 {
 public:
     SearchResultBuffer() = default;
     ~SearchResultBuffer() = default;
 
-    // 生产者：更新搜索结果（主线程调用）
-    void updateResults(const DFMSearchResultMap &newResults);
+    // 生产者：追加新增或更新的结果（主线程调用）
+    void appendResults(const DFMSearchResultList &newResults);
 
-    // 消费者：获取当前搜索结果快照（子线程调用）
-    DFMSearchResultMap getResults() const;
-
-    // 消费者：获取并清空当前搜索结果（子线程调用）
-    DFMSearchResultMap consumeResults();
+    // 消费者：获取并清空已缓冲的结果（子线程调用）
+    DFMSearchResultList consumeResults();
 
     // 检查是否有数据
     bool isEmpty() const;
 
 private:
-    mutable DFMSearchResultMap bufferA;
-    mutable DFMSearchResultMap bufferB;
-    std::atomic<bool> useBufferA { true };
-    mutable QMutex writerMutex;   // 只保护写操作
+    DFMSearchResultList pending;
+    mutable QMutex mutex;
 };
 
 class SearchDirIterator;
@@ -76,6 +71,7 @@ public:
 
     std::atomic<bool> searchFinished { false };   // 搜索是否完成(原子操作保证线程安全)
     std::atomic<bool> searchStoped { false };   // 搜索是否停止(原子操作保证线程安全)
+    quint64 resultSequence { 0 };   // 已取得的结果序号，只在主线程访问
 
     SearchResultBuffer resultBuffer;   // 双缓冲搜索结果
     QScopedPointer<LocalFileWatcher> searchRootWatcher;   // 文件监视器
@@ -83,7 +79,6 @@ public:
     SearchDirIterator *q = nullptr;   // 指向父类的指针
     QWaitCondition resultWaitCond;
     mutable QMutex waitMutex;   // 只用于等待条件的轻量级锁
-    std::atomic<bool> hasConsumedResults { false };   // 标记结果是否已被消费(原子操作保证线程安全)
 };
 
 }
@@ -71,6 +71,14 @@ DFMSearchResultMap MainController::getResults(QString taskId)
     return {};
 }
 
+DFMSearchResultList MainController::getResultsSince(QString taskId, quint64 since, quint64 *latest)
+{
+    if (taskManager.contains(taskId))
+        return taskManager[taskId]->getResultsSince(since, latest);
+
+    return {};
+}
+
 QList<QUrl> MainController::getResultUrls(QString taskId)
 {
     if (taskManager.contains(taskId))
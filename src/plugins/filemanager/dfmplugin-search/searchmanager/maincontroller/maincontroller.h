@@ -26,6 +26,9 @@ private:
     
     // 获取统一的搜索结果
     DFMSearchResultMap getResults(QString taskId);
+
+    // 获取序号 since 之后的增量结果
+    DFMSearchResultList getResultsSince(QString taskId, quint64 since, quint64 *latest);
     
     // 为兼容性保留的接口
     QList<QUrl> getResultUrls(QString taskId);
@@ -36,14 +36,17 @@ SimplifiedSearchWorker::~SimplifiedSearchWorker()
 
 DFMSearchResultMap SimplifiedSearchWorker::getResults()
 {
-    QReadLocker locker(&rwLock);
-    return resultMap;
+    return resultStore.results();
 }
 
 QList<QUrl> SimplifiedSearchWorker::getResultUrls()
 {
-    QReadLocker locker(&rwLock);
-    return resultMap.keys();
+    return resultStore.urls();
+}
+
+DFMSearchResultList SimplifiedSearchWorker::getResultsSince(quint64 since, quint64 *latest)
+{
+    return resultStore.resultsSince(since, latest);
 }
 
 void SimplifiedSearchWorker::startSearch()
@@ -52,10 +55,7 @@ void SimplifiedSearchWorker::startSearch()
     isRunning = true;
     finishedSearcherCount = 0;
 
-    {
-        QWriteLocker locker(&rwLock);
-        resultMap.clear();
-    }
+    resultStore.clear();
 
     // 创建搜索器并启动搜索
     createSearchers();
@@ -193,29 +193,8 @@ void SimplifiedSearchWorker::mergeResults(AbstractSearcher *searcher)
     if (newResults.isEmpty())
         return;
 
-    // 合并到主结果集
-    {
-        QWriteLocker locker(&rwLock);
-
-        // 第一次直接复制结果
-        if (resultMap.isEmpty()) {
-            resultMap = newResults;
-            return;
-        }
-
-        // 合并结果，保留匹配分数更高的结果
-        for (auto it = newResults.constBegin(); it != newResults.constEnd(); ++it) {
-            const QUrl &url = it.key();
-            auto existing = resultMap.find(url);
-
-            if (existing != resultMap.end()) {
-                if (it.value().matchScore() > existing.value().matchScore())
-                    resultMap[url] = it.value();
-            } else {
-                resultMap.insert(url, it.value());
-            }
-        }
-    }
+    // 合并到主结果集，已有结果仅在匹配分数更高时更新
+    resultStore.merge(newResults);
 }
 
 void SimplifiedSearchWorker::onSearcherFinished()
@@ -334,6 +313,16 @@ DFMSearchResultMap TaskCommander::getResults() const
     return results;
 }
 
+DFMSearchResultList TaskCommander::getResultsSince(quint64 since, quint64 *latest) const
+{
+    if (!d->searchWorker) {
+        fmWarning() << "Search worker not available for getting incremental results";
+        return DFMSearchResultList();
+    }
+
+    return d->searchWorker->getResultsSince(since, latest);
+}
+
 QList<QUrl> TaskCommander::getResultsUrls() const
 {
     if (!d->searchWorker) {
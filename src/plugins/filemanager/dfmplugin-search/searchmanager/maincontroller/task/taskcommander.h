@@ -28,6 +28,7 @@ private:
     
     // 获取搜索结果
     DFMSearchResultMap getResults() const;
+    DFMSearchResultList getResultsSince(quint64 since, quint64 *latest) const;
     QList<QUrl> getResultsUrls() const;
     
     // 控制搜索流程
@@ -7,6 +7,7 @@
 
 #include "taskcommander.h"
 #include "searchmanager/searcher/abstractsearcher.h"
+#include "searchmanager/searcher/searchresultstore.h"
 
 #include <dfm-search/dsearch_global.h>
 #include <dfm-search/contentsearchapi.h>
@@ -39,6 +40,8 @@ public:
     // 获取结果
     Q_INVOKABLE DFMSearchResultMap getResults();
     Q_INVOKABLE QList<QUrl> getResultUrls();
+    // 结果存储是线程安全的，可直接在其他线程调用
+    DFMSearchResultList getResultsSince(quint64 since, quint64 *latest);
 
     // 控制搜索流程
     Q_INVOKABLE void startSearch();
@@ -67,9 +70,8 @@ private:
     QString searchKeyword;
 
     QList<AbstractSearcher *> searchers;
-    DFMSearchResultMap resultMap;
+    SearchResultStore resultStore;
 
-    QReadWriteLock rwLock;
     QMutex mutex;
 
     bool isRunning { false };
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "iteratorsearcher.h"
+#include "localiterationengine.h"
 #include "utils/searchhelper.h"
 
 #include <dfm-base/utils/fileutils.h>
@@ -91,6 +92,10 @@ IteratorSearcher::~IteratorSearcher()
     // 清理资源
     pendingDirs.clear();
 
+    // 工作线程会访问匹配规则，需在成员析构前等待其结束
+    delete engine;
+    engine = nullptr;
+
     // 确保停止定时器
     if (batchTimer->isActive())
         batchTimer->stop();
@@ -104,6 +109,9 @@ bool IteratorSearcher::search()
         return false;
     }
 
+    if (LocalIterationEngine::isSupported(searchUrl))
+        return startLocalIteration();
+
     // 从根URL开始搜索
     pendingDirs.enqueue(searchUrl);
 
@@ -131,6 +139,8 @@ void IteratorSearcher::stop()
     if (previousState == kRuning) {
         // 清理待处理目录
         pendingDirs.clear();
+        if (engine)
+            engine->stop();
 
         // 确保处理挖掘的结果
         if (hasItem())
@@ -312,3 +322,59 @@ void IteratorSearcher::requestNextDirectory()
     // 通过信号请求处理下一个目录
     emit requestProcessNextDirectory();
 }
+
+bool IteratorSearcher::startLocalIteration()
+{
+    engine = new LocalIterationEngine(this);
+    engine->setMatchFunction([this](const QString &fileName, const QString &dirPath) {
+        return matchFileName(fileName, dirPath);
+    });
+
+    connect(engine, &LocalIterationEngine::matched,
+            this, &IteratorSearcher::onEngineMatched,
+            Qt::QueuedConnection);
+    connect(engine, &LocalIterationEngine::finished,
+            this, &IteratorSearcher::onEngineFinished,
+            Qt::QueuedConnection);
+
+    if (!engine->start(searchUrl.toLocalFile())) {
+        fmWarning() << "Failed to start local iteration for:" << searchUrl;
+        status.storeRelease(kCompleted);
+        return false;
+    }
+
+    return true;
+}
+
+bool IteratorSearcher::matchFileName(const QString &fileName, const QString &dirPath) const
+{
+    // 桌面文件按显示名称匹配，与迭代器方式保持一致
+    if (fileName.endsWith(QLatin1String(".desktop"))) {
+        const auto &info = InfoFactory::create<FileInfo>(QUrl::fromLocalFile(QDir(dirPath).filePath(fileName)));
+        if (info)
+            return regex.match(info->displayOf(DisPlayInfoType::kFileDisplayName)).hasMatch();
+    }
+
+    return regex.match(fileName).hasMatch();
+}
+
+void IteratorSearcher::onEngineMatched(const QList<QUrl> &urls)
+{
+    if (status.loadAcquire() != kRuning)
+        return;
+
+    DFMSearchResultMap newResults;
+    for (const QUrl &url : urls)
+        addResultToMap(url, newResults);
+
+    addResults(newResults);
+}
+
+void IteratorSearcher::onEngineFinished()
+{
+    if (!status.testAndSetRelease(kRuning, kCompleted))
+        return;
+
+    fmDebug() << "Iterator search completed - local iteration finished";
+    emit finished();
+}
@@ -25,6 +25,7 @@ DPSEARCH_BEGIN_NAMESPACE
 
 // 前向声明
 class IteratorSearcherBridge;
+class LocalIterationEngine;
 
 class IteratorSearcher : public AbstractSearcher
 {
@@ -59,6 +60,10 @@ public slots:
     // 处理目录
     void processDirectory();
 
+    // 处理本地遍历引擎的结果
+    void onEngineMatched(const QList<QUrl> &urls);
+    void onEngineFinished();
+
 private:
     // 处理迭代器结果
     void processIteratorResults(QSharedPointer<DFMBASE_NAMESPACE::AbstractDirIterator> iterator);
@@ -72,6 +77,10 @@ private:
     // 请求处理队列中的下一个目录
     void requestNextDirectory();
 
+    // 本地目录在工作线程中遍历，不经过主线程
+    bool startLocalIteration();
+    bool matchFileName(const QString &fileName, const QString &dirPath) const;
+
     // 发布批量结果
     void publishBatchedResults();
 
@@ -85,6 +94,9 @@ private:
     // 用于主线程与工作线程间通信的桥接对象
     QSharedPointer<IteratorSearcherBridge> bridge;
 
+    // 本地目录遍历引擎
+    LocalIterationEngine *engine { nullptr };
+
     // 批量处理相关
     QTimer *batchTimer;               // 批量定时器
     DFMSearchResultMap batchedResults; // 批量结果
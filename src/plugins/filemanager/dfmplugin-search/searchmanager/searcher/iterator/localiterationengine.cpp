@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localiterationengine.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+// 单个工作线程积累多少结果或多长时间后提交一次
+constexpr int kFlushCount = 100;
+constexpr int kFlushIntervalMs = 50;
+constexpr int kMaxThreadCount = 8;
+}   // namespace
+
+LocalIterationEngine::LocalIterationEngine(QObject *parent)
+    : QObject(parent)
+{
+    // 遍历以等待 IO 为主，移动设备和网络目录上适当多开线程可以掩盖延迟
+    setThreadCount(qBound(2, QThread::idealThreadCount(), kMaxThreadCount));
+}
+
+LocalIterationEngine::~LocalIterationEngine()
+{
+    stop();
+    pool.waitForDone();
+}
+
+bool LocalIterationEngine::isSupported(const QUrl &url)
+{
+    return url.isLocalFile();
+}
+
+void LocalIterationEngine::setMatchFunction(const MatchFunction &func)
+{
+    matchFunc = func;
+}
+
+void LocalIterationEngine::setThreadCount(int count)
+{
+    workerCount = qMax(1, count);
+    pool.setMaxThreadCount(workerCount);
+}
+
+bool LocalIterationEngine::start(const QString &rootPath)
+{
+    if (isRunning() || !matchFunc)
+        return false;
+
+    QByteArray root = QFile::encodeName(rootPath);
+    while (root.size() > 1 && root.endsWith('/'))
+        root.chop(1);
+
+    {
+        QMutexLocker lk(&mutex);
+        sharedDirs = { root };
+        exhausted = false;
+        idleWorkers.storeRelaxed(0);
+    }
+    stopped.storeRelaxed(0);
+    runningWorkers.storeRelease(workerCount);
+
+    for (int i = 0; i < workerCount; ++i)
+        pool.start([this] { runWorker(); });
+
+    fmDebug() << "Local iteration started for" << rootPath << "with" << workerCount << "threads";
+    return true;
+}
+
+void LocalIterationEngine::stop()
+{
+    stopped.storeRelease(1);
+
+    QMutexLocker lk(&mutex);
+    condition.wakeAll();
+}
+
+bool LocalIterationEngine::isRunning() const
+{
+    return runningWorkers.loadAcquire() > 0;
+}
+
+void LocalIterationEngine::runWorker()
+{
+    const MatchFunction match = matchFunc;
+    QList<QByteArray> localDirs;
+    QList<QUrl> results;
+    QElapsedTimer flushTimer;
+    flushTimer.start();
+
+    while (!stopped.loadAcquire()) {
+        // 优先深度遍历自己发现的目录，本地为空时再从共享队列领取
+        QByteArray dir;
+        if (!localDirs.isEmpty())
+            dir = localDirs.takeLast();
+        else if (!takeSharedDirectory(&dir))
+            break;
+
+        scanDirectory(dir, match, &localDirs, &results);
+        shareSurplusDirectories(&localDirs);
+
+        if (results.size() >= kFlushCount
+            || (!results.isEmpty() && flushTimer.elapsed() >= kFlushIntervalMs)) {
+            emit matched(results);
+            results.clear();
+            flushTimer.restart();
+        }
+    }
+
+    if (!results.isEmpty() && !stopped.loadAcquire())
+        emit matched(results);
+
+    if (!runningWorkers.deref())
+        emit finished();
+}
+
+bool LocalIterationEngine::takeSharedDirectory(QByteArray *dir)
+{
+    QMutexLocker lk(&mutex);
+    idleWorkers.ref();
+    while (sharedDirs.isEmpty() && !exhausted && !stopped.loadAcquire()) {
+        // 所有线程都空闲且没有待处理目录时遍历结束
+        if (idleWorkers.loadRelaxed() == workerCount) {
+            exhausted = true;
+            condition.wakeAll();
+            break;
+        }
+        condition.wait(&mutex);
+    }
+    idleWorkers.deref();
+
+    if (sharedDirs.isEmpty() || stopped.loadAcquire())
+        return false;
+
+    *dir = sharedDirs.takeLast();
+    return true;
+}
+
+void LocalIterationEngine::shareSurplusDirectories(QList<QByteArray> *localDirs)
+{
+    if (idleWorkers.loadRelaxed() == 0 || localDirs->size() < 2)
+        return;
+
+    // 把较浅层的一半目录交给空闲线程，浅层目录下通常还有更大的子树
+    const int count = localDirs->size() / 2;
+    QMutexLocker lk(&mutex);
+    for (int i = 0; i < count; ++i)
+        sharedDirs.append(localDirs->at(i));
+    localDirs->erase(localDirs->begin(), localDirs->begin() + count);
+    condition.wakeAll();
+}
+
+void LocalIterationEngine::scanDirectory(const QByteArray &dir, const MatchFunction &match,
+                                         QList<QByteArray> *subDirs, QList<QUrl> *results)
+{
+    DIR *dirp = opendir(dir.constData());
+    if (!dirp)
+        return;
+
+    const QByteArray prefix = dir.endsWith('/') ? dir : dir + '/';
+    const QString &dirPath = QFile::decodeName(dir);
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dirp)) && !stopped.loadAcquire()) {
+        const char *name = entry->d_name;
+        // 与 DirIteratorFactory 的默认过滤一致，不包含隐藏文件
+        if (name[0] == '.')
+            continue;
+
+        const QByteArray path = prefix + name;
+        unsigned char type = entry->d_type;
+        struct stat st;
+        if (type == DT_UNKNOWN) {
+            if (lstat(path.constData(), &st) != 0)
+                continue;
+            type = S_ISDIR(st.st_mode) ? DT_DIR : (S_ISLNK(st.st_mode) ? DT_LNK : DT_REG);
+        }
+
+        // 失效的链接不作为结果，链接目录也不进入
+        if (type == DT_LNK && stat(path.constData(), &st) != 0)
+            continue;
+
+        if (type == DT_DIR && !path.startsWith("/sys/"))
+            subDirs->append(path);
+
+        if (match(QFile::decodeName(name), dirPath))
+            results->append(QUrl::fromLocalFile(QFile::decodeName(path)));
+    }
+
+    closedir(dirp);
+}
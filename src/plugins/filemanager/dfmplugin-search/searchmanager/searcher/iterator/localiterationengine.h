@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALITERATIONENGINE_H
+#define LOCALITERATIONENGINE_H
+
+#include "dfmplugin_search_global.h"
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QObject>
+#include <QThreadPool>
+#include <QUrl>
+#include <QWaitCondition>
+
+#include <functional>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+// 在线程池中遍历本地目录树，不经过主线程创建迭代器
+class LocalIterationEngine : public QObject
+{
+    Q_OBJECT
+public:
+    // 参数为文件名和所在目录路径，返回是否命中
+    using MatchFunction = std::function<bool(const QString &, const QString &)>;
+
+    explicit LocalIterationEngine(QObject *parent = nullptr);
+    ~LocalIterationEngine() override;
+
+    static bool isSupported(const QUrl &url);
+
+    void setMatchFunction(const MatchFunction &func);
+    void setThreadCount(int count);
+
+    bool start(const QString &rootPath);
+    void stop();
+    bool isRunning() const;
+
+signals:
+    // 在工作线程中发出，接收方需使用队列连接
+    void matched(const QList<QUrl> &urls);
+    void finished();
+
+private:
+    void runWorker();
+    bool takeSharedDirectory(QByteArray *dir);
+    void shareSurplusDirectories(QList<QByteArray> *localDirs);
+    void scanDirectory(const QByteArray &dir, const MatchFunction &match,
+                       QList<QByteArray> *subDirs, QList<QUrl> *results);
+
+private:
+    QThreadPool pool;
+    MatchFunction matchFunc;
+    int workerCount { 0 };
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QList<QByteArray> sharedDirs;
+    QAtomicInt idleWorkers { 0 };
+    QAtomicInt runningWorkers { 0 };
+    QAtomicInt stopped { 0 };
+    bool exhausted { false };
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // LOCALITERATIONENGINE_H
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchresultstore.h"
+
+DPSEARCH_USE_NAMESPACE
+
+quint64 SearchResultStore::merge(const DFMSearchResultMap &results)
+{
+    QWriteLocker lk(&lock);
+    for (auto it = results.constBegin(); it != results.constEnd(); ++it) {
+        auto existing = index.find(it.key());
+        if (existing != index.end()) {
+            // 保留匹配分数更高的结果
+            if (it.value().matchScore() <= records.at(existing.value()).matchScore())
+                continue;
+            existing.value() = records.size();
+        } else {
+            index.insert(it.key(), records.size());
+        }
+        records.append(it.value());
+    }
+
+    return static_cast<quint64>(records.size());
+}
+
+DFMSearchResultList SearchResultStore::resultsSince(quint64 since, quint64 *latest) const
+{
+    QReadLocker lk(&lock);
+    const int size = records.size();
+    if (latest)
+        *latest = static_cast<quint64>(size);
+
+    DFMSearchResultList delta;
+    if (since >= static_cast<quint64>(size))
+        return delta;
+
+    delta.reserve(size - static_cast<int>(since));
+    for (int i = static_cast<int>(since); i < size; ++i) {
+        const DFMSearchResult &record = records.at(i);
+        // 跳过已被更新记录取代的旧记录
+        if (index.value(record.url(), -1) == i)
+            delta.append(record);
+    }
+
+    return delta;
+}
+
+DFMSearchResultMap SearchResultStore::results() const
+{
+    QReadLocker lk(&lock);
+    DFMSearchResultMap map;
+    for (auto it = index.constBegin(); it != index.constEnd(); ++it)
+        map.insert(it.key(), records.at(it.value()));
+    return map;
+}
+
+QList<QUrl> SearchResultStore::urls() const
+{
+    QReadLocker lk(&lock);
+    return index.keys();
+}
+
+quint64 SearchResultStore::latestSequence() const
+{
+    QReadLocker lk(&lock);
+    return static_cast<quint64>(records.size());
+}
+
+int SearchResultStore::count() const
+{
+    QReadLocker lk(&lock);
+    return index.size();
+}
+
+void SearchResultStore::clear()
+{
+    QWriteLocker lk(&lock);
+    records.clear();
+    index.clear();
+}
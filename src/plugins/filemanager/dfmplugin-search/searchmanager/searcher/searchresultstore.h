@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SEARCHRESULTSTORE_H
+#define SEARCHRESULTSTORE_H
+
+#include "searchresult_define.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+// 只追加的搜索结果存储，每条记录的序号即其位置加一
+// 同一URL得到更高的匹配分数时追加新记录，旧记录作废，消费者按序号增量获取
+class SearchResultStore
+{
+public:
+    // 合并一批结果，返回合并后的最新序号
+    quint64 merge(const DFMSearchResultMap &results);
+
+    // 获取序号大于 since 的有效结果，latest 返回当前最新序号
+    DFMSearchResultList resultsSince(quint64 since, quint64 *latest = nullptr) const;
+
+    DFMSearchResultMap results() const;
+    QList<QUrl> urls() const;
+    quint64 latestSequence() const;
+    int count() const;
+    void clear();
+
+private:
+    mutable QReadWriteLock lock;
+    DFMSearchResultList records;
+    QHash<QUrl, int> index;   // URL -> 最新记录的位置
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // SEARCHRESULTSTORE_H
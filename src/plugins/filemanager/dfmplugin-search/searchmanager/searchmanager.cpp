@@ -53,6 +53,15 @@ DFMSearchResultMap SearchManager::matchedResults(const QString &taskId)
     return {};
 }
 
+DFMSearchResultList SearchManager::matchedResultsSince(const QString &taskId, quint64 since, quint64 *latest)
+{
+    if (mainController)
+        return mainController->getResultsSince(taskId, since, latest);
+
+    fmWarning() << "MainController not available, cannot retrieve results for taskId:" << taskId;
+    return {};
+}
+
 QList<QUrl> SearchManager::matchedResultUrls(const QString &taskId)
 {
     // Get real-time result URLs from controller
@@ -28,6 +28,9 @@ public:
     
     // 获取统一的搜索结果数据
     DFMSearchResultMap matchedResults(const QString &taskId);
+
+    // 获取序号 since 之后新增或更新的结果，latest 返回当前最新序号
+    DFMSearchResultList matchedResultsSince(const QString &taskId, quint64 since, quint64 *latest);
     
     // 为向后兼容保留的接口，只获取URL列表
     QList<QUrl> matchedResultUrls(const QString &taskId);
@@ -22,6 +22,16 @@
 
 using namespace dfmbase;
 using namespace dfmplugin_workspace;
+
+namespace {
+// 单批处理的文件事件数量上限
+constexpr int kWatcherEventBatchSize = 2000;
+// 持续有事件到达时，单批最长收集时间
+constexpr int kWatcherEventWindowMs = 200;
+// 没有新事件时处理线程的等待时间，超时后线程退出
+constexpr int kWatcherEventIdleMs = 100;
+}   // namespace
+
 RootInfo::RootInfo(const QUrl &u, const bool canCache, QObject *parent)
     : QObject(parent), url(u), canCache(canCache)
 {
@@ -49,6 +59,7 @@ RootInfo::~RootInfo()
     }
 
     cancelWatcherEvent = true;
+    watcherEvents.interrupt();
     for (auto &future : watcherEventFutures) {
         future.waitForFinished();
     }
@@ -149,6 +160,7 @@ void RootInfo::startWork(const QString &key, const bool getCache)
     {
         QWriteLocker lk(&childrenLock);
         childrenUrlList.clear();
+        childrenUrlIndex.clear();
         sourceDataList.clear();
     }
     traversalThreads.value(key)->traversalThread->start();
@@ -237,6 +249,7 @@ void RootInfo::reset()
     {
         QWriteLocker lk(&childrenLock);
         childrenUrlList.clear();
+        childrenUrlIndex.clear();
         sourceDataList.clear();
     }
 
@@ -249,6 +262,7 @@ void RootInfo::reset()
     traversalFinish = false;
 
     cancelWatcherEvent = true;
+    watcherEvents.interrupt();
     for (const auto &thread : traversalThreads) {
         thread->traversalThread->stop();
     }
@@ -298,8 +312,7 @@ bool RootInfo::checkKeyOnly(const QString &key) const
 void RootInfo::doFileDeleted(const QUrl &url)
 {
     fmDebug() << "File deleted event for URL:" << url.toString();
-    enqueueEvent(QPair<QUrl, EventType>(url, kRmFile));
-    metaObject()->invokeMethod(this, QT_STRINGIFY(doThreadWatcherEvent), Qt::QueuedConnection);
+    enqueueEvent(QPair<QUrl, EventType>(url, FileEventCoalescer::kRmFile));
 }
 
 void RootInfo::dofileMoved(const QUrl &fromUrl, const QUrl &toUrl)
@@ -318,125 +331,68 @@ void RootInfo::dofileMoved(const QUrl &fromUrl, const QUrl &toUrl)
 void RootInfo::dofileCreated(const QUrl &url)
 {
     fmDebug() << "File created event for URL:" << url.toString();
-    enqueueEvent(QPair<QUrl, EventType>(url, kAddFile));
-    metaObject()->invokeMethod(this, QT_STRINGIFY(doThreadWatcherEvent), Qt::QueuedConnection);
+    enqueueEvent(QPair<QUrl, EventType>(url, FileEventCoalescer::kAddFile));
 }
 
 void RootInfo::doFileUpdated(const QUrl &url)
 {
     fmDebug() << "File updated event for URL:" << url.toString();
-    enqueueEvent(QPair<QUrl, EventType>(url, kUpdateFile));
-    metaObject()->invokeMethod(this, QT_STRINGIFY(doThreadWatcherEvent), Qt::QueuedConnection);
+    enqueueEvent(QPair<QUrl, EventType>(url, FileEventCoalescer::kUpdateFile));
 }
 
 void RootInfo::doWatcherEvent()
 {
-    if (processFileEventRuning)
-        return;
-
-    processFileEventRuning = true;
-    QElapsedTimer timer;
-    timer.start();
-    QList<QUrl> adds, updates, removes;
-    qint64 oldtime = 0;
-    int emptyLoopCount = 0;
-    while (checkFileEventQueue() || timer.elapsed() < 200) {
-        // 检查超时，重新设置起始时间
-        if (timer.elapsed() - oldtime >= 200) {
-            // 处理添加文件
-            if (!adds.isEmpty())
-                addChildren(adds);
-            if (!updates.isEmpty())
-                updateChildren(updates);
-            if (!removes.isEmpty())
-                removeChildren(removes);
-
-            adds.clear();
-            updates.clear();
-            removes.clear();
-
-            oldtime = timer.elapsed();
-        }
-
+    forever {
         if (cancelWatcherEvent)
             return;
 
-        if (!checkFileEventQueue()) {
-            if (emptyLoopCount >= 5)
-                break;
-
-            QThread::msleep(20);
-            if (adds.isEmpty() && updates.isEmpty() && removes.isEmpty())
-                oldtime = timer.elapsed();
-
-            ++emptyLoopCount;
-            continue;
-        }
-
-        emptyLoopCount = 0;
-        QPair<QUrl, EventType> event = dequeueEvent();
-        const QUrl &fileUrl = event.first;
-
-        if (cancelWatcherEvent)
+        // 阻塞等待事件，按数量或时间分批处理，空闲超时后退出
+        const auto &batch = watcherEvents.takeBatch(kWatcherEventBatchSize, kWatcherEventWindowMs,
+                                                    kWatcherEventIdleMs);
+        if (batch.isEmpty() || cancelWatcherEvent)
             return;
 
-        if (!fileUrl.isValid())
-            continue;
-
-        if (UniversalUtils::urlEquals(fileUrl, url)) {
-            if (event.second == kAddFile)
-                continue;
-            else if (event.second == kRmFile) {
-                emit InfoCacheController::instance().removeCacheFileInfo({ fileUrl });
-                WatcherCache::instance().removeCacheWatcherByParent(fileUrl);
-                emit requestCloseTab(fileUrl);
-                emit requestClearRoot(fileUrl);
-                QWriteLocker lk(&childrenLock);
-                childrenUrlList.clear();
-                sourceDataList.clear();
-                break;
-            }
-        }
-
-        if (cancelWatcherEvent)
-            return;
-
-        if (event.second == kAddFile) {
-            // 判断update和remove中是否存在存在就移除
-            updates.removeOne(fileUrl);
-            removes.removeOne(fileUrl);
-            if (adds.contains(fileUrl))
-                continue;
+        applyWatcherEvents(batch);
+    }
+}
 
-            adds.append(fileUrl);
-        } else if (event.second == kUpdateFile) {
-            // 如果在增加或者移除中就不添加
-            if (adds.contains(fileUrl) || removes.contains(fileUrl) || updates.contains(fileUrl))
-                continue;
-            updates.append(fileUrl);
-        } else {
-            adds.removeOne(fileUrl);
-            updates.removeOne(fileUrl);
-            if (removes.contains(fileUrl))
-                continue;
+void RootInfo::applyWatcherEvents(const FileEventCoalescer::Batch &batch)
+{
+    QList<QUrl> removes;
+    removes.reserve(batch.removes.size());
+    bool rootRemoved = false;
+    for (const auto &fileUrl : batch.removes) {
+        if (UniversalUtils::urlEquals(fileUrl, url))
+            rootRemoved = true;
+        else
             removes.append(fileUrl);
-        }
     }
-    processFileEventRuning = false;
 
-    // 处理添加文件
+    if (rootRemoved) {
+        emit InfoCacheController::instance().removeCacheFileInfo({ url });
+        WatcherCache::instance().removeCacheWatcherByParent(url);
+        emit requestCloseTab(url);
+        emit requestClearRoot(url);
+        QWriteLocker lk(&childrenLock);
+        childrenUrlList.clear();
+        childrenUrlIndex.clear();
+        sourceDataList.clear();
+    }
+
     if (!removes.isEmpty())
         removeChildren(removes);
-    if (!adds.isEmpty())
-        addChildren(adds);
-    if (!updates.isEmpty())
-        updateChildren(updates);
+    if (!batch.adds.isEmpty())
+        addChildren(batch.adds);
+    if (!batch.updates.isEmpty())
+        updateChildren(batch.updates);
+
+    // 根目录已被删除，丢弃后续事件
+    if (rootRemoved)
+        watcherEvents.interrupt();
 }
 
 void RootInfo::doThreadWatcherEvent()
 {
-    if (processFileEventRuning)
-        return;
     for (auto it = watcherEventFutures.begin(); it != watcherEventFutures.end();) {
         if (it->isFinished()) {
             it = watcherEventFutures.erase(it);
@@ -479,12 +435,25 @@ void RootInfo::handleTraversalResultsUpdate(const QList<SortInfoPointer> childre
     if (children.isEmpty())
         return;
 
-    QWriteLocker lk(&childrenLock);
-    // 更新已存在的文件信息
-    sourceDataList = children;
+    {
+        QWriteLocker lk(&childrenLock);
+        // 迭代器只返回新增或更新的条目，新条目追加，已存在的条目替换
+        for (const auto &child : children) {
+            if (!child)
+                continue;
+
+            const QUrl &childUrl = child->fileUrl();
+            const int index = childrenUrlIndex.value(childUrl, -1);
+            if (index >= 0) {
+                sourceDataList.replace(index, child);
+                continue;
+            }
+            appendChild(childUrl, child);
+        }
+    }
 
     bool isFirst = isFirstBatch.exchange(false);   // Get and reset the flag
-    Q_EMIT iteratorUpdateFiles(travseToken, sourceDataList, isFirst);
+    Q_EMIT iteratorUpdateFiles(travseToken, children, isFirst);
 }
 
 void RootInfo::handleTraversalLocalResult(QList<SortInfoPointer> children,
@@ -608,8 +577,12 @@ void RootInfo::addChildren(const QList<SortInfoPointer> &children)
             continue;
 
         QWriteLocker lk(&childrenLock);
-        childrenUrlList.append(file->fileUrl());
-        sourceDataList.append(file);
+        const QUrl &fileUrl = file->fileUrl();
+        const int index = childrenUrlIndex.value(fileUrl, -1);
+        if (index >= 0)
+            sourceDataList.replace(index, file);
+        else
+            appendChild(fileUrl, file);
     }
 }
 
@@ -627,17 +600,32 @@ SortInfoPointer RootInfo::addChild(const FileInfoPointer &child)
 
     {
         QWriteLocker lk(&childrenLock);
-        if (childrenUrlList.contains(childUrl)) {
-            sourceDataList.replace(childrenUrlList.indexOf(childUrl), sort);
+        const int index = childrenUrlIndex.value(childUrl, -1);
+        if (index >= 0) {
+            sourceDataList.replace(index, sort);
             return sort;
         }
-        childrenUrlList.append(childUrl);
-        sourceDataList.append(sort);
+        appendChild(childUrl, sort);
     }
 
     return sort;
 }
 
+void RootInfo::appendChild(const QUrl &url, const SortInfoPointer &sort)
+{
+    childrenUrlIndex.insert(url, childrenUrlList.count());
+    childrenUrlList.append(url);
+    sourceDataList.append(sort);
+}
+
+void RootInfo::rebuildChildrenIndex()
+{
+    childrenUrlIndex.clear();
+    childrenUrlIndex.reserve(childrenUrlList.count());
+    for (int i = 0; i < childrenUrlList.count(); ++i)
+        childrenUrlIndex.insert(childrenUrlList.at(i), i);
+}
+
 SortInfoPointer RootInfo::sortFileInfo(const FileInfoPointer &info)
 {
     if (!info)
@@ -662,8 +650,8 @@ SortInfoPointer RootInfo::sortFileInfo(const FileInfoPointer &info)
 void RootInfo::removeChildren(const QList<QUrl> &urlList)
 {
     QList<SortInfoPointer> removeChildren {};
-    int childIndex = -1;
     QList<QUrl> removeUrls;
+    QList<FileInfoPointer> removeInfos;
     emit InfoCacheController::instance().removeCacheFileInfo(urlList);
     for (QUrl url : urlList) {
         WatcherCache::instance().removeCacheWatcherByParent(url);
@@ -673,16 +661,39 @@ void RootInfo::removeChildren(const QList<QUrl> &urlList)
         if (!child)
             continue;
 
-        auto realUrl = child->urlOf(UrlInfoType::kUrl);
-        removeUrls.append(realUrl);
+        removeUrls.append(child->urlOf(UrlInfoType::kUrl));
+        removeInfos.append(child);
+    }
+
+    if (!removeInfos.isEmpty()) {
         QWriteLocker lk(&childrenLock);
-        childIndex = childrenUrlList.indexOf(realUrl);
-        if (childIndex < 0 || childIndex >= childrenUrlList.length()) {
-            removeChildren.append(sortFileInfo(child));
-            continue;
+        QSet<int> removeIndexes;
+        for (int i = 0; i < removeInfos.count(); ++i) {
+            const int childIndex = childrenUrlIndex.value(removeUrls.at(i), -1);
+            if (childIndex < 0 || removeIndexes.contains(childIndex)) {
+                removeChildren.append(sortFileInfo(removeInfos.at(i)));
+                continue;
+            }
+            removeIndexes.insert(childIndex);
+            removeChildren.append(sourceDataList.at(childIndex));
+        }
+
+        // 一次遍历删除所有条目并重建索引，避免每删一个都移动后续条目
+        if (!removeIndexes.isEmpty()) {
+            QList<QUrl> urls;
+            QList<SortInfoPointer> datas;
+            urls.reserve(childrenUrlList.count() - removeIndexes.count());
+            datas.reserve(urls.capacity());
+            for (int i = 0; i < childrenUrlList.count(); ++i) {
+                if (removeIndexes.contains(i))
+                    continue;
+                urls.append(childrenUrlList.at(i));
+                datas.append(sourceDataList.at(i));
+            }
+            childrenUrlList = urls;
+            sourceDataList = datas;
+            rebuildChildrenIndex();
         }
-        childrenUrlList.removeAt(childIndex);
-        removeChildren.append(sourceDataList.takeAt(childIndex));
     }
 
     if (removeUrls.count() > 0)
@@ -698,7 +709,7 @@ void RootInfo::removeChildren(const QList<QUrl> &urlList)
 bool RootInfo::containsChild(const QUrl &url)
 {
     QReadLocker lk(&childrenLock);
-    return childrenUrlList.contains(url);
+    return childrenUrlIndex.contains(url);
 }
 
 SortInfoPointer RootInfo::updateChild(const QUrl &url)
@@ -712,12 +723,13 @@ SortInfoPointer RootInfo::updateChild(const QUrl &url)
     auto realUrl = info->urlOf(UrlInfoType::kUrl);
 
     QWriteLocker lk(&childrenLock);
-    if (!childrenUrlList.contains(realUrl))
+    const int index = childrenUrlIndex.value(realUrl, -1);
+    if (index < 0)
         return nullptr;
     sort = sortFileInfo(info);
     if (sort.isNull())
         return nullptr;
-    sourceDataList.replace(childrenUrlList.indexOf(realUrl), sort);
+    sourceDataList.replace(index, sort);
 
     // NOTE: GlobalEventType::kHideFiles event is watched in fileview, but this can be used to notify update view
     // when the file is modified in other way.
@@ -740,25 +752,18 @@ void RootInfo::updateChildren(const QList<QUrl> &urls)
     emit watcherUpdateFiles(updates);
 }
 
-bool RootInfo::checkFileEventQueue()
-{
-    QMutexLocker lk(&watcherEventMutex);
-    return !watcherEvent.isEmpty();
-}
-
 void RootInfo::enqueueEvent(const QPair<QUrl, EventType> &e)
 {
-    QMutexLocker lk(&watcherEventMutex);
-    watcherEvent.enqueue(e);
-}
+    if (!e.first.isValid())
+        return;
 
-QPair<QUrl, RootInfo::EventType> RootInfo::dequeueEvent()
-{
-    QMutexLocker lk(&watcherEventMutex);
-    if (!watcherEvent.isEmpty())
-        return watcherEvent.dequeue();
+    // 根目录自身的创建事件无需处理
+    if (e.second == FileEventCoalescer::kAddFile && UniversalUtils::urlEquals(e.first, url))
+        return;
 
-    return QPair<QUrl, RootInfo::EventType>();
+    // 只有在没有处理线程运行时才需要启动新的线程
+    if (watcherEvents.enqueue(e.first, e.second))
+        metaObject()->invokeMethod(this, QT_STRINGIFY(doThreadWatcherEvent), Qt::QueuedConnection);
 }
 
 // When monitoring the mtp directory, the monitor monitors that the scheme of the
@@ -7,13 +7,14 @@
 
 #include "dfmplugin_workspace_global.h"
 #include "utils/traversaldirthreadmanager.h"
+#include "utils/fileeventcoalescer.h"
 
 #include <dfm-base/dfm_base_global.h>
 #include <dfm-base/utils/traversaldirthread.h>
 #include <dfm-base/interfaces/abstractfilewatcher.h>
 
 #include <QReadWriteLock>
-#include <QQueue>
+#include <QSet>
 #include <QFuture>
 
 namespace dfmplugin_workspace {
@@ -23,11 +24,7 @@ class RootInfo : public QObject
 {
     Q_OBJECT
 
-    enum EventType {
-        kAddFile,
-        kUpdateFile,
-        kRmFile
-    };
+    using EventType = FileEventCoalescer::EventType;
 
 public:
     struct DirIteratorThread
@@ -121,14 +118,16 @@ private:
     void addChildren(const QList<SortInfoPointer> &children);
     SortInfoPointer addChild(const FileInfoPointer &child);
     SortInfoPointer sortFileInfo(const FileInfoPointer &info);
+    // 以下两个函数需要在持有 childrenLock 写锁时调用
+    void appendChild(const QUrl &url, const SortInfoPointer &sort);
+    void rebuildChildrenIndex();
     void removeChildren(const QList<QUrl> &urlList);
     bool containsChild(const QUrl &url);
     SortInfoPointer updateChild(const QUrl &url);
     void updateChildren(const QList<QUrl> &urls);
 
-    bool checkFileEventQueue();
     void enqueueEvent(const QPair<QUrl, EventType> &e);
-    QPair<QUrl, EventType> dequeueEvent();
+    void applyWatcherEvents(const FileEventCoalescer::Batch &batch);
     FileInfoPointer fileInfo(const QUrl &url);
 
 public:
@@ -145,6 +144,7 @@ private:
 
     QReadWriteLock childrenLock;
     QList<QUrl> childrenUrlList {};
+    QHash<QUrl, int> childrenUrlIndex {};   // childrenUrlList 中每个 url 的位置，用于快速查重和替换
     QList<SortInfoPointer> sourceDataList {};
     // origin data sort information
     dfmio::DEnumerator::SortRoleCompareFlag originSortRole { dfmio::DEnumerator::SortRoleCompareFlag::kSortRoleCompareDefault };
@@ -155,9 +155,7 @@ private:
     std::atomic_bool cancelWatcherEvent { false };
     QList<QFuture<void>> watcherEventFutures;
 
-    QQueue<QPair<QUrl, EventType>> watcherEvent {};
-    QMutex watcherEventMutex;
-    QAtomicInteger<bool> processFileEventRuning = false;
+    FileEventCoalescer watcherEvents;
 
     QList<TraversalThreadPointer> discardedThread {};
     QList<QSharedPointer<QThread>> threads {};
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fileeventcoalescer.h"
+
+#include <QDeadlineTimer>
+
+using namespace dfmplugin_workspace;
+
+namespace {
+// 收集窗口内若这段时间没有新的文件事件，提前结束本批次以降低界面延迟
+constexpr int kQuietPeriodMs = 50;
+}   // namespace
+
+bool FileEventCoalescer::enqueue(const QUrl &url, EventType type)
+{
+    QMutexLocker lk(&mutex);
+    if (interrupted)
+        return false;
+
+    auto it = states.find(url);
+    if (it == states.end()) {
+        states.insert(url, type);
+        order.append(url);
+    } else if (type != kUpdateFile) {
+        // 添加和删除覆盖之前的状态；已有事件时忽略更新
+        it.value() = type;
+    }
+
+    if (order.size() == 1 || order.size() >= wakeThreshold)
+        condition.wakeOne();
+
+    if (consumerRunning)
+        return false;
+
+    consumerRunning = true;
+    return true;
+}
+
+FileEventCoalescer::Batch FileEventCoalescer::takeBatch(int maxCount, int windowMs, int idleTimeoutMs)
+{
+    QMutexLocker lk(&mutex);
+    wakeThreshold = qMax(1, maxCount);
+
+    QDeadlineTimer idle(idleTimeoutMs);
+    while (order.isEmpty() && !interrupted) {
+        if (!condition.wait(&mutex, idle))
+            break;
+    }
+
+    if (order.isEmpty() || interrupted) {
+        consumerRunning = false;
+        return {};
+    }
+
+    // 事件持续到达时在窗口内继续收集，达到数量上限或短暂静默后立即处理
+    QDeadlineTimer window(windowMs);
+    while (order.size() < maxCount && !interrupted && !window.hasExpired()) {
+        const int lastSize = order.size();
+        condition.wait(&mutex, QDeadlineTimer(qMin<qint64>(kQuietPeriodMs, window.remainingTime())));
+        if (order.size() == lastSize)
+            break;
+    }
+
+    Batch batch;
+    const int count = qMin(order.size(), maxCount);
+    for (int i = 0; i < count; ++i) {
+        const QUrl &url = order.at(i);
+        switch (states.take(url)) {
+        case kAddFile:
+            batch.adds.append(url);
+            break;
+        case kUpdateFile:
+            batch.updates.append(url);
+            break;
+        case kRmFile:
+            batch.removes.append(url);
+            break;
+        }
+    }
+    order.remove(0, count);
+
+    return batch;
+}
+
+bool FileEventCoalescer::hasPendingEvents() const
+{
+    QMutexLocker lk(&mutex);
+    return !order.isEmpty();
+}
+
+int FileEventCoalescer::pendingCount() const
+{
+    QMutexLocker lk(&mutex);
+    return order.size();
+}
+
+void FileEventCoalescer::interrupt()
+{
+    QMutexLocker lk(&mutex);
+    interrupted = true;
+    order.clear();
+    states.clear();
+    condition.wakeAll();
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FILEEVENTCOALESCER_H
+#define FILEEVENTCOALESCER_H
+
+#include "dfmplugin_workspace_global.h"
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QUrl>
+#include <QWaitCondition>
+
+namespace dfmplugin_workspace {
+
+/*!
+ * \brief Merges file watcher events per url before they are applied to the model
+ *
+ * Each url keeps only its latest state: an add or remove replaces any earlier
+ * event of the same url, an update is dropped if the url already has a pending
+ * event. Urls are handed out in the order they were first seen. A single
+ * consumer drains the events in batches bounded by size and time.
+ */
+class FileEventCoalescer
+{
+public:
+    enum EventType {
+        kAddFile,
+        kUpdateFile,
+        kRmFile
+    };
+
+    struct Batch
+    {
+        QList<QUrl> adds;
+        QList<QUrl> updates;
+        QList<QUrl> removes;
+
+        bool isEmpty() const { return adds.isEmpty() && updates.isEmpty() && removes.isEmpty(); }
+    };
+
+    /*!
+     * \brief Merge an event into the pending state
+     * \return true if no consumer is running and the caller has to start one
+     */
+    bool enqueue(const QUrl &url, EventType type);
+
+    /*!
+     * \brief Wait for events and take the next batch
+     * \param maxCount Maximum number of urls in the batch
+     * \param windowMs Time to keep collecting after the first event arrived
+     * \param idleTimeoutMs Time to wait for the first event
+     * \return An empty batch when idle or interrupted, the consumer is then
+     *         considered finished
+     */
+    Batch takeBatch(int maxCount, int windowMs, int idleTimeoutMs);
+
+    bool hasPendingEvents() const;
+    int pendingCount() const;
+
+    // Drop all pending events and wake up a waiting consumer
+    void interrupt();
+
+private:
+    mutable QMutex mutex;
+    QWaitCondition condition;
+    QList<QUrl> order;
+    QHash<QUrl, EventType> states;
+    int wakeThreshold { 1 };
+    bool consumerRunning { false };
+    bool interrupted { false };
+};
+
+}
+
+#endif   // FILEEVENTCOALESCER_H
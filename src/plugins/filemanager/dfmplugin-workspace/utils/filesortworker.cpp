@@ -14,16 +14,23 @@
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/mimetype/mimetypedisplaymanager.h>
 #include <dfm-base/utils/sortutils.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 
 #include <dfm-io/dfmio_utils.h>
 
 #include <QStandardPaths>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+#include <queue>
 
 #include <sys/stat.h>
 
 using namespace dfmplugin_workspace;
 using namespace dfmbase::Global;
 using namespace dfmio;
+using namespace GlobalDConfDefines::ConfigPath;
+using namespace GlobalDConfDefines::BaseConfig;
 
 namespace {
 template<class T>
@@ -47,6 +54,7 @@ FileSortWorker::FileSortWorker(const QUrl &url, const QString &key, FileViewFilt
     current.setPath(dirPath);
     sortAndFilter = SortFilterFactory::create<AbstractSortFilter>(current);
     isMixDirAndFile = Application::instance()->appAttribute(Application::kFileAndDirMixedSort).toBool();
+    parallelSortThreshold = DConfigManager::instance()->value(kViewDConfName, kParallelSortThreshold, 50000).toInt();
 
     fmDebug() << "Mixed dir and file sorting enabled:" << isMixDirAndFile;
 
@@ -1301,6 +1309,14 @@ QList<QUrl> FileSortWorker::sortTreeFiles(const QList<QUrl> &children, const boo
         return children;
     }
 
+    if (!reverse && canSortInParallel(children.count())) {
+        auto sortList = parallelSortFiles(children);
+        if (sortList.isEmpty())
+            return {};
+        visibleTreeChildren.insert(parentUrl, sortList);
+        return sortList;
+    }
+
     QList<QUrl> sortList;
     int sortIndex = 0;
     QHash<QUrl, SortInfoPointer> sortInfos = reverse && !isMixDirAndFile ? this->children.value(parentUrl)
@@ -1331,6 +1347,81 @@ QList<QUrl> FileSortWorker::sortTreeFiles(const QList<QUrl> &children, const boo
     return sortList;
 }
 
+bool FileSortWorker::canSortInParallel(const int count) const
+{
+    // 插件提供的排序过滤器不保证线程安全，只对默认比较规则并行排序
+    return parallelSortThreshold > 0 && count >= parallelSortThreshold
+            && !sortAndFilter && QThreadPool::globalInstance()->maxThreadCount() > 1;
+}
+
+QList<QUrl> FileSortWorker::parallelSortFiles(const QList<QUrl> &children)
+{
+    const auto sort = AbstractSortFilter::SortScenarios::kSortScenariosNormal;
+    const bool ascending = sortOrder == Qt::AscendingOrder;
+    auto before = [this, ascending, sort](const QUrl &left, const QUrl &right) {
+        return ascending ? lessThan(left, right, sort) : lessThan(right, left, sort);
+    };
+
+    // 与 insertSortList 逐个插入的结果保持一致：升序时相等元素保持原有顺序，
+    // 降序时后插入的元素排在相等元素之前，因此降序先反转输入再做稳定排序
+    QList<QUrl> input = children;
+    if (!ascending)
+        std::reverse(input.begin(), input.end());
+
+    // 分块后在线程池中稳定排序，每个条目只会被一个线程访问
+    const int total = input.count();
+    const int chunkCount = qBound(2, QThreadPool::globalInstance()->maxThreadCount(), total);
+    const int chunkSize = (total + chunkCount - 1) / chunkCount;
+    QList<QList<QUrl>> chunks;
+    for (int pos = 0; pos < total; pos += chunkSize)
+        chunks.append(input.mid(pos, chunkSize));
+
+    QElapsedTimer timer;
+    timer.start();
+    QtConcurrent::blockingMap(chunks, [&before](QList<QUrl> &chunk) {
+        std::stable_sort(chunk.begin(), chunk.end(), before);
+    });
+
+    if (isCanceled)
+        return {};
+
+    // k 路归并，相等时取块序号小的元素以保持稳定
+    struct Cursor
+    {
+        int chunk;
+        int pos;
+    };
+    auto after = [&chunks, &before](const Cursor &left, const Cursor &right) {
+        const QUrl &leftUrl = chunks.at(left.chunk).at(left.pos);
+        const QUrl &rightUrl = chunks.at(right.chunk).at(right.pos);
+        if (before(rightUrl, leftUrl))
+            return true;
+        if (before(leftUrl, rightUrl))
+            return false;
+        return left.chunk > right.chunk;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(after)> heap(after);
+    for (int i = 0; i < chunks.count(); ++i)
+        heap.push({ i, 0 });
+
+    QList<QUrl> sortList;
+    sortList.reserve(total);
+    while (!heap.empty()) {
+        if (isCanceled)
+            return {};
+
+        Cursor cursor = heap.top();
+        heap.pop();
+        sortList.append(chunks.at(cursor.chunk).at(cursor.pos));
+        if (++cursor.pos < chunks.at(cursor.chunk).count())
+            heap.push(cursor);
+    }
+
+    fmDebug() << "Parallel sorted" << total << "files in" << chunks.count()
+              << "chunks, elapsed(ms):" << timer.elapsed();
+    return sortList;
+}
+
 QList<QUrl> FileSortWorker::removeChildrenByParents(const QList<QUrl> &dirs)
 {
     QList<QUrl> urls;
@@ -1585,6 +1676,11 @@ bool FileSortWorker::lessThan(const QUrl &left, const QUrl &right, AbstractSortF
     if (isCanceled)
         return false;
 
+    // 按名称排序时直接比较预计算的排序键，避免每次比较都构造 QVariant 并逐字符排序
+    if (orgSortRole == kItemFileDisplayNameRole
+        && canUseNameSortKey(leftSortInfo) && canUseNameSortKey(rightSortInfo))
+        return leftSortInfo->fileNameSortKey() < rightSortInfo->fileNameSortKey();
+
     QVariant leftData = data(leftSortInfo, orgSortRole);
     QVariant rightData = data(rightSortInfo, orgSortRole);
 
@@ -1608,11 +1704,8 @@ bool FileSortWorker::lessThan(const QUrl &left, const QUrl &right, AbstractSortF
     }
 
     // When the selected sort attribute value is the same, sort by file name
-    if (leftData == rightData) {
-        QString leftName = leftSortInfo->fileUrl().fileName();
-        QString rightName = rightSortInfo->fileUrl().fileName();
-        return SortUtils::compareStringForFileName(leftName, rightName);
-    }
+    if (leftData == rightData)
+        return leftSortInfo->fileNameSortKey() < rightSortInfo->fileNameSortKey();
 
     switch (orgSortRole) {
     case kItemFileDisplayNameRole:
@@ -1687,20 +1780,28 @@ QVariant FileSortWorker::data(const FileInfoPointer &info, ItemRoles role)
     }
 }
 
-QVariant FileSortWorker::data(const SortInfoPointer &info, Global::ItemRoles role)
+bool FileSortWorker::isDirInHome(const SortInfoPointer &info)
 {
-    auto isContainInHomeDir = [info, role]() {
-        if (!info->isDir() || role != kItemFileDisplayNameRole)
-            return false;
-        const QUrl &url = info->fileUrl();
-        static const QString kHomePath = QStandardPaths::writableLocation(QStandardPaths::HomeLocation);
-        const auto &path = QDir::cleanPath(url.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash).toLocalFile());
-        return path == kHomePath;
-    };
+    if (!info->isDir())
+        return false;
+    const QUrl &url = info->fileUrl();
+    static const QString kHomePath = QStandardPaths::writableLocation(QStandardPaths::HomeLocation);
+    const auto &path = QDir::cleanPath(url.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash).toLocalFile());
+    return path == kHomePath;
+}
 
+bool FileSortWorker::canUseNameSortKey(const SortInfoPointer &info)
+{
+    // 与 data() 的判断保持一致：这些情况下显示名称需要从 FileInfo 获取
+    return info->fileUrl().isLocalFile() && !info->isSymLink() && !isDirInHome(info);
+}
+
+QVariant FileSortWorker::data(const SortInfoPointer &info, Global::ItemRoles role)
+{
     // 1. 非本地文件的搜索结果不会进行sortinfo的填充，因此直接返回
     // 2. Home 目录下由于 XDG 目录进行了转译，使用 fileinfo 的 displayname 更
-    if (info.isNull() || !info->fileUrl().isLocalFile() || isContainInHomeDir())
+    if (info.isNull() || !info->fileUrl().isLocalFile()
+        || (role == kItemFileDisplayNameRole && isDirInHome(info)))
         return QVariant();
 
     switch (role) {
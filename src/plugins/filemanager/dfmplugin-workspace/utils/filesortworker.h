@@ -195,7 +195,11 @@ private:
 
     int insertSortList(const QUrl &needNode, const QList<QUrl> &list,
                        AbstractSortFilter::SortScenarios sort);
+    bool canSortInParallel(const int count) const;
+    QList<QUrl> parallelSortFiles(const QList<QUrl> &children);
     bool lessThan(const QUrl &left, const QUrl &right, AbstractSortFilter::SortScenarios sort);
+    static bool isDirInHome(const SortInfoPointer &info);
+    static bool canUseNameSortKey(const SortInfoPointer &info);
     QVariant data(const FileInfoPointer &info, Global::ItemRoles role);
     QVariant data(const SortInfoPointer &info, Global::ItemRoles role);
 
@@ -240,6 +244,7 @@ private:
     QList<QUrl> fileInfoRefresh;
     QTimer *updateRefresh {nullptr};
     std::atomic_bool mimeSorting{ false };
+    int parallelSortThreshold { 0 };
     QSet<QUrl> waitUpdatedFiles;
 };
 
@@ -78,16 +78,14 @@ bool FileViewHelper::isTransparent(const QModelIndex &index) const
 
     //  cutting
 
-    if (ClipBoard::instance()->clipboardAction() == ClipBoard::kCutAction) {
+    const auto &snapshot = ClipBoard::instance()->snapshot();
+    if (snapshot->action == ClipBoard::kCutAction) {
         QUrl localUrl = file->urlOf(UrlInfoType::kUrl);
-        auto cutUrls = ClipBoard::instance()->clipboardFileUrlList();
-        if (cutUrls.contains(localUrl)) {
-            fmDebug() << "File is transparent due to cut operation:" << localUrl.toString();
+        if (snapshot->urlSet.contains(localUrl))
             return true;
-        }
 
         if (file->canAttributes(CanableInfoType::kCanRedirectionFileUrl))
-            return cutUrls.contains(QUrl::fromLocalFile(file->pathOf(PathInfoType::kAbsoluteFilePath)));
+            return snapshot->urlSet.contains(QUrl::fromLocalFile(file->pathOf(PathInfoType::kAbsoluteFilePath)));
     }
 
     return false;
@@ -427,7 +425,7 @@ void FileViewHelper::handleTrashStateChanged()
     parent()->trashStateChanged();
 }
 
-void FileViewHelper::clipboardDataChanged()
+void FileViewHelper::handleCutStateChanged(const QList<QUrl> &urls)
 {
     if (itemDelegate()) {
         for (const QModelIndex &index : itemDelegate()->hasWidgetIndexs()) {
@@ -439,7 +437,29 @@ void FileViewHelper::clipboardDataChanged()
         }
     }
 
-    parent()->update();
+    // 只重绘可见区域内剪切状态发生变化的项
+    QSet<QUrl> changedUrls;
+    changedUrls.reserve(urls.size());
+    for (const QUrl &url : urls)
+        changedUrls.insert(url);
+
+    QRect visibleRect = parent()->viewport()->rect();
+    visibleRect.moveTop(parent()->verticalOffset());
+    auto model = parent()->model();
+    for (const auto &range : parent()->visibleIndexes(visibleRect)) {
+        for (int row = range.first; row <= range.second; ++row) {
+            const QModelIndex &index = model->index(row, 0, model->rootIndex());
+            const FileInfoPointer &file = model->fileInfo(index);
+            if (!file)
+                continue;
+
+            bool changed = changedUrls.contains(file->urlOf(UrlInfoType::kUrl));
+            if (!changed && file->canAttributes(CanableInfoType::kCanRedirectionFileUrl))
+                changed = changedUrls.contains(QUrl::fromLocalFile(file->pathOf(PathInfoType::kAbsoluteFilePath)));
+            if (changed)
+                parent()->update(index);
+        }
+    }
 }
 
 void FileViewHelper::clearSearchKey()
@@ -458,7 +478,7 @@ void FileViewHelper::init()
     fmDebug() << "Keyboard search timer initialized with 200ms interval";
 
     connect(qApp, &DApplication::iconThemeChanged, parent(), static_cast<void (QWidget::*)()>(&QWidget::update));
-    connect(ClipBoard::instance(), &ClipBoard::clipboardDataChanged, this, &FileViewHelper::clipboardDataChanged);
+    connect(ClipBoard::instance(), &ClipBoard::cutStateChanged, this, &FileViewHelper::handleCutStateChanged);
     connect(parent(), &FileView::triggerEdit, this, &FileViewHelper::triggerEdit);
     connect(WorkspaceHelper::instance(), &WorkspaceHelper::requestSelectFiles, this, &FileViewHelper::selectFiles);
     connect(WorkspaceHelper::instance(), &WorkspaceHelper::trashStateChanged, this, &FileViewHelper::handleTrashStateChanged);
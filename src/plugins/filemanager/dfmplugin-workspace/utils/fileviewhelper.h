@@ -56,7 +56,7 @@ public slots:
     void handleTrashStateChanged();
 
 private slots:
-    void clipboardDataChanged();
+    void handleCutStateChanged(const QList<QUrl> &urls);
     void clearSearchKey();
 
 signals:
@@ -0,0 +1,392 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fanotifywatcher.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSocketNotifier>
+
+#include <fcntl.h>
+#include <sys/fanotify.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+namespace {
+// 单次 read 的缓冲区大小
+constexpr size_t kEventBufferSize = 64 * 1024;
+// 目录句柄缓存上限，超过后淘汰最久未使用的句柄
+constexpr int kMaxCachedDirectories = 65536;
+
+QByteArray fsidKey(const fsid_t &fsid)
+{
+    return QByteArray(reinterpret_cast<const char *>(&fsid), sizeof(fsid));
+}
+}   // namespace
+
+FanotifyWatcher::FanotifyWatcher(QObject *parent)
+    : QObject(parent), directoryCache(kMaxCachedDirectories)
+{
+}
+
+FanotifyWatcher::~FanotifyWatcher()
+{
+    stop();
+}
+
+bool FanotifyWatcher::isSupported()
+{
+#ifdef FAN_REPORT_DFID_NAME
+    return true;
+#else
+    return false;
+#endif
+}
+
+void FanotifyWatcher::setExclusionChecker(const std::function<bool(const QString &)> &checker)
+{
+    exclusionChecker = checker;
+}
+
+bool FanotifyWatcher::start(const QStringList &rootPaths)
+{
+#ifdef FAN_REPORT_DFID_NAME
+    if (isActive())
+        return true;
+
+    fanotifyFd = fanotify_init(FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME | FAN_CLOEXEC | FAN_NONBLOCK,
+                               O_RDONLY | O_LARGEFILE);
+    if (fanotifyFd < 0) {
+        // EPERM: 缺少 CAP_SYS_ADMIN；EINVAL: 内核不支持 FAN_REPORT_DFID_NAME
+        fmInfo() << "FanotifyWatcher: fanotify_init failed:" << strerror(errno);
+        return false;
+    }
+
+    // 句柄解析出的路径不含符号链接，根路径需要同样的形式才能比较
+    this->rootPaths.clear();
+    for (const QString &root : rootPaths) {
+        const QString &canonical = QFileInfo(root).canonicalFilePath();
+        this->rootPaths.append(canonical.isEmpty() ? QDir::cleanPath(root) : canonical);
+    }
+
+    for (const QString &root : std::as_const(this->rootPaths)) {
+        if (!markFilesystem(root)) {
+            stop();
+            return false;
+        }
+    }
+
+    notifier.reset(new QSocketNotifier(fanotifyFd, QSocketNotifier::Read));
+    connect(notifier.data(), &QSocketNotifier::activated, this, &FanotifyWatcher::readEvents);
+
+    fmInfo() << "FanotifyWatcher: Watching" << mountFds.size() << "filesystems for"
+             << rootPaths.size() << "root paths";
+    return true;
+#else
+    Q_UNUSED(rootPaths)
+    fmInfo() << "FanotifyWatcher: FAN_REPORT_DFID_NAME is not available at build time";
+    return false;
+#endif
+}
+
+void FanotifyWatcher::stop()
+{
+    notifier.reset();
+
+    for (int fd : std::as_const(mountFds))
+        close(fd);
+    mountFds.clear();
+    clearDirectoryCache();
+    rootPaths.clear();
+
+    if (fanotifyFd >= 0) {
+        close(fanotifyFd);
+        fanotifyFd = -1;
+    }
+}
+
+bool FanotifyWatcher::markFilesystem(const QString &rootPath)
+{
+#ifdef FAN_REPORT_DFID_NAME
+    const QByteArray &path = rootPath.toLocal8Bit();
+
+    struct statfs fsInfo;
+    if (statfs(path.constData(), &fsInfo) != 0) {
+        fmWarning() << "FanotifyWatcher: statfs failed for" << rootPath << strerror(errno);
+        return false;
+    }
+
+    const QByteArray &key = fsidKey(fsInfo.f_fsid);
+    if (mountFds.contains(key))
+        return true;   // 同一文件系统已标记
+
+    const uint64_t baseMask = FAN_CREATE | FAN_DELETE | FAN_CLOSE_WRITE | FAN_ONDIR;
+    int ret = -1;
+#    ifdef FAN_RENAME
+    // FAN_RENAME (5.17+) 在一个事件中同时携带新旧位置，可直接还原移动
+    ret = fanotify_mark(fanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM,
+                        baseMask | FAN_RENAME, AT_FDCWD, path.constData());
+#    endif
+    if (ret != 0)
+        ret = fanotify_mark(fanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM,
+                            baseMask | FAN_MOVED_FROM | FAN_MOVED_TO, AT_FDCWD, path.constData());
+    if (ret != 0) {
+        fmInfo() << "FanotifyWatcher: fanotify_mark failed for" << rootPath << strerror(errno);
+        return false;
+    }
+
+    const int mountFd = open(path.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (mountFd < 0) {
+        fmWarning() << "FanotifyWatcher: Failed to open" << rootPath << strerror(errno);
+        return false;
+    }
+    mountFds.insert(key, mountFd);
+    return true;
+#else
+    Q_UNUSED(rootPath)
+    return false;
+#endif
+}
+
+QString FanotifyWatcher::resolveDirectory(const QByteArray &fsid, const void *fileHandle, QString *realPath)
+{
+    const auto *handle = static_cast<const struct file_handle *>(fileHandle);
+    const QByteArray &key = fsid
+            + QByteArray(reinterpret_cast<const char *>(&handle->handle_type), sizeof(handle->handle_type))
+            + QByteArray(reinterpret_cast<const char *>(handle->f_handle), static_cast<int>(handle->handle_bytes));
+
+    if (const CachedDirectory *cached = directoryCache.object(key)) {
+        if (realPath)
+            *realPath = cached->path;
+        return cached->watched ? cached->path : QString();
+    }
+
+    const int mountFd = mountFds.value(fsid, -1);
+    if (mountFd < 0)
+        return {};
+
+    // open_by_handle_at 需要 CAP_DAC_READ_SEARCH
+    const int fd = open_by_handle_at(mountFd, const_cast<struct file_handle *>(handle), O_PATH | O_CLOEXEC);
+    if (fd < 0) {
+        // ESTALE: 目录已被删除
+        if (errno == EPERM)
+            fmWarning() << "FanotifyWatcher: open_by_handle_at not permitted";
+        return {};
+    }
+
+    char buffer[PATH_MAX];
+    const QByteArray &link = QByteArray("/proc/self/fd/") + QByteArray::number(fd);
+    const ssize_t len = readlink(link.constData(), buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (len <= 0)
+        return {};
+
+    const QString &dirPath = QString::fromLocal8Bit(buffer, static_cast<int>(len));
+    // 不在根路径下或被排除的目录也缓存，避免对无关目录重复解析
+    const bool watched = isWatchedPath(dirPath);
+    cacheDirectory(key, dirPath, watched);
+
+    if (realPath)
+        *realPath = dirPath;
+    return watched ? dirPath : QString();
+}
+
+bool FanotifyWatcher::isWatchedPath(const QString &dirPath) const
+{
+    bool underRoot = false;
+    for (const QString &root : rootPaths) {
+        if (dirPath == root || dirPath.startsWith(root.endsWith('/') ? root : root + '/')) {
+            underRoot = true;
+            break;
+        }
+    }
+
+    if (!underRoot)
+        return false;
+
+    return !exclusionChecker || !exclusionChecker(dirPath);
+}
+
+void FanotifyWatcher::cacheDirectory(const QByteArray &key, const QString &dirPath, bool watched)
+{
+    if (watched) {
+        // 同一路径只保留最新的句柄，旧句柄对应的目录已不在该位置
+        const QByteArray &oldKey = cachedPaths.value(dirPath);
+        if (!oldKey.isEmpty() && oldKey != key)
+            directoryCache.remove(oldKey);
+        cachedPaths.insert(dirPath, key);
+
+        // 被淘汰的句柄在路径表中留有残项，积累过多时一并清理
+        if (cachedPaths.size() > 2 * directoryCache.maxCost()) {
+            for (auto it = cachedPaths.begin(); it != cachedPaths.end();)
+                it = directoryCache.contains(it.value()) || it.value() == key ? std::next(it) : cachedPaths.erase(it);
+        }
+    }
+    directoryCache.insert(key, new CachedDirectory { dirPath, watched });
+}
+
+void FanotifyWatcher::evictDirectory(const QString &parentPath, const QString &name)
+{
+    if (parentPath.isEmpty())
+        return;   // 父目录已不存在，其下的目录不会再产生事件
+
+    const QString &dirPath = QDir(parentPath).filePath(name);
+
+    // 改名的是根路径或其上级目录时，所有缓存的路径都可能失效
+    for (const QString &root : std::as_const(rootPaths)) {
+        if (root == dirPath || root.startsWith(dirPath + '/')) {
+            clearDirectoryCache();
+            return;
+        }
+    }
+
+    // 目录改名或删除后，它和所有子目录缓存的路径都已失效
+    auto it = cachedPaths.find(dirPath);
+    if (it != cachedPaths.end()) {
+        directoryCache.remove(it.value());
+        it = cachedPaths.erase(it);
+    }
+
+    const QString &prefix = dirPath + '/';
+    it = cachedPaths.lowerBound(prefix);
+    while (it != cachedPaths.end() && it.key().startsWith(prefix)) {
+        directoryCache.remove(it.value());
+        it = cachedPaths.erase(it);
+    }
+}
+
+void FanotifyWatcher::evictUnwatchedDirectories()
+{
+    const QList<QByteArray> &keys = directoryCache.keys();
+    for (const QByteArray &key : keys) {
+        const CachedDirectory *cached = directoryCache.object(key);
+        if (cached && !cached->watched)
+            directoryCache.remove(key);
+    }
+}
+
+void FanotifyWatcher::clearDirectoryCache()
+{
+    directoryCache.clear();
+    cachedPaths.clear();
+}
+
+void FanotifyWatcher::readEvents()
+{
+#ifdef FAN_REPORT_DFID_NAME
+    alignas(fanotify_event_metadata) char buffer[kEventBufferSize];
+
+    forever {
+        const ssize_t len = read(fanotifyFd, buffer, sizeof(buffer));
+        if (len <= 0) {
+            if (len < 0 && errno != EAGAIN && errno != EINTR)
+                fmWarning() << "FanotifyWatcher: read failed:" << strerror(errno);
+            return;
+        }
+
+        ssize_t remaining = len;
+        for (auto *meta = reinterpret_cast<fanotify_event_metadata *>(buffer);
+             FAN_EVENT_OK(meta, remaining);
+             meta = FAN_EVENT_NEXT(meta, remaining)) {
+            if (meta->vers != FANOTIFY_METADATA_VERSION) {
+                fmWarning() << "FanotifyWatcher: Unexpected metadata version" << meta->vers;
+                return;
+            }
+
+            if (meta->mask & FAN_Q_OVERFLOW) {
+                fmWarning() << "FanotifyWatcher: Event queue overflowed";
+                // 丢失的事件中可能有目录改名，缓存的路径不再可信
+                clearDirectoryCache();
+                Q_EMIT eventsOverflowed();
+                continue;
+            }
+
+            const bool isDir = meta->mask & FAN_ONDIR;
+            // real* 是父目录解析出的实际路径，父目录不在监控范围内时也有值
+            QString dirPath, name, oldDirPath, oldName, newDirPath, newName;
+            QString realDirPath, realOldDirPath;
+            bool hasOld = false;
+            bool hasNew = false;
+
+            const char *ptr = reinterpret_cast<const char *>(meta) + meta->metadata_len;
+            const char *end = reinterpret_cast<const char *>(meta) + meta->event_len;
+            while (ptr + sizeof(fanotify_event_info_header) <= end) {
+                const auto *info = reinterpret_cast<const fanotify_event_info_fid *>(ptr);
+                if (info->hdr.len == 0)
+                    break;
+
+                const auto *handle = reinterpret_cast<const struct file_handle *>(info->handle);
+                const char *entryName = reinterpret_cast<const char *>(handle->f_handle) + handle->handle_bytes;
+                const QByteArray &fsid = QByteArray(reinterpret_cast<const char *>(&info->fsid), sizeof(info->fsid));
+
+                switch (info->hdr.info_type) {
+                case FAN_EVENT_INFO_TYPE_DFID_NAME:
+                    dirPath = resolveDirectory(fsid, handle, &realDirPath);
+                    name = QString::fromLocal8Bit(entryName);
+                    break;
+#    ifdef FAN_RENAME
+                case FAN_EVENT_INFO_TYPE_OLD_DFID_NAME:
+                    hasOld = true;
+                    oldDirPath = resolveDirectory(fsid, handle, &realOldDirPath);
+                    oldName = QString::fromLocal8Bit(entryName);
+                    break;
+                case FAN_EVENT_INFO_TYPE_NEW_DFID_NAME:
+                    hasNew = true;
+                    newDirPath = resolveDirectory(fsid, handle);
+                    newName = QString::fromLocal8Bit(entryName);
+                    break;
+#    endif
+                default:
+                    break;
+                }
+                ptr += info->hdr.len;
+            }
+
+#    ifdef FAN_RENAME
+            if ((meta->mask & FAN_RENAME) && hasOld && hasNew) {
+                if (isDir) {
+                    evictDirectory(realOldDirPath, oldName);
+                    if (oldDirPath.isEmpty() && !newDirPath.isEmpty())
+                        evictUnwatchedDirectories();
+                }
+
+                // 移入或移出监控范围时分别视为创建和删除
+                if (!oldDirPath.isEmpty() && !newDirPath.isEmpty())
+                    Q_EMIT fileMoved(oldDirPath, oldName, newDirPath, newName, isDir);
+                else if (!oldDirPath.isEmpty())
+                    Q_EMIT fileDeleted(oldDirPath, oldName, isDir);
+                else if (!newDirPath.isEmpty())
+                    Q_EMIT fileCreated(newDirPath, newName, isDir);
+                continue;
+            }
+#    endif
+
+            if (isDir && (meta->mask & (FAN_DELETE | FAN_MOVED_FROM)))
+                evictDirectory(realDirPath, name);
+            // 移入的目录可能来自监控范围外，其子目录曾被缓存为空路径
+            if (isDir && (meta->mask & FAN_MOVED_TO) && !dirPath.isEmpty())
+                evictUnwatchedDirectories();
+
+            if (dirPath.isEmpty() || name.isEmpty() || name == QLatin1String("."))
+                continue;
+
+            // 不支持 FAN_RENAME 时移动事件无法配对，按删除和创建处理
+            if (meta->mask & (FAN_CREATE | FAN_MOVED_TO))
+                Q_EMIT fileCreated(dirPath, name, isDir);
+            if (meta->mask & (FAN_DELETE | FAN_MOVED_FROM))
+                Q_EMIT fileDeleted(dirPath, name, isDir);
+            if ((meta->mask & FAN_CLOSE_WRITE) && !isDir)
+                Q_EMIT fileModified(dirPath, name);
+        }
+    }
+#endif
+}
+
+SERVICETEXTINDEX_END_NAMESPACE
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FANOTIFYWATCHER_H
+#define FANOTIFYWATCHER_H
+
+#include "service_textindex_global.h"
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QMap>
+#include <QScopedPointer>
+#include <QStringList>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+class QSocketNotifier;
+QT_END_NAMESPACE
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+/**
+ * @brief Whole-filesystem change feed based on fanotify
+ *
+ * Marks the filesystem of each root path with FAN_MARK_FILESYSTEM and
+ * FAN_REPORT_DFID_NAME, so a single mark covers every directory below the
+ * roots without a recursive scan or one inotify watch per directory.
+ * Events carry the handle of the parent directory plus the entry name; the
+ * handle is resolved to a path and filtered against the root paths, which
+ * are canonicalized in start() because resolved handles never contain
+ * symbolic links.
+ *
+ * Marking a filesystem requires CAP_SYS_ADMIN and resolving handles requires
+ * CAP_DAC_READ_SEARCH; start() fails when either is missing so that the
+ * caller can fall back to inotify.
+ */
+class FanotifyWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FanotifyWatcher(QObject *parent = nullptr);
+    ~FanotifyWatcher() override;
+
+    // Whether the kernel headers the service was built with support the required flags
+    static bool isSupported();
+
+    // Set exclusion checker, called with the full path of the parent directory
+    void setExclusionChecker(const std::function<bool(const QString &)> &checker);
+
+    bool start(const QStringList &rootPaths);
+    void stop();
+    bool isActive() const { return fanotifyFd >= 0; }
+
+signals:
+    void fileCreated(const QString &path, const QString &name, bool isDir);
+    void fileDeleted(const QString &path, const QString &name, bool isDir);
+    void fileModified(const QString &path, const QString &name);
+    void fileMoved(const QString &fromPath, const QString &fromName,
+                   const QString &toPath, const QString &toName, bool isDir);
+
+    // Emitted when the kernel event queue overflowed and events were lost
+    void eventsOverflowed();
+
+private slots:
+    void readEvents();
+
+private:
+    struct CachedDirectory
+    {
+        QString path;
+        bool watched { false };
+    };
+
+    bool markFilesystem(const QString &rootPath);
+    // Returns the path of a watched directory, or an empty string; realPath receives the
+    // resolved path even when the directory is outside the roots
+    QString resolveDirectory(const QByteArray &fsid, const void *fileHandle, QString *realPath = nullptr);
+    bool isWatchedPath(const QString &dirPath) const;
+    void cacheDirectory(const QByteArray &key, const QString &dirPath, bool watched);
+    // Drop the cached handle of the directory name in parentPath and of every cached directory below it,
+    // or the whole cache when the directory is a root or one of its ancestors
+    void evictDirectory(const QString &parentPath, const QString &name);
+    // Drop the handles cached as unwatched, a directory may have been moved into the roots
+    void evictUnwatchedDirectories();
+    void clearDirectoryCache();
+
+    int fanotifyFd { -1 };
+    QScopedPointer<QSocketNotifier> notifier;
+    QStringList rootPaths;
+    // fsid -> fd of a directory on that filesystem, used by open_by_handle_at
+    QHash<QByteArray, int> mountFds;
+    // encoded directory handle -> resolved directory, least recently used handles are dropped first
+    QCache<QByteArray, CachedDirectory> directoryCache;
+    // resolved path -> encoded handle of watched directories, sorted so that the descendants of a
+    // directory are contiguous; may still name handles the cache has already dropped
+    QMap<QString, QByteArray> cachedPaths;
+    std::function<bool(const QString &)> exclusionChecker;
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // FANOTIFYWATCHER_H
@@ -110,10 +110,7 @@ bool FSEventCollectorPrivate::startCollecting()
                      });
 
     // Clear existing events
-    createdFilesList.clear();
-    deletedFilesList.clear();
-    modifiedFilesList.clear();
-    movedFilesList.clear();
+    clearAllEntries();
 
     // Start the FSMonitor
     if (!fsMonitor.start()) {
@@ -148,25 +145,22 @@ void FSEventCollectorPrivate::stopCollecting()
     fsMonitor.stop();
 
     // Clear collected events
-    createdFilesList.clear();
-    deletedFilesList.clear();
-    modifiedFilesList.clear();
-    movedFilesList.clear();
+    clearAllEntries();
 
     fmInfo() << "FSEventCollector: Stopped event collection";
 }
 
-bool FSEventCollectorPrivate::shouldIndexFile(const QString &path) const
+bool FSEventCollectorPrivate::shouldIndexFile(const QString &path, bool isDir) const
 {
     if (path.isEmpty())
         return false;
 
-    // For deleted files, don't attempt to check file system since it's gone
-    if (deletedFilesList.contains(path))
+    // Always track directories regardless of extension
+    if (isDir)
         return true;
 
-    // Always track directories regardless of extension
-    if (isDirectory(path))
+    // For deleted files, don't attempt to check file system since it's gone
+    if (deletedFilesList.contains(path))
         return true;
 
     // Get file suffix for extension check
@@ -182,7 +176,57 @@ bool FSEventCollectorPrivate::shouldIndexFile(const QString &path) const
     return supported;
 }
 
-void FSEventCollectorPrivate::handleFileCreated(const QString &path, const QString &name)
+void FSEventCollectorPrivate::insertCreated(const QString &path, bool isDir)
+{
+    createdFilesList.insert(path);
+    createdIndex.insert(path, isDir);
+    if (isDir)
+        createdDirectories.insert(path);
+}
+
+void FSEventCollectorPrivate::removeCreated(const QString &path)
+{
+    createdFilesList.remove(path);
+    createdIndex.remove(path);
+    createdDirectories.remove(path);
+}
+
+void FSEventCollectorPrivate::removeCreatedChildren(const QString &dir)
+{
+    const QString prefix = dir.endsWith('/') ? dir : dir + '/';
+    for (auto it = createdIndex.lowerBound(prefix); it != createdIndex.end() && it.key().startsWith(prefix);) {
+        fmDebug() << "FSEventCollector: Removed redundant entry, parent directory exists in list:" << it.key();
+        createdFilesList.remove(it.key());
+        createdDirectories.remove(it.key());
+        it = createdIndex.erase(it);
+    }
+}
+
+void FSEventCollectorPrivate::insertDeleted(const QString &path, bool isDir)
+{
+    deletedFilesList.insert(path);
+    if (isDir)
+        deletedDirectories.insert(path);
+}
+
+void FSEventCollectorPrivate::removeDeleted(const QString &path)
+{
+    deletedFilesList.remove(path);
+    deletedDirectories.remove(path);
+}
+
+void FSEventCollectorPrivate::clearAllEntries()
+{
+    createdFilesList.clear();
+    deletedFilesList.clear();
+    modifiedFilesList.clear();
+    movedFilesList.clear();
+    createdDirectories.clear();
+    deletedDirectories.clear();
+    createdIndex.clear();
+}
+
+void FSEventCollectorPrivate::handleFileCreated(const QString &path, const QString &name, bool isDir)
 {
     QString fullPath = normalizePath(path, name);
 
@@ -196,24 +240,24 @@ void FSEventCollectorPrivate::handleFileCreated(const QString &path, const QStri
     //    (re-creation needs reindexing as content might have changed)
     // 2. Otherwise, add to created list
     if (deletedFilesList.contains(fullPath)) {
-        deletedFilesList.remove(fullPath);
+        removeDeleted(fullPath);
 
         // Add to created list to ensure reindexing
-        if (shouldIndexFile(fullPath)) {
-            createdFilesList.insert(fullPath);
+        if (shouldIndexFile(fullPath, isDir)) {
+            insertCreated(fullPath, isDir);
             fmDebug() << "FSEventCollector: File recreated after deletion, adding to created list:" << fullPath;
         }
     } else {
         // Check if this file is under a directory that's already in the created list
-        if (!isChildOfAnyPath(fullPath, createdFilesList)) {
+        if (!isChildOfAnyPath(fullPath, createdDirectories)) {
             // Only insert if file has supported extension or is a directory
-            if (shouldIndexFile(fullPath)) {
-                createdFilesList.insert(fullPath);
+            if (shouldIndexFile(fullPath, isDir)) {
+                insertCreated(fullPath, isDir);
                 fmDebug() << "FSEventCollector: Added to created list:" << fullPath;
 
                 // If this is a directory, remove any files in the list that are under this directory
-                if (isDirectory(fullPath)) {
-                    removeRedundantEntries(createdFilesList);
+                if (isDir) {
+                    removeCreatedChildren(fullPath);
                 }
             }
         }
@@ -226,7 +270,7 @@ void FSEventCollectorPrivate::handleFileCreated(const QString &path, const QStri
     }
 }
 
-void FSEventCollectorPrivate::handleFileDeleted(const QString &path, const QString &name)
+void FSEventCollectorPrivate::handleFileDeleted(const QString &path, const QString &name, bool isDir)
 {
     QString fullPath = normalizePath(path, name);
 
@@ -240,10 +284,10 @@ void FSEventCollectorPrivate::handleFileDeleted(const QString &path, const QStri
     // 2. If file was previously modified, remove from modified list (deletion supersedes modification)
     // 3. Otherwise, add to deleted list
     if (createdFilesList.contains(fullPath)) {
-        createdFilesList.remove(fullPath);
+        removeCreated(fullPath);
         fmDebug() << "FSEventCollector: Removed from created list due to deletion:" << fullPath;
-        if (shouldIndexFile(fullPath)) {
-            deletedFilesList.insert(fullPath);
+        if (shouldIndexFile(fullPath, isDir)) {
+            insertDeleted(fullPath, isDir);
             fmDebug() << "FSEventCollector: Added to deleted list:" << fullPath;
         }
     } else {
@@ -252,8 +296,8 @@ void FSEventCollectorPrivate::handleFileDeleted(const QString &path, const QStri
             fmDebug() << "FSEventCollector: Removed from modified list due to deletion:" << fullPath;
         }
 
-        if (shouldIndexFile(fullPath)) {
-            deletedFilesList.insert(fullPath);
+        if (shouldIndexFile(fullPath, isDir)) {
+            insertDeleted(fullPath, isDir);
             fmDebug() << "FSEventCollector: Added to deleted list:" << fullPath;
         }
     }
@@ -284,9 +328,9 @@ void FSEventCollectorPrivate::handleFileModified(const QString &path, const QStr
     } else {
         // For modified files, we only care about actual files, not directories
         // So we don't need to check for parent directories or redundant entries
-        if (!isDirectory(fullPath) && !isChildOfAnyPath(fullPath, createdFilesList) && !isChildOfAnyPath(fullPath, deletedFilesList)) {
+        if (!isDirectory(fullPath) && !isChildOfAnyPath(fullPath, createdDirectories) && !isChildOfAnyPath(fullPath, deletedDirectories)) {
             // Only insert if file has supported extension
-            if (shouldIndexFile(fullPath)) {
+            if (shouldIndexFile(fullPath, false)) {
                 modifiedFilesList.insert(fullPath);
                 fmDebug() << "FSEventCollector: Added to modified list:" << fullPath;
             }
@@ -301,19 +345,19 @@ void FSEventCollectorPrivate::handleFileModified(const QString &path, const QStr
 }
 
 void FSEventCollectorPrivate::handleFileMoved(const QString &fromPath, const QString &fromName,
-                                              const QString &toPath, const QString &toName)
+                                              const QString &toPath, const QString &toName, bool isDir)
 {
     // Handle file moves as deletion from source and creation at destination
 
     // Special case: Move to outside monitored directory
     if (toPath.isEmpty() && toName.isEmpty()) {
-        handleFileDeleted(fromPath, fromName);
+        handleFileDeleted(fromPath, fromName, isDir);
         return;
     }
 
     // Special case: Move from outside monitored directory
     if (fromPath.isEmpty() && fromName.isEmpty()) {
-        handleFileCreated(toPath, toName);
+        handleFileCreated(toPath, toName, isDir);
         return;
     }
 
@@ -327,7 +371,7 @@ void FSEventCollectorPrivate::handleFileMoved(const QString &fromPath, const QSt
     }
 
     // Only track moves for files that should be indexed
-    if (!shouldIndexFile(fullFromPath) && !shouldIndexFile(fullToPath)) {
+    if (!shouldIndexFile(fullFromPath, isDir) && !shouldIndexFile(fullToPath, isDir)) {
         return;
     }
 
@@ -336,9 +380,9 @@ void FSEventCollectorPrivate::handleFileMoved(const QString &fromPath, const QSt
 
     // If the source was in created list, remove it and treat as a pure creation at new location
     if (createdFilesList.contains(fullFromPath)) {
-        createdFilesList.remove(fullFromPath);
-        if (shouldIndexFile(fullToPath)) {
-            createdFilesList.insert(fullToPath);
+        removeCreated(fullFromPath);
+        if (shouldIndexFile(fullToPath, isDir)) {
+            insertCreated(fullToPath, isDir);
             fmDebug() << "FSEventCollector: Converted move to creation, source was newly created:" << fullFromPath << "->" << fullToPath;
         }
         hasConflict = true;
@@ -353,8 +397,8 @@ void FSEventCollectorPrivate::handleFileMoved(const QString &fromPath, const QSt
     // If destination already exists in any list, we have a conflict - fall back to delete+create
     if (createdFilesList.contains(fullToPath) || deletedFilesList.contains(fullToPath) || modifiedFilesList.contains(fullToPath) || movedFilesList.contains(fullToPath)) {
         fmWarning() << "FSEventCollector: Move conflict detected, falling back to delete+create:" << fullFromPath << "->" << fullToPath;
-        handleFileDeleted(fromPath, fromName);
-        handleFileCreated(toPath, toName);
+        handleFileDeleted(fromPath, fromName, isDir);
+        handleFileCreated(toPath, toName, isDir);
         return;
     }
 
@@ -373,18 +417,18 @@ void FSEventCollectorPrivate::handleFileMoved(const QString &fromPath, const QSt
 
 void FSEventCollectorPrivate::handleDirectoryCreated(const QString &path, const QString &name)
 {
-    handleFileCreated(path, name);
+    handleFileCreated(path, name, true);
 }
 
 void FSEventCollectorPrivate::handleDirectoryDeleted(const QString &path, const QString &name)
 {
-    handleFileDeleted(path, name);
+    handleFileDeleted(path, name, true);
 }
 
 void FSEventCollectorPrivate::handleDirectoryMoved(const QString &fromPath, const QString &fromName,
                                                    const QString &toPath, const QString &toName)
 {
-    handleFileMoved(fromPath, fromName, toPath, toName);
+    handleFileMoved(fromPath, fromName, toPath, toName, true);
 }
 
 void FSEventCollectorPrivate::flushCollectedEvents()
@@ -399,10 +443,7 @@ void FSEventCollectorPrivate::flushCollectedEvents()
     QHash<QString, QString> moved = movedFilesList;
 
     // Clear the internal sets for next collection period
-    createdFilesList.clear();
-    deletedFilesList.clear();
-    modifiedFilesList.clear();
-    movedFilesList.clear();
+    clearAllEntries();
 
     // Log statistics
     fmInfo() << "FSEventCollector: Flushing events - Created:" << created.size()
@@ -430,110 +471,72 @@ void FSEventCollectorPrivate::flushCollectedEvents()
     Q_EMIT q_ptr->flushFinished();
 }
 
-void FSEventCollectorPrivate::removeRedundantEntries(QSet<QString> &filesList)
+void FSEventCollectorPrivate::removeRedundantEntries(QSet<QString> &filesList, const QSet<QString> &directories)
 {
-    QSet<QString> directoryPaths;
-    QSet<QString> filePaths;
+    if (directories.isEmpty())
+        return;
 
-    // First, separate directories from files
-    for (const QString &path : filesList) {
-        if (isDirectory(path)) {
-            directoryPaths.insert(path);
+    for (auto it = filesList.begin(); it != filesList.end();) {
+        if (isChildOfAnyPath(*it, directories)) {
+            fmDebug() << "FSEventCollector: Removed redundant entry, parent directory exists in list:" << *it;
+            createdDirectories.remove(*it);
+            deletedDirectories.remove(*it);
+            if (&filesList == &createdFilesList)
+                createdIndex.remove(*it);
+            it = filesList.erase(it);
         } else {
-            filePaths.insert(path);
+            ++it;
         }
     }
-
-    // Remove any files that are under any of the directories
-    QSet<QString> redundantPaths;
-    for (const QString &filePath : filePaths) {
-        if (isChildOfAnyPath(filePath, directoryPaths)) {
-            redundantPaths.insert(filePath);
-        }
-    }
-
-    // Remove redundant paths from the original list
-    for (const QString &path : redundantPaths) {
-        filesList.remove(path);
-        fmDebug() << "FSEventCollector: Removed redundant entry, parent directory exists in list:" << path;
-    }
 }
 
-bool FSEventCollectorPrivate::isChildOfAnyPath(const QString &path, const QSet<QString> &pathSet) const
+bool FSEventCollectorPrivate::isChildOfAnyPath(const QString &path, const QSet<QString> &directories) const
 {
     // Quick check for empty set
-    if (pathSet.isEmpty() || path.isEmpty()) {
+    if (directories.isEmpty() || path.isEmpty()) {
         return false;
     }
 
-    // For each potential parent directory in the set
-    for (const QString &potentialParent : pathSet) {
-        // Skip if the potential parent is not a directory
-        if (!isDirectory(potentialParent)) {
-            continue;
-        }
-
-        // Check if path starts with potentialParent + "/"
-        // First, normalize both paths to ensure consistent comparison
-        QString normalizedPath = QDir::cleanPath(path);
-        QString normalizedParent = QDir::cleanPath(potentialParent);
-
-        // Make sure the parent path ends with a separator
-        if (!normalizedParent.endsWith('/')) {
-            normalizedParent += '/';
-        }
-
-        // Path is a child if it starts with the parent path (including the trailing slash)
-        if (normalizedPath.startsWith(normalizedParent)) {
+    // Paths are already absolute and clean (see buildPath), so every ancestor
+    // is a prefix ending right before a separator
+    qsizetype index = path.lastIndexOf('/');
+    while (index > 0) {
+        if (directories.contains(path.left(index)))
             return true;
-        }
+        index = path.lastIndexOf('/', index - 1);
     }
 
-    return false;
+    return index == 0 && path.size() > 1 && directories.contains(QStringLiteral("/"));
 }
 
 bool FSEventCollectorPrivate::isDirectory(const QString &path) const
 {
-    QFileInfo fileInfo(path);
-    return fileInfo.isDir() && !fileInfo.isSymLink();
+    if (createdDirectories.contains(path) || deletedDirectories.contains(path))
+        return true;
+
+    // Not created or deleted in this period, so the sets know nothing about it
+    if (createdFilesList.contains(path) || deletedFilesList.contains(path))
+        return false;
+    return QFileInfo(path).isDir();
 }
 
 void FSEventCollectorPrivate::cleanupRedundantEntries()
 {
     // Clean up each list separately
-    removeRedundantEntries(createdFilesList);
-    removeRedundantEntries(deletedFilesList);
+    removeRedundantEntries(createdFilesList, createdDirectories);
+    removeRedundantEntries(deletedFilesList, deletedDirectories);
 
-    // For the modified list, we need to remove entries that:
+    // For the modified list, remove entries that:
     // 1. Are under directories in the created list (creation supersedes modification)
     // 2. Are under directories in the deleted list (deletion supersedes modification)
-
-    // First, get all directory paths from created and deleted lists
-    QSet<QString> allDirectories;
-    for (const QString &path : std::as_const(createdFilesList)) {
-        if (isDirectory(path)) {
-            allDirectories.insert(path);
-        }
-    }
-    for (const QString &path : std::as_const(deletedFilesList)) {
-        if (isDirectory(path)) {
-            allDirectories.insert(path);
-        }
-    }
-
-    // Remove any modified files that are under these directories
-    QSet<QString> redundantModified;
-    for (const QString &modifiedPath : std::as_const(modifiedFilesList)) {
-        if (isChildOfAnyPath(modifiedPath, allDirectories)) {
-            redundantModified.insert(modifiedPath);
-            fmDebug() << "FSEventCollector: Removed redundant modified entry, parent directory in created/deleted lists:" << modifiedPath;
+    for (auto it = modifiedFilesList.begin(); it != modifiedFilesList.end();) {
+        if (isChildOfAnyPath(*it, createdDirectories) || isChildOfAnyPath(*it, deletedDirectories)) {
+            fmDebug() << "FSEventCollector: Removed redundant modified entry, parent directory in created/deleted lists:" << *it;
+            it = modifiedFilesList.erase(it);
+        } else {
+            ++it;
         }
     }
-
-    // Remove the redundant entries
-    for (const QString &path : redundantModified) {
-        modifiedFilesList.remove(path);
-    }
 }
 
 bool FSEventCollectorPrivate::isMaxEventCountExceeded() const
@@ -666,10 +669,7 @@ void FSEventCollector::clearEvents()
 {
     Q_D(FSEventCollector);
 
-    d->createdFilesList.clear();
-    d->deletedFilesList.clear();
-    d->modifiedFilesList.clear();
-    d->movedFilesList.clear();
+    d->clearAllEntries();
 
     fmInfo() << "FSEventCollector: Cleared all collected events";
 }
@@ -11,6 +11,7 @@
 #include <QSet>
 #include <QDateTime>
 #include <QHash>
+#include <QMap>
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
 
@@ -30,17 +31,17 @@ public:
     void stopCollecting();
 
     // Process file created event
-    void handleFileCreated(const QString &path, const QString &name);
+    void handleFileCreated(const QString &path, const QString &name, bool isDir = false);
 
     // Process file deleted event
-    void handleFileDeleted(const QString &path, const QString &name);
+    void handleFileDeleted(const QString &path, const QString &name, bool isDir = false);
 
     // Process file modified event
     void handleFileModified(const QString &path, const QString &name);
 
     // Process file moved event
     void handleFileMoved(const QString &fromPath, const QString &fromName,
-                         const QString &toPath, const QString &toName);
+                         const QString &toPath, const QString &toName, bool isDir = false);
 
     // Process directory created event
     void handleDirectoryCreated(const QString &path, const QString &name);
@@ -58,20 +59,31 @@ public:
     // Check if max event count exceeded
     bool isMaxEventCountExceeded() const;
 
-    // Remove redundant file entries that are under directories already in the list
-    void removeRedundantEntries(QSet<QString> &filesList);
+    // Remove entries that are under any directory of the given set
+    void removeRedundantEntries(QSet<QString> &filesList, const QSet<QString> &directories);
 
-    // Check if a path is a child of any path in the given set
-    bool isChildOfAnyPath(const QString &path, const QSet<QString> &pathSet) const;
+    // Check if any ancestor directory of path is in the given directory set.
+    // Walks up the path components, O(depth) lookups without filesystem access
+    bool isChildOfAnyPath(const QString &path, const QSet<QString> &directories) const;
 
-    // Check if path is a directory
+    // Check if path is a directory: uses the type reported with its event when
+    // the path is in the created/deleted lists, otherwise stats the path
     bool isDirectory(const QString &path) const;
 
     // Remove redundant entries from all event lists
     void cleanupRedundantEntries();
 
     // Check if a file should be indexed based on its extension
-    bool shouldIndexFile(const QString &path) const;
+    bool shouldIndexFile(const QString &path, bool isDir) const;
+
+    // Keep the event lists and their directory indexes in sync
+    void insertCreated(const QString &path, bool isDir);
+    void removeCreated(const QString &path);
+    void insertDeleted(const QString &path, bool isDir);
+    void removeDeleted(const QString &path);
+    // Drop every created entry below dir, found by a range lookup in createdIndex
+    void removeCreatedChildren(const QString &dir);
+    void clearAllEntries();
 
     // Normalize path for consistent handling
     QString normalizePath(const QString &dirPath, const QString &fileName) const;
@@ -106,6 +118,15 @@ public:
 
     // New: Track moved/renamed files separately for efficient index updates
     QHash<QString, QString> movedFilesList;   // fromPath -> toPath mapping
+
+    // Directory entries of createdFilesList / deletedFilesList, recorded when
+    // the event arrives so that redundancy pruning never has to stat paths
+    QSet<QString> createdDirectories;
+    QSet<QString> deletedDirectories;
+
+    // Sorted copy of createdFilesList: the entries below a directory form one
+    // contiguous range starting at the directory prefix
+    QMap<QString, bool> createdIndex;
 };
 
 SERVICETEXTINDEX_END_NAMESPACE
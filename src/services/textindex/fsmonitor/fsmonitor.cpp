@@ -113,6 +113,12 @@ bool FSMonitorPrivate::init(const QStringList &rootPaths)
     // Setup watcher connections
     setupWatcherConnections();
 
+    fanotifyWatcher.reset(new FanotifyWatcher());
+    fanotifyWatcher->setExclusionChecker([this](const QString &path) {
+        return shouldExcludePath(path);
+    });
+    setupFanotifyConnections();
+
     // Add default blacklisted paths
     const auto &defaultBlacklistedDirs = TextIndexConfig::instance().folderExcludeFilters();
     for (const QString &dir : defaultBlacklistedDirs) {
@@ -136,6 +142,13 @@ bool FSMonitorPrivate::startMonitoring()
         return true;
     }
 
+    // fanotify covers whole filesystems with a single mark, no directory scan needed
+    if (useFanotify && startFanotifyMonitoring()) {
+        active = true;
+        fmInfo() << "FSMonitor: Started monitoring with fanotify backend";
+        return true;
+    }
+
     // Determine system limits for inotify watches
     maxWatches = getMaxUserWatches();
     if (maxWatches <= 0) {
@@ -175,6 +188,11 @@ void FSMonitorPrivate::stopMonitoring()
 
     active = false;
 
+    if (fanotifyActive) {
+        fanotifyWatcher->stop();
+        fanotifyActive = false;
+    }
+
     // Clear all watched directories
     if (!watchedDirectories.isEmpty() && watcher) {
         watcher->removePaths(watchedDirectories.values());
@@ -184,6 +202,20 @@ void FSMonitorPrivate::stopMonitoring()
     fmInfo() << "FSMonitor: Stopped all monitoring";
 }
 
+bool FSMonitorPrivate::startFanotifyMonitoring()
+{
+    if (!fanotifyWatcher || !FanotifyWatcher::isSupported()) {
+        return false;
+    }
+
+    fanotifyActive = fanotifyWatcher->start(rootPaths);
+    if (!fanotifyActive) {
+        fmInfo() << "FSMonitor: fanotify backend unavailable, falling back to inotify";
+    }
+
+    return fanotifyActive;
+}
+
 void FSMonitorPrivate::travelRootDirectories()
 {
     // Process the root directories using traditional method
@@ -456,6 +488,52 @@ void FSMonitorPrivate::setupWatcherConnections()
                      });
 }
 
+void FSMonitorPrivate::setupFanotifyConnections()
+{
+    // fanotify reports whether the entry is a directory, so events are
+    // forwarded directly instead of going through the inotify handlers
+    QObject::connect(fanotifyWatcher.data(), &FanotifyWatcher::fileCreated,
+                     q_ptr, [this](const QString &path, const QString &name, bool isDir) {
+                         if (!active || (!showHidden() && name.startsWith('.')))
+                             return;
+                         if (isDir)
+                             Q_EMIT q_ptr->directoryCreated(path, name);
+                         else
+                             Q_EMIT q_ptr->fileCreated(path, name);
+                     });
+
+    QObject::connect(fanotifyWatcher.data(), &FanotifyWatcher::fileDeleted,
+                     q_ptr, [this](const QString &path, const QString &name, bool isDir) {
+                         if (!active || (!showHidden() && name.startsWith('.')))
+                             return;
+                         if (isDir)
+                             Q_EMIT q_ptr->directoryDeleted(path, name);
+                         else
+                             Q_EMIT q_ptr->fileDeleted(path, name);
+                     });
+
+    QObject::connect(fanotifyWatcher.data(), &FanotifyWatcher::fileModified,
+                     q_ptr, [this](const QString &path, const QString &name) {
+                         handleFileModified(path, name);
+                     });
+
+    QObject::connect(fanotifyWatcher.data(), &FanotifyWatcher::fileMoved,
+                     q_ptr, [this](const QString &fromPath, const QString &fromName,
+                                   const QString &toPath, const QString &toName, bool isDir) {
+                         if (!active || (!showHidden() && (fromName.startsWith('.') || toName.startsWith('.'))))
+                             return;
+                         if (isDir)
+                             Q_EMIT q_ptr->directoryMoved(fromPath, fromName, toPath, toName);
+                         else
+                             Q_EMIT q_ptr->fileMoved(fromPath, fromName, toPath, toName);
+                     });
+
+    QObject::connect(fanotifyWatcher.data(), &FanotifyWatcher::eventsOverflowed,
+                     q_ptr, [this]() {
+                         Q_EMIT q_ptr->errorOccurred(QStringLiteral("fanotify event queue overflowed"));
+                     });
+}
+
 void FSMonitorPrivate::handleFileCreated(const QString &path, const QString &name)
 {
     if (!active || path.isEmpty()) {
@@ -7,6 +7,7 @@
 
 #include "fsmonitor.h"
 #include "fsmonitorworker.h"
+#include "fanotifywatcher.h"
 
 #include <QFileInfo>
 #include <QSet>
@@ -37,6 +38,9 @@ public:
     // Stop all monitoring
     void stopMonitoring();
 
+    // Start monitoring using fanotify, returns false if not permitted or supported
+    bool startFanotifyMonitoring();
+
     // Process the root directories using traditional method
     void travelRootDirectories();
 
@@ -70,6 +74,9 @@ public:
     // Parse and connect watcher signals
     void setupWatcherConnections();
 
+    // Connect fanotify watcher signals
+    void setupFanotifyConnections();
+
     // Set up the worker thread and connections
     void setupWorkerThread();
 
@@ -98,9 +105,14 @@ public:
     // Fast scan control
     bool useFastScan { true };   // Whether to try fast scan first
 
+    // Whether to try the fanotify backend before inotify
+    bool useFanotify { true };
+
     // Data members
     FSMonitor *q_ptr;
     QScopedPointer<Dtk::Core::DFileSystemWatcher> watcher;
+    QScopedPointer<FanotifyWatcher> fanotifyWatcher;
+    bool fanotifyActive { false };
 
     // Worker thread members
     QThread workerThread;
@@ -35,6 +35,8 @@ inline const QString kFolderExcludeFilters = QLatin1String("folderExcludeFilters
 inline const QString kCpuUsageLimitPercent = QLatin1String("cpuUsageLimitPercent");
 inline const QString kInotifyWatchesCoefficient = QLatin1String("inotifyWatchesCoefficient");
 inline const QString kBatchCommitInterval = QLatin1String("batchCommitInterval");
+inline const QString kIndexWorkerCount = QLatin1String("indexWorkerCount");
+inline const QString kContentDeduplication = QLatin1String("contentDeduplication");
 
 }   // namesapce DConf
 
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "documentpipeline.h"
+#include "utils/processprioritymanager.h"
+#include "utils/textindexconfig.h"
+
+SERVICETEXTINDEX_USE_NAMESPACE
+using namespace Lucene;
+
+namespace {
+// 队列等待超时，用于及时响应任务中断
+constexpr unsigned long kWaitTimeoutMs = 100;
+// 每个提取线程对应的队列容量
+constexpr int kQueueSlotsPerWorker = 32;
+// 自动模式下提取线程数量上限
+constexpr int kMaxAutoWorkerCount = 8;
+}   // namespace
+
+double DocumentPipeline::Statistics::documentsPerSecond() const
+{
+    return elapsedMs > 0 ? documents * 1000.0 / elapsedMs : 0.0;
+}
+
+double DocumentPipeline::Statistics::megabytesPerSecond() const
+{
+    return elapsedMs > 0 ? (bytes / (1024.0 * 1024.0)) * 1000.0 / elapsedMs : 0.0;
+}
+
+DocumentPipeline::DocumentPipeline(int workerCount, TaskState &state,
+                                   DocumentBuilder builder, DocumentConsumer consumer)
+    : m_workerCount(qMax(1, workerCount)),
+      m_inputCapacity(m_workerCount * kQueueSlotsPerWorker),
+      m_outputCapacity(m_workerCount * kQueueSlotsPerWorker),
+      m_state(state),
+      m_builder(std::move(builder)),
+      m_consumer(std::move(consumer))
+{
+    fmInfo() << "[DocumentPipeline] Initialized with" << m_workerCount << "extraction workers";
+}
+
+DocumentPipeline::~DocumentPipeline()
+{
+    if (m_started && !m_finished)
+        finish();
+}
+
+int DocumentPipeline::configuredWorkerCount()
+{
+    const TextIndexConfig &config = TextIndexConfig::instance();
+    int count = config.indexWorkerCount();
+    if (count > 0)
+        return count;
+
+    // 自动模式：按 CPU 使用率限制折算可用核心数
+    count = QThread::idealThreadCount() * config.cpuUsageLimitPercent() / 100;
+    return qBound(1, count, kMaxAutoWorkerCount);
+}
+
+void DocumentPipeline::start()
+{
+    if (m_started)
+        return;
+
+    m_started = true;
+    m_activeWorkers = m_workerCount;
+    m_timer.start();
+
+    for (int i = 0; i < m_workerCount; ++i) {
+        m_workers.emplace_back(QThread::create([this]() {
+            // 新线程不一定继承服务的低优先级设置，这里显式降低
+            ProcessPriorityManager::lowerAllAvailablePriorities();
+            extractLoop();
+        }));
+        m_workers.back()->start();
+    }
+
+    m_writer.reset(QThread::create([this]() { writeLoop(); }));
+    m_writer->start();
+}
+
+bool DocumentPipeline::enqueue(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_inputQueue.size() >= m_inputCapacity && !isStopped())
+        m_inputNotFull.wait(&m_mutex, kWaitTimeoutMs);
+
+    if (m_inputClosed || isStopped())
+        return false;
+
+    m_inputQueue.enqueue(path);
+    m_inputNotEmpty.wakeOne();
+    return true;
+}
+
+void DocumentPipeline::finish()
+{
+    if (!m_started || m_finished)
+        return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_inputClosed = true;
+        m_inputNotEmpty.wakeAll();
+    }
+
+    for (auto &worker : m_workers)
+        worker->wait();
+    m_writer->wait();
+    m_finished = true;
+
+    QMutexLocker locker(&m_mutex);
+    m_stats.elapsedMs = m_timer.elapsed();
+    fmInfo() << "[DocumentPipeline::finish] Pipeline finished - workers:" << m_workerCount
+             << "documents:" << m_stats.documents
+             << "bytes:" << m_stats.bytes
+             << "elapsed(ms):" << m_stats.elapsedMs
+             << "docs/sec:" << m_stats.documentsPerSecond()
+             << "MB/sec:" << m_stats.megabytesPerSecond();
+}
+
+DocumentPipeline::Statistics DocumentPipeline::statistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    Statistics stats = m_stats;
+    if (!m_finished && m_timer.isValid())
+        stats.elapsedMs = m_timer.elapsed();
+    return stats;
+}
+
+bool DocumentPipeline::isStopped() const
+{
+    return !m_state.isRunning();
+}
+
+void DocumentPipeline::extractLoop()
+{
+    forever {
+        QString path;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_inputQueue.isEmpty() && !m_inputClosed && !isStopped())
+                m_inputNotEmpty.wait(&m_mutex, kWaitTimeoutMs);
+
+            if (isStopped() || m_inputQueue.isEmpty())
+                break;
+
+            path = m_inputQueue.dequeue();
+            m_inputNotFull.wakeOne();
+        }
+
+        qint64 size = 0;
+        DocumentPtr doc = m_builder(path, &size);
+        if (!doc)
+            continue;
+
+        BuiltDocument built { path, doc, size };
+        QMutexLocker locker(&m_mutex);
+        while (m_outputQueue.size() >= m_outputCapacity && !isStopped())
+            m_outputNotFull.wait(&m_mutex, kWaitTimeoutMs);
+
+        if (isStopped())
+            break;
+
+        m_outputQueue.enqueue(std::move(built));
+        m_outputNotEmpty.wakeOne();
+    }
+
+    QMutexLocker locker(&m_mutex);
+    --m_activeWorkers;
+    m_outputNotEmpty.wakeAll();
+}
+
+void DocumentPipeline::writeLoop()
+{
+    forever {
+        BuiltDocument built;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_outputQueue.isEmpty() && m_activeWorkers > 0 && !isStopped())
+                m_outputNotEmpty.wait(&m_mutex, kWaitTimeoutMs);
+
+            if (isStopped() || m_outputQueue.isEmpty())
+                break;
+
+            built = m_outputQueue.dequeue();
+            m_outputNotFull.wakeOne();
+        }
+
+        m_consumer(built.path, built.doc);
+
+        QMutexLocker locker(&m_mutex);
+        ++m_stats.documents;
+        m_stats.bytes += built.size;
+    }
+}
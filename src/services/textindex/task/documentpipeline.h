@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DOCUMENTPIPELINE_H
+#define DOCUMENTPIPELINE_H
+
+#include "service_textindex_global.h"
+#include "utils/taskstate.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <QString>
+#include <QQueue>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+#include <QElapsedTimer>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+/**
+ * @brief Bounded producer/consumer pipeline for building Lucene documents
+ *
+ * The producer (usually a FileProvider traversal) feeds file paths through
+ * enqueue(). A pool of extraction workers turns each path into a document
+ * in parallel, and a single writer thread hands every built document to the
+ * consumer. Both queues are bounded, which keeps memory flat no matter how
+ * fast the provider is compared to document extraction.
+ *
+ * The builder runs concurrently on the workers and must not use the
+ * IndexWriter; everything written to the index, including the content
+ * documents of ContentDeduplicator::prepareDocument(), goes through the
+ * consumer. The consumer only runs on the writer thread, so it needs no
+ * locking of its own for the writer or the ProgressReporter.
+ */
+class DocumentPipeline
+{
+public:
+    // fileSize receives the size of the file read by the builder, for the statistics
+    using DocumentBuilder = std::function<Lucene::DocumentPtr(const QString &path, qint64 *fileSize)>;
+    using DocumentConsumer = std::function<void(const QString &path, const Lucene::DocumentPtr &doc)>;
+
+    struct Statistics
+    {
+        qint64 documents { 0 };
+        qint64 bytes { 0 };
+        qint64 elapsedMs { 0 };
+
+        double documentsPerSecond() const;
+        double megabytesPerSecond() const;
+    };
+
+    DocumentPipeline(int workerCount, TaskState &state,
+                     DocumentBuilder builder, DocumentConsumer consumer);
+    ~DocumentPipeline();
+
+    void start();
+
+    /**
+     * @brief Queue a file for extraction, blocks while the input queue is full
+     * @return false if the pipeline is no longer accepting input
+     */
+    bool enqueue(const QString &path);
+
+    /**
+     * @brief Close the input and wait until every queued file has been consumed
+     */
+    void finish();
+
+    int workerCount() const { return m_workerCount; }
+    Statistics statistics() const;
+
+    /**
+     * @brief Resolve the number of extraction workers from TextIndexConfig
+     */
+    static int configuredWorkerCount();
+
+private:
+    struct BuiltDocument
+    {
+        QString path;
+        Lucene::DocumentPtr doc;
+        qint64 size { 0 };
+    };
+
+    void extractLoop();
+    void writeLoop();
+    bool isStopped() const;
+
+    const int m_workerCount;
+    const int m_inputCapacity;
+    const int m_outputCapacity;
+    TaskState &m_state;
+    DocumentBuilder m_builder;
+    DocumentConsumer m_consumer;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_inputNotFull;
+    QWaitCondition m_inputNotEmpty;
+    QWaitCondition m_outputNotFull;
+    QWaitCondition m_outputNotEmpty;
+    QQueue<QString> m_inputQueue;
+    QQueue<BuiltDocument> m_outputQueue;
+    bool m_inputClosed { false };
+    int m_activeWorkers { 0 };
+
+    std::vector<std::unique_ptr<QThread>> m_workers;
+    std::unique_ptr<QThread> m_writer;
+
+    QElapsedTimer m_timer;
+    Statistics m_stats;
+    bool m_started { false };
+    bool m_finished { false };
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // DOCUMENTPIPELINE_H
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "indexsnapshot.h"
+#include "utils/scopeguard.h"
+
+#include <QElapsedTimer>
+
+#include <functional>
+#include <vector>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+using namespace Lucene;
+
+namespace {
+
+// 遍历指定字段的全部词项，回调 (docId, 词项文本)
+bool forEachFieldTerm(const IndexReaderPtr &reader, const String &field, TaskState &running,
+                      const std::function<void(int32_t, const String &)> &callback)
+{
+    TermEnumPtr termEnum = reader->terms(newLucene<Term>(field, L""));
+    TermDocsPtr termDocs = reader->termDocs();
+    ScopeGuard closer([&termEnum, &termDocs]() {
+        termEnum->close();
+        termDocs->close();
+    });
+
+    do {
+        TermPtr term = termEnum->term();
+        if (!term || term->field() != field)
+            break;
+
+        if (!running.isRunning())
+            return false;
+
+        termDocs->seek(termEnum);
+        while (termDocs->next())
+            callback(termDocs->doc(), term->text());
+    } while (termEnum->next());
+
+    return true;
+}
+
+}   // namespace
+
+bool IndexSnapshot::load(const IndexReaderPtr &reader, TaskState &running)
+{
+    m_modifiedTimes.clear();
+    if (!reader)
+        return false;
+
+    try {
+        QElapsedTimer timer;
+        timer.start();
+
+        // 先建立 docId -> path 映射，再按 modified 词项回填时间，两次遍历均不加载存储字段
+        std::vector<QString> docPaths(static_cast<size_t>(reader->maxDoc()));
+        bool completed = forEachFieldTerm(reader, L"path", running,
+                                          [&docPaths](int32_t doc, const String &text) {
+                                              docPaths[static_cast<size_t>(doc)] = QString::fromStdWString(text);
+                                          });
+        if (!completed)
+            return false;
+
+        m_modifiedTimes.reserve(reader->numDocs());
+        for (const QString &path : docPaths) {
+            if (!path.isEmpty())
+                m_modifiedTimes.insert(path, -1);
+        }
+
+        completed = forEachFieldTerm(reader, L"modified", running,
+                                     [this, &docPaths](int32_t doc, const String &text) {
+                                         const QString &path = docPaths[static_cast<size_t>(doc)];
+                                         if (path.isEmpty())
+                                             return;
+                                         bool ok = false;
+                                         const qint64 modified = QString::fromStdWString(text).toLongLong(&ok);
+                                         m_modifiedTimes.insert(path, ok ? modified : -1);
+                                     });
+        if (!completed)
+            return false;
+
+        fmInfo() << "[IndexSnapshot::load] Loaded" << m_modifiedTimes.size()
+                 << "indexed paths in" << timer.elapsed() << "ms";
+        return true;
+    } catch (const LuceneException &e) {
+        fmWarning() << "[IndexSnapshot::load] Load snapshot failed with Lucene exception:"
+                    << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        fmWarning() << "[IndexSnapshot::load] Load snapshot failed with exception:" << e.what();
+    }
+
+    m_modifiedTimes.clear();
+    return false;
+}
+
+bool IndexSnapshot::lookup(const QString &path, qint64 *modified) const
+{
+    auto it = m_modifiedTimes.constFind(path);
+    if (it == m_modifiedTimes.constEnd())
+        return false;
+
+    if (modified)
+        *modified = it.value();
+    return true;
+}
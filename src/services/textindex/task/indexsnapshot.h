@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INDEXSNAPSHOT_H
+#define INDEXSNAPSHOT_H
+
+#include "service_textindex_global.h"
+#include "utils/taskstate.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <QHash>
+#include <QString>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+/**
+ * @brief In-memory map of indexed paths to their stored modification time
+ *
+ * Built once per update run by streaming the terms of the "path" and
+ * "modified" fields, so that the filesystem walk can be diffed against
+ * the index without running a query per file.
+ */
+class IndexSnapshot
+{
+public:
+    /**
+     * @brief Load all live "path" -> "modified" pairs from the reader
+     * @param reader Index reader to scan
+     * @param running Task state for interruption checking
+     * @return true if the snapshot is complete, false if interrupted or failed
+     */
+    bool load(const Lucene::IndexReaderPtr &reader, TaskState &running);
+
+    /**
+     * @brief Look up an indexed path
+     * @param path File path
+     * @param modified Receives the stored modification time (seconds since epoch)
+     * @return true if the path is in the index
+     */
+    bool lookup(const QString &path, qint64 *modified = nullptr) const;
+
+    int size() const { return m_modifiedTimes.size(); }
+
+private:
+    QHash<QString, qint64> m_modifiedTimes;
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // INDEXSNAPSHOT_H
@@ -25,6 +25,8 @@ IndexTask::IndexTask(Type type, const QString &path, TaskHandler handler, QObjec
     // 连接进度通知
     connect(ProgressNotifier::instance(), &ProgressNotifier::progressChanged,
             this, &IndexTask::onProgressChanged);
+    connect(ProgressNotifier::instance(), &ProgressNotifier::cleanupProgressChanged,
+            this, &IndexTask::onCleanupProgressChanged);
 }
 
 IndexTask::~IndexTask()
@@ -32,6 +34,8 @@ IndexTask::~IndexTask()
     fmDebug() << "[IndexTask] Destroying task for path:" << m_path;
     disconnect(ProgressNotifier::instance(), &ProgressNotifier::progressChanged,
                this, &IndexTask::onProgressChanged);
+    disconnect(ProgressNotifier::instance(), &ProgressNotifier::cleanupProgressChanged,
+               this, &IndexTask::onCleanupProgressChanged);
 }
 
 void IndexTask::onProgressChanged(qint64 count, qint64 total)
@@ -48,6 +52,17 @@ void IndexTask::onProgressChanged(qint64 count, qint64 total)
     }
 }
 
+void IndexTask::onCleanupProgressChanged(qint64 checked, qint64 total, qint64 peakRssKB)
+{
+    if (!m_state.isRunning())
+        return;
+
+    fmDebug() << "[IndexTask::onCleanupProgressChanged] Cleanup progress - type:" << static_cast<int>(m_type)
+              << "checked:" << checked << "total:" << total << "peak RSS(KB):" << peakRssKB;
+    // 清理阶段以索引文档数为总量，与文件处理进度分开上报
+    emit cleanupProgressChanged(m_type, checked, total);
+}
+
 bool IndexTask::silent() const
 {
     return m_silent;
@@ -55,12 +55,14 @@ public:
 
 Q_SIGNALS:
     void progressChanged(SERVICETEXTINDEX_NAMESPACE::IndexTask::Type type, qint64 count, qint64 total);
+    void cleanupProgressChanged(SERVICETEXTINDEX_NAMESPACE::IndexTask::Type type, qint64 checked, qint64 total);
     void finished(SERVICETEXTINDEX_NAMESPACE::IndexTask::Type type, SERVICETEXTINDEX_NAMESPACE::HandlerResult result);
 
 private:
     void throttleCpuUsage();
     void doTask();
     void onProgressChanged(qint64 count, qint64 total);
+    void onCleanupProgressChanged(qint64 checked, qint64 total, qint64 peakRssKB);
 
     Type m_type;
     QString m_path;
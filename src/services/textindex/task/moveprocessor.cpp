@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "moveprocessor.h"
+#include "utils/contentdeduplicator.h"
 #include "utils/docutils.h"
 #include "utils/indexutility.h"
 #include "utils/textindexconfig.h"
@@ -57,6 +58,9 @@ bool FileMoveProcessor::processFileMove(const QString &fromPath, const QString &
             return false;
         }
 
+        // Deduplicated documents do not store their contents, get them back before re-adding
+        ContentDeduplicator::restoreContents(newDoc, m_searcher);
+
         // Add new path field
         newDoc->add(newLucene<Field>(L"path", toPath.toStdWString(),
                                      Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
@@ -272,6 +276,9 @@ bool DirectoryMoveProcessor::updateSingleDocumentPath(const DocumentPtr &doc,
             return false;
         }
 
+        // Deduplicated documents do not store their contents, get them back before re-adding
+        ContentDeduplicator::restoreContents(newDoc, m_searcher);
+
         // Add new path field
         newDoc->add(newLucene<Field>(L"path", newPath.toStdWString(),
                                      Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
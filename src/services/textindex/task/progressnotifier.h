@@ -19,6 +19,8 @@ public:
 
 Q_SIGNALS:
     void progressChanged(qint64 count, qint64 total);
+    // 索引清理进度，peakRssKB 为进程的峰值常驻内存
+    void cleanupProgressChanged(qint64 checked, qint64 total, qint64 peakRssKB);
 
 private:
     explicit ProgressNotifier(QObject *parent = nullptr)
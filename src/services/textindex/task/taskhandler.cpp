@@ -6,7 +6,10 @@
 #include "fileprovider.h"
 #include "progressnotifier.h"
 #include "moveprocessor.h"
+#include "documentpipeline.h"
+#include "indexsnapshot.h"
 #include "utils/scopeguard.h"
+#include "utils/contentdeduplicator.h"
 #include "utils/docutils.h"
 #include "utils/indexutility.h"
 #include "utils/textindexconfig.h"
@@ -24,6 +27,15 @@
 
 #include <QDir>
 #include <QDateTime>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <vector>
 
 SERVICETEXTINDEX_USE_NAMESPACE
 
@@ -112,8 +124,8 @@ private:
 // 目录遍历相关函数
 using FileHandler = std::function<void(const QString &path)>;
 
-// 文档处理相关函数
-DocumentPtr createFileDocument(const QString &file)
+// 文档处理相关函数，fileSize 返回读取到的文件大小
+DocumentPtr createFileDocument(const QString &file, qint64 *fileSize = nullptr)
 {
     try {
         DocumentPtr doc = newLucene<Document>();
@@ -124,6 +136,8 @@ DocumentPtr createFileDocument(const QString &file)
 
         // file last modified time
         QFileInfo fileInfo(file);
+        if (fileSize)
+            *fileSize = fileInfo.size();
         const QDateTime modifyTime = fileInfo.lastModified();
         const QString modifyEpoch = QString::number(modifyTime.toSecsSinceEpoch());
         doc->add(newLucene<Field>(L"modified", modifyEpoch.toStdWString(),
@@ -144,18 +158,40 @@ DocumentPtr createFileDocument(const QString &file)
         const TextIndexConfig &config = TextIndexConfig::instance();
         const int truncationSizeMB = config.maxIndexFileTruncationSizeMB();
         const size_t maxBytes = static_cast<size_t>(truncationSizeMB) * 1024 * 1024;
-        
-        const auto &contentOpt = DocUtils::extractFileContent(file, maxBytes);
 
-        if (!contentOpt) {
-            fmWarning() << "[createFileDocument] Failed to extract content from file:" << file;
-            return doc;   // Return document without content
+        // 去重模式下内容相同的副本直接复用本次任务中已提取的文本
+        const bool deduplicate = ContentDeduplicator::isEnabled();
+        QByteArray fileHash;
+        std::optional<QString> knownContents;
+        if (deduplicate) {
+            fileHash = ContentDeduplicator::computeFileHash(file, static_cast<qint64>(maxBytes));
+            if (!fileHash.isEmpty())
+                knownContents = ContentDeduplicator::instance().knownContents(fileHash);
         }
 
-        const QString &contents = contentOpt.value().trimmed();
+        QString contents;
+        if (knownContents) {
+            contents = knownContents.value();
+        } else {
+            const auto &contentOpt = DocUtils::extractFileContent(file, maxBytes);
+
+            if (!contentOpt) {
+                fmWarning() << "[createFileDocument] Failed to extract content from file:" << file;
+                return doc;   // Return document without content
+            }
 
-        doc->add(newLucene<Field>(L"contents", contents.toStdWString(),
-                                  Field::STORE_YES, Field::INDEX_ANALYZED));
+            contents = contentOpt.value().trimmed();
+            if (!fileHash.isEmpty())
+                ContentDeduplicator::instance().rememberContents(fileHash, contents);
+        }
+
+        if (deduplicate) {
+            // 文本只在以文本哈希为键的内容文档中存储一次，内容文档由写入线程补齐
+            ContentDeduplicator::addContentFields(doc, contents);
+        } else {
+            doc->add(newLucene<Field>(L"contents", contents.toStdWString(),
+                                      Field::STORE_YES, Field::INDEX_ANALYZED));
+        }
 
         return doc;
     } catch (const LuceneException &e) {
@@ -181,10 +217,33 @@ DocumentPtr createFileDocument(const QString &file)
     }
 }
 
-bool checkNeedUpdate(const QString &file, const IndexReaderPtr &reader, bool *needAdd)
+// 判断文件是否需要更新，needAdd 表示索引中不存在该文件
+using UpdateChecker = std::function<bool(const QString &file, bool *needAdd)>;
+
+bool isModifiedSince(const QString &file, const QString &storeTime)
+{
+    QFileInfo fileInfo(file);
+    if (!fileInfo.exists()) {
+        fmDebug() << "[checkNeedUpdate] File no longer exists:" << file;
+        return false;
+    }
+
+    const QDateTime modifyTime = fileInfo.lastModified();
+    const QString modifyEpoch = QString::number(modifyTime.toSecsSinceEpoch());
+
+    bool needsUpdate = modifyEpoch != storeTime;
+    if (needsUpdate) {
+        fmDebug() << "[checkNeedUpdate] File needs update:" << file
+                 << "stored time:" << storeTime
+                 << "current time:" << modifyEpoch;
+    }
+    return needsUpdate;
+}
+
+// 使用共享的 searcher 逐个查询，适用于文件数量较少的场景
+bool checkNeedUpdate(const QString &file, const SearcherPtr &searcher, bool *needAdd)
 {
     try {
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
         TermQueryPtr query = newLucene<TermQuery>(newLucene<Term>(L"path", file.toStdWString()));
 
         TopDocsPtr topDocs = searcher->search(query, 1);
@@ -196,23 +255,7 @@ bool checkNeedUpdate(const QString &file, const IndexReaderPtr &reader, bool *ne
         }
 
         DocumentPtr doc = searcher->doc(topDocs->scoreDocs[0]->doc);
-        QFileInfo fileInfo(file);
-        if (!fileInfo.exists()) {
-            fmDebug() << "[checkNeedUpdate] File no longer exists:" << file;
-            return false;
-        }
-
-        const QDateTime modifyTime = fileInfo.lastModified();
-        const QString modifyEpoch = QString::number(modifyTime.toSecsSinceEpoch());
-        const String &storeTime = doc->get(L"modified");
-
-        bool needsUpdate = modifyEpoch.toStdWString() != storeTime;
-        if (needsUpdate) {
-            fmDebug() << "[checkNeedUpdate] File needs update:" << file 
-                     << "stored time:" << QString::fromStdWString(storeTime) 
-                     << "current time:" << modifyEpoch;
-        }
-        return needsUpdate;
+        return isModifiedSince(file, QString::fromStdWString(doc->get(L"modified")));
     } catch (const LuceneException &e) {
         fmWarning() << "[checkNeedUpdate] Check update failed with Lucene exception:" << file
                     << "error:" << QString::fromStdWString(e.getError());
@@ -227,35 +270,63 @@ bool checkNeedUpdate(const QString &file, const IndexReaderPtr &reader, bool *ne
     }
 }
 
-void processFile(const QString &path, const IndexWriterPtr &writer, ProgressReporter *reporter)
+// 使用预加载的索引快照在内存中比较，适用于全量更新
+bool checkNeedUpdate(const QString &file, const IndexSnapshot &snapshot, bool *needAdd)
+{
+    qint64 storeTime = -1;
+    if (!snapshot.lookup(file, &storeTime)) {
+        if (needAdd)
+            *needAdd = true;
+        return true;
+    }
+
+    return isModifiedSince(file, QString::number(storeTime));
+}
+
+// 在提取线程中构建文档，不支持的文件返回空指针
+DocumentPtr buildFileDocument(const QString &path, qint64 *fileSize)
 {
     try {
         if (!IndexUtility::isSupportedFile(path))
-            return;
+            return nullptr;
 #ifdef QT_DEBUG
         fmDebug() << "Adding [" << path << "]";
 #endif
-        DocumentPtr doc = createFileDocument(path);
-        if (!doc) {
-            fmWarning() << "[processFile] Failed to create document for:" << path;
-            return;
-        }
+        DocumentPtr doc = createFileDocument(path, fileSize);
+        if (!doc)
+            fmWarning() << "[buildFileDocument] Failed to create document for:" << path;
+        return doc;
+    } catch (const std::exception &e) {
+        fmWarning() << "[buildFileDocument] Build document failed with exception:" << path
+                    << "error:" << e.what();
+    } catch (...) {
+        fmWarning() << "[buildFileDocument] Build document failed with unknown exception:" << path;
+    }
+    return nullptr;
+}
+
+// 在写入线程中将文档及其引用的内容文档写入索引
+void writeFileDocument(const QString &path, const DocumentPtr &doc,
+                       const IndexWriterPtr &writer, ProgressReporter *reporter)
+{
+    try {
+        ContentDeduplicator::instance().prepareDocument(doc);
         writer->addDocument(doc);
         if (reporter) {
             reporter->increment();
         }
     } catch (const LuceneException &e) {
-        fmWarning() << "[processFile] Process file failed with Lucene exception:" << path
+        fmWarning() << "[writeFileDocument] Write document failed with Lucene exception:" << path
                     << "error:" << QString::fromStdWString(e.getError());
     } catch (const std::exception &e) {
-        fmWarning() << "[processFile] Process file failed with exception:" << path 
-                   << "error:" << e.what();
+        fmWarning() << "[writeFileDocument] Write document failed with exception:" << path
+                    << "error:" << e.what();
     } catch (...) {
-        fmWarning() << "[processFile] Process file failed with unknown exception:" << path;
+        fmWarning() << "[writeFileDocument] Write document failed with unknown exception:" << path;
     }
 }
 
-void updateFile(const QString &path, const IndexReaderPtr &reader,
+void updateFile(const QString &path, const UpdateChecker &checker,
                 const IndexWriterPtr &writer, ProgressReporter *reporter)
 {
     try {
@@ -263,13 +334,14 @@ void updateFile(const QString &path, const IndexReaderPtr &reader,
             return;
 
         bool needAdd = false;
-        if (checkNeedUpdate(path, reader, &needAdd)) {
+        if (checker(path, &needAdd)) {
             DocumentPtr doc = createFileDocument(path);
             if (!doc) {
                 fmWarning() << "[updateFile] Failed to create document for:" << path;
                 return;
             }
 
+            ContentDeduplicator::instance().prepareDocument(doc);
             if (needAdd) {
 #ifdef QT_DEBUG
                 fmDebug() << "Adding [" << path << "]";
@@ -318,6 +390,86 @@ void removeFile(const QString &path, const IndexWriterPtr &writer, ProgressRepor
     }
 }
 
+// 每批检查的文档数量，决定清理过程的内存上限
+constexpr int kCleanupBatchSize = 2048;
+
+qint64 peakResidentSetSizeKB()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+    return usage.ru_maxrss;   // Linux 下单位为 KB
+}
+
+bool fileExists(const QString &path)
+{
+    const QByteArray &localPath = path.toLocal8Bit();
+#ifdef STATX_TYPE
+    struct statx stx;
+    if (statx(AT_FDCWD, localPath.constData(), AT_STATX_DONT_SYNC, STATX_TYPE, &stx) == 0)
+        return true;
+    if (errno != ENOSYS)
+        return false;
+#endif
+    struct stat st;
+    return stat(localPath.constData(), &st) == 0;
+}
+
+// 并行检查一批文件，返回需要从索引中删除的路径
+QList<String> collectStaleEntries(const QList<String> &batch, const QSet<QString> &supportedExtensions,
+                                  QThreadPool *pool)
+{
+    const int count = batch.size();
+    std::vector<char> stale(static_cast<size_t>(count), 0);
+
+    const int sliceCount = qMax(1, pool->maxThreadCount());
+    const int sliceSize = (count + sliceCount - 1) / sliceCount;
+    for (int begin = 0; begin < count; begin += sliceSize) {
+        const int end = qMin(count, begin + sliceSize);
+        pool->start([&batch, &supportedExtensions, &stale, begin, end]() {
+            for (int i = begin; i < end; ++i) {
+                const QString &filePath = QString::fromStdWString(batch.at(i));
+                const int dot = filePath.lastIndexOf('.');
+                const int slash = filePath.lastIndexOf('/');
+                const QString &suffix = dot > slash ? filePath.mid(dot + 1).toLower() : QString();
+                if (!supportedExtensions.contains(suffix) || !fileExists(filePath))
+                    stale[static_cast<size_t>(i)] = 1;
+            }
+        });
+    }
+    pool->waitForDone();
+
+    QList<String> result;
+    for (int i = 0; i < count; ++i) {
+        if (stale[static_cast<size_t>(i)])
+            result.append(batch.at(i));
+    }
+    return result;
+}
+
+int deleteStaleEntries(const QList<String> &paths, const IndexWriterPtr &writer)
+{
+    if (paths.isEmpty())
+        return 0;
+
+    try {
+        Collection<TermPtr> terms = Collection<TermPtr>::newInstance();
+        for (const String &path : paths)
+            terms.add(newLucene<Term>(L"path", path));
+        writer->deleteDocuments(terms);
+        return paths.size();
+    } catch (const LuceneException &e) {
+        fmWarning() << "[cleanupIndexs] Failed to delete" << paths.size() << "documents with Lucene exception:"
+                    << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        fmWarning() << "[cleanupIndexs] Failed to delete" << paths.size() << "documents with exception:" << e.what();
+    } catch (...) {
+        fmWarning() << "[cleanupIndexs] Failed to delete" << paths.size() << "documents with unknown exception";
+    }
+    return 0;
+}
+
+// 流式清理：按批遍历 path 词项，只保留当前批次的路径，内存占用与索引大小无关
 bool cleanupIndexs(IndexReaderPtr reader, IndexWriterPtr writer, TaskState &running)
 {
     try {
@@ -326,90 +478,62 @@ bool cleanupIndexs(IndexReaderPtr reader, IndexWriterPtr writer, TaskState &runn
             return false;
         }
 
-        fmInfo() << "[cleanupIndexs] Starting index cleanup - checking for deleted files";
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
-        if (!searcher) {
-            fmCritical() << "[cleanupIndexs] Failed to create searcher for index cleanup";
-            return false;
-        }
-
-        // 获取所有文档
-        TermPtr allDocsTerm = newLucene<Term>(L"path", L"*");
-        WildcardQueryPtr allDocsQuery = newLucene<WildcardQuery>(allDocsTerm);
-        TopDocsPtr allDocs = searcher->search(allDocsQuery, reader->maxDoc());
-        if (!allDocs) {
-            fmCritical() << "[cleanupIndexs] Search returned null result for index cleanup";
-            return false;
-        }
-
-        fmInfo() << "[cleanupIndexs] Found" << allDocs->totalHits << "documents to check";
-
-        int removedCount = 0;
-        const QStringList supportedExtensions = TextIndexConfig::instance().supportedFileExtensions();
-        
-        // 检查每个文档对应的文件是否存在
-        for (int32_t i = 0; i < allDocs->totalHits && running.isRunning(); ++i) {
-            // Ensure scoreDocs[i] is not null before accessing ->doc
-            if (!allDocs->scoreDocs || !allDocs->scoreDocs[i]) {
-                fmWarning() << "[cleanupIndexs] Null scoreDoc at index" << i << "during index cleanup";
-                return false;
-            }
-
-            DocumentPtr doc = searcher->doc(allDocs->scoreDocs[i]->doc);
-            if (!doc) {   // Ensure document is valid
-                fmWarning() << "[cleanupIndexs] Null document at index" << i << "during index cleanup";
-                return false;
-            }
+        // 去重模式下的内容文档不是文件，不计入总数
+        const qint64 total = reader->numDocs() - ContentDeduplicator::contentDocumentCount(reader);
+        fmInfo() << "[cleanupIndexs] Starting index cleanup - checking" << total << "documents for deleted files";
 
-            String pathValue = doc->get(L"path");
-            if (pathValue.empty()) {
-                fmWarning() << "[cleanupIndexs] Document at index" << i << "has empty path during index cleanup";
-                return false;
-            }
+        QSet<QString> supportedExtensions;
+        for (const QString &ext : TextIndexConfig::instance().supportedFileExtensions())
+            supportedExtensions.insert(ext.toLower());
 
-            QString filePath = QString::fromStdWString(pathValue);
+        QThreadPool pool;
+        pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), 8));
 
-            bool shouldDelete = false;
+        TermEnumPtr termEnum = reader->terms(newLucene<Term>(L"path", L""));
+        TermDocsPtr termDocs = reader->termDocs();
+        ScopeGuard enumCloser([&termEnum, &termDocs]() {
+            termEnum->close();
+            termDocs->close();
+        });
 
-            QFileInfo fileInfo(filePath);
+        QList<String> batch;
+        batch.reserve(kCleanupBatchSize);
+        qint64 checkedCount = 0;
+        int removedCount = 0;
 
-            //  Check existence first
-            if (!fileInfo.exists()) {
-                shouldDelete = true;
-            } else {
-                // If exists, check suffix (only if not already marked for deletion)
-                QString suffix = fileInfo.suffix().toLower();   // Normalize to lowercase for case-insensitive comparison
+        auto flushBatch = [&]() {
+            removedCount += deleteStaleEntries(collectStaleEntries(batch, supportedExtensions, &pool), writer);
+            checkedCount += batch.size();
+            batch.clear();
+            emit ProgressNotifier::instance()->cleanupProgressChanged(checkedCount, total, peakResidentSetSizeKB());
+        };
+
+        do {
+            TermPtr term = termEnum->term();
+            if (!term || term->field() != L"path")
+                break;
+
+            // 跳过仅属于已删除文档的词项
+            termDocs->seek(termEnum);
+            if (!termDocs->next())
+                continue;
 
-                // Use the pre-fetched list/set
-                // if (!supportedExtensionsSet.contains(suffix)) { // If using QSet
-                if (!supportedExtensions.contains(suffix, Qt::CaseInsensitive)) {   // QStringList::contains with case insensitivity
-                    shouldDelete = true;
-                }
-            }
+            batch.append(term->text());
+            if (batch.size() >= kCleanupBatchSize)
+                flushBatch();
+        } while (running.isRunning() && termEnum->next());
 
-            //  Delete if necessary
-            if (shouldDelete) {
-                try {
-                    TermPtr term = newLucene<Term>(L"path", pathValue);   // Create Term only when needed
-                    if (term) {
-                        writer->deleteDocuments(term);
-                        removedCount++;
-                    }
-                } catch (const std::exception &e) {
-                    fmWarning() << "[cleanupIndexs] Failed to delete document:" << filePath 
-                               << "error:" << e.what();
-                    // 继续处理其他文档
-                } catch (...) {
-                    fmWarning() << "[cleanupIndexs] Failed to delete document with unknown exception:" << filePath;
-                    // 继续处理其他文档
-                }
-            }
-        }
+        if (!batch.isEmpty() && running.isRunning())
+            flushBatch();
 
+        const qint64 peakRss = peakResidentSetSizeKB();
+        emit ProgressNotifier::instance()->cleanupProgressChanged(checkedCount, total, peakRss);
         if (removedCount > 0) {
-            fmInfo() << "[cleanupIndexs] Index cleanup completed - removed" << removedCount << "deleted/unsupported files from index";
+            fmInfo() << "[cleanupIndexs] Index cleanup completed - removed" << removedCount << "deleted/unsupported files from index"
+                     << "checked:" << checkedCount << "peak RSS(KB):" << peakRss;
         } else {
-            fmInfo() << "[cleanupIndexs] Index cleanup completed - no files needed removal";
+            fmInfo() << "[cleanupIndexs] Index cleanup completed - no files needed removal"
+                     << "checked:" << checkedCount << "peak RSS(KB):" << peakRss;
         }
 
         return true;
@@ -431,7 +555,8 @@ bool cleanupIndexs(IndexReaderPtr reader, IndexWriterPtr writer, TaskState &runn
 
 // 移除目录下所有文件的索引，使用前缀匹配
 void removeDirectoryIndex(const QString &dirPath, const IndexWriterPtr &writer,
-                          const IndexReaderPtr &reader, ProgressReporter *reporter)
+                          const IndexReaderPtr &reader, const SearcherPtr &searcher,
+                          ProgressReporter *reporter)
 {
     try {
         QString normalizedPath = dirPath;
@@ -446,7 +571,6 @@ void removeDirectoryIndex(const QString &dirPath, const IndexWriterPtr &writer,
                 newLucene<Term>(L"path", normalizedPath.toStdWString()));
 
         // 使用索引读取器和搜索器来找到所有匹配的文档
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
         TopDocsPtr allDocs = searcher->search(prefixQuery, reader->maxDoc());
 
         // 检查allDocs是否有效
@@ -596,6 +720,9 @@ TaskHandler TaskHandlers::CreateIndexHandler()
             writer->deleteAll();
             fmInfo() << "[CreateIndexHandler] Cleared existing index data";
 
+            ContentDeduplicator::instance().beginSession(nullptr, writer);
+            ScopeGuard dedupSession([]() { ContentDeduplicator::instance().endSession(); });
+
             // 使用文件提供者遍历文件
             auto provider = createFileProvider(path);
             if (!provider) {
@@ -613,9 +740,19 @@ TaskHandler TaskHandlers::CreateIndexHandler()
             reporter.setTotal(totalCount);
             fmInfo() << "[CreateIndexHandler] Starting file processing, estimated total files:" << totalCount;
 
+            // 文档内容提取并行执行，索引写入保持在单一线程
+            DocumentPipeline pipeline(
+                    DocumentPipeline::configuredWorkerCount(), running,
+                    buildFileDocument,
+                    [&](const QString &file, const DocumentPtr &doc) {
+                        writeFileDocument(file, doc, writer, &reporter);
+                    });
+            pipeline.start();
+
             provider->traverse(running, [&](const QString &file) {
-                processFile(file, writer, &reporter);
+                pipeline.enqueue(file);
             });
+            pipeline.finish();
 
             // Only the creation of an index that is interrupted is also considered a failure
             // Created indexes must be guaranteed to be complete
@@ -719,8 +856,27 @@ TaskHandler TaskHandlers::UpdateIndexHandler()
             reporter.setTotal(totalCount);
             fmInfo() << "[UpdateIndexHandler] Starting file update processing, estimated total files:" << totalCount;
 
+            ContentDeduplicator::instance().beginSession(reader, writer);
+            ScopeGuard dedupSession([]() { ContentDeduplicator::instance().endSession(); });
+
+            // 一次性加载索引中的路径和修改时间，遍历过程中仅在内存中比较
+            IndexSnapshot snapshot;
+            if (!snapshot.load(reader, running)) {
+                if (!running.isRunning()) {
+                    fmWarning() << "[UpdateIndexHandler] Index update was interrupted while loading index snapshot";
+                    result.interrupted = true;
+                    return result;
+                }
+                fmCritical() << "[UpdateIndexHandler] Failed to load index snapshot, aborting update";
+                result.fatal = true;
+                return result;
+            }
+
+            const UpdateChecker checker = [&snapshot](const QString &file, bool *needAdd) {
+                return checkNeedUpdate(file, snapshot, needAdd);
+            };
             provider->traverse(running, [&](const QString &file) {
-                updateFile(file, reader, writer, &reporter);
+                updateFile(file, checker, writer, &reporter);
             });
 
             if (!running.isRunning()) {
@@ -813,8 +969,15 @@ TaskHandler TaskHandlers::CreateOrUpdateFileListHandler(const QStringList &fileL
             reporter.setTotal(totalCount);
             fmInfo() << "[CreateOrUpdateFileListHandler] Starting file list processing, total files:" << totalCount;
 
+            ContentDeduplicator::instance().beginSession(reader, writer);
+            ScopeGuard dedupSession([]() { ContentDeduplicator::instance().endSession(); });
+
+            SearcherPtr searcher = newLucene<IndexSearcher>(reader);
+            const UpdateChecker checker = [&searcher](const QString &file, bool *needAdd) {
+                return checkNeedUpdate(file, searcher, needAdd);
+            };
             provider->traverse(running, [&](const QString &file) {
-                updateFile(file, reader, writer, &reporter);
+                updateFile(file, checker, writer, &reporter);
             });
 
             if (!running.isRunning()) {
@@ -895,6 +1058,12 @@ TaskHandler TaskHandlers::RemoveFileListHandler(const QStringList &fileList)
             int filesRemoved = 0;
             int directoriesRemoved = 0;
 
+            // 删除路径文档后，会话结束时清理不再被引用的内容文档
+            ContentDeduplicator::instance().beginSession(reader, writer);
+            ScopeGuard dedupSession([]() { ContentDeduplicator::instance().endSession(); });
+
+            SearcherPtr searcher = newLucene<IndexSearcher>(reader);
+
             // 直接遍历文件列表，不使用MixedPathListProvider
             for (const QString &itemPath : fileList) {
                 if (!running.isRunning()) {
@@ -903,7 +1072,6 @@ TaskHandler TaskHandlers::RemoveFileListHandler(const QStringList &fileList)
                 }
 
                 // 首先尝试从索引中查找该路径
-                SearcherPtr searcher = newLucene<IndexSearcher>(reader);
                 TermQueryPtr pathQuery = newLucene<TermQuery>(
                         newLucene<Term>(L"path", itemPath.toStdWString()));
 
@@ -916,7 +1084,7 @@ TaskHandler TaskHandlers::RemoveFileListHandler(const QStringList &fileList)
                     fmDebug() << "[RemoveFileListHandler] Removed file from index:" << itemPath;
                 } else {
                     // 如果没有找到精确匹配，尝试作为目录处理
-                    removeDirectoryIndex(itemPath, writer, reader, &reporter);
+                    removeDirectoryIndex(itemPath, writer, reader, searcher, &reporter);
                     directoriesRemoved++;
                     fmDebug() << "[RemoveFileListHandler] Processed directory removal:" << itemPath;
                 }
@@ -993,6 +1161,10 @@ TaskHandler TaskHandlers::MoveFileListHandler(const QHash<QString, QString> &mov
             reporter.setTotal(movedFiles.size());
             fmInfo() << "[MoveFileListHandler] Starting file move processing, total moves:" << movedFiles.size();
 
+            // 移动覆盖已索引的文件时旧文档被替换，会话结束时清理不再被引用的内容文档
+            ContentDeduplicator::instance().beginSession(reader, writer);
+            ScopeGuard dedupSession([]() { ContentDeduplicator::instance().endSession(); });
+
             SearcherPtr searcher = newLucene<IndexSearcher>(reader);
 
             // Create processors for different move types using the new separate classes
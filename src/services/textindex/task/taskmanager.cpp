@@ -198,6 +198,7 @@ bool TaskManager::startTask(IndexTask::Type type, const QStringList &pathList, b
     currentTask->moveToThread(&workerThread);
 
     connect(currentTask, &IndexTask::progressChanged, this, &TaskManager::onTaskProgress, Qt::QueuedConnection);
+    connect(currentTask, &IndexTask::cleanupProgressChanged, this, &TaskManager::onTaskCleanupProgress, Qt::QueuedConnection);
     connect(currentTask, &IndexTask::finished, this, &TaskManager::onTaskFinished, Qt::QueuedConnection);
     connect(this, &TaskManager::startTaskInThread, currentTask, &IndexTask::start, Qt::QueuedConnection);
     workerThread.start();
@@ -263,6 +264,7 @@ bool TaskManager::startFileListTask(IndexTask::Type type, const QStringList &fil
     currentTask->moveToThread(&workerThread);
 
     connect(currentTask, &IndexTask::progressChanged, this, &TaskManager::onTaskProgress, Qt::QueuedConnection);
+    connect(currentTask, &IndexTask::cleanupProgressChanged, this, &TaskManager::onTaskCleanupProgress, Qt::QueuedConnection);
     connect(currentTask, &IndexTask::finished, this, &TaskManager::onTaskFinished, Qt::QueuedConnection);
     connect(this, &TaskManager::startTaskInThread, currentTask, &IndexTask::start, Qt::QueuedConnection);
     workerThread.start();
@@ -318,6 +320,7 @@ bool TaskManager::startFileMoveTask(const QHash<QString, QString> &movedFiles, b
     currentTask->moveToThread(&workerThread);
 
     connect(currentTask, &IndexTask::progressChanged, this, &TaskManager::onTaskProgress, Qt::QueuedConnection);
+    connect(currentTask, &IndexTask::cleanupProgressChanged, this, &TaskManager::onTaskCleanupProgress, Qt::QueuedConnection);
     connect(currentTask, &IndexTask::finished, this, &TaskManager::onTaskFinished, Qt::QueuedConnection);
     connect(this, &TaskManager::startTaskInThread, currentTask, &IndexTask::start, Qt::QueuedConnection);
     workerThread.start();
@@ -371,6 +374,16 @@ void TaskManager::onTaskProgress(IndexTask::Type type, qint64 count, qint64 tota
     emit taskProgressChanged(typeToString(type), currentTask->taskPath(), count, total);
 }
 
+void TaskManager::onTaskCleanupProgress(IndexTask::Type type, qint64 checked, qint64 total)
+{
+    if (!currentTask) {
+        fmWarning() << "[TaskManager::onTaskCleanupProgress] Received cleanup progress but no current task exists";
+        return;
+    }
+
+    emit taskCleanupProgressChanged(typeToString(type), currentTask->taskPath(), checked, total);
+}
+
 void TaskManager::onTaskFinished(IndexTask::Type type, HandlerResult result)
 {
     if (!currentTask) {
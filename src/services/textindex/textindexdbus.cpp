@@ -7,6 +7,7 @@
 #include "utils/indexutility.h"
 #include "utils/systemdcpuutils.h"
 #include "utils/textindexconfig.h"
+#include "utils/contentdeduplicator.h"
 
 #include <QDir>
 
@@ -42,6 +43,11 @@ void TextIndexDBusPrivate::initConnect()
                          emit q->TaskProgressChanged(type, path, count, total);
                      });
 
+    QObject::connect(taskManager, &TaskManager::taskCleanupProgressChanged,
+                     q, [this](const QString &type, const QString &path, qint64 checked, qint64 total) {
+                         emit q->TaskCleanupProgressChanged(type, path, checked, total);
+                     });
+
     QObject::connect(fsEventController, &FSEventController::requestProcessFileChanges,
                      q, &TextIndexDBus::ProcessFileChanges);
     QObject::connect(fsEventController, &FSEventController::requestProcessFileMoves,
@@ -247,6 +253,21 @@ bool TextIndexDBus::ProcessFileMoves(const QHash<QString, QString> &movedFiles)
     return taskQueued;
 }
 
+QVariantMap TextIndexDBus::GetContentDeduplicationStatistics()
+{
+    QVariantMap result;
+    result.insert("enabled", ContentDeduplicator::isEnabled());
+
+    // 统计在每次索引任务结束时由任务线程汇总，这里只返回缓存结果
+    bool collected = false;
+    const ContentDeduplicator::Statistics &stats = ContentDeduplicator::instance().statistics(&collected);
+    result.insert("collected", collected);
+    result.insert("uniqueContents", stats.uniqueContents);
+    result.insert("duplicateDocuments", stats.duplicateDocuments);
+    result.insert("bytesSaved", stats.bytesSaved);
+    return result;
+}
+
 void TextIndexDBusPrivate::initializeSupportedExtensions()
 {
     m_currentSupportedExtensions = TextIndexConfig::instance().supportedFileExtensions();
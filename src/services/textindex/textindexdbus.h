@@ -11,6 +11,7 @@
 #include <QDBusContext>
 #include <QStringList>
 #include <QHash>
+#include <QVariantMap>
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
 class TextIndexDBusPrivate;
@@ -39,10 +40,12 @@ public Q_SLOTS:
     QString GetLastUpdateTime();
     bool ProcessFileChanges(const QStringList &createdFiles, const QStringList &modifiedFiles, const QStringList &deletedFiles);
     bool ProcessFileMoves(const QHash<QString, QString> &movedFiles);
+    QVariantMap GetContentDeduplicationStatistics();
 
 Q_SIGNALS:
     void TaskFinished(const QString &type, const QString &path, bool success);
     void TaskProgressChanged(const QString &type, const QString &path, qint64 count, qint64 total);
+    void TaskCleanupProgressChanged(const QString &type, const QString &path, qint64 checked, qint64 total);
 
 private:
     QScopedPointer<SERVICETEXTINDEX_NAMESPACE::TextIndexDBusPrivate> d;
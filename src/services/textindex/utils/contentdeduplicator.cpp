@@ -0,0 +1,367 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "contentdeduplicator.h"
+#include "scopeguard.h"
+#include "textindexconfig.h"
+
+#include <MapFieldSelector.h>
+
+#include <QCryptographicHash>
+#include <QFile>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+using namespace Lucene;
+
+namespace {
+// 内存中缓存的文本总量上限（按 QChar 计）
+constexpr int kContentsCacheCost = 32 * 1024 * 1024;
+constexpr qint64 kHashReadChunkSize = 1024 * 1024;
+// 路径文档中保存的文本片段长度，供搜索结果高亮使用；不超过该长度的文本不做去重
+constexpr int kStoredSnippetLength = 16 * 1024;
+
+// 每个内容文档以文本哈希为键保存一份文本，路径文档通过 content_hash 引用它
+const String kContentHashField = L"content_hash";
+const String kContentKeyField = L"content_key";
+const String kContentTextField = L"content_text";
+// 内容文档中未在路径文档里保存的字节数，即每个重复文档节省的大小
+const String kContentSizeField = L"content_size";
+const String kContentsField = L"contents";
+
+// 路径文档中建立了倒排索引的完整文本，存储的只是片段
+QString indexedContents(const DocumentPtr &doc)
+{
+    for (const FieldablePtr &field : doc->getFieldables(kContentsField)) {
+        if (field->isIndexed())
+            return QString::fromStdWString(field->stringValue());
+    }
+    return {};
+}
+
+bool hasContentDocument(const SearcherPtr &searcher, const QByteArray &key)
+{
+    TermQueryPtr query = newLucene<TermQuery>(
+            newLucene<Term>(kContentKeyField, QString::fromLatin1(key).toStdWString()));
+    return searcher->search(query, 1)->totalHits > 0;
+}
+
+DocumentPtr createContentDocument(const QByteArray &key, const QString &contents)
+{
+    // 内容文档不含 path 和 contents 词项，不会出现在搜索结果和路径遍历中
+    DocumentPtr doc = newLucene<Document>();
+    doc->add(newLucene<Field>(kContentKeyField, QString::fromLatin1(key).toStdWString(),
+                              Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
+    doc->add(newLucene<Field>(kContentTextField, contents.toStdWString(),
+                              Field::STORE_YES, Field::INDEX_NO));
+    const qint64 savedBytes = contents.mid(kStoredSnippetLength).toUtf8().size();
+    doc->add(newLucene<Field>(kContentSizeField, QString::number(savedBytes).toStdWString(),
+                              Field::STORE_YES, Field::INDEX_NO));
+    return doc;
+}
+}   // namespace
+
+ContentDeduplicator &ContentDeduplicator::instance()
+{
+    static ContentDeduplicator self;
+    return self;
+}
+
+ContentDeduplicator::ContentDeduplicator()
+    : m_contentsCache(kContentsCacheCost)
+{
+}
+
+bool ContentDeduplicator::isEnabled()
+{
+    return TextIndexConfig::instance().contentDeduplication();
+}
+
+QByteArray ContentDeduplicator::computeFileHash(const QString &path, qint64 maxBytes)
+{
+    QFile file(path);
+    // 超过截断大小的文件只有部分内容被索引，读取整个文件计算哈希得不偿失
+    if ((maxBytes > 0 && file.size() > maxBytes) || !file.open(QIODevice::ReadOnly))
+        return {};
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    while (!file.atEnd()) {
+        const QByteArray &chunk = file.read(kHashReadChunkSize);
+        if (chunk.isEmpty() && file.error() != QFileDevice::NoError)
+            return {};
+        hash.addData(chunk);
+    }
+
+    return hash.result().toHex();
+}
+
+QByteArray ContentDeduplicator::computeContentKey(const QString &contents)
+{
+    return QCryptographicHash::hash(contents.toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+void ContentDeduplicator::beginSession(const IndexReaderPtr &reader, const IndexWriterPtr &writer)
+{
+    QMutexLocker locker(&m_mutex);
+    m_contentsCache.clear();
+    m_storedKeys.clear();
+    m_searcher = reader ? newLucene<IndexSearcher>(reader) : SearcherPtr();
+    m_writer = writer;
+}
+
+void ContentDeduplicator::endSession()
+{
+    IndexWriterPtr writer;
+    {
+        QMutexLocker locker(&m_mutex);
+        writer = m_writer;
+        m_contentsCache.clear();
+        m_storedKeys.clear();
+        m_searcher.reset();
+        m_writer.reset();
+    }
+
+    if (!writer)
+        return;
+
+    // 统计随清理一起完成，DBus 查询时直接返回结果，不再遍历索引
+    const auto &stats = removeUnreferencedContents(writer);
+    if (stats) {
+        QMutexLocker locker(&m_mutex);
+        m_statistics = stats.value();
+        m_statisticsCollected = true;
+    }
+}
+
+std::optional<QString> ContentDeduplicator::knownContents(const QByteArray &fileHash)
+{
+    QMutexLocker locker(&m_mutex);
+    if (const QString *cached = m_contentsCache.object(fileHash))
+        return *cached;
+    return std::nullopt;
+}
+
+void ContentDeduplicator::rememberContents(const QByteArray &fileHash, const QString &contents)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_contentsCache.contains(fileHash))
+        m_contentsCache.insert(fileHash, new QString(contents), static_cast<int>(qMin<qsizetype>(contents.size(), kContentsCacheCost)));
+}
+
+void ContentDeduplicator::addContentFields(const DocumentPtr &doc, const QString &contents)
+{
+    // 短文本去重节省的空间还不及内容文档本身，直接保存在路径文档中
+    if (contents.size() <= kStoredSnippetLength) {
+        doc->add(newLucene<Field>(kContentsField, contents.toStdWString(),
+                                  Field::STORE_YES, Field::INDEX_ANALYZED));
+        return;
+    }
+
+    // 保存的片段在前，Document::get 返回的是片段
+    doc->add(newLucene<Field>(kContentHashField, QString::fromLatin1(computeContentKey(contents)).toStdWString(),
+                              Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
+    doc->add(newLucene<Field>(kContentsField, contents.left(kStoredSnippetLength).toStdWString(),
+                              Field::STORE_YES, Field::INDEX_NO));
+    doc->add(newLucene<Field>(kContentsField, contents.toStdWString(),
+                              Field::STORE_NO, Field::INDEX_ANALYZED));
+}
+
+void ContentDeduplicator::prepareDocument(const DocumentPtr &doc)
+{
+    if (!doc)
+        return;
+
+    const String &keyText = doc->get(kContentHashField);
+    if (keyText.empty())
+        return;
+
+    const QByteArray &key = QString::fromStdWString(keyText).toLatin1();
+    SearcherPtr searcher;
+    IndexWriterPtr writer;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_storedKeys.contains(key))
+            return;
+        searcher = m_searcher;
+        writer = m_writer;
+    }
+
+    const QString &contents = indexedContents(doc);
+    bool stored = false;
+    try {
+        stored = searcher && hasContentDocument(searcher, key);
+        if (!stored && writer) {
+            writer->addDocument(createContentDocument(key, contents));
+            stored = true;
+        }
+    } catch (const LuceneException &e) {
+        fmWarning() << "[ContentDeduplicator] Add content document failed with Lucene exception:"
+                    << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        fmWarning() << "[ContentDeduplicator] Add content document failed with exception:" << e.what();
+    }
+
+    if (stored) {
+        QMutexLocker locker(&m_mutex);
+        m_storedKeys.insert(key);
+        return;
+    }
+
+    // 没有可引用的内容文档时在路径文档中保存全文，不留下无法还原的引用
+    doc->removeField(kContentHashField);
+    doc->removeFields(kContentsField);
+    doc->add(newLucene<Field>(kContentsField, contents.toStdWString(),
+                              Field::STORE_YES, Field::INDEX_ANALYZED));
+}
+
+std::optional<QString> ContentDeduplicator::lookupStoredContents(const SearcherPtr &searcher,
+                                                                 const QByteArray &key)
+{
+    try {
+        TermQueryPtr query = newLucene<TermQuery>(
+                newLucene<Term>(kContentKeyField, QString::fromLatin1(key).toStdWString()));
+        TopDocsPtr topDocs = searcher->search(query, 1);
+        if (topDocs->totalHits > 0) {
+            DocumentPtr doc = searcher->doc(topDocs->scoreDocs[0]->doc);
+            FieldablePtr field = doc ? doc->getFieldable(kContentTextField) : FieldablePtr();
+            if (field)
+                return QString::fromStdWString(field->stringValue());
+        }
+    } catch (const LuceneException &e) {
+        fmWarning() << "[ContentDeduplicator] Lookup stored contents failed with Lucene exception:"
+                    << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        fmWarning() << "[ContentDeduplicator] Lookup stored contents failed with exception:" << e.what();
+    }
+    return std::nullopt;
+}
+
+void ContentDeduplicator::restoreContents(const DocumentPtr &doc, const SearcherPtr &searcher)
+{
+    if (!doc)
+        return;
+
+    // 没有引用的文档全文保存在自身中
+    const String &key = doc->get(kContentHashField);
+    if (key.empty())
+        return;
+
+    const auto &contents = lookupStoredContents(searcher, QString::fromStdWString(key).toLatin1());
+    if (!contents) {
+        fmWarning() << "[ContentDeduplicator] No content document left for key:" << QString::fromStdWString(key);
+        return;
+    }
+
+    // 读回的片段字段带有索引属性，替换为与新建文档相同的字段
+    doc->removeField(kContentHashField);
+    doc->removeFields(kContentsField);
+    addContentFields(doc, contents.value());
+}
+
+qint64 ContentDeduplicator::contentDocumentCount(const IndexReaderPtr &reader)
+{
+    if (!reader)
+        return 0;
+
+    try {
+        TermEnumPtr termEnum = reader->terms(newLucene<Term>(kContentKeyField, L""));
+        TermDocsPtr termDocs = reader->termDocs();
+        ScopeGuard enumCloser([&termEnum, &termDocs]() {
+            termEnum->close();
+            termDocs->close();
+        });
+
+        qint64 count = 0;
+        do {
+            TermPtr term = termEnum->term();
+            if (!term || term->field() != kContentKeyField)
+                break;
+
+            // termDocs 跳过已删除的文档
+            termDocs->seek(termEnum);
+            while (termDocs->next())
+                ++count;
+        } while (termEnum->next());
+        return count;
+    } catch (const LuceneException &e) {
+        fmWarning() << "[ContentDeduplicator] Count content documents failed with Lucene exception:"
+                    << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        fmWarning() << "[ContentDeduplicator] Count content documents failed with exception:" << e.what();
+    }
+    return 0;
+}
+
+ContentDeduplicator::Statistics ContentDeduplicator::statistics(bool *collected)
+{
+    QMutexLocker locker(&m_mutex);
+    if (collected)
+        *collected = m_statisticsCollected;
+    return m_statistics;
+}
+
+std::optional<ContentDeduplicator::Statistics> ContentDeduplicator::removeUnreferencedContents(const IndexWriterPtr &writer)
+{
+    try {
+        // 从 writer 打开的读取器包含本次会话中尚未提交的增删
+        IndexReaderPtr reader = writer->getReader();
+        ScopeGuard readerCloser([&reader]() { reader->close(); });
+
+        TermEnumPtr termEnum = reader->terms(newLucene<Term>(kContentKeyField, L""));
+        TermDocsPtr contentDocs = reader->termDocs();
+        TermDocsPtr referenceDocs = reader->termDocs();
+        ScopeGuard enumCloser([&termEnum, &contentDocs, &referenceDocs]() {
+            termEnum->close();
+            contentDocs->close();
+            referenceDocs->close();
+        });
+
+        Collection<String> sizeField = Collection<String>::newInstance();
+        sizeField.add(kContentSizeField);
+        FieldSelectorPtr selector = newLucene<MapFieldSelector>(sizeField);
+
+        Statistics stats;
+        Collection<TermPtr> unreferenced = Collection<TermPtr>::newInstance();
+        do {
+            TermPtr term = termEnum->term();
+            if (!term || term->field() != kContentKeyField)
+                break;
+
+            contentDocs->seek(termEnum);
+            if (!contentDocs->next())
+                continue;
+            const int32_t contentDoc = contentDocs->doc();
+
+            referenceDocs->seek(newLucene<Term>(kContentHashField, term->text()));
+            qint64 references = 0;
+            while (referenceDocs->next())
+                ++references;
+
+            if (references == 0) {
+                unreferenced.add(newLucene<Term>(kContentKeyField, term->text()));
+                continue;
+            }
+
+            ++stats.uniqueContents;
+            if (references > 1) {
+                stats.duplicateDocuments += references - 1;
+                DocumentPtr doc = reader->document(contentDoc, selector);
+                stats.bytesSaved += (references - 1) * QString::fromStdWString(doc->get(kContentSizeField)).toLongLong();
+            }
+        } while (termEnum->next());
+
+        if (!unreferenced.empty()) {
+            writer->deleteDocuments(unreferenced);
+            fmInfo() << "[ContentDeduplicator] Removed" << unreferenced.size() << "unreferenced content documents";
+        }
+        return stats;
+    } catch (const LuceneException &e) {
+        fmWarning() << "[ContentDeduplicator] Remove unreferenced contents failed with Lucene exception:"
+                    << QString::fromStdWString(e.getError());
+    } catch (const std::exception &e) {
+        fmWarning() << "[ContentDeduplicator] Remove unreferenced contents failed with exception:" << e.what();
+    }
+    return std::nullopt;
+}
+
+SERVICETEXTINDEX_END_NAMESPACE
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CONTENTDEDUPLICATOR_H
+#define CONTENTDEDUPLICATOR_H
+
+#include "service_textindex_global.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+#include <optional>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+/**
+ * @brief Stores the extracted text of identical contents only once
+ *
+ * When content deduplication is enabled, the text of each distinct content
+ * is stored in a single content document keyed by "content_key", the hash
+ * of the indexed (already truncated) text. Per-path documents carry a
+ * "content_hash" field referencing it, index their "contents" without
+ * storing them and keep a short stored snippet for result highlighting.
+ *
+ * Extraction workers only build per-path documents. Content documents are
+ * written by prepareDocument() on the thread that owns the IndexWriter, right
+ * before the per-path document itself, so the writer is never used
+ * concurrently and a reference is only written once its content document is.
+ *
+ * Within a session the text of files with identical raw bytes is kept in a
+ * memory cache, so copies of a file are not extracted again.
+ * Content documents are only removed at the end of a session, once no
+ * per-path document references their hash any more.
+ */
+class ContentDeduplicator
+{
+public:
+    struct Statistics
+    {
+        qint64 uniqueContents { 0 };
+        qint64 duplicateDocuments { 0 };
+        qint64 bytesSaved { 0 };
+    };
+
+    static ContentDeduplicator &instance();
+    static bool isEnabled();
+
+    /**
+     * @brief Compute the hash of the raw file bytes, used to find copies of a file
+     * @param maxBytes Files larger than this are not hashed, their text is
+     *                 truncated on extraction and they are always extracted
+     * @return Hex encoded hash, or an empty array if the file is skipped or cannot be read
+     */
+    static QByteArray computeFileHash(const QString &path, qint64 maxBytes);
+
+    /**
+     * @brief Compute the content key of the text that gets indexed
+     */
+    static QByteArray computeContentKey(const QString &contents);
+
+    /**
+     * @brief Start an indexing run
+     * @param reader Reader of the existing index used to look up content
+     *               documents, nullptr when the index is being rebuilt
+     * @param writer Writer of the run, content documents are added through it
+     */
+    void beginSession(const Lucene::IndexReaderPtr &reader, const Lucene::IndexWriterPtr &writer);
+
+    /**
+     * @brief Finish the run, removing content documents no longer referenced
+     *        and refreshing the statistics
+     *
+     * Must be called before the writer is closed.
+     */
+    void endSession();
+
+    /**
+     * @brief Get the text already extracted in this session for a file with the same raw bytes
+     */
+    std::optional<QString> knownContents(const QByteArray &fileHash);
+
+    /**
+     * @brief Remember the extracted text of a file for its copies
+     */
+    void rememberContents(const QByteArray &fileHash, const QString &contents);
+
+    /**
+     * @brief Add the deduplicated contents fields to a per-path document
+     *
+     * The document references the content key and keeps only a snippet of
+     * the text stored. Called by the extraction workers.
+     */
+    static void addContentFields(const Lucene::DocumentPtr &doc, const QString &contents);
+
+    /**
+     * @brief Make sure the content document referenced by doc exists
+     *
+     * Writes the content document if neither the index nor this session has
+     * one yet. When it cannot be written, the full text is stored in doc
+     * instead. Must be called on the thread that owns the IndexWriter, before
+     * doc is added or updated.
+     */
+    void prepareDocument(const Lucene::DocumentPtr &doc);
+
+    /**
+     * @brief Re-attach the text of a document whose contents are not stored
+     *
+     * Documents read back from the index only contain stored fields, so a
+     * deduplicated document must get its text back before being re-added.
+     */
+    static void restoreContents(const Lucene::DocumentPtr &doc, const Lucene::SearcherPtr &searcher);
+
+    /**
+     * @brief Number of live content documents, which are not files
+     */
+    static qint64 contentDocumentCount(const Lucene::IndexReaderPtr &reader);
+
+    /**
+     * @brief Statistics collected at the end of the last session
+     * @param collected Set to false if no session has finished since startup
+     */
+    Statistics statistics(bool *collected = nullptr);
+
+private:
+    ContentDeduplicator();
+
+    static std::optional<QString> lookupStoredContents(const Lucene::SearcherPtr &searcher,
+                                                       const QByteArray &key);
+    static std::optional<Statistics> removeUnreferencedContents(const Lucene::IndexWriterPtr &writer);
+
+    QMutex m_mutex;
+    // 原始字节哈希 -> 本次会话中已提取的文本
+    QCache<QByteArray, QString> m_contentsCache;
+    // 本次会话中已写入或已在索引中找到内容文档的键，只在写入线程中访问
+    QSet<QByteArray> m_storedKeys;
+    Lucene::SearcherPtr m_searcher;
+    Lucene::IndexWriterPtr m_writer;
+    Statistics m_statistics;
+    bool m_statisticsCollected { false };
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // CONTENTDEDUPLICATOR_H
@@ -145,6 +145,23 @@ void TextIndexConfig::loadAllConfigs()
         m_batchCommitInterval = DEFAULT_BATCH_COMMIT_INTERVAL;
     }
 
+    // Index worker count
+    m_indexWorkerCount = m_dconfigManager->value(
+                                                 Defines::DConf::kTextIndexSchema,
+                                                 Defines::DConf::kIndexWorkerCount,
+                                                 DEFAULT_INDEX_WORKER_COUNT)
+                                 .toInt();
+    if (m_indexWorkerCount < 0 || m_indexWorkerCount > MAX_INDEX_WORKER_COUNT) {
+        m_indexWorkerCount = DEFAULT_INDEX_WORKER_COUNT;
+    }
+
+    // Content deduplication
+    m_contentDeduplication = m_dconfigManager->value(
+                                                     Defines::DConf::kTextIndexSchema,
+                                                     Defines::DConf::kContentDeduplication,
+                                                     DEFAULT_CONTENT_DEDUPLICATION)
+                                     .toBool();
+
     fmDebug() << "TextIndexConfig: Text index configurations loaded successfully";
     // You might want to print the loaded values here for debugging if needed
     // fmDebug() << "AutoIndexUpdateInterval:" << m_autoIndexUpdateInterval;
@@ -218,4 +235,16 @@ int TextIndexConfig::batchCommitInterval() const
     return m_batchCommitInterval;
 }
 
+int TextIndexConfig::indexWorkerCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_indexWorkerCount;
+}
+
+bool TextIndexConfig::contentDeduplication() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_contentDeduplication;
+}
+
 SERVICETEXTINDEX_END_NAMESPACE
@@ -34,6 +34,8 @@ public:
     int cpuUsageLimitPercent() const;
     double inotifyWatchesCoefficient() const;
     int batchCommitInterval() const;
+    int indexWorkerCount() const;
+    bool contentDeduplication() const;
 
     // Call this if you need to manually reload all configurations
     Q_INVOKABLE void reloadConfig();
@@ -61,6 +63,8 @@ private:
     int m_cpuUsageLimitPercent;
     double m_inotifyWatchesCoefficient;
     int m_batchCommitInterval;
+    int m_indexWorkerCount;
+    bool m_contentDeduplication;
 
     mutable QMutex m_mutex;
 
@@ -73,6 +77,9 @@ private:
     static const int DEFAULT_CPU_USAGE_LIMIT_PERCENT = 50;
     static constexpr double DEFAULT_INOTIFY_WATCHES_COEFFICIENT = 0.5;
     static const int DEFAULT_BATCH_COMMIT_INTERVAL = 1000;
+    static const int DEFAULT_INDEX_WORKER_COUNT = 0;   // 0: decided by CPU count and cpuUsageLimitPercent
+    static const int MAX_INDEX_WORKER_COUNT = 32;
+    static const bool DEFAULT_CONTENT_DEDUPLICATION = false;
     // Default QStringLists need to be initialized in the .cpp or constructor
     // For simplicity here, we'll define them directly in loadAllConfigs logic
 };
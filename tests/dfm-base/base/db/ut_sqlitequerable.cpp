@@ -147,7 +147,7 @@ TEST_F(UT_SqliteQueryable, toMaps)
 
 TEST_F(UT_SqliteQueryable, aggregate)
 {
-    stub.set_lamda(ADDR(SqliteHelper, excute), []() {
+    stub.set_lamda(ADDR(SqliteHelper, excutePrepared), []() {
         return true;
     });
     SqliteQueryable<User> querable { "dbname", " FROM " + SqliteHelper::tableName<User>() };
@@ -21,6 +21,8 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 DFMBASE_USE_NAMESPACE
 
 class UT_DeviceWatcher : public testing::Test
@@ -303,16 +305,19 @@ private:
 // }
 TEST_F(UT_DeviceWatcherPrivate, QueryUsageAsync)
 {
-    bool query_invoked = false;
-    stub.set_lamda(&DeviceWatcherPrivate::queryUsageOfItem, [&] { __DBG_STUB_INVOKE__ query_invoked = true; });
+    std::atomic_bool query_invoked { false };
+    stub.set_lamda(&DeviceWatcherPrivate::queryUsageOfBlock, [&] { __DBG_STUB_INVOKE__ query_invoked = true; return DevStorage(); });
+    stub.set_lamda(&DeviceWatcherPrivate::queryUsageOfProtocol, [&] { __DBG_STUB_INVOKE__ query_invoked = true; return DevStorage(); });
 
-    //    typedef QFuture<void> (*RunType)(RunTarget);
-    //    auto run = static_cast<RunType>(QtConcurrent::run);
-    //    stub.set(run, stub_run);
+    // 未挂载的设备不查询
+    EXPECT_NO_FATAL_FAILURE(pd->queryUsageAsync());
+    EXPECT_EQ(pd->usageMetrics.dispatched, 0u);
 
+    pd->allBlockInfos["/org/freedesktop/UDisks2/block_devices/loop1"]["MountPoint"] = "/home";
     EXPECT_NO_FATAL_FAILURE(pd->queryUsageAsync());
+    EXPECT_EQ(pd->usageMetrics.dispatched, 1u);
     int maxWait = 3;
-    do {   // wait QtConcurrent::run finished
+    do {   // wait usage pool finished
         QThread::msleep(50);
     } while (!query_invoked && maxWait--);
     EXPECT_TRUE(query_invoked);
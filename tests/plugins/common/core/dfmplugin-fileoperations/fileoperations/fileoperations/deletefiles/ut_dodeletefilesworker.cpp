@@ -16,6 +16,9 @@
 
 #include <dfm-framework/event/event.h>
 
+#include <QFileInfo>
+#include <QTemporaryDir>
+
 #include <gtest/gtest.h>
 
 #include <dfm-io/denumerator.h>
@@ -69,21 +72,27 @@ TEST_F(UT_DoDeleteFilesWorker, testDeleteFilesOnCanNotRemoveDevice)
 {
     DoDeleteFilesWorker worker;
     stub_ext::StubExt stub;
-    worker.localFileHandler.reset(new LocalFileHandler);
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    QDir(tmp.path()).mkpath("dir/sub");
+    QFile(tmp.filePath("dir/sub/file.txt")).open(QIODevice::WriteOnly);
+    QFile(tmp.filePath("file.txt")).open(QIODevice::WriteOnly);
 
     worker.stop();
     EXPECT_TRUE(worker.deleteFilesOnCanNotRemoveDevice());
 
-    worker.allFilesList.append(QUrl());
+    worker.sourceUrls.append(QUrl::fromLocalFile(tmp.filePath("dir")));
     EXPECT_FALSE(worker.deleteFilesOnCanNotRemoveDevice());
+    EXPECT_TRUE(QFileInfo::exists(tmp.filePath("dir")));
 
     worker.resume();
-    stub.set_lamda(&DoDeleteFilesWorker::doHandleErrorAndWait, []{ __DBG_STUB_INVOKE__
-                return AbstractJobHandler::SupportAction::kNoAction;});
-    worker.sourceUrls.append(QUrl());
-    stub.set_lamda(&LocalFileHandler::deleteFile, []{ __DBG_STUB_INVOKE__ return false;});
     EXPECT_TRUE(worker.deleteFilesOnCanNotRemoveDevice());
+    EXPECT_FALSE(QFileInfo::exists(tmp.filePath("dir")));
+    EXPECT_EQ(worker.deleteFilesCount.loadRelaxed(), 3);
+    EXPECT_TRUE(worker.completeSourceFiles.contains(QUrl::fromLocalFile(tmp.filePath("dir"))));
 
+    // 路径中间是普通文件，lstat 失败并进入错误处理
+    worker.sourceUrls = { QUrl::fromLocalFile(tmp.filePath("file.txt/child")) };
     stub.set_lamda(&DoDeleteFilesWorker::doHandleErrorAndWait, []{ __DBG_STUB_INVOKE__
                 return AbstractJobHandler::SupportAction::kSkipAction;});
     EXPECT_TRUE(worker.deleteFilesOnCanNotRemoveDevice());
@@ -60,7 +60,7 @@ TEST_F(UT_DoCopyFileWorker, testOperateAction)
     stub_ext::StubExt stub;
     stub.set_lamda(&DoCopyFileWorker::doDfmioFileCopy, []{ __DBG_STUB_INVOKE__ return false;});
     worker.doFileCopy(nullptr,nullptr);
-    EXPECT_EQ(1 , data->completeFileCount);
+    EXPECT_EQ(1 , data->completeFileCount.load());
 }
 
 TEST_F(UT_DoCopyFileWorker, testDoCopyFilePractically)
@@ -207,12 +207,9 @@ TEST_F(UT_RootInfo, DoFileDeleted)
     QUrl url(QStandardPaths::standardLocations(QStandardPaths::HomeLocation).first());
     rootInfoObj->doFileDeleted(url);
 
-    EXPECT_FALSE(rootInfoObj->watcherEvent.isEmpty());
-    if (!rootInfoObj->watcherEvent.isEmpty()) {
-        QPair<QUrl, RootInfo::EventType> event = rootInfoObj->watcherEvent.dequeue();
-        EXPECT_EQ(event.first, url);
-        EXPECT_EQ(event.second, RootInfo::EventType::kRmFile);
-    }
+    EXPECT_TRUE(rootInfoObj->watcherEvents.hasPendingEvents());
+    const auto &batch = rootInfoObj->watcherEvents.takeBatch(10, 0, 0);
+    EXPECT_EQ(batch.removes, QList<QUrl> { url });
 }
 
 TEST_F(UT_RootInfo, DoFileCreated)
@@ -224,12 +221,9 @@ TEST_F(UT_RootInfo, DoFileCreated)
     QUrl url(QStandardPaths::standardLocations(QStandardPaths::HomeLocation).first());
     rootInfoObj->dofileCreated(url);
 
-    EXPECT_FALSE(rootInfoObj->watcherEvent.isEmpty());
-    if (!rootInfoObj->watcherEvent.isEmpty()) {
-        QPair<QUrl, RootInfo::EventType> event = rootInfoObj->watcherEvent.dequeue();
-        EXPECT_EQ(event.first, url);
-        EXPECT_EQ(event.second, RootInfo::EventType::kAddFile);
-    }
+    EXPECT_TRUE(rootInfoObj->watcherEvents.hasPendingEvents());
+    const auto &batch = rootInfoObj->watcherEvents.takeBatch(10, 0, 0);
+    EXPECT_EQ(batch.adds, QList<QUrl> { url });
 }
 
 TEST_F(UT_RootInfo, DoFileUpdated)
@@ -241,12 +235,9 @@ TEST_F(UT_RootInfo, DoFileUpdated)
     QUrl url(QStandardPaths::standardLocations(QStandardPaths::HomeLocation).first());
     rootInfoObj->doFileUpdated(url);
 
-    EXPECT_FALSE(rootInfoObj->watcherEvent.isEmpty());
-    if (!rootInfoObj->watcherEvent.isEmpty()) {
-        QPair<QUrl, RootInfo::EventType> event = rootInfoObj->watcherEvent.dequeue();
-        EXPECT_EQ(event.first, url);
-        EXPECT_EQ(event.second, RootInfo::EventType::kUpdateFile);
-    }
+    EXPECT_TRUE(rootInfoObj->watcherEvents.hasPendingEvents());
+    const auto &batch = rootInfoObj->watcherEvents.takeBatch(10, 0, 0);
+    EXPECT_EQ(batch.updates, QList<QUrl> { url });
 }
 
 TEST_F(UT_RootInfo, DoFileMoved)
@@ -331,14 +322,6 @@ TEST_F(UT_RootInfo, DoThreadWatcherEvent)
     stub.set_lamda(&RootInfo::doWatcherEvent,
                    [&calledDoWatcherEvent]() { calledDoWatcherEvent = true; });
 
-    rootInfoObj->processFileEventRuning = true;
-    rootInfoObj->doThreadWatcherEvent();
-    for (auto &future : rootInfoObj->watcherEventFutures) {
-        future.waitForFinished();
-    }
-    EXPECT_FALSE(calledDoWatcherEvent);
-
-    rootInfoObj->processFileEventRuning = false;
     rootInfoObj->cancelWatcherEvent = true;
     rootInfoObj->doThreadWatcherEvent();
     for (auto &future : rootInfoObj->watcherEventFutures) {
@@ -346,7 +329,6 @@ TEST_F(UT_RootInfo, DoThreadWatcherEvent)
     }
     EXPECT_FALSE(calledDoWatcherEvent);
 
-    rootInfoObj->processFileEventRuning = false;
     rootInfoObj->cancelWatcherEvent = false;
     rootInfoObj->doThreadWatcherEvent();
     for (auto &future : rootInfoObj->watcherEventFutures) {
@@ -9,11 +9,12 @@
 #[[
 函数: dfm_create_component_test
 用途: 为指定组件创建测试目标，实现零侵入的自动文件发现
-参数: COMPONENT_NAME - 组件名称（如：dfm-framework, dfm-base等）
+参数: COMPONENT_NAME - 组件名称（如：dfm-framework, dfm-base, plugins/common/dfmplugin-fileoperations等）
 功能: 
   1. 自动发现${DFM_SOURCE_DIR}/src/${COMPONENT_NAME}/*.cpp文件
   2. 智能过滤排除test、main.cpp、build目录下的文件
-  3. 创建${COMPONENT_NAME}-test-objects对象库
+  3. 创建<组件目录名>-test-objects对象库，并通过DFM_TEST_OBJECTS返回其名称
+     （插件等组件可在调用后为对象库补充生成的DBus接口等源文件）
   4. 应用覆盖率编译选项
   5. 自动配置include路径
   6. 调用依赖链接函数
@@ -85,7 +86,10 @@ function(dfm_create_component_test COMPONENT_NAME)
     endforeach()
     
     # 创建测试专用对象库 - 包含源文件和头文件
-    set(TEST_OBJ_NAME "${COMPONENT_NAME}-test-objects")
+    # 嵌套目录的组件（如插件）以最后一级目录名作为目标名
+    get_filename_component(COMPONENT_TARGET ${COMPONENT_NAME} NAME)
+    set(TEST_OBJ_NAME "${COMPONENT_TARGET}-test-objects")
+    set(DFM_TEST_OBJECTS ${TEST_OBJ_NAME} PARENT_SCOPE)
     
     # 查找需要MOC处理的头文件
     set(MOC_HEADERS "")
@@ -152,6 +156,7 @@ function(dfm_create_component_test COMPONENT_NAME)
         ${DFM_SOURCE_DIR}/src              # 源代码根目录
         ${DFM_SOURCE_DIR}/include          # 公共头文件目录
         ${DFM_SOURCE_DIR}/src/${COMPONENT_NAME}  # 组件特定目录
+        ${CMAKE_CURRENT_BINARY_DIR}        # 生成的DBus接口等头文件
         ${DFM_SOURCE_DIR}/3rdparty/testutils/cpp-stub  # stub.h头文件
         ${DFM_SOURCE_DIR}/3rdparty/testutils/stub-ext  # stubext.h头文件
     )
@@ -198,22 +203,79 @@ function(dfm_auto_link_dependencies TARGET_NAME COMPONENT_NAME)
         endif()
         
     elseif(${COMPONENT_NAME} STREQUAL "dfm-base")
-        # dfm-base 组件依赖
+        # dfm-base 组件依赖，与 src/dfm-base/dfm-base.cmake 保持一致
+        find_package(Qt6 COMPONENTS Core Widgets Gui Concurrent DBus Sql Network REQUIRED)
+        find_package(Dtk6 COMPONENTS Core Widget Gui REQUIRED)
+        find_package(dfm6-io REQUIRED)
+        find_package(dfm6-mount REQUIRED)
+        find_package(dfm6-burn REQUIRED)
+        find_package(ICU COMPONENTS i18n uc REQUIRED)
+        pkg_check_modules(gio REQUIRED gio-unix-2.0 IMPORTED_TARGET)
+        pkg_check_modules(mount REQUIRED mount IMPORTED_TARGET)
+        pkg_check_modules(LIBHEIF REQUIRED libheif)
+        pkg_search_module(X11 REQUIRED x11 IMPORTED_TARGET)
+
         target_link_libraries(${TARGET_NAME} PRIVATE 
             Qt6::Core 
             Qt6::Widgets 
+            Qt6::Gui
+            Qt6::Concurrent
             Qt6::DBus
+            Qt6::Sql
+            Qt6::Network
+            Dtk6::Core
+            Dtk6::Widget
+            Dtk6::Gui
+            dfm6-io
+            dfm6-mount
+            dfm6-burn
+            PkgConfig::gio
+            PkgConfig::mount
+            PkgConfig::X11
+            poppler-cpp
+            ICU::i18n
+            ICU::uc
+            ${LIBHEIF_LIBRARIES}
         )
-        
-        # 查找并链接Dtk6::Core
-        find_package(Dtk6 COMPONENTS Core REQUIRED)
-        if(Dtk6_FOUND)
-            target_link_libraries(${TARGET_NAME} PRIVATE Dtk6::Core)
-            message(STATUS "    ✅ 链接 Dtk6::Core")
-        else()
-            message(FATAL_ERROR "❌ 未找到 Dtk6::Core，dfm-base组件需要此依赖")
+        target_include_directories(${TARGET_NAME} PRIVATE
+            ${dfm6-io_INCLUDE_DIR}
+            ${dfm6-mount_INCLUDE_DIR}
+            ${dfm6-burn_INCLUDE_DIR}
+        )
+        target_compile_definitions(${TARGET_NAME} PRIVATE
+            QT_NO_SIGNALS_SLOTS_KEYWORDS
+            THUMBNAIL_TOOL_DIR="${DFM_THUMBNAIL_TOOL}"
+            APPSHAREDIR="${CMAKE_INSTALL_PREFIX}/share/dde-file-manager"
+            DFM_BASE_INTERNAL_USE=1
+        )
+
+        # 设备管理的DBus接口
+        qt6_add_dbus_interface(DFM_BASE_DBUS_SOURCES
+            ${DFM_SOURCE_DIR}/assets/dbus/org.deepin.Filemanager.Daemon.DeviceManager.xml
+            devicemanager_interface_qt6)
+        target_sources(${TARGET_NAME} PRIVATE ${DFM_BASE_DBUS_SOURCES})
+        message(STATUS "    ✅ 链接 dfm-base 全部依赖")
+
+    elseif(${COMPONENT_NAME} MATCHES "^plugins/")
+        # 插件链接已构建（随主工程构建时）或已安装的 dfm-base 与 dfm-framework
+        if(NOT TARGET DFM6::base)
+            find_package(dfm6-base REQUIRED)
         endif()
-        
+        if(NOT TARGET DFM6::framework)
+            find_package(dfm6-framework REQUIRED)
+        endif()
+        find_package(Qt6 COMPONENTS Core Widgets Concurrent DBus REQUIRED)
+
+        target_link_libraries(${TARGET_NAME} PRIVATE
+            Qt6::Core
+            Qt6::Widgets
+            Qt6::Concurrent
+            Qt6::DBus
+            DFM6::base
+            DFM6::framework
+        )
+        message(STATUS "    ✅ 链接 DFM6::base DFM6::framework")
+
     elseif(${COMPONENT_NAME} STREQUAL "dfm-extension")
         # dfm-extension 组件依赖
         target_link_libraries(${TARGET_NAME} PRIVATE 
@@ -239,10 +301,33 @@ endfunction()
   3. 链接到对应的test-objects库
   4. 链接测试框架
   5. 注册到CTest
+  6. 开启DFM_BUILD_BENCHMARKS时，另外为bench_*.cpp创建基准测试目标
+     （不注册到CTest，通过run-benchmarks目标运行）
 ]]
 function(dfm_discover_test_files COMPONENT_NAME TEST_OBJ_NAME)
     message(STATUS "  发现 ${COMPONENT_NAME} 组件的测试文件...")
     
+    get_filename_component(COMPONENT_TARGET ${COMPONENT_NAME} NAME)
+
+    # 基准测试只在显式开启时构建，单元测试中不做耗时统计
+    if(DFM_BUILD_BENCHMARKS)
+        file(GLOB_RECURSE BENCH_SOURCES
+            RELATIVE ${CMAKE_CURRENT_SOURCE_DIR}
+            "bench_*.cpp"
+        )
+        foreach(BENCH_SOURCE ${BENCH_SOURCES})
+            get_filename_component(BENCH_NAME ${BENCH_SOURCE} NAME_WE)
+            set(FULL_BENCH_NAME "${COMPONENT_TARGET}-${BENCH_NAME}")
+            message(STATUS "      ${BENCH_SOURCE} -> ${FULL_BENCH_NAME} (基准测试)")
+
+            dfm_add_test_executable(${FULL_BENCH_NAME} ${BENCH_SOURCE} ${COMPONENT_NAME} ${TEST_OBJ_NAME})
+            set_target_properties(${FULL_BENCH_NAME} PROPERTIES
+                RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/benchmarks/${COMPONENT_NAME}"
+            )
+            set_property(GLOBAL APPEND PROPERTY DFM_BENCHMARK_TARGETS ${FULL_BENCH_NAME})
+        endforeach()
+    endif()
+
     # 发现当前目录下的测试文件
     file(GLOB_RECURSE TEST_SOURCES 
         RELATIVE ${CMAKE_CURRENT_SOURCE_DIR}
@@ -261,67 +346,11 @@ function(dfm_discover_test_files COMPONENT_NAME TEST_OBJ_NAME)
     foreach(TEST_SOURCE ${TEST_SOURCES})
         # 获取测试名称（去掉扩展名）
         get_filename_component(TEST_NAME ${TEST_SOURCE} NAME_WE)
-        set(FULL_TEST_NAME "${COMPONENT_NAME}-${TEST_NAME}")
+        set(FULL_TEST_NAME "${COMPONENT_TARGET}-${TEST_NAME}")
         
         message(STATUS "      ${TEST_SOURCE} -> ${FULL_TEST_NAME}")
         
-        # 创建测试可执行文件
-        add_executable(${FULL_TEST_NAME}
-            ${TEST_SOURCE}
-            $<TARGET_OBJECTS:${TEST_OBJ_NAME}>  # 包含带覆盖率的源码对象
-        )
-        
-        # 创建testutils库（如果不存在）
-        if(NOT TARGET testutils)
-            add_library(testutils STATIC
-                ${DFM_SOURCE_DIR}/3rdparty/testutils/stub-ext/stub-shadow.cpp
-            )
-            target_include_directories(testutils PUBLIC
-                ${DFM_SOURCE_DIR}/3rdparty/testutils/cpp-stub
-                ${DFM_SOURCE_DIR}/3rdparty/testutils/stub-ext
-            )
-        endif()
-
-        # 链接测试框架和覆盖率库
-        target_link_libraries(${FULL_TEST_NAME} PRIVATE
-            Qt6::Test           # Qt6测试框架
-            GTest::GTest        # Google Test框架
-            GTest::Main         # Google Test主函数
-            gcov                # 覆盖率库
-            testutils           # 测试工具库
-        )
-        
-        # 继承对象库的依赖 - 这很重要！
-        target_link_libraries(${FULL_TEST_NAME} PRIVATE
-            $<TARGET_PROPERTY:${TEST_OBJ_NAME},LINK_LIBRARIES>
-        )
-        
-        # 手动添加组件特定的依赖
-        if(${COMPONENT_NAME} STREQUAL "dfm-framework")
-            target_link_libraries(${FULL_TEST_NAME} PRIVATE 
-                Qt6::Core 
-                Qt6::Concurrent
-                Dtk6::Core
-            )
-        elseif(${COMPONENT_NAME} STREQUAL "dfm-base")
-            target_link_libraries(${FULL_TEST_NAME} PRIVATE 
-                Qt6::Core 
-                Qt6::Widgets 
-                Qt6::DBus
-                Dtk6::Core
-            )
-        endif()
-        
-        # 继承对象库的include目录和编译选项
-        target_include_directories(${FULL_TEST_NAME} PRIVATE
-            ${DFM_SOURCE_DIR}/src
-            ${DFM_SOURCE_DIR}/include
-            ${DFM_SOURCE_DIR}/src/${COMPONENT_NAME}
-            ${CMAKE_CURRENT_SOURCE_DIR}  # 测试文件所在目录
-            ${CMAKE_CURRENT_SOURCE_DIR}/../../framework  # 测试框架头文件
-            ${DFM_SOURCE_DIR}/3rdparty/testutils/cpp-stub  # stub.h头文件
-            ${DFM_SOURCE_DIR}/3rdparty/testutils/stub-ext  # stubext.h头文件
-        )
+        dfm_add_test_executable(${FULL_TEST_NAME} ${TEST_SOURCE} ${COMPONENT_NAME} ${TEST_OBJ_NAME})
         
         # 设置测试运行时属性
         set_target_properties(${FULL_TEST_NAME} PROPERTIES
@@ -343,6 +372,78 @@ function(dfm_discover_test_files COMPONENT_NAME TEST_OBJ_NAME)
     message(STATUS "  ✅ 测试文件发现完成")
 endfunction()
 
+#[[
+函数: dfm_add_test_executable
+用途: 创建链接组件对象库的测试可执行文件（单元测试与基准测试共用）
+参数: TARGET_NAME - 可执行目标名称
+      SOURCE_FILE - 测试源文件
+      COMPONENT_NAME - 组件名称
+      TEST_OBJ_NAME - 测试对象库名称
+]]
+function(dfm_add_test_executable TARGET_NAME SOURCE_FILE COMPONENT_NAME TEST_OBJ_NAME)
+    # 创建测试可执行文件
+    add_executable(${TARGET_NAME}
+        ${SOURCE_FILE}
+        $<TARGET_OBJECTS:${TEST_OBJ_NAME}>  # 包含带覆盖率的源码对象
+    )
+    
+    # 创建testutils库（如果不存在）
+    if(NOT TARGET testutils)
+        add_library(testutils STATIC
+            ${DFM_SOURCE_DIR}/3rdparty/testutils/stub-ext/stub-shadow.cpp
+        )
+        target_include_directories(testutils PUBLIC
+            ${DFM_SOURCE_DIR}/3rdparty/testutils/cpp-stub
+            ${DFM_SOURCE_DIR}/3rdparty/testutils/stub-ext
+        )
+    endif()
+
+    # 链接测试框架和覆盖率库
+    target_link_libraries(${TARGET_NAME} PRIVATE
+        Qt6::Test           # Qt6测试框架
+        GTest::GTest        # Google Test框架
+        GTest::Main         # Google Test主函数
+        gcov                # 覆盖率库
+        testutils           # 测试工具库
+    )
+    
+    # 继承对象库的依赖 - 这很重要！
+    target_link_libraries(${TARGET_NAME} PRIVATE
+        $<TARGET_PROPERTY:${TEST_OBJ_NAME},LINK_LIBRARIES>
+    )
+    
+    # 手动添加组件特定的依赖
+    if(${COMPONENT_NAME} STREQUAL "dfm-framework")
+        target_link_libraries(${TARGET_NAME} PRIVATE 
+            Qt6::Core 
+            Qt6::Concurrent
+            Dtk6::Core
+        )
+    elseif(${COMPONENT_NAME} STREQUAL "dfm-base")
+        target_link_libraries(${TARGET_NAME} PRIVATE 
+            Qt6::Core 
+            Qt6::Widgets 
+            Qt6::DBus
+            Dtk6::Core
+        )
+    endif()
+    
+    # 继承对象库的include目录和编译选项
+    target_include_directories(${TARGET_NAME} PRIVATE
+        ${DFM_SOURCE_DIR}/src
+        ${DFM_SOURCE_DIR}/include
+        ${DFM_SOURCE_DIR}/src/${COMPONENT_NAME}
+        ${CMAKE_CURRENT_SOURCE_DIR}  # 测试文件所在目录
+        ${DFM_SOURCE_DIR}/tests2/framework  # 测试框架头文件
+        ${DFM_SOURCE_DIR}/3rdparty/testutils/cpp-stub  # stub.h头文件
+        ${DFM_SOURCE_DIR}/3rdparty/testutils/stub-ext  # stubext.h头文件
+        $<TARGET_PROPERTY:${TEST_OBJ_NAME},INCLUDE_DIRECTORIES>
+    )
+    target_compile_definitions(${TARGET_NAME} PRIVATE
+        $<TARGET_PROPERTY:${TEST_OBJ_NAME},COMPILE_DEFINITIONS>
+    )
+endfunction()
+
 #[[
 函数: dfm_print_component_summary
 用途: 打印组件测试配置摘要
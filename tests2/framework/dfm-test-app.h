@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// dfm-test-app.h - 为依赖事件循环、字体或剪贴板的测试提供应用实例
+// 测试可执行文件使用 GTest::Main 作为入口，不会自动创建 QApplication
+
+#pragma once
+
+#include <QApplication>
+
+namespace DFMTest {
+
+/**
+ * @brief 确保进程中存在 QApplication 实例
+ * 未指定平台插件时使用 offscreen，便于在无显示环境的CI中运行
+ */
+inline QApplication *ensureApplication()
+{
+    if (!QCoreApplication::instance()) {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        static int argc = 1;
+        static char arg0[] = "dfm-test";
+        static char *argv[] = { arg0, nullptr };
+        new QApplication(argc, argv);
+    }
+    return qobject_cast<QApplication *>(QCoreApplication::instance());
+}
+
+}   // namespace DFMTest
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_clipboard.cpp - 大量剪切文件时可见项的剪切状态查询耗时
+
+#include "dfm-test-app.h"
+
+#include "dfm-base/utils/clipboard.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QMimeData>
+#include <QPainter>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+
+static QList<QUrl> makeUrls(int count, const QString &dir)
+{
+    QList<QUrl> urls;
+    urls.reserve(count);
+    for (int i = 0; i < count; ++i)
+        urls << QUrl::fromLocalFile(QString("%1/file_%2").arg(dir).arg(i));
+    return urls;
+}
+
+class BM_ClipBoard : public testing::Test
+{
+protected:
+    static void SetUpTestSuite() { DFMTest::ensureApplication(); }
+
+    void SetUp() override
+    {
+        connection = QObject::connect(ClipBoard::instance(), &ClipBoard::cutStateChanged,
+                                      [this](const QList<QUrl> &urls) {
+                                          for (const QUrl &url : urls)
+                                              changed.insert(url);
+                                      });
+    }
+
+    void TearDown() override
+    {
+        QObject::disconnect(connection);
+        qApp->clipboard()->clear();
+        ClipBoard::instance()->onClipboardDataChanged();
+    }
+
+    void setClipboard(const QList<QUrl> &urls, bool cut)
+    {
+        QByteArray ba = cut ? "cut" : "copy";
+        for (const QUrl &url : urls)
+            ba.append('\n').append(url.toString().toUtf8());
+
+        QMimeData *mimeData = new QMimeData;
+        mimeData->setData("x-special/gnome-copied-files", ba);
+        mimeData->setUrls(urls);
+
+        changed.clear();
+        qApp->clipboard()->setMimeData(mimeData);
+        ClipBoard::instance()->onClipboardDataChanged();
+    }
+
+    QMetaObject::Connection connection;
+    QSet<QUrl> changed;
+};
+
+TEST_F(BM_ClipBoard, PaintVisibleItemsWithLargeCutSet)
+{
+    constexpr int kCutCount = 50000;
+    constexpr int kVisible = 1000;
+    constexpr int kFrames = 20;
+
+    // 可见项中一半处于剪切状态
+    const auto &cutUrls = makeUrls(kCutCount, "/tmp/ut_clipboard_cut");
+    QList<QUrl> visible = cutUrls.mid(kCutCount - kVisible / 2);
+    visible << makeUrls(kVisible / 2, "/tmp/ut_clipboard_other");
+    setClipboard(cutUrls, true);
+    EXPECT_EQ(changed.size(), kCutCount);
+
+    QImage image(400, 250, QImage::Format_ARGB32_Premultiplied);
+    auto paintFrame = [&](const std::function<bool(const QUrl &)> &isTransparent) {
+        int transparent = 0;
+        QPainter painter(&image);
+        for (int i = 0; i < kVisible; ++i) {
+            const bool trans = isTransparent(visible.at(i));
+            transparent += trans;
+            painter.setOpacity(trans ? 0.3 : 1);
+            painter.fillRect(QRect((i % 40) * 10, (i / 40) * 10, 10, 10), Qt::blue);
+        }
+        return transparent;
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    const int listCount = paintFrame([](const QUrl &url) {
+        return ClipBoard::instance()->clipboardFileUrlList().contains(url);
+    });
+    const qint64 listCost = timer.nsecsElapsed();
+
+    timer.restart();
+    int setCount = 0;
+    for (int frame = 0; frame < kFrames; ++frame) {
+        setCount = paintFrame([](const QUrl &url) {
+            return ClipBoard::instance()->isCutUrl(url);
+        });
+    }
+    const qint64 setCost = timer.nsecsElapsed() / kFrames;
+
+    std::cout << "[ PAINT    ] visible: " << kVisible << " cut: " << kCutCount
+              << " list scan(ms/frame): " << listCost / 1e6
+              << " hashed(ms/frame): " << setCost / 1e6 << std::endl;
+
+    EXPECT_EQ(listCount, kVisible / 2);
+    EXPECT_EQ(setCount, kVisible / 2);
+}
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_elidetextlayout.cpp - 大量文件名绘制时布局缓存对帧率的影响
+
+#include "dfm-test-app.h"
+
+#include "dfm-base/utils/elidetextlayout.h"
+
+#include <QCache>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+
+static const QRectF kTextRect(0, 0, 80, 48);
+
+class BM_ElideTextLayout : public testing::Test
+{
+protected:
+    static void SetUpTestSuite() { DFMTest::ensureApplication(); }
+    void SetUp() override { ElideTextLayout::clearLayoutCache(); }
+    void TearDown() override { ElideTextLayout::clearLayoutCache(); }
+};
+
+TEST_F(BM_ElideTextLayout, PaintFramesPerSecond)
+{
+    constexpr int kItems = 5000;
+    constexpr int kFrames = 5;
+    constexpr int kColumns = 50;
+
+    QStringList names;
+    names.reserve(kItems);
+    for (int i = 0; i < kItems; ++i)
+        names << QString("document_%1_with_a_reasonably_long_name.txt").arg(i);
+
+    QImage image(kColumns * 90, (kItems / kColumns) * 50, QImage::Format_ARGB32_Premultiplied);
+    auto paintFrames = [&](bool useDocument) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int frame = 0; frame < kFrames; ++frame) {
+            image.fill(Qt::white);
+            QPainter painter(&image);
+            for (int i = 0; i < kItems; ++i) {
+                ElideTextLayout layout(names.at(i));
+                layout.setAttribute(ElideTextLayout::kLineHeight, 16);
+                if (useDocument)
+                    layout.documentHandle();
+                const QPointF pos((i % kColumns) * 90, (i / kColumns) * 50);
+                layout.layout(kTextRect.translated(pos), Qt::ElideMiddle, &painter);
+            }
+        }
+        return qMax<qint64>(1, timer.elapsed());
+    };
+
+    const qint64 uncached = paintFrames(true);
+    const qint64 cached = paintFrames(false);
+    std::cout << "[ PAINT    ] items: " << kItems
+              << " uncached fps: " << kFrames * 1000.0 / uncached
+              << " cached fps: " << kFrames * 1000.0 / cached << std::endl;
+
+    EXPECT_EQ(ElideTextLayout::layoutCache()->count(), kItems);
+}
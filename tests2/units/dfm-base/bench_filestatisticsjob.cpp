@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_filestatisticsjob.cpp - 深而宽的目录树统计耗时
+
+#include "dfm-test-app.h"
+
+#include "dfm-base/utils/filestatisticsjob.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+
+struct TreeSummary
+{
+    int files { 0 };
+    int directories { 1 };
+    qint64 size { 0 };
+};
+
+static void createTree(const QString &dir, int depth, int width, int filesPerDir, int fileSize, TreeSummary *summary)
+{
+    const QByteArray content(fileSize, 'x');
+    for (int i = 0; i < filesPerDir; ++i) {
+        QFile file(QString("%1/file_%2").arg(dir).arg(i));
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(content);
+            ++summary->files;
+            summary->size += fileSize;
+        }
+    }
+
+    if (depth <= 0)
+        return;
+
+    for (int i = 0; i < width; ++i) {
+        const QString &sub = QString("%1/dir_%2").arg(dir).arg(i);
+        if (QDir().mkpath(sub)) {
+            ++summary->directories;
+            createTree(sub, depth - 1, width, filesPerDir, fileSize, summary);
+        }
+    }
+}
+
+TEST(BM_FileStatisticsJob, DeepWideTreeTiming)
+{
+    DFMTest::ensureApplication();
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    TreeSummary summary;
+    createTree(tmp.path(), 4, 6, 10, 16, &summary);
+
+    // 按原实现的方式逐项构造对象遍历，作为对照
+    QElapsedTimer timer;
+    timer.start();
+    int serialFiles = 0;
+    QDirIterator it(tmp.path(), QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QUrl &url = QUrl::fromLocalFile(it.next());
+        if (!QFileInfo(url.toLocalFile()).isDir())
+            ++serialFiles;
+    }
+    const qint64 serialCost = timer.elapsed();
+
+    timer.restart();
+    FileStatisticsJob job;
+    job.setFileHints(FileStatisticsJob::kNoFollowSymlink | FileStatisticsJob::kDontSizeInfoPointer);
+    job.start({ QUrl::fromLocalFile(tmp.path()) });
+    ASSERT_TRUE(job.wait(120000));
+    const qint64 jobCost = timer.elapsed();
+
+    std::cout << "[ STAT     ] files: " << summary.files << " dirs: " << summary.directories
+              << " serial walk(ms): " << serialCost << " job(ms): " << jobCost << std::endl;
+
+    EXPECT_EQ(serialFiles, summary.files);
+    EXPECT_EQ(job.filesCount(), summary.files);
+    EXPECT_EQ(job.directorysCount(), summary.directories);
+    EXPECT_EQ(job.totalSize(), summary.size);
+}
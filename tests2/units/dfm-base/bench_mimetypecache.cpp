@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_mimetypecache.cpp - MIME 类型解析的冷启动、热缓存与重启加载耗时
+
+#include "dfm-base/mimetype/dmimedatabase.h"
+#include "dfm-base/mimetype/mimetypecache.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+
+static const QByteArray kPngHeader("\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16);
+
+static bool writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    return file.write(content) == content.size();
+}
+
+class BM_MimeTypeCache : public testing::Test
+{
+protected:
+    void SetUp() override { MimeTypeCache::instance()->clear(); }
+    void TearDown() override
+    {
+        MimeTypeCache::instance()->setPersistentFile(QString());
+        MimeTypeCache::instance()->clear();
+    }
+};
+
+TEST_F(BM_MimeTypeCache, ResolveFixtureColdWarmAndRestart)
+{
+    constexpr int kFiles = 50000;
+
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    QStringList files;
+    files.reserve(kFiles);
+    const QByteArray &png = kPngHeader + QByteArray(64, '\0');
+    for (int i = 0; i < kFiles; ++i) {
+        const QString &path = tmp.filePath(QString("file_%1").arg(i));
+        ASSERT_TRUE(writeFile(path, i % 2 ? png : QByteArray("text content\n")));
+        files << path;
+    }
+
+    auto resolveAll = [&]() {
+        QElapsedTimer timer;
+        timer.start();
+        DMimeDatabase db;
+        int images = 0;
+        for (const QString &path : files)
+            images += db.mimeTypeForFile(path, QMimeDatabase::MatchDefault, QString()).name() == "image/png";
+        EXPECT_EQ(images, kFiles / 2);
+        return timer.elapsed();
+    };
+
+    const QString &cacheFile = tmp.filePath("MimeTypeCache.dat");
+    MimeTypeCache::instance()->setPersistentFile(cacheFile);
+
+    const qint64 cold = resolveAll();
+    const qint64 warm = resolveAll();
+    EXPECT_EQ(MimeTypeCache::instance()->count(), kFiles);
+
+    // 模拟重启：保存后清空内存中的缓存再从文件加载
+    ASSERT_TRUE(MimeTypeCache::instance()->save());
+    MimeTypeCache::instance()->clear();
+    QElapsedTimer timer;
+    timer.start();
+    MimeTypeCache::instance()->setPersistentFile(cacheFile);
+    const qint64 loadCost = timer.elapsed();
+    EXPECT_EQ(MimeTypeCache::instance()->count(), kFiles);
+    const qint64 restart = resolveAll();
+
+    std::cout << "[ MIME     ] files: " << kFiles << " cold(ms): " << cold << " warm(ms): " << warm
+              << " load(ms): " << loadCost << " after restart(ms): " << restart << std::endl;
+}
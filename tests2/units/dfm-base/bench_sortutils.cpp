@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_sortutils.cpp - 按文件名排序时逐次比较字符串与比较排序键的耗时
+
+#include "dfm-base/utils/sortutils.h"
+#include "dfm-base/interfaces/sortfileinfo.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+
+static QList<SortInfoPointer> makeInfos(int count)
+{
+    static const QStringList kStems { "report", "IMG_", "文档", "Screenshot ", "新建文件夹", "backup-", "Résumé" };
+    static const QStringList kSuffixes { "txt", "png", "pdf", "docx", "", "tar.gz" };
+    QRandomGenerator generator(7);
+
+    QList<SortInfoPointer> infos;
+    infos.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QString name = kStems.at(generator.bounded(kStems.size())) + QString::number(generator.bounded(100000));
+        const QString &suffix = kSuffixes.at(generator.bounded(kSuffixes.size()));
+        if (!suffix.isEmpty())
+            name += '.' + suffix;
+
+        SortInfoPointer info(new SortFileInfo);
+        info->setUrl(QUrl::fromLocalFile("/bench/" + name));
+        infos.append(info);
+    }
+    return infos;
+}
+
+TEST(BM_SortUtils, FileNameSortKey)
+{
+    for (int count : { 10000, 100000 }) {
+        QList<SortInfoPointer> byString = makeInfos(count);
+        QList<SortInfoPointer> byKey = byString;
+
+        QElapsedTimer timer;
+        timer.start();
+        std::sort(byString.begin(), byString.end(), [](const SortInfoPointer &left, const SortInfoPointer &right) {
+            return SortUtils::compareStringForFileName(left->fileUrl().fileName(), right->fileUrl().fileName());
+        });
+        const qint64 stringMs = timer.restart();
+
+        // 排序键在第一次比较时生成，计入排序耗时
+        std::sort(byKey.begin(), byKey.end(), [](const SortInfoPointer &left, const SortInfoPointer &right) {
+            return left->fileNameSortKey() < right->fileNameSortKey();
+        });
+        const qint64 keyMs = timer.restart();
+
+        std::sort(byKey.begin(), byKey.end(), [](const SortInfoPointer &left, const SortInfoPointer &right) {
+            return left->fileNameSortKey() > right->fileNameSortKey();
+        });
+        const qint64 resortMs = timer.elapsed();
+
+        std::cout << "[ SORTKEY  ] files: " << count
+                  << " compareString(ms): " << stringMs
+                  << " sortKey first(ms): " << keyMs
+                  << " sortKey resort(ms): " << resortMs << std::endl;
+
+        for (int i = 0; i < count; ++i)
+            EXPECT_EQ(byString.at(i)->fileNameSortKey(), byKey.at(count - 1 - i)->fileNameSortKey());
+    }
+}
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_sqlitehandle.cpp - 标记数据库负载下预编译语句与批量插入的耗时
+
+#include <dfm-base/base/db/sqlitehandle.h>
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+
+namespace TestObj {
+
+class User : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("TableName", "User")
+    Q_PROPERTY(int id READ getId WRITE setId)
+    Q_PROPERTY(QString name READ getName WRITE setName)
+    Q_PROPERTY(QString password READ getPassword WRITE setPassword)
+    Q_PROPERTY(QString email READ getEmail WRITE setEmail)
+    Q_PROPERTY(double height READ getHeight WRITE setHeight)
+    Q_PROPERTY(double weight READ getWeight WRITE setWeight)
+
+public:
+    explicit User(QObject *parent = nullptr)
+        : QObject(parent) { }
+
+    int getId() const { return id; }
+    void setId(int value) { id = value; }
+    QString getName() const { return name; }
+    void setName(const QString &value) { name = value; }
+    QString getPassword() const { return password; }
+    void setPassword(const QString &value) { password = value; }
+    QString getEmail() const { return email; }
+    void setEmail(const QString &value) { email = value; }
+    double getHeight() const { return height; }
+    void setHeight(double value) { height = value; }
+    double getWeight() const { return weight; }
+    void setWeight(double value) { weight = value; }
+
+private:
+    int id { 0 };
+    QString name;
+    QString password;
+    QString email;
+    double height { 0 };
+    double weight { 0 };
+};
+
+}   // namespace TestObj
+
+using namespace TestObj;
+
+class BM_SqliteHandle : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        ASSERT_TRUE(tmp.isValid());
+        handle.reset(new SqliteHandle(tmp.filePath("test.db")));
+        ASSERT_TRUE(handle->createTable<User>(SqliteConstraint::primary("id"),
+                                              SqliteConstraint::autoIncreament("id")));
+        handle->excute("CREATE INDEX IF NOT EXISTS idx_user_name ON User(name);");
+        // 基准测试会执行大量语句，关闭逐条的 SQL 日志
+        logDFMBase().setEnabled(QtInfoMsg, false);
+    }
+    virtual void TearDown() override
+    {
+        logDFMBase().setEnabled(QtInfoMsg, true);
+        handle.reset();
+    }
+
+    // 以标记数据库的形式填充：name 为文件路径，每 100 个路径一个目录
+    void seed(int count)
+    {
+        handle->transaction([this, count]() {
+            for (int i = 0; i < count; i += 500) {
+                QStringList values;
+                for (int j = i; j < qMin(i + 500, count); ++j)
+                    values.append(QString("('/home/user/dir_%1/file_%2','','',0,0)").arg(j / 100).arg(j));
+                if (!handle->excute("INSERT INTO User(name,password,email,height,weight) VALUES "
+                                    + values.join(",") + ";"))
+                    return false;
+            }
+            return true;
+        });
+    }
+
+    static QVariantList paths(int count)
+    {
+        QVariantList list;
+        for (int i = 0; i < count; ++i)
+            list.append(QString("/home/user/dir_%1/file_%2").arg(i / 100).arg(i));
+        return list;
+    }
+
+    QTemporaryDir tmp;
+    QScopedPointer<SqliteHandle> handle;
+};
+
+TEST_F(BM_SqliteHandle, queryRateTiming)
+{
+    constexpr int kSeedCount = 10000;
+    constexpr int kQueryCount = 5000;
+    seed(kSeedCount);
+
+    auto field = Expression::Field<User>;
+    const QVariantList &all = paths(kSeedCount);
+    QElapsedTimer timer;
+
+    // 标记守护进程的典型负载：按路径查询文件的标记
+    timer.start();
+    for (int i = 0; i < kQueryCount; ++i) {
+        const auto &expr = field("name") == all.at(i % kSeedCount);
+        SqliteHelper::excute(tmp.filePath("test.db"), "SELECT * FROM User WHERE " + expr.toString() + ";");
+    }
+    const qint64 literalMs = qMax<qint64>(1, timer.elapsed());
+
+    timer.restart();
+    for (int i = 0; i < kQueryCount; ++i)
+        handle->query<User>().where(field("name") == all.at(i % kSeedCount)).toBeans();
+    const qint64 preparedMs = qMax<qint64>(1, timer.elapsed());
+
+    // 逐条插入，每条语句单独提交
+    timer.restart();
+    for (int i = 0; i < 200; ++i)
+        handle->excute(QString("INSERT INTO User(name,password,email,height,weight) VALUES ('/tmp/literal_%1','','',0,0);").arg(i));
+    const qint64 insertMs = qMax<qint64>(1, timer.elapsed());
+
+    QList<QSharedPointer<User>> users;
+    for (int i = 0; i < 200; ++i) {
+        QSharedPointer<User> user { new User };
+        user->setName(QString("/tmp/prepared_%1").arg(i));
+        users.append(user);
+    }
+    timer.restart();
+    handle->transaction([&]() { return handle->insertBatch<User>(users); });
+    const qint64 batchMs = qMax<qint64>(1, timer.elapsed());
+
+    std::cout << "[ QPS      ] literal lookups/s: " << kQueryCount * 1000 / literalMs
+              << " prepared lookups/s: " << kQueryCount * 1000 / preparedMs
+              << " single inserts/s: " << 200 * 1000 / insertMs
+              << " batch inserts/s: " << 200 * 1000 / batchMs << std::endl;
+}
+
+#include "bench_sqlitehandle.moc"
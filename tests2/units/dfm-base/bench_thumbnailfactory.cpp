@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_thumbnailfactory.cpp - 1000 张图片生成缩略图的吞吐量与 GUI 线程阻塞时间
+// 图片由 QImage 生成到临时目录，HOME 指向临时目录使缩略图缓存不写入用户目录
+// GUI 线程阻塞时间由 5ms 定时器的延迟累计得到
+
+#include "dfm-base/utils/thumbnail/thumbnailfactory.h"
+
+#include "dfm-test-app.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QImage>
+#include <QLoggingCategory>
+#include <QPainter>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QTimer>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+DFMGLOBAL_USE_NAMESPACE
+
+static bool generateImage(const QString &path, int index)
+{
+    QImage image(1600, 1200, QImage::Format_RGB32);
+    image.fill(QColor::fromHsv(index * 37 % 360, 160, 200));
+    QPainter painter(&image);
+    painter.setPen(Qt::black);
+    for (int y = 0; y < image.height(); y += 40)
+        painter.drawLine(0, y, image.width(), (y + index * 13) % image.height());
+    painter.drawText(image.rect(), Qt::AlignCenter, QString::number(index));
+    painter.end();
+    return image.save(path, index % 2 ? "PNG" : "JPG");
+}
+
+TEST(BM_ThumbnailFactory, GenerateImageFixture)
+{
+    constexpr int kImages = 1000;
+    constexpr int kTickMs = 5;
+
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QByteArray oldHome = qgetenv("HOME");
+    qputenv("HOME", tmp.path().toLocal8Bit());
+    DFMTest::ensureApplication();
+    QLoggingCategory::setFilterRules("org.deepin.dde.filemanager.*.debug=false\n"
+                                     "org.deepin.dde.filemanager.*.info=false");
+
+    QDir(tmp.path()).mkdir("images");
+    QList<QUrl> urls;
+    for (int i = 0; i < kImages; ++i) {
+        const QString &path = tmp.filePath(QString("images/image_%1.%2").arg(i).arg(i % 2 ? "png" : "jpg"));
+        ASSERT_TRUE(generateImage(path, i));
+        urls.append(QUrl::fromLocalFile(path));
+    }
+    // 刚写入的文件会被视为不稳定而延时生成，等待超过稳定判断的 2 秒
+    QThread::msleep(2100);
+
+    ThumbnailFactory *factory = ThumbnailFactory::instance();
+    int finished = 0;
+    int failed = 0;
+    QEventLoop loop;
+    auto onDone = [&] {
+        if (finished + failed == kImages)
+            loop.quit();
+    };
+    auto finishedConn = QObject::connect(factory, &ThumbnailFactory::produceFinished, &loop, [&] { ++finished; onDone(); });
+    auto failedConn = QObject::connect(factory, &ThumbnailFactory::produceFailed, &loop, [&] { ++failed; onDone(); });
+
+    // 定时器按期触发的偏差即 GUI 线程被占用的时间
+    QElapsedTimer tickTimer;
+    qint64 blockedMs = 0;
+    qint64 maxBlockedMs = 0;
+    QTimer ticker;
+    ticker.setTimerType(Qt::PreciseTimer);
+    ticker.setInterval(kTickMs);
+    QObject::connect(&ticker, &QTimer::timeout, &loop, [&] {
+        const qint64 late = tickTimer.restart() - kTickMs;
+        if (late > 0) {
+            blockedMs += late;
+            maxBlockedMs = qMax(maxBlockedMs, late);
+        }
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    tickTimer.start();
+    ticker.start();
+    for (const QUrl &url : std::as_const(urls))
+        factory->joinThumbnailJob(url, kLarge);
+    QTimer::singleShot(120 * 1000, &loop, &QEventLoop::quit);
+    loop.exec();
+    const qint64 cost = timer.elapsed();
+    ticker.stop();
+
+    QObject::disconnect(finishedConn);
+    QObject::disconnect(failedConn);
+    QLoggingCategory::setFilterRules(QString());
+    qputenv("HOME", oldHome);
+
+    EXPECT_EQ(finished + failed, kImages);
+    std::cout << "[ THUMB    ] images: " << kImages
+              << " finished: " << finished << " failed: " << failed
+              << " elapsed(ms): " << cost
+              << " throughput(img/s): " << finished * 1000.0 / qMax<qint64>(cost, 1)
+              << " GUI blocked(ms): " << blockedMs
+              << " max block(ms): " << maxBlockedMs << std::endl;
+}
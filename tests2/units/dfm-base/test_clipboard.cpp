@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-test-app.h"
+
+#include "dfm-base/utils/clipboard.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QMimeData>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+static QList<QUrl> makeUrls(int count, const QString &dir)
+{
+    QList<QUrl> urls;
+    urls.reserve(count);
+    for (int i = 0; i < count; ++i)
+        urls << QUrl::fromLocalFile(QString("%1/file_%2").arg(dir).arg(i));
+    return urls;
+}
+
+class UT_ClipBoard : public testing::Test
+{
+protected:
+    static void SetUpTestSuite() { DFMTest::ensureApplication(); }
+
+    void SetUp() override
+    {
+        connection = QObject::connect(ClipBoard::instance(), &ClipBoard::cutStateChanged,
+                                      [this](const QList<QUrl> &urls) {
+                                          for (const QUrl &url : urls)
+                                              changed.insert(url);
+                                      });
+    }
+
+    void TearDown() override
+    {
+        QObject::disconnect(connection);
+        qApp->clipboard()->clear();
+        ClipBoard::instance()->onClipboardDataChanged();
+    }
+
+    void setClipboard(const QList<QUrl> &urls, bool cut)
+    {
+        QByteArray ba = cut ? "cut" : "copy";
+        for (const QUrl &url : urls)
+            ba.append('\n').append(url.toString().toUtf8());
+
+        QMimeData *mimeData = new QMimeData;
+        mimeData->setData("x-special/gnome-copied-files", ba);
+        mimeData->setUrls(urls);
+
+        changed.clear();
+        qApp->clipboard()->setMimeData(mimeData);
+        ClipBoard::instance()->onClipboardDataChanged();
+    }
+
+    QMetaObject::Connection connection;
+    QSet<QUrl> changed;
+};
+
+TEST_F(UT_ClipBoard, CutStateChangedOnlyForDiff)
+{
+    const auto &urls = makeUrls(4, "/tmp/ut_clipboard");
+    const QUrl &a = urls.at(0), &b = urls.at(1), &c = urls.at(2), &d = urls.at(3);
+
+    setClipboard({ a, b, c }, true);
+    EXPECT_EQ(changed, QSet<QUrl>({ a, b, c }));
+    EXPECT_TRUE(ClipBoard::instance()->isCutUrl(a));
+    EXPECT_FALSE(ClipBoard::instance()->isCutUrl(d));
+
+    const quint64 version = ClipBoard::instance()->clipboardVersion();
+    setClipboard({ b, c, d }, true);
+    EXPECT_EQ(changed, QSet<QUrl>({ a, d }));
+    EXPECT_GT(ClipBoard::instance()->clipboardVersion(), version);
+    EXPECT_EQ(ClipBoard::instance()->clipboardFileUrlList(), QList<QUrl>({ b, c, d }));
+
+    // 复制的文件不是剪切状态
+    setClipboard({ b, c, d }, false);
+    EXPECT_EQ(changed, QSet<QUrl>({ b, c, d }));
+    EXPECT_FALSE(ClipBoard::instance()->isCutUrl(b));
+    EXPECT_EQ(ClipBoard::instance()->snapshot()->urlSet.size(), 3);
+}
+
+TEST_F(UT_ClipBoard, LookupInLargeCutSet)
+{
+    constexpr int kCutCount = 5000;
+    constexpr int kVisible = 200;
+
+    // 可见项中一半处于剪切状态
+    const auto &cutUrls = makeUrls(kCutCount, "/tmp/ut_clipboard_cut");
+    QList<QUrl> visible = cutUrls.mid(kCutCount - kVisible / 2);
+    visible << makeUrls(kVisible / 2, "/tmp/ut_clipboard_other");
+    setClipboard(cutUrls, true);
+    EXPECT_EQ(changed.size(), kCutCount);
+
+    const auto &list = ClipBoard::instance()->clipboardFileUrlList();
+    int cut = 0;
+    for (const QUrl &url : visible) {
+        EXPECT_EQ(ClipBoard::instance()->isCutUrl(url), list.contains(url));
+        cut += ClipBoard::instance()->isCutUrl(url);
+    }
+    EXPECT_EQ(cut, kVisible / 2);
+}
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_devicewatcher.cpp - 设备容量轮询调度测试
+
+#include "stubext.h"
+#include "dfm-test-app.h"
+
+#include <dfm-base/base/device/private/devicewatcher.h>
+#include <dfm-base/base/device/private/devicewatcher_p.h>
+#include <dfm-base/base/device/devicemanager.h>
+
+#include <QDeadlineTimer>
+#include <QSemaphore>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+class UT_DeviceWatcherPrivate : public testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        DFMTest::ensureApplication();
+    }
+    virtual void SetUp() override
+    {
+        watcher = new DeviceWatcher();
+        pd = watcher->d.data();
+
+        pd->allBlockInfos.insert("/org/freedesktop/UDisks2/block_devices/loop1", {});
+        pd->allProtocolInfos.insert("smb://1.2.3.4/hello", {});
+    }
+    virtual void TearDown() override
+    {
+        stub.clear();
+        delete watcher;
+        watcher = nullptr;
+    }
+
+    stub_ext::StubExt stub;
+    DeviceWatcher *watcher { nullptr };
+    DeviceWatcherPrivate *pd { nullptr };
+};
+
+TEST_F(UT_DeviceWatcherPrivate, SlowDeviceDoesNotBlockOthers)
+{
+    const QString slowId { "smb://1.2.3.4/hello" };
+    const QString fastId { "/org/freedesktop/UDisks2/block_devices/loop1" };
+    pd->allBlockInfos[fastId]["MountPoint"] = "/home";
+    pd->allBlockInfos[fastId]["Id"] = fastId;
+    pd->allProtocolInfos[slowId]["MountPoint"] = "/run/user/1000/gvfs/smb-share:server=1.2.3.4,share=hello";
+    pd->allProtocolInfos[slowId]["Id"] = slowId;
+
+    // 模拟卡住的网络挂载：放行之前一直阻塞
+    QSemaphore gate;
+    stub.set_lamda(&DeviceWatcherPrivate::queryUsageOfProtocol, [&] {
+        __DBG_STUB_INVOKE__
+        gate.tryAcquire(1, 5000);
+        return DevStorage { 100, 50, 50 };
+    });
+    stub.set_lamda(&DeviceWatcherPrivate::queryUsageOfBlock, [] {
+        __DBG_STUB_INVOKE__
+        return DevStorage { 200, 100, 100 };
+    });
+
+    QStringList arrivals;
+    auto conn = QObject::connect(DevMngIns, &DeviceManager::devSizeChanged, pd, [&](const QString &id) {
+        arrivals.append(id);
+    });
+    auto waitFor = [&](int count) {
+        QDeadlineTimer deadline(5000);
+        while (arrivals.size() < count && !deadline.hasExpired())
+            qApp->processEvents(QEventLoop::AllEvents, 20);
+    };
+
+    // 慢设备仍在查询时，快设备的结果已经送达
+    pd->queryUsageAsync();
+    waitFor(1);
+    EXPECT_EQ(arrivals, QStringList { fastId });
+
+    gate.release();
+    waitFor(2);
+    QObject::disconnect(conn);
+    EXPECT_EQ(arrivals, (QStringList { fastId, slowId }));
+
+    // 慢设备查询期间再次调度时被跳过，超时后计入指标
+    pd->usageStates[slowId].nextDue = 0;
+    pd->usageStates[slowId].startedAt = pd->usageClock.elapsed() - pd->kUsageQueryTimeout;
+    pd->queryUsageAsync();
+    EXPECT_EQ(pd->usageMetrics.timedOut, 1u);
+    EXPECT_EQ(pd->usageMetrics.skipped, 1u);
+}
+
+TEST_F(UT_DeviceWatcherPrivate, UnchangedUsageBacksOff)
+{
+    const QString id { "/org/freedesktop/UDisks2/block_devices/loop1" };
+    pd->usageStates[id].startedAt = 0;
+    pd->onUsageQueried(id, DFMMOUNT::DeviceType::kBlockDevice, { 200, 100, 100 });
+    EXPECT_EQ(pd->usageStates[id].interval, pd->kPollingInterval);
+
+    pd->usageStates[id].startedAt = 0;
+    pd->onUsageQueried(id, DFMMOUNT::DeviceType::kBlockDevice, { 200, 100, 100 });
+    EXPECT_EQ(pd->usageStates[id].interval, pd->kPollingInterval * 2);
+    EXPECT_EQ(pd->usageMetrics.unchanged, 1u);
+
+    pd->usageStates[id].startedAt = 0;
+    pd->onUsageQueried(id, DFMMOUNT::DeviceType::kBlockDevice, { 200, 90, 110 });
+    EXPECT_EQ(pd->usageStates[id].interval, pd->kPollingInterval);
+}
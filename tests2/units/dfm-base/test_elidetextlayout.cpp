@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-test-app.h"
+
+#include "dfm-base/utils/elidetextlayout.h"
+
+#include <QCache>
+#include <QImage>
+#include <QPainter>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+static const QRectF kTextRect(0, 0, 80, 48);
+
+static QList<QRectF> layoutText(const QString &text, bool useDocument, QStringList *lines, QPainter *painter = nullptr)
+{
+    ElideTextLayout layout(text);
+    layout.setAttribute(ElideTextLayout::kLineHeight, 16);
+    if (useDocument)
+        layout.documentHandle();
+    return layout.layout(kTextRect, Qt::ElideMiddle, painter, Qt::NoBrush, lines);
+}
+
+class UT_ElideTextLayout : public testing::Test
+{
+protected:
+    static void SetUpTestSuite() { DFMTest::ensureApplication(); }
+    void SetUp() override { ElideTextLayout::clearLayoutCache(); }
+    void TearDown() override { ElideTextLayout::clearLayoutCache(); }
+};
+
+TEST_F(UT_ElideTextLayout, CachedLayoutMatchesDocumentLayout)
+{
+    const QString name("a_very_long_file_name_that_needs_to_be_wrapped_and_elided.txt");
+
+    QStringList docLines;
+    const auto &docRects = layoutText(name, true, &docLines);
+    EXPECT_EQ(ElideTextLayout::layoutCache()->count(), 0);
+
+    QStringList lines;
+    const auto &rects = layoutText(name, false, &lines);
+    EXPECT_EQ(ElideTextLayout::layoutCache()->count(), 1);
+    EXPECT_EQ(rects, docRects);
+    EXPECT_EQ(lines, docLines);
+
+    // 命中缓存时结果平移到目标区域
+    ElideTextLayout layout(name);
+    layout.setAttribute(ElideTextLayout::kLineHeight, 16);
+    const auto &moved = layout.layout(kTextRect.translated(100, 200), Qt::ElideMiddle);
+    EXPECT_EQ(ElideTextLayout::layoutCache()->count(), 1);
+    ASSERT_EQ(moved.size(), docRects.size());
+    for (int i = 0; i < moved.size(); ++i)
+        EXPECT_EQ(moved.at(i), docRects.at(i).translated(100, 200));
+}
+
+TEST_F(UT_ElideTextLayout, CacheKeyCoversLayoutInputs)
+{
+    ElideTextLayout layout("file.txt");
+    layout.setAttribute(ElideTextLayout::kLineHeight, 16);
+    const QString &key = layout.cacheKey(kTextRect.size(), Qt::ElideMiddle);
+    ASSERT_FALSE(key.isEmpty());
+
+    // 高度不同但可容纳行数相同时复用
+    EXPECT_EQ(layout.cacheKey(QSizeF(80, 63), Qt::ElideMiddle), key);
+    EXPECT_NE(layout.cacheKey(QSizeF(80, 64), Qt::ElideMiddle), key);
+    EXPECT_NE(layout.cacheKey(QSizeF(81, 48), Qt::ElideMiddle), key);
+    EXPECT_NE(layout.cacheKey(kTextRect.size(), Qt::ElideRight), key);
+
+    layout.setText("file2.txt");
+    EXPECT_NE(layout.cacheKey(kTextRect.size(), Qt::ElideMiddle), key);
+    layout.setText("file.txt");
+
+    QFont font;
+    font.setPixelSize(30);
+    layout.setAttribute(ElideTextLayout::kFont, font);
+    EXPECT_NE(layout.cacheKey(kTextRect.size(), Qt::ElideMiddle), key);
+    layout.setAttribute(ElideTextLayout::kFont, QFont());
+
+    layout.setHighlightKeywords({ "file" });
+    layout.setHighlightColor(Qt::red);
+    layout.setHighlightEnabled(true);
+    EXPECT_NE(layout.cacheKey(kTextRect.size(), Qt::ElideMiddle), key);
+}
+
+TEST_F(UT_ElideTextLayout, PaintFillsLayoutCache)
+{
+    constexpr int kItems = 200;
+    constexpr int kColumns = 20;
+
+    QImage image(kColumns * 90, (kItems / kColumns) * 50, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    QPainter painter(&image);
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < kItems; ++i) {
+            ElideTextLayout layout(QString("document_%1_with_a_reasonably_long_name.txt").arg(i));
+            layout.setAttribute(ElideTextLayout::kLineHeight, 16);
+            const QPointF pos((i % kColumns) * 90, (i / kColumns) * 50);
+            EXPECT_FALSE(layout.layout(kTextRect.translated(pos), Qt::ElideMiddle, &painter).isEmpty());
+        }
+    }
+
+    // 第二轮绘制全部命中缓存，不再新增条目
+    EXPECT_EQ(ElideTextLayout::layoutCache()->count(), kItems);
+}
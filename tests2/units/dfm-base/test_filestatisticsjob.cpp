@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-test-app.h"
+
+#include "dfm-base/utils/filestatisticsjob.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+DFMBASE_USE_NAMESPACE
+
+struct TreeSummary
+{
+    int files { 0 };
+    int directories { 1 };
+    qint64 size { 0 };
+};
+
+static void createTree(const QString &dir, int depth, int width, int filesPerDir, int fileSize, TreeSummary *summary)
+{
+    const QByteArray content(fileSize, 'x');
+    for (int i = 0; i < filesPerDir; ++i) {
+        QFile file(QString("%1/file_%2").arg(dir).arg(i));
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(content);
+            ++summary->files;
+            summary->size += fileSize;
+        }
+    }
+
+    if (depth <= 0)
+        return;
+
+    for (int i = 0; i < width; ++i) {
+        const QString &sub = QString("%1/dir_%2").arg(dir).arg(i);
+        if (QDir().mkpath(sub)) {
+            ++summary->directories;
+            createTree(sub, depth - 1, width, filesPerDir, fileSize, summary);
+        }
+    }
+}
+
+TEST(UT_FileStatisticsJob, LocalTreeWithHardLink)
+{
+    DFMTest::ensureApplication();
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    TreeSummary summary;
+    createTree(tmp.path(), 2, 3, 4, 100, &summary);
+    // 硬链接只统计一次
+    ASSERT_EQ(::link(QFile::encodeName(tmp.path() + "/file_0").constData(),
+                     QFile::encodeName(tmp.path() + "/dir_0/hardlink").constData()),
+              0);
+
+    FileStatisticsJob job;
+    job.start({ QUrl::fromLocalFile(tmp.path()) });
+    ASSERT_TRUE(job.wait(30000));
+
+    EXPECT_EQ(job.filesCount(), summary.files);
+    EXPECT_EQ(job.directorysCount(), summary.directories);
+    EXPECT_EQ(job.totalSize(), summary.size);
+
+    // 文件列表中目录总在其子项之前
+    const auto &allFiles = job.getFileSizeInfo()->allFiles;
+    EXPECT_EQ(allFiles.size(), summary.files + summary.directories + 1);
+    QSet<QString> seen { QFileInfo(tmp.path()).absolutePath() };
+    for (const QUrl &url : allFiles) {
+        const QString &path = url.toLocalFile();
+        EXPECT_TRUE(seen.contains(QFileInfo(path).absolutePath())) << path.toStdString();
+        seen.insert(path);
+    }
+}
+
+TEST(UT_FileStatisticsJob, TreeWithoutSizeInfo)
+{
+    DFMTest::ensureApplication();
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    TreeSummary summary;
+    createTree(tmp.path(), 3, 3, 5, 16, &summary);
+
+    FileStatisticsJob job;
+    job.setFileHints(FileStatisticsJob::kNoFollowSymlink | FileStatisticsJob::kDontSizeInfoPointer);
+    job.start({ QUrl::fromLocalFile(tmp.path()) });
+    ASSERT_TRUE(job.wait(30000));
+
+    EXPECT_EQ(job.filesCount(), summary.files);
+    EXPECT_EQ(job.directorysCount(), summary.directories);
+    EXPECT_EQ(job.totalSize(), summary.size);
+}
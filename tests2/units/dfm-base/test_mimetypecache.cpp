@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/mimetype/dmimedatabase.h"
+#include "dfm-base/mimetype/mimetypecache.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+static const QByteArray kPngHeader("\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16);
+
+static bool writeFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    return file.write(content) == content.size();
+}
+
+class UT_MimeTypeCache : public testing::Test
+{
+protected:
+    void SetUp() override { MimeTypeCache::instance()->clear(); }
+    void TearDown() override
+    {
+        MimeTypeCache::instance()->setPersistentFile(QString());
+        MimeTypeCache::instance()->clear();
+    }
+};
+
+TEST_F(UT_MimeTypeCache, SharedAcrossInstancesAndInvalidatedOnChange)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString &path = tmp.filePath("noext");
+    ASSERT_TRUE(writeFile(path, "plain text content\n"));
+
+    EXPECT_EQ(DMimeDatabase().mimeTypeForFile(path, QMimeDatabase::MatchDefault, QString()).name(), "text/plain");
+    EXPECT_EQ(MimeTypeCache::instance()->count(), 1);
+
+    // 另一个实例直接命中缓存
+    EXPECT_EQ(DMimeDatabase().mimeTypeForFile(path, QMimeDatabase::MatchDefault, QString()).name(), "text/plain");
+    EXPECT_EQ(MimeTypeCache::instance()->count(), 1);
+
+    // 内容改变后修改时间和大小变化，不会命中旧结果
+    ASSERT_TRUE(writeFile(path, kPngHeader + QByteArray(64, '\0')));
+    EXPECT_EQ(DMimeDatabase().mimeTypeForFile(path, QMimeDatabase::MatchDefault, QString()).name(), "image/png");
+    EXPECT_EQ(MimeTypeCache::instance()->count(), 2);
+
+    // 按扩展名匹配不进入缓存
+    DMimeDatabase().mimeTypeForFile(path, QMimeDatabase::MatchExtension, QString());
+    EXPECT_EQ(MimeTypeCache::instance()->count(), 2);
+}
+
+TEST_F(UT_MimeTypeCache, PersistAndReload)
+{
+    constexpr int kFiles = 200;
+
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    QStringList files;
+    const QByteArray &png = kPngHeader + QByteArray(64, '\0');
+    for (int i = 0; i < kFiles; ++i) {
+        const QString &path = tmp.filePath(QString("file_%1").arg(i));
+        ASSERT_TRUE(writeFile(path, i % 2 ? png : QByteArray("text content\n")));
+        files << path;
+    }
+
+    auto resolveAll = [&]() {
+        DMimeDatabase db;
+        int images = 0;
+        for (const QString &path : files)
+            images += db.mimeTypeForFile(path, QMimeDatabase::MatchDefault, QString()).name() == "image/png";
+        EXPECT_EQ(images, kFiles / 2);
+    };
+
+    const QString &cacheFile = tmp.filePath("MimeTypeCache.dat");
+    MimeTypeCache::instance()->setPersistentFile(cacheFile);
+    resolveAll();
+    EXPECT_EQ(MimeTypeCache::instance()->count(), kFiles);
+
+    // 模拟重启：保存后清空内存中的缓存再从文件加载
+    ASSERT_TRUE(MimeTypeCache::instance()->save());
+    MimeTypeCache::instance()->clear();
+    EXPECT_EQ(MimeTypeCache::instance()->count(), 0);
+    MimeTypeCache::instance()->setPersistentFile(cacheFile);
+    EXPECT_EQ(MimeTypeCache::instance()->count(), kFiles);
+    resolveAll();
+    EXPECT_EQ(MimeTypeCache::instance()->count(), kFiles);
+}
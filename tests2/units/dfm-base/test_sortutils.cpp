@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/sortutils.h"
+#include "dfm-base/interfaces/sortfileinfo.h"
+
+#include <QRandomGenerator>
+#include <QStringList>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+static bool keyLessThan(const QString &str1, const QString &str2)
+{
+    return SortUtils::fileNameSortKey(str1) < SortUtils::fileNameSortKey(str2);
+}
+
+TEST(UT_SortUtils, testFileNameSortKey_NaturalNumbers)
+{
+    EXPECT_TRUE(keyLessThan("file2.txt", "file10.txt"));
+    EXPECT_FALSE(keyLessThan("file10.txt", "file2.txt"));
+    EXPECT_TRUE(keyLessThan("file001", "file01"));
+    EXPECT_TRUE(keyLessThan("file01", "file1"));
+}
+
+TEST(UT_SortUtils, testFileNameSortKey_SuffixAndCase)
+{
+    EXPECT_TRUE(keyLessThan("abc", "abc.txt"));
+    EXPECT_FALSE(keyLessThan("abc.", "abc"));
+    EXPECT_FALSE(keyLessThan("abc", "abc."));
+    EXPECT_TRUE(keyLessThan("a", "A"));
+    EXPECT_TRUE(keyLessThan("a.txt", "ab"));
+}
+
+TEST(UT_SortUtils, testFileNameSortKey_MatchesComparator)
+{
+    static const QString kAlphabet = QStringLiteral("aAbBzZ019._- 文件夹测试éÉ（)");
+    QRandomGenerator generator(1);
+
+    QStringList names;
+    for (int i = 0; i < 2000; ++i) {
+        QString name;
+        const int length = 1 + generator.bounded(8);
+        for (int j = 0; j < length; ++j)
+            name.append(kAlphabet.at(generator.bounded(kAlphabet.size())));
+        names.append(name);
+    }
+
+    for (int i = 0; i < 20000; ++i) {
+        const QString &left = names.at(generator.bounded(names.size()));
+        const QString &right = names.at(generator.bounded(names.size()));
+        EXPECT_EQ(SortUtils::compareStringForFileName(left, right), keyLessThan(left, right))
+                << left.toStdString() << " | " << right.toStdString();
+    }
+}
+
+TEST(UT_SortUtils, testSortFileInfo_LazyNameSortKey)
+{
+    SortFileInfo info;
+    info.setUrl(QUrl::fromLocalFile("/tmp/file2.txt"));
+    EXPECT_EQ(info.fileNameSortKey(), SortUtils::fileNameSortKey("file2.txt"));
+
+    // 重新设置 url 后排序键随之更新
+    info.setUrl(QUrl::fromLocalFile("/tmp/file10.txt"));
+    EXPECT_EQ(info.fileNameSortKey(), SortUtils::fileNameSortKey("file10.txt"));
+}
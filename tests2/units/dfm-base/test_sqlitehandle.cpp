@@ -0,0 +1,212 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_sqlitehandle.cpp - SQLite ORM 层的批量查询、预编译语句测试
+
+#include <dfm-base/base/db/sqlitehandle.h>
+
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+
+namespace TestObj {
+
+class User : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("TableName", "User")
+    Q_PROPERTY(int id READ getId WRITE setId)
+    Q_PROPERTY(QString name READ getName WRITE setName)
+    Q_PROPERTY(QString password READ getPassword WRITE setPassword)
+    Q_PROPERTY(QString email READ getEmail WRITE setEmail)
+    Q_PROPERTY(double height READ getHeight WRITE setHeight)
+    Q_PROPERTY(double weight READ getWeight WRITE setWeight)
+
+public:
+    explicit User(QObject *parent = nullptr)
+        : QObject(parent) { }
+
+    int getId() const { return id; }
+    void setId(int value) { id = value; }
+    QString getName() const { return name; }
+    void setName(const QString &value) { name = value; }
+    QString getPassword() const { return password; }
+    void setPassword(const QString &value) { password = value; }
+    QString getEmail() const { return email; }
+    void setEmail(const QString &value) { email = value; }
+    double getHeight() const { return height; }
+    void setHeight(double value) { height = value; }
+    double getWeight() const { return weight; }
+    void setWeight(double value) { weight = value; }
+
+private:
+    int id { 0 };
+    QString name;
+    QString password;
+    QString email;
+    double height { 0 };
+    double weight { 0 };
+};
+
+}   // namespace TestObj
+
+using namespace TestObj;
+
+TEST(UT_SqliteHelper, serializeQuotedString)
+{
+    QString out;
+    EXPECT_TRUE(SerializationHelper::serialize(&out, QString("/home/user/it's.txt")));
+    EXPECT_EQ(out, QString("'/home/user/it''s.txt'"));
+}
+
+TEST(UT_SqliteHelper, inExpression)
+{
+    auto field = Expression::Field<QObject>;
+    const auto &expr = Expression::in(field("filePath"), { QString("/a"), QString("/b'c") });
+    EXPECT_EQ(expr.toString(), QString("filePath IN ('/a','/b''c')"));
+
+    const auto &numExpr = Expression::in(field("id"), { 1, 2 });
+    EXPECT_EQ(numExpr.toString(), QString("id IN (1,2)"));
+}
+
+TEST(UT_SqliteQueryable, wherePrepared)
+{
+    auto field = Expression::Field<User>;
+    SqliteQueryable<User> querable { "dbname", " FROM " + SqliteHelper::tableName<User>() };
+    querable.where(field("name") == QString("it's") && field("height") > 1.5);
+    EXPECT_EQ(querable.sqlWhere, QString(" WHERE (name='it''s' AND height>1.5)"));
+    EXPECT_EQ(querable.preparedWhere, QString(" WHERE (name=? AND height>?)"));
+    EXPECT_EQ(querable.whereValues, (QVariantList { QString("it's"), 1.5 }));
+    EXPECT_EQ(querable.getPreparedFromSql(), QString(" FROM User WHERE (name=? AND height>?)"));
+}
+
+class UT_SqliteHandle : public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        ASSERT_TRUE(tmp.isValid());
+        handle.reset(new SqliteHandle(tmp.filePath("test.db")));
+        ASSERT_TRUE(handle->createTable<User>(SqliteConstraint::primary("id"),
+                                              SqliteConstraint::autoIncreament("id")));
+        handle->excute("CREATE INDEX IF NOT EXISTS idx_user_name ON User(name);");
+        // 批量填充和查询会执行大量语句，关闭逐条的 SQL 日志
+        logDFMBase().setEnabled(QtInfoMsg, false);
+    }
+    virtual void TearDown() override
+    {
+        logDFMBase().setEnabled(QtInfoMsg, true);
+        handle.reset();
+    }
+
+    // 以标记数据库的形式填充：name 为文件路径，每 100 个路径一个目录
+    void seed(int count)
+    {
+        handle->transaction([this, count]() {
+            for (int i = 0; i < count; i += 500) {
+                QStringList values;
+                for (int j = i; j < qMin(i + 500, count); ++j)
+                    values.append(QString("('/home/user/dir_%1/file_%2','','',0,0)").arg(j / 100).arg(j));
+                if (!handle->excute("INSERT INTO User(name,password,email,height,weight) VALUES "
+                                    + values.join(",") + ";"))
+                    return false;
+            }
+            return true;
+        });
+    }
+
+    static QVariantList paths(int count)
+    {
+        QVariantList list;
+        for (int i = 0; i < count; ++i)
+            list.append(QString("/home/user/dir_%1/file_%2").arg(i / 100).arg(i));
+        return list;
+    }
+
+    QTemporaryDir tmp;
+    QScopedPointer<SqliteHandle> handle;
+};
+
+TEST_F(UT_SqliteHandle, inQuery)
+{
+    seed(1000);
+    auto field = Expression::Field<User>;
+    const auto &beans = handle->query<User>().where(Expression::in(field("name"), paths(10))).toBeans();
+    EXPECT_EQ(beans.size(), 10);
+}
+
+TEST_F(UT_SqliteHandle, batchLookup)
+{
+    constexpr int kBatchSize = 500;
+    seed(2000);
+
+    auto field = Expression::Field<User>;
+    const QVariantList &all = paths(1200);
+    int found = 0;
+    for (int i = 0; i < all.size(); i += kBatchSize)
+        found += handle->query<User>().where(Expression::in(field("name"), all.mid(i, kBatchSize))).toBeans().size();
+    EXPECT_EQ(found, all.size());
+}
+
+TEST_F(UT_SqliteHandle, insertBatch)
+{
+    QList<QSharedPointer<User>> users;
+    for (int i = 0; i < 3; ++i) {
+        QSharedPointer<User> user { new User };
+        user->setName(QString("/home/user/it's_%1").arg(i));
+        users.append(user);
+    }
+    EXPECT_TRUE(handle->transaction([&]() { return handle->insertBatch<User>(users); }));
+
+    auto field = Expression::Field<User>;
+    EXPECT_EQ(handle->query<User>().where(field("name") == QString("/home/user/it's_1")).toBeans().size(), 1);
+    EXPECT_TRUE(handle->updateBatch<User>({ { field("email") = QString("a"), field("name") == QString("/home/user/it's_0") },
+                                            { field("email") = QString("b"), field("name") == QString("/home/user/it's_2") } }));
+    EXPECT_EQ(handle->query<User>().where(field("email") == QString("b")).toBean()->getName(), QString("/home/user/it's_2"));
+}
+
+TEST_F(UT_SqliteHandle, nestedPreparedQueries)
+{
+    seed(5);
+
+    // 遍历结果时再次执行同一条语句，外层语句的结果集不能被内层重置
+    const QString sql { "SELECT id FROM User WHERE id>?;" };
+    const QString dbPath { tmp.filePath("test.db") };
+    int outerRows = 0;
+    int innerRows = 0;
+    EXPECT_TRUE(SqliteHelper::excutePrepared(dbPath, sql, { 0 }, nullptr, [&](QSqlQuery *outer) {
+        while (outer->next()) {
+            ++outerRows;
+            SqliteHelper::excutePrepared(dbPath, sql, { outer->value(0) }, nullptr, [&](QSqlQuery *inner) {
+                while (inner->next())
+                    ++innerRows;
+            });
+        }
+    }));
+    EXPECT_EQ(outerRows, 5);
+    EXPECT_EQ(innerRows, 4 + 3 + 2 + 1);
+}
+
+TEST_F(UT_SqliteHandle, writeAheadLogIsOptIn)
+{
+    auto journalMode = [](const QString &dbPath) {
+        QString mode;
+        SqliteHelper::excute(dbPath, "PRAGMA journal_mode;", nullptr, [&mode](QSqlQuery *query) {
+            if (query->next())
+                mode = query->value(0).toString().toLower();
+        });
+        return mode;
+    };
+
+    // 未登记的数据库保持默认日志模式，只有所有者登记的数据库使用 WAL
+    EXPECT_EQ(journalMode(tmp.filePath("test.db")), "delete");
+
+    const QString walPath { tmp.filePath("wal.db") };
+    SqliteConnectionPool::instance().enableWriteAheadLog(walPath);
+    EXPECT_EQ(journalMode(walPath), "wal");
+}
+
+#include "test_sqlitehandle.moc"
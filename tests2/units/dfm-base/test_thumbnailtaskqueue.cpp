@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-base/utils/thumbnail/thumbnailtaskqueue.h"
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+DFMGLOBAL_USE_NAMESPACE
+
+static QUrl taskUrl(const QString &name)
+{
+    return QUrl::fromLocalFile("/tmp/thumbnail/" + name);
+}
+
+TEST(UT_ThumbnailTaskQueue, testTake_NewestFirst)
+{
+    ThumbnailTaskQueue queue;
+    queue.push(taskUrl("1.png"), kLarge);
+    queue.push(taskUrl("2.png"), kLarge);
+    queue.push(taskUrl("3.png"), kLarge);
+    // 重复请求提到队首
+    queue.push(taskUrl("1.png"), kNormal);
+    EXPECT_EQ(queue.size(), 3);
+
+    ThumbnailTaskQueue::Task task;
+    ASSERT_TRUE(queue.take(&task));
+    EXPECT_EQ(task.url, taskUrl("1.png"));
+    EXPECT_EQ(task.size, kNormal);
+    ASSERT_TRUE(queue.take(&task));
+    EXPECT_EQ(task.url, taskUrl("3.png"));
+    ASSERT_TRUE(queue.take(&task));
+    EXPECT_EQ(task.url, taskUrl("2.png"));
+    EXPECT_FALSE(queue.take(&task));
+}
+
+TEST(UT_ThumbnailTaskQueue, testTake_ConcurrencyLimit)
+{
+    ThumbnailTaskQueue queue;
+    queue.setConcurrencyLimit("video/*", 1);
+    queue.push(taskUrl("1.mp4"), kLarge);
+    queue.push(taskUrl("1.png"), kLarge);
+    queue.push(taskUrl("2.mp4"), kLarge);
+
+    ThumbnailTaskQueue::Task video;
+    ASSERT_TRUE(queue.take(&video));
+    EXPECT_EQ(video.url, taskUrl("2.mp4"));
+    EXPECT_EQ(video.group, QString("video/*"));
+
+    // 视频名额已满，其他类型继续出队
+    ThumbnailTaskQueue::Task task;
+    ASSERT_TRUE(queue.take(&task));
+    EXPECT_EQ(task.url, taskUrl("1.png"));
+    EXPECT_FALSE(queue.take(&task));
+
+    queue.finish(video);
+    ASSERT_TRUE(queue.take(&task));
+    EXPECT_EQ(task.url, taskUrl("1.mp4"));
+}
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_copyscheduler.cpp - 按设备并发准入与全局串行拷贝的吞吐对比
+
+#include "fileoperations/fileoperationutils/copyscheduler.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+static bool copyByRange(const QString &from, const QString &to)
+{
+    const int in = ::open(QFile::encodeName(from).constData(), O_RDONLY);
+    const int out = ::open(QFile::encodeName(to).constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    bool ok = in >= 0 && out >= 0;
+    while (ok) {
+        const ssize_t result = copy_file_range(in, nullptr, out, nullptr, 1024 * 1024, 0);
+        ok = result >= 0;
+        if (result <= 0)
+            break;
+    }
+    if (in >= 0)
+        ::close(in);
+    if (out >= 0)
+        ::close(out);
+    return ok;
+}
+
+TEST(BM_CopyScheduler, BigFileThroughput)
+{
+    constexpr int kFiles = 6;
+    constexpr int kFileSize = 32 * 1024 * 1024;
+
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QByteArray block(1024 * 1024, 'x');
+    for (int i = 0; i < kFiles; ++i) {
+        QFile file(tmp.filePath(QString("src_%1").arg(i)));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        for (int j = 0; j < kFileSize / block.size(); ++j)
+            file.write(block);
+    }
+
+    // 预算为 1 时等同原来的全局串行拷贝
+    auto copyAll = [&](int budget) {
+        WorkerData::CopyAdmissionPolicy policy;
+        policy.rotationalBudget = budget;
+        policy.solidStateBudget = budget;
+        policy.sameDeviceWeight = 1;
+
+        std::atomic_int copied { 0 };
+        QThreadPool pool;
+        pool.setMaxThreadCount(8);
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < kFiles; ++i) {
+            const QString &from = tmp.filePath(QString("src_%1").arg(i));
+            const QString &to = tmp.filePath(QString("dst_%1_%2").arg(budget).arg(i));
+            auto ticket = CopyScheduler::instance()->acquire(from, tmp.path(), policy, nullptr);
+            pool.start([from, to, ticket, &copied]() mutable {
+                copied += copyByRange(from, to);
+                ticket.reset();
+            });
+        }
+        pool.waitForDone();
+        EXPECT_EQ(copied.load(), kFiles);
+        return qMax<qint64>(1, timer.elapsed());
+    };
+
+    const qint64 serialCost = copyAll(1);
+    const qint64 scheduledCost = copyAll(4);
+    const double totalMB = double(kFiles) * kFileSize / (1024 * 1024);
+    std::cout << "[ COPY     ] files: " << kFiles << " size(MB): " << totalMB
+              << " serial(MB/s): " << totalMB * 1000 / serialCost
+              << " scheduled(MB/s): " << totalMB * 1000 / scheduledCost << std::endl;
+
+    for (int i = 0; i < kFiles; ++i)
+        EXPECT_EQ(QFileInfo(tmp.filePath(QString("dst_4_%1").arg(i))).size(), kFileSize);
+}
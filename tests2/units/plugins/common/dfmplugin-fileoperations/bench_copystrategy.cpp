@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_copystrategy.cpp - reflink、copy_file_range 与读写三种拷贝方式的速度对比
+
+#include "stubext.h"
+
+#include "fileoperations/fileoperationutils/copystrategy.h"
+#include "fileoperations/fileoperationutils/docopyfileworker.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+static QByteArray makeContent(int size)
+{
+    QByteArray content(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        content[i] = static_cast<char>(i * 31 + i / 4096);
+    return content;
+}
+
+// 通过拷贝线程实际使用的 doCopyFileByRange 拷贝
+static bool copyFile(const QSharedPointer<WorkerData> &workData, const QString &from, const QString &to)
+{
+    DFileInfoPointer fromInfo(new DFileInfo(QUrl::fromLocalFile(from)));
+    DFileInfoPointer toInfo(new DFileInfo(QUrl::fromLocalFile(to)));
+    fromInfo->initQuerier();
+    DoCopyFileWorker worker(workData);
+    return worker.doCopyFileByRange(fromInfo, toInfo, nullptr) == DoCopyFileWorker::NextDo::kDoCopyNext;
+}
+
+TEST(BM_CopyStrategy, CompareStrategies)
+{
+    constexpr int kFileSize = 256 * 1024 * 1024;
+
+    // 通过环境变量指定挂载了 btrfs、xfs、ext4 回环镜像的目录，以冒号分隔
+    QStringList dirs = qEnvironmentVariable("DFM_COPY_BENCHMARK_DIRS").split(':', Qt::SkipEmptyParts);
+    if (dirs.isEmpty())
+        dirs << QString();
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(&DoCopyFileWorker::setTargetPermissions, [] { __DBG_STUB_INVOKE__ });
+
+    const QByteArray block = makeContent(1024 * 1024);
+    for (const QString &dir : dirs) {
+        QTemporaryDir tmp(dir.isEmpty() ? QDir::tempPath() + "/copystrategy-XXXXXX" : dir + "/copystrategy-XXXXXX");
+        ASSERT_TRUE(tmp.isValid());
+        QFile source(tmp.filePath("source"));
+        ASSERT_TRUE(source.open(QIODevice::WriteOnly));
+        for (int i = 0; i < kFileSize / block.size(); ++i)
+            ASSERT_EQ(source.write(block), block.size());
+        source.close();
+
+        CopyStrategy probed;
+        probed.probe(tmp.filePath("source"), tmp.path());
+        std::cout << "[ STRATEGY ] dir: " << tmp.path().toStdString()
+                  << " probed methods: " << int(probed.methods()) << std::endl;
+
+        const QList<QPair<const char *, CopyStrategy::Methods>> strategies {
+            { "reflink", probed.methods() },
+            { "copy_file_range", CopyStrategy::kReadWrite | CopyStrategy::kCopyFileRange },
+            { "read/write", CopyStrategy::kReadWrite },
+        };
+        for (const auto &item : strategies) {
+            QSharedPointer<WorkerData> workData { new WorkerData };
+            workData->copyStrategy.setMethods(item.second);
+            const QString &target = tmp.filePath(QString("target_%1").arg(int(item.second)));
+            QElapsedTimer timer;
+            timer.start();
+            EXPECT_TRUE(copyFile(workData, tmp.filePath("source"), target));
+            const qint64 cost = qMax<qint64>(1, timer.elapsed());
+            EXPECT_EQ(QFileInfo(target).size(), kFileSize);
+            EXPECT_EQ(workData->currentWriteSize.load(), kFileSize);
+            // 克隆被文件系统拒绝时该方式会在本任务内禁用
+            const bool cloned = item.second.testFlag(CopyStrategy::kReflink)
+                    && workData->copyStrategy.methods().testFlag(CopyStrategy::kReflink);
+            std::cout << "[ STRATEGY ] " << item.first << (cloned ? " (cloned)" : "")
+                      << " size(MB): " << kFileSize / (1024 * 1024) << " cost(ms): " << cost
+                      << " speed(MB/s): " << double(kFileSize) / (1024 * 1024) * 1000 / cost << std::endl;
+            QFile::remove(target);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_localdeleteengine.cpp - 宽目录树与深目录树的删除耗时
+
+#include "fileoperations/deletefiles/localdeleteengine.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <iostream>
+
+#include <unistd.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+// 返回创建的文件和目录总数
+static int createWideTree(const QString &root, int dirs, int filesPerDir)
+{
+    int count = 0;
+    for (int i = 0; i < dirs; ++i) {
+        const QString &dir = QString("%1/dir_%2").arg(root).arg(i);
+        QDir().mkpath(dir);
+        ++count;
+        for (int j = 0; j < filesPerDir; ++j, ++count)
+            QFile(QString("%1/file_%2").arg(dir).arg(j)).open(QIODevice::WriteOnly);
+    }
+    return count;
+}
+
+static int createDeepTree(const QString &root, int chains, int depth, int filesPerLevel)
+{
+    int count = 0;
+    for (int i = 0; i < chains; ++i) {
+        QString dir = QString("%1/chain_%2").arg(root).arg(i);
+        for (int level = 0; level < depth; ++level, dir += "/d") {
+            QDir().mkpath(dir);
+            ++count;
+            for (int j = 0; j < filesPerLevel; ++j, ++count)
+                QFile(QString("%1/f%2").arg(dir).arg(j)).open(QIODevice::WriteOnly);
+        }
+    }
+    return count;
+}
+
+TEST(BM_LocalDeleteEngine, RemoveWideAndDeepTrees)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    struct Fixture
+    {
+        const char *name;
+        std::function<int(const QString &)> create;
+    };
+    const QList<Fixture> fixtures {
+        { "wide", [](const QString &root) { return createWideTree(root, 200, 500); } },
+        { "deep", [](const QString &root) { return createDeepTree(root, 20, 200, 5); } },
+    };
+
+    for (const Fixture &fixture : fixtures) {
+        auto measure = [&](const QString &label, const std::function<bool(const QString &)> &remove) {
+            const QString &root = tmp.filePath(QString("%1_%2").arg(fixture.name).arg(label));
+            const int entries = fixture.create(root);
+            ::sync();
+            QElapsedTimer timer;
+            timer.start();
+            EXPECT_TRUE(remove(root));
+            const qint64 cost = timer.elapsed();
+            EXPECT_FALSE(QFileInfo::exists(root));
+            std::cout << "[ DELETE   ] " << fixture.name << " entries: " << entries << " "
+                      << label.toStdString() << "(ms): " << cost << std::endl;
+        };
+
+        measure("removeRecursively", [](const QString &root) { return QDir(root).removeRecursively(); });
+        measure("serial", [](const QString &root) {
+            return LocalDeleteEngine(1).remove(root) == LocalDeleteEngine::SupportAction::kNoAction;
+        });
+        measure("parallel", [](const QString &root) {
+            return LocalDeleteEngine().remove(root) == LocalDeleteEngine::SupportAction::kNoAction;
+        });
+    }
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_progresscounter.cpp - 大量小文件拷贝时进度统计的开销
+// 拷贝线程按 dfmio 的方式逐块回调 DoCopyFileWorker::progressCallback，
+// 同时模拟进度定时器汇总 WorkerData 中的计数；不读写文件，只测量统计路径本身
+
+#include "fileoperations/fileoperationutils/docopyfileworker.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QUrl>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <iostream>
+
+#include <sys/resource.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+namespace {
+struct Usage
+{
+    long voluntarySwitches { 0 };
+    long involuntarySwitches { 0 };
+    double cpuMs { 0 };
+};
+
+Usage processUsage()
+{
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return { usage.ru_nvcsw, usage.ru_nivcsw,
+             (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0
+                     + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0 };
+}
+}   // namespace
+
+TEST(BM_ProgressCounter, CopySmallFilesProgress)
+{
+    constexpr int kFileSize = 4096;
+    constexpr int kChunkSize = 1024;
+    const int files = qEnvironmentVariableIsSet("DFM_PROGRESS_BENCHMARK_FILES")
+            ? qEnvironmentVariableIntValue("DFM_PROGRESS_BENCHMARK_FILES")
+            : 200000;
+    const int threads = qMax(8, QThread::idealThreadCount());
+
+    QSharedPointer<WorkerData> workData { new WorkerData };
+    std::atomic_bool finished { false };
+    std::atomic_int reports { 0 };
+
+    // 进度定时器：与 FileOperateBaseWorker 相同，定时汇总已写入大小和完成数
+    QThread *reporter = QThread::create([&]() {
+        while (!finished) {
+            const qint64 written = workData->currentWriteSize.load();
+            const qint64 completed = workData->completeFileCount.load();
+            Q_UNUSED(written)
+            Q_UNUSED(completed)
+            ++reports;
+            QThread::msleep(10);
+        }
+    });
+    reporter->start();
+
+    const Usage before = processUsage();
+    QElapsedTimer timer;
+    timer.start();
+
+    std::atomic_int next { 0 };
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (int t = 0; t < threads; ++t) {
+        pool.start([&]() {
+            for (int i = next++; i < files; i = next++) {
+                DoCopyFileWorker::ProgressData data;
+                data.data = workData;
+                data.copyFile = QUrl::fromLocalFile(QString("/tmp/progress/%1").arg(i));
+                for (qint64 written = kChunkSize; written <= kFileSize; written += kChunkSize)
+                    DoCopyFileWorker::progressCallback(written, kFileSize, &data);
+                workData->completeFileCount++;
+            }
+        });
+    }
+    pool.waitForDone();
+
+    const qint64 cost = qMax<qint64>(1, timer.elapsed());
+    const Usage after = processUsage();
+    finished = true;
+    reporter->wait();
+    delete reporter;
+
+    EXPECT_EQ(workData->currentWriteSize.load(), qint64(files) * kFileSize);
+    EXPECT_EQ(workData->completeFileCount.load(), files);
+
+    std::cout << "[ PROGRESS ] files: " << files << " size(KB): " << kFileSize / 1024
+              << " threads: " << threads << " reports: " << reports.load() << std::endl;
+    std::cout << "[ PROGRESS ] files/s: " << qint64(files) * 1000 / cost
+              << " cpu(ms): " << after.cpuMs - before.cpuMs
+              << " voluntary switches: " << after.voluntarySwitches - before.voluntarySwitches
+              << " involuntary switches: " << after.involuntarySwitches - before.involuntarySwitches << std::endl;
+}
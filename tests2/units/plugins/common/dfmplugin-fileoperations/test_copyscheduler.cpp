@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fileoperations/fileoperationutils/copyscheduler.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+static dev_t deviceOf(const QString &path)
+{
+    struct stat st;
+    return ::stat(QFile::encodeName(path).constData(), &st) == 0 ? st.st_dev : 0;
+}
+
+static bool copyByRange(const QString &from, const QString &to)
+{
+    const int in = ::open(QFile::encodeName(from).constData(), O_RDONLY);
+    const int out = ::open(QFile::encodeName(to).constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    bool ok = in >= 0 && out >= 0;
+    while (ok) {
+        const ssize_t result = copy_file_range(in, nullptr, out, nullptr, 1024 * 1024, 0);
+        ok = result >= 0;
+        if (result <= 0)
+            break;
+    }
+    if (in >= 0)
+        ::close(in);
+    if (out >= 0)
+        ::close(out);
+    return ok;
+}
+
+TEST(UT_CopyScheduler, SameDeviceBudget)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    QFile(tmp.filePath("a")).open(QIODevice::WriteOnly);
+
+    WorkerData::CopyAdmissionPolicy policy;
+    policy.rotationalBudget = 2;
+    policy.solidStateBudget = 2;
+    policy.sameDeviceWeight = 1;
+
+    const dev_t device = deviceOf(tmp.path());
+    auto scheduler = CopyScheduler::instance();
+    EXPECT_EQ(scheduler->deviceBudget(device, policy), 2);
+
+    auto first = scheduler->acquire(tmp.filePath("a"), tmp.path(), policy, nullptr);
+    auto second = scheduler->acquire(tmp.filePath("a"), tmp.path(), policy, nullptr);
+    ASSERT_TRUE(first && second);
+    EXPECT_TRUE(first->isSameDevice());
+    EXPECT_EQ(scheduler->activeStreams(device), 2);
+
+    // 预算用尽时第三个拷贝阻塞，直到有拷贝结束
+    std::atomic_bool admitted { false };
+    QThreadPool pool;
+    pool.start([&]() {
+        auto third = scheduler->acquire(tmp.filePath("a"), tmp.path(), policy, nullptr);
+        admitted = !third.isNull();
+    });
+    EXPECT_FALSE(pool.waitForDone(200));
+    EXPECT_FALSE(admitted);
+
+    first.reset();
+    EXPECT_TRUE(pool.waitForDone(5000));
+    EXPECT_TRUE(admitted);
+
+    second.reset();
+    EXPECT_EQ(scheduler->activeStreams(device), 0);
+}
+
+TEST(UT_CopyScheduler, StopWakesWaiter)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    QFile(tmp.filePath("a")).open(QIODevice::WriteOnly);
+
+    WorkerData::CopyAdmissionPolicy policy;
+    policy.rotationalBudget = 1;
+    policy.solidStateBudget = 1;
+
+    auto scheduler = CopyScheduler::instance();
+    auto holder = scheduler->acquire(tmp.filePath("a"), tmp.path(), policy, nullptr);
+    ASSERT_TRUE(holder);
+
+    std::atomic_bool stopped { false };
+    std::atomic_bool returned { false };
+    QThreadPool pool;
+    pool.start([&]() {
+        auto ticket = scheduler->acquire(tmp.filePath("a"), tmp.path(), policy, [&]() { return stopped.load(); });
+        returned = ticket.isNull();
+    });
+    EXPECT_FALSE(pool.waitForDone(200));
+
+    stopped = true;
+    scheduler->wakeAll();
+    EXPECT_TRUE(pool.waitForDone(5000));
+    EXPECT_TRUE(returned);
+}
+
+TEST(UT_CopyScheduler, ScheduledCopiesComplete)
+{
+    constexpr int kFiles = 6;
+    constexpr int kFileSize = 1024 * 1024;
+
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QByteArray block(kFileSize, 'x');
+    for (int i = 0; i < kFiles; ++i) {
+        QFile file(tmp.filePath(QString("src_%1").arg(i)));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        ASSERT_EQ(file.write(block), kFileSize);
+    }
+
+    WorkerData::CopyAdmissionPolicy policy;
+    policy.rotationalBudget = 2;
+    policy.solidStateBudget = 2;
+    policy.sameDeviceWeight = 1;
+
+    // 调度线程多于预算时，拷贝依次获得准入并全部完成
+    std::atomic_int copied { 0 };
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    for (int i = 0; i < kFiles; ++i) {
+        const QString &from = tmp.filePath(QString("src_%1").arg(i));
+        const QString &to = tmp.filePath(QString("dst_%1").arg(i));
+        auto ticket = CopyScheduler::instance()->acquire(from, tmp.path(), policy, nullptr);
+        ASSERT_TRUE(ticket);
+        pool.start([from, to, ticket, &copied]() mutable {
+            copied += copyByRange(from, to);
+            ticket.reset();
+        });
+    }
+    pool.waitForDone();
+
+    EXPECT_EQ(copied.load(), kFiles);
+    EXPECT_EQ(CopyScheduler::instance()->activeStreams(deviceOf(tmp.path())), 0);
+    for (int i = 0; i < kFiles; ++i)
+        EXPECT_EQ(QFileInfo(tmp.filePath(QString("dst_%1").arg(i))).size(), kFileSize);
+}
+
+TEST(UT_CopyScheduler, AnonymousDeviceFallback)
+{
+    auto scheduler = CopyScheduler::instance();
+
+    // proc 没有块设备，按机械盘处理
+    bool memoryBacked = false;
+    const dev_t proc = deviceOf("/proc");
+    ASSERT_EQ(major(proc), 0u);
+    EXPECT_EQ(scheduler->resolveBlockDevice(proc, &memoryBacked), dev_t(0));
+    EXPECT_FALSE(memoryBacked);
+    EXPECT_TRUE(scheduler->isRotational(proc));
+
+    // tmpfs 的数据在内存中，按非机械盘处理
+    const dev_t shm = deviceOf("/dev/shm");
+    if (shm != 0 && major(shm) == 0) {
+        EXPECT_EQ(scheduler->resolveBlockDevice(shm, &memoryBacked), dev_t(0));
+        EXPECT_TRUE(memoryBacked);
+        EXPECT_FALSE(scheduler->isRotational(shm));
+    }
+
+    // 已知设备号以外的匿名设备同样按机械盘处理
+    EXPECT_TRUE(scheduler->isRotational(makedev(0, 0xfffff)));
+}
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+
+#include "fileoperations/fileoperationutils/copystrategy.h"
+#include "fileoperations/fileoperationutils/docopyfileworker.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+static QByteArray makeContent(int size)
+{
+    QByteArray content(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i)
+        content[i] = static_cast<char>(i * 31 + i / 4096);
+    return content;
+}
+
+class UT_CopyStrategy : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tmp.isValid());
+        stub.set_lamda(&DoCopyFileWorker::setTargetPermissions, [] { __DBG_STUB_INVOKE__ });
+    }
+    void TearDown() override { stub.clear(); }
+
+    QString createSource(const QByteArray &content)
+    {
+        QFile file(tmp.filePath("source"));
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+        EXPECT_EQ(file.write(content), content.size());
+        return file.fileName();
+    }
+
+    // 通过拷贝线程实际使用的 doCopyFileByRange 拷贝，beforeCopy 在源文件信息读取后执行
+    DoCopyFileWorker::NextDo copy(const QString &from, const QString &to, bool *skip = nullptr,
+                                  const std::function<void()> &beforeCopy = nullptr)
+    {
+        DFileInfoPointer fromInfo(new DFileInfo(QUrl::fromLocalFile(from)));
+        DFileInfoPointer toInfo(new DFileInfo(QUrl::fromLocalFile(to)));
+        fromInfo->initQuerier();
+        if (beforeCopy)
+            beforeCopy();
+        DoCopyFileWorker worker(workData);
+        return worker.doCopyFileByRange(fromInfo, toInfo, skip);
+    }
+
+    static QByteArray readAll(const QString &path)
+    {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    QTemporaryDir tmp;
+    QSharedPointer<WorkerData> workData { new WorkerData };
+    stub_ext::StubExt stub;
+};
+
+TEST_F(UT_CopyStrategy, ProbeAndFallback)
+{
+    const QByteArray &content = makeContent(3 * 1024 * 1024 + 123);
+    const QString &source = createSource(content);
+
+    CopyStrategy strategy;
+    EXPECT_EQ(strategy.methods(), CopyStrategy::kReadWrite | CopyStrategy::kCopyFileRange);
+
+    // 同一目录下源和目标的文件系统相同
+    strategy.probe(source, tmp.path());
+    EXPECT_TRUE(strategy.methods().testFlag(CopyStrategy::kCopyFileRange));
+
+    for (CopyStrategy::Methods methods : { CopyStrategy::Methods(CopyStrategy::kReadWrite),
+                                           CopyStrategy::kReadWrite | CopyStrategy::kCopyFileRange,
+                                           CopyStrategy::kReadWrite | CopyStrategy::kCopyFileRange | CopyStrategy::kReflink }) {
+        workData->copyStrategy.setMethods(methods);
+        workData->currentWriteSize.reset();
+        const QString &target = tmp.filePath(QString("target_%1").arg(int(methods)));
+        ASSERT_EQ(copy(source, target), DoCopyFileWorker::NextDo::kDoCopyNext);
+        EXPECT_EQ(readAll(target), content);
+        EXPECT_EQ(workData->currentWriteSize.load(), content.size());
+    }
+
+    // 读写方式始终保留
+    strategy.setMethods(CopyStrategy::Methods());
+    EXPECT_EQ(strategy.methods(), CopyStrategy::Methods(CopyStrategy::kReadWrite));
+    EXPECT_FALSE(strategy.reflink(-1, -1));
+}
+
+TEST_F(UT_CopyStrategy, WriteBehindAndDropCacheWindows)
+{
+    constexpr off_t kWindow = 16 * 1024 * 1024;
+    const QByteArray &content = makeContent(2 * kWindow + 5 * 1024 * 1024 + 123);
+    const QString &source = createSource(content);
+
+    QList<QPair<off_t, off_t>> writtenBack;
+    QList<QPair<off_t, off_t>> dropped;
+    stub.set_lamda(&CopyStrategy::writeBehind, [&](int, off_t offset, off_t length) {
+        __DBG_STUB_INVOKE__
+        writtenBack.append({ offset, length });
+    });
+    stub.set_lamda(&CopyStrategy::dropCache, [&](int, int, off_t offset, off_t length) {
+        __DBG_STUB_INVOKE__
+        dropped.append({ offset, length });
+    });
+
+    workData->copyStrategy.setMethods(CopyStrategy::kReadWrite | CopyStrategy::kCopyFileRange);
+    ASSERT_EQ(copy(source, tmp.filePath("target")), DoCopyFileWorker::NextDo::kDoCopyNext);
+    EXPECT_EQ(readAll(tmp.filePath("target")), content);
+    EXPECT_EQ(workData->currentWriteSize.load(), content.size());
+
+    // 每满 16MB 回写一次，回写区间首尾相接
+    ASSERT_EQ(writtenBack.size(), 2);
+    EXPECT_EQ(writtenBack.at(0), qMakePair(off_t(0), kWindow));
+    EXPECT_EQ(writtenBack.at(1), qMakePair(kWindow, kWindow));
+
+    // 拷贝过程中只丢弃上一个窗口已回写的数据，结束时丢弃剩余部分，区间首尾相接
+    ASSERT_EQ(dropped.size(), 3);
+    EXPECT_EQ(dropped.at(0), qMakePair(off_t(0), off_t(0)));
+    EXPECT_EQ(dropped.at(1), qMakePair(off_t(0), kWindow));
+    EXPECT_EQ(dropped.at(2), qMakePair(kWindow, off_t(content.size()) - kWindow));
+}
+
+TEST_F(UT_CopyStrategy, ReflinkCountsWholeFile)
+{
+    const QByteArray &content = makeContent(3 * 1024 * 1024);
+    const QString &source = createSource(content);
+
+    int rangeCalls = 0;
+    int cacheCalls = 0;
+    stub.set_lamda(&CopyStrategy::reflink, [] { __DBG_STUB_INVOKE__ return true; });
+    stub.set_lamda(&CopyStrategy::copyRange, [&] { __DBG_STUB_INVOKE__ ++rangeCalls; return ssize_t(0); });
+    stub.set_lamda(&CopyStrategy::dropCache, [&] { __DBG_STUB_INVOKE__ ++cacheCalls; });
+    stub.set_lamda(&CopyStrategy::writeBehind, [&] { __DBG_STUB_INVOKE__ ++cacheCalls; });
+
+    // 克隆成功后整个文件一次计入进度，不再搬运数据
+    EXPECT_EQ(copy(source, tmp.filePath("target")), DoCopyFileWorker::NextDo::kDoCopyNext);
+    EXPECT_EQ(workData->currentWriteSize.load(), content.size());
+    EXPECT_EQ(rangeCalls, 0);
+    EXPECT_EQ(cacheCalls, 0);
+}
+
+TEST_F(UT_CopyStrategy, SourceTruncatedDuringCopy)
+{
+    constexpr int kRemaining = 1024 * 1024;
+    const QString &source = createSource(makeContent(3 * 1024 * 1024));
+
+    QList<AbstractJobHandler::JobErrorType> errors;
+    stub.set_lamda(&DoCopyFileWorker::doHandleErrorAndWait,
+                   [&](DoCopyFileWorker *, const QUrl &, const QUrl &,
+                       const AbstractJobHandler::JobErrorType &error, const bool, const QString &) {
+                       __DBG_STUB_INVOKE__
+                       errors.append(error);
+                       // 第一次重试，之后跳过
+                       return errors.size() == 1 ? AbstractJobHandler::SupportAction::kRetryAction
+                                                 : AbstractJobHandler::SupportAction::kSkipAction;
+                   });
+
+    // 文件信息记录的大小是 3MB，拷贝开始前源文件被截断
+    bool skip = false;
+    const auto nextDo = copy(source, tmp.filePath("target"), &skip, [&]() {
+        ASSERT_TRUE(QFile::resize(source, kRemaining));
+    });
+    EXPECT_EQ(nextDo, DoCopyFileWorker::NextDo::kDoCopyErrorAddCancel);
+    EXPECT_TRUE(skip);
+    EXPECT_EQ(errors, (QList<AbstractJobHandler::JobErrorType> { AbstractJobHandler::JobErrorType::kReadError,
+                                                                 AbstractJobHandler::JobErrorType::kReadError }));
+    EXPECT_EQ(workData->currentWriteSize.load(), kRemaining);
+}
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fileoperations/deletefiles/localdeleteengine.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+// 返回创建的文件和目录总数
+static int createWideTree(const QString &root, int dirs, int filesPerDir)
+{
+    int count = 0;
+    for (int i = 0; i < dirs; ++i) {
+        const QString &dir = QString("%1/dir_%2").arg(root).arg(i);
+        QDir().mkpath(dir);
+        ++count;
+        for (int j = 0; j < filesPerDir; ++j, ++count)
+            QFile(QString("%1/file_%2").arg(dir).arg(j)).open(QIODevice::WriteOnly);
+    }
+    return count;
+}
+
+static int createDeepTree(const QString &root, int chains, int depth, int filesPerLevel)
+{
+    int count = 0;
+    for (int i = 0; i < chains; ++i) {
+        QString dir = QString("%1/chain_%2").arg(root).arg(i);
+        for (int level = 0; level < depth; ++level, dir += "/d") {
+            QDir().mkpath(dir);
+            ++count;
+            for (int j = 0; j < filesPerLevel; ++j, ++count)
+                QFile(QString("%1/f%2").arg(dir).arg(j)).open(QIODevice::WriteOnly);
+        }
+    }
+    return count;
+}
+
+// 逐级相对父目录 fd 创建，总路径长度可以超过 PATH_MAX
+static int createLongPathTree(const QString &root, int depth)
+{
+    const QByteArray name(20, 'n');
+    int fd = ::open(QFile::encodeName(root).constData(), O_RDONLY | O_DIRECTORY);
+    int count = 0;
+    for (int level = 0; level < depth && fd >= 0; ++level) {
+        ::close(::openat(fd, "file", O_CREAT | O_WRONLY, 0644));
+        if (::mkdirat(fd, name.constData(), 0755) != 0)
+            break;
+        count += 2;
+        const int child = ::openat(fd, name.constData(), O_RDONLY | O_DIRECTORY);
+        ::close(fd);
+        fd = child;
+    }
+    if (fd >= 0)
+        ::close(fd);
+    return count;
+}
+
+TEST(UT_LocalDeleteEngine, RemoveTreeWithoutFollowingLinks)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString &root = tmp.filePath("root");
+    const int entries = createWideTree(root, 10, 20) + createDeepTree(root, 2, 50, 2);
+    QDir().mkpath(tmp.filePath("outside"));
+    QFile(tmp.filePath("outside/keep")).open(QIODevice::WriteOnly);
+    ASSERT_TRUE(QFile::link(tmp.filePath("outside"), root + "/link"));
+
+    QAtomicInteger<qint64> deleted { 0 };
+    LocalDeleteEngine engine(4);
+    engine.setDeletedCounter(&deleted);
+    EXPECT_EQ(engine.remove(root), LocalDeleteEngine::SupportAction::kNoAction);
+    EXPECT_FALSE(QFileInfo::exists(root));
+    EXPECT_TRUE(QFileInfo::exists(tmp.filePath("outside/keep")));
+    // 子项、链接和根目录自身
+    EXPECT_EQ(deleted.loadRelaxed(), entries + 2);
+
+    // 已经不存在的路径视为删除成功
+    EXPECT_EQ(engine.remove(root), LocalDeleteEngine::SupportAction::kNoAction);
+
+    QFile(tmp.filePath("single")).open(QIODevice::WriteOnly);
+    EXPECT_EQ(engine.remove(tmp.filePath("single")), LocalDeleteEngine::SupportAction::kNoAction);
+    EXPECT_FALSE(QFileInfo::exists(tmp.filePath("single")));
+}
+
+TEST(UT_LocalDeleteEngine, RemoveLongPathTree)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const int entries = createLongPathTree(tmp.path(), 300);
+    ASSERT_EQ(entries, 600);
+
+    QAtomicInteger<qint64> deleted { 0 };
+    LocalDeleteEngine engine;
+    engine.setDeletedCounter(&deleted);
+    EXPECT_EQ(engine.remove(tmp.filePath(QByteArray(20, 'n'))), LocalDeleteEngine::SupportAction::kNoAction);
+    EXPECT_EQ(deleted.loadRelaxed(), entries - 1);
+    EXPECT_TRUE(QDir(tmp.path()).entryList(QDir::NoDotAndDotDot | QDir::AllEntries | QDir::System) == QStringList { "file" });
+}
+
+TEST(UT_LocalDeleteEngine, StopAndErrors)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    createWideTree(tmp.filePath("root"), 4, 4);
+
+    LocalDeleteEngine engine(2);
+    engine.setStateCheck([]() { return false; });
+    EXPECT_EQ(engine.remove(tmp.filePath("root")), LocalDeleteEngine::SupportAction::kCancelAction);
+    EXPECT_TRUE(QFileInfo::exists(tmp.filePath("root")));
+
+    // 路径中间是普通文件时 lstat 失败
+    QFile(tmp.filePath("file")).open(QIODevice::WriteOnly);
+    int errors = 0;
+    engine.setStateCheck(nullptr);
+    engine.setErrorHandler([&errors](const QUrl &, const QString &) {
+        return ++errors < 3 ? LocalDeleteEngine::SupportAction::kRetryAction : LocalDeleteEngine::SupportAction::kSkipAction;
+    });
+    EXPECT_EQ(engine.remove(tmp.filePath("file/child")), LocalDeleteEngine::SupportAction::kSkipAction);
+    EXPECT_EQ(errors, 3);
+
+    engine.setErrorHandler(nullptr);
+    EXPECT_EQ(engine.remove(tmp.filePath("file/child")), LocalDeleteEngine::SupportAction::kCancelAction);
+    EXPECT_EQ(engine.remove(tmp.filePath("root")), LocalDeleteEngine::SupportAction::kNoAction);
+    EXPECT_FALSE(QFileInfo::exists(tmp.filePath("root")));
+}
+
+TEST(UT_LocalDeleteEngine, CountFoundAndSkippedEntries)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QString &root = tmp.filePath("root");
+    const int entries = createWideTree(root, 5, 10);
+
+    QAtomicInteger<qint64> deleted { 0 };
+    QAtomicInteger<qint64> found { 0 };
+    LocalDeleteEngine engine(2);
+    engine.setDeletedCounter(&deleted);
+    engine.setFoundCounter(&found);
+    EXPECT_EQ(engine.remove(root), LocalDeleteEngine::SupportAction::kNoAction);
+    // 遍历时统计的数量与删除数量一致，不需要预先遍历
+    EXPECT_EQ(found.loadRelaxed(), entries + 1);
+    EXPECT_EQ(deleted.loadRelaxed(), entries + 1);
+
+    if (::geteuid() == 0)
+        GTEST_SKIP() << "root can unlink in read-only directories";
+
+    // 只读目录中的文件无法删除，跳过的文件及其上级目录都不计入删除数量
+    QDir().mkpath(root + "/locked");
+    QFile(root + "/locked/file").open(QIODevice::WriteOnly);
+    QFile(root + "/free").open(QIODevice::WriteOnly);
+    ASSERT_EQ(::chmod(QFile::encodeName(root + "/locked").constData(), 0555), 0);
+
+    deleted.storeRelaxed(0);
+    found.storeRelaxed(0);
+    engine.setErrorHandler([](const QUrl &, const QString &) { return LocalDeleteEngine::SupportAction::kSkipAction; });
+    EXPECT_EQ(engine.remove(root), LocalDeleteEngine::SupportAction::kSkipAction);
+    EXPECT_EQ(found.loadRelaxed(), 4);
+    EXPECT_EQ(deleted.loadRelaxed(), 1);
+
+    ::chmod(QFile::encodeName(root + "/locked").constData(), 0755);
+}
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fileoperations/fileoperationutils/progresscounter.h"
+#include "fileoperations/fileoperationutils/docopyfileworker.h"
+
+#include <QThreadPool>
+#include <QUrl>
+
+#include <gtest/gtest.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+TEST(UT_ProgressCounter, SumAcrossThreads)
+{
+    ProgressCounter counter;
+    QThreadPool pool;
+    pool.setMaxThreadCount(16);
+    for (int i = 0; i < 100; ++i) {
+        pool.start([&counter]() {
+            for (int j = 0; j < 1000; ++j) {
+                counter += 3;
+                counter -= 1;
+                counter++;
+            }
+        });
+    }
+    pool.waitForDone();
+    EXPECT_EQ(counter.load(), 100 * 1000 * 3);
+    EXPECT_TRUE(counter > 0);
+
+    counter.reset();
+    EXPECT_EQ(counter.load(), 0);
+}
+
+TEST(UT_ProgressCounter, ProgressCallbackCountsWrittenDelta)
+{
+    QSharedPointer<WorkerData> workData { new WorkerData };
+    QThreadPool pool;
+    pool.setMaxThreadCount(8);
+    for (int i = 0; i < 100; ++i) {
+        pool.start([workData, i]() {
+            // 与 dfmio 拷贝相同，回调的是当前文件累计写入的大小
+            DoCopyFileWorker::ProgressData data;
+            data.data = workData;
+            data.copyFile = QUrl::fromLocalFile(QString("/tmp/progress/%1").arg(i));
+            for (qint64 written = 1024; written <= 4096; written += 1024)
+                DoCopyFileWorker::progressCallback(written, 4096, &data);
+            EXPECT_EQ(data.writtenSize, 4096);
+            workData->completeFileCount++;
+        });
+    }
+    pool.waitForDone();
+    EXPECT_EQ(workData->currentWriteSize.load(), 100 * 4096);
+    EXPECT_EQ(workData->completeFileCount.load(), 100);
+    EXPECT_EQ(workData->zeroOrlinkOrDirWriteSize.loadRelaxed(), 0);
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_dcustomactionbuilder.cpp - 大量选中项时自定义菜单的匹配耗时
+
+#include "dfm-test-app.h"
+
+#include "extendmenuscene/extendmenu/dcustomactionbuilder.h"
+
+#include <dfm-base/base/schemefactory.h>
+#include <dfm-base/file/local/syncfileinfo.h>
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+using namespace dfmplugin_menu;
+
+static DCustomActionEntry makeEntry(const QString &name, const QStringList &mimeTypes,
+                                    const QStringList &excludeMimeTypes = {},
+                                    const QStringList &suffixes = {},
+                                    const QStringList &schemes = {})
+{
+    // 与解析 .conf 得到的一级菜单项一致
+    DCustomActionEntry entry;
+    entry.packageName = name;
+    entry.actionFileCombo = DCustomActionDefines::kSingleFile | DCustomActionDefines::kMultiFiles;
+    entry.actionMimeTypes = mimeTypes;
+    entry.actionExcludeMimeTypes = excludeMimeTypes;
+    entry.actionSupportSuffix = suffixes;
+    entry.actionSupportSchemes = schemes;
+    return entry;
+}
+
+class BM_DCustomActionBuilder : public testing::Test
+{
+protected:
+    static void SetUpTestSuite() { DFMTest::ensureApplication(); }
+
+    void SetUp() override
+    {
+        UrlRoute::regScheme(Global::Scheme::kFile, "/", QIcon(), false, QObject::tr("System Disk"));
+        InfoFactory::regClass<dfmbase::SyncFileInfo>(Global::Scheme::kFile);
+        ASSERT_TRUE(tmp.isValid());
+    }
+
+    QTemporaryDir tmp;
+};
+
+TEST_F(BM_DCustomActionBuilder, MatchActionsForLargeSelections)
+{
+    // 50 个已安装的菜单配置
+    QList<DCustomActionEntry> entries;
+    const QStringList mimes { "text/plain", "image/*", "application/pdf", "application/zip", "video/*" };
+    for (int i = 0; i < 50; ++i) {
+        entries << makeEntry(QString("action_%1").arg(i),
+                             i % 3 ? QStringList { mimes.at(i % mimes.size()) } : QStringList(),
+                             i % 7 ? QStringList() : QStringList { "application/x-executable" },
+                             i % 11 ? QStringList() : QStringList { "7z.*", "zip" });
+    }
+
+    const QStringList suffixes { "txt", "png", "pdf", "jpg", "md", "tar.gz", "mp4", "conf" };
+    for (int count : { 1000, 10000, 100000 }) {
+        QList<QUrl> selects;
+        selects.reserve(count);
+        for (int i = 0; i < count; ++i)
+            selects << QUrl::fromLocalFile(tmp.filePath(QString("file_%1.%2").arg(i).arg(suffixes.at(i % suffixes.size()))));
+
+        QElapsedTimer timer;
+        timer.start();
+        const auto &matched = DCustomActionBuilder::matchActions(selects, entries);
+        std::cout << "[ MENU     ] selects: " << count << " actions: " << entries.size()
+                  << " matched: " << matched.size() << " cost(ms): " << timer.elapsed() << std::endl;
+    }
+}
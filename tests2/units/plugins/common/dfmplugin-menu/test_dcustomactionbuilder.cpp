@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-test-app.h"
+
+#include "extendmenuscene/extendmenu/dcustomactionbuilder.h"
+
+#include <dfm-base/base/schemefactory.h>
+#include <dfm-base/file/local/syncfileinfo.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+DFMBASE_USE_NAMESPACE
+using namespace dfmplugin_menu;
+
+static DCustomActionEntry makeEntry(const QString &name, const QStringList &mimeTypes,
+                                    const QStringList &excludeMimeTypes = {},
+                                    const QStringList &suffixes = {},
+                                    const QStringList &schemes = {})
+{
+    // 与解析 .conf 得到的一级菜单项一致
+    DCustomActionEntry entry;
+    entry.packageName = name;
+    entry.actionFileCombo = DCustomActionDefines::kSingleFile | DCustomActionDefines::kMultiFiles;
+    entry.actionMimeTypes = mimeTypes;
+    entry.actionExcludeMimeTypes = excludeMimeTypes;
+    entry.actionSupportSuffix = suffixes;
+    entry.actionSupportSchemes = schemes;
+    return entry;
+}
+
+static QStringList packageNames(const QList<DCustomActionEntry> &entries)
+{
+    QStringList names;
+    for (const auto &entry : entries)
+        names << entry.package();
+    return names;
+}
+
+class UT_DCustomActionBuilder : public testing::Test
+{
+protected:
+    static void SetUpTestSuite() { DFMTest::ensureApplication(); }
+
+    void SetUp() override
+    {
+        UrlRoute::regScheme(Global::Scheme::kFile, "/", QIcon(), false, QObject::tr("System Disk"));
+        InfoFactory::regClass<dfmbase::SyncFileInfo>(Global::Scheme::kFile);
+        ASSERT_TRUE(tmp.isValid());
+    }
+
+    QUrl createFile(const QString &name, const QByteArray &content = "text\n")
+    {
+        QFile file(tmp.filePath(name));
+        file.open(QIODevice::WriteOnly);
+        file.write(content);
+        return QUrl::fromLocalFile(tmp.filePath(name));
+    }
+
+    QTemporaryDir tmp;
+};
+
+TEST_F(UT_DCustomActionBuilder, MatchActionsByClass)
+{
+    const QUrl &text = createFile("a.txt");
+    const QUrl &source = createFile("b.c", "int main() { return 0; }\n");
+    const QUrl &archive = createFile("c.7z.001", QByteArray(16, '\0'));
+
+    const QList<DCustomActionEntry> entries {
+        makeEntry("all", {}),
+        makeEntry("text", { "text/plain" }),
+        makeEntry("textWildcard", { "TEXT/*" }),
+        makeEntry("image", { "image/*" }),
+        makeEntry("excludeC", {}, { "text/x-csrc" }),
+        makeEntry("archive", {}, {}, { "7z.*" }),
+        makeEntry("trashOnly", {}, {}, {}, { "trash" }),
+        makeEntry("emptyMime", { "" }),
+    };
+
+    // 父类型参与支持类型的匹配：text/x-csrc 的父类型为 text/plain
+    EXPECT_EQ(packageNames(DCustomActionBuilder::matchActions({ source }, entries)),
+              QStringList({ "all", "text", "textWildcard" }));
+    EXPECT_EQ(packageNames(DCustomActionBuilder::matchActions({ text }, entries)),
+              QStringList({ "all", "text", "textWildcard", "excludeC" }));
+    EXPECT_EQ(packageNames(DCustomActionBuilder::matchActions({ archive }, entries)),
+              QStringList({ "all", "excludeC", "archive" }));
+
+    // 多选时取交集，同类选中项只检查一次
+    EXPECT_EQ(packageNames(DCustomActionBuilder::matchActions({ text, source, text, source }, entries)),
+              QStringList({ "all", "text", "textWildcard" }));
+    EXPECT_EQ(packageNames(DCustomActionBuilder::matchActions({ text, archive }, entries)),
+              QStringList({ "all", "excludeC" }));
+}
+
+TEST_F(UT_DCustomActionBuilder, MatchActionsForLargeSelections)
+{
+    // 50 个已安装的菜单配置
+    QList<DCustomActionEntry> entries;
+    const QStringList mimes { "text/plain", "image/*", "application/pdf", "application/zip", "video/*" };
+    for (int i = 0; i < 50; ++i) {
+        entries << makeEntry(QString("action_%1").arg(i),
+                             i % 3 ? QStringList { mimes.at(i % mimes.size()) } : QStringList(),
+                             i % 7 ? QStringList() : QStringList { "application/x-executable" },
+                             i % 11 ? QStringList() : QStringList { "7z.*", "zip" });
+    }
+
+    // 大量选中项的结果与每类各选一个时一致
+    const QStringList suffixes { "txt", "png", "pdf", "jpg", "md", "tar.gz", "mp4", "conf" };
+    QList<QUrl> selects;
+    QList<QUrl> representatives;
+    for (int i = 0; i < 1000; ++i) {
+        const QUrl &url = QUrl::fromLocalFile(tmp.filePath(QString("file_%1.%2").arg(i).arg(suffixes.at(i % suffixes.size()))));
+        selects << url;
+        if (i < suffixes.size())
+            representatives << url;
+    }
+
+    EXPECT_EQ(packageNames(DCustomActionBuilder::matchActions(selects, entries)),
+              packageNames(DCustomActionBuilder::matchActions(representatives, entries)));
+}
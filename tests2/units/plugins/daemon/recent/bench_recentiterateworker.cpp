@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_recentiterateworker.cpp - 10k 书签的 xbel 文件在逐条更新时的重新加载耗时
+
+#include "dfm-test-app.h"
+#include "stubext.h"
+
+#include "recentiterateworker.h"
+
+#include <dfm-base/utils/fileutils.h>
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QUrl>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+SERVERRECENTMANAGER_USE_NAMESPACE
+DFMBASE_USE_NAMESPACE
+
+namespace {
+
+QByteArray bookmarkLine(const QString &path, int version)
+{
+    const QString &time = QDateTime::fromSecsSinceEpoch(1700000000 + version).toUTC().toString(Qt::ISODate);
+    return QString("  <bookmark href=\"%1\" added=\"%2\" modified=\"%2\" visited=\"%2\">\n"
+                   "    <info>\n"
+                   "      <metadata owner=\"http://freedesktop.org\">\n"
+                   "        <mime:mime-type type=\"text/plain\"/>\n"
+                   "        <bookmark:applications>\n"
+                   "          <bookmark:application name=\"deepin-editor\" exec=\"&apos;deepin-editor %u&apos;\" modified=\"%2\" count=\"%3\"/>\n"
+                   "        </bookmark:applications>\n"
+                   "      </metadata>\n"
+                   "    </info>\n"
+                   "  </bookmark>\n")
+            .arg(QUrl::fromLocalFile(path).toString(QUrl::FullyEncoded), time)
+            .arg(version + 1)
+            .toUtf8();
+}
+
+bool writeXbel(const QString &xbelPath, const QStringList &paths, const QVector<int> &versions)
+{
+    QByteArray content { "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                         "<xbel version=\"1.0\"\n"
+                         "      xmlns:bookmark=\"http://www.freedesktop.org/standards/desktop-bookmarks\"\n"
+                         "      xmlns:mime=\"http://www.freedesktop.org/standards/shared-mime-info\"\n"
+                         ">\n" };
+    for (int i = 0; i < paths.size(); ++i)
+        content += bookmarkLine(paths.at(i), versions.at(i));
+    content += "</xbel>\n";
+
+    // 与 GLib 一样通过临时文件和重命名整体替换
+    const QString &tmpPath = xbelPath + ".tmp";
+    QFile file(tmpPath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size())
+        return false;
+    file.close();
+    QFile::remove(xbelPath);
+    return QFile::rename(tmpPath, xbelPath);
+}
+
+qint64 timedReload(RecentIterateWorker *worker, const QString &xbelPath)
+{
+    // 工作函数只能在非主线程调用
+    QElapsedTimer timer;
+    QThread *thread = QThread::create([worker, xbelPath, &timer] {
+        timer.start();
+        worker->onRequestReload(xbelPath, 0);
+    });
+    thread->start();
+    thread->wait();
+    const qint64 cost = timer.nsecsElapsed();
+    delete thread;
+    return cost;
+}
+
+}   // namespace
+
+TEST(BM_RecentIterateWorker, SingleEntryUpdates)
+{
+    constexpr int kBookmarks = 10000;
+    constexpr int kUpdates = 200;
+
+    DFMTest::ensureApplication();
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    stub_ext::StubExt stub;
+    stub.set_lamda(&FileUtils::bindPathTransform, [](const QString &path, bool) {
+        __DBG_STUB_INVOKE__
+        return path;
+    });
+    QLoggingCategory::setFilterRules("org.deepin.dde.filemanager.*.debug=false\n"
+                                     "org.deepin.dde.filemanager.*.info=false");
+
+    QStringList paths;
+    for (int i = 0; i < kBookmarks; ++i) {
+        paths.append(tmp.filePath(QString("file_%1.txt").arg(i)));
+        QFile file(paths.last());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    }
+    QVector<int> versions(kBookmarks, 0);
+    const QString &xbelPath = tmp.filePath("recently-used.xbel");
+    ASSERT_TRUE(writeXbel(xbelPath, paths, versions));
+
+    RecentIterateWorker worker;
+    const qint64 initialNs = timedReload(&worker, xbelPath);
+    ASSERT_EQ(worker.itemsInfo.size(), kBookmarks);
+
+    int changed = 0;
+    QObject::connect(&worker, &RecentIterateWorker::itemChanged, &worker, [&changed] { ++changed; }, Qt::DirectConnection);
+
+    // 每次只有一个书签变化，与应用打开文件时的更新方式相同
+    qint64 incrementalNs = 0;
+    for (int i = 0; i < kUpdates; ++i) {
+        const int index = (i * 7919) % kBookmarks;
+        ++versions[index];
+        ASSERT_TRUE(writeXbel(xbelPath, paths, versions));
+        incrementalNs += timedReload(&worker, xbelPath);
+    }
+    EXPECT_EQ(changed, kUpdates);
+
+    // 对照：每次都用新的工作对象完整解析
+    qint64 fullNs = 0;
+    for (int i = 0; i < kUpdates / 10; ++i) {
+        RecentIterateWorker fresh;
+        fullNs += timedReload(&fresh, xbelPath);
+    }
+
+    std::cout << "[ RECENT   ] bookmarks: " << kBookmarks
+              << " initial(ms): " << initialNs / 1e6
+              << " incremental avg(ms): " << incrementalNs / 1e6 / kUpdates
+              << " full avg(ms): " << fullNs / 1e6 / (kUpdates / 10) << std::endl;
+
+    stub.clear();
+    QLoggingCategory::setFilterRules(QString());
+}
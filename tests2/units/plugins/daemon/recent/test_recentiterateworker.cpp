@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dfm-test-app.h"
+#include "stubext.h"
+
+#include "recentiterateworker.h"
+
+#include <dfm-base/utils/fileutils.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QUrl>
+
+#include <gtest/gtest.h>
+
+SERVERRECENTMANAGER_USE_NAMESPACE
+DFMBASE_USE_NAMESPACE
+
+class UT_RecentIterateWorker : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        DFMTest::ensureApplication();
+        ASSERT_TRUE(tmp.isValid());
+        xbelPath = tmp.filePath("recently-used.xbel");
+        stub.set_lamda(&FileUtils::bindPathTransform, [](const QString &path, bool) {
+            __DBG_STUB_INVOKE__
+            return path;
+        });
+        QObject::connect(&worker, &RecentIterateWorker::itemsRemoved, &worker, [this](const QStringList &paths) {
+            removedPaths += paths;
+        }, Qt::DirectConnection);
+        QObject::connect(&worker, &RecentIterateWorker::itemChanged, &worker, [this](const QString &path, const RecentItem &) {
+            changedPaths += path;
+        }, Qt::DirectConnection);
+    }
+    void TearDown() override { stub.clear(); }
+
+    QString createFile(const QString &name)
+    {
+        const QString &path = tmp.filePath(name);
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        return path;
+    }
+
+    void writeXbel(const QMap<QString, QString> &modifiedByPath)
+    {
+        QByteArray content { "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<xbel version=\"1.0\">\n" };
+        for (auto it = modifiedByPath.begin(); it != modifiedByPath.end(); ++it)
+            content += QString("  <bookmark href=\"%1\" added=\"%2\" modified=\"%2\" visited=\"%2\"/>\n")
+                               .arg(QUrl::fromLocalFile(it.key()).toString(QUrl::FullyEncoded), it.value())
+                               .toUtf8();
+        content += "</xbel>\n";
+
+        QFile file(xbelPath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    }
+
+    // 工作函数只能在非主线程调用
+    void reload(qint64 timestamp = 0)
+    {
+        QThread *thread = QThread::create([this, timestamp] { worker.onRequestReload(xbelPath, timestamp); });
+        thread->start();
+        thread->wait();
+        delete thread;
+    }
+
+    QTemporaryDir tmp;
+    QString xbelPath;
+    stub_ext::StubExt stub;
+    RecentIterateWorker worker;
+    QStringList removedPaths;
+    QStringList changedPaths;
+};
+
+TEST_F(UT_RecentIterateWorker, ChangedBookmarkIsReparsed)
+{
+    const QString &a = createFile("a.txt");
+    const QString &b = createFile("b.txt");
+    writeXbel({ { a, "2024-01-01T00:00:00Z" }, { b, "2024-01-01T00:00:00Z" } });
+    reload();
+    EXPECT_EQ(worker.itemsInfo.size(), 2);
+
+    // 改变文件长度，避免时间戳精度不足时被当作未变化
+    writeXbel({ { a, "2024-01-01T00:00:00Z" }, { b, "2024-06-01T12:00:00+08:00" } });
+    reload();
+    EXPECT_EQ(changedPaths, QStringList { b });
+    EXPECT_TRUE(removedPaths.isEmpty());
+}
+
+TEST_F(UT_RecentIterateWorker, DeletedFileDroppedOnWatcherReload)
+{
+    // 超过原先每次抽查的数量，所有缓存的条目都要重新检查
+    QMap<QString, QString> bookmarks;
+    for (int i = 0; i < 600; ++i)
+        bookmarks.insert(createFile(QString("file_%1.txt").arg(i)), "2024-01-01T00:00:00Z");
+    writeXbel(bookmarks);
+    reload();
+    ASSERT_EQ(worker.itemsInfo.size(), 600);
+
+    QStringList deleted = bookmarks.keys().mid(0, 3);
+    for (const QString &path : qAsConst(deleted))
+        ASSERT_TRUE(QFile::remove(path));
+
+    // xbel 未变化时同样检查文件是否存在
+    reload();
+    removedPaths.sort();
+    deleted.sort();
+    EXPECT_EQ(removedPaths, deleted);
+    EXPECT_EQ(worker.itemsInfo.size(), 597);
+}
+
+TEST_F(UT_RecentIterateWorker, RemovedBookmarkIsDropped)
+{
+    const QString &a = createFile("a.txt");
+    const QString &b = createFile("b.txt");
+    writeXbel({ { a, "2024-01-01T00:00:00Z" }, { b, "2024-01-01T00:00:00Z" } });
+    reload();
+
+    writeXbel({ { a, "2024-01-01T00:00:00Z" } });
+    reload(1);
+    EXPECT_EQ(removedPaths, QStringList { b });
+    EXPECT_EQ(worker.itemsInfo.keys(), QStringList { a });
+}
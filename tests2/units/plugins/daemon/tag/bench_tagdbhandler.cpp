@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_tagdbhandler.cpp - 标记守护进程按文件批量查询标记的耗时
+
+#include "tagdbhandler.h"
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DAEMONPTAG_USE_NAMESPACE
+
+TEST(BM_TagDbHandler, BatchLookupTiming)
+{
+    constexpr int kSeedCount = 100000;
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    const QByteArray oldHome = qgetenv("HOME");
+    qputenv("HOME", tmp.path().toLocal8Bit());
+    // 基准测试会执行大量语句，关闭 dfm-base 与插件逐条的日志
+    QLoggingCategory::setFilterRules("org.deepin.dde.filemanager.*.debug=false\n"
+                                     "org.deepin.dde.filemanager.*.info=false");
+
+    QScopedPointer<TagDbHandler> handler { new TagDbHandler };
+    QStringList paths;
+    QVariantMap data;
+    for (int i = 0; i < kSeedCount; ++i) {
+        paths.append(QString("/home/user/dir_%1/file_%2").arg(i / 100).arg(i));
+        data.insert(paths.last(), QStringList { "red", "blue" });
+    }
+    ASSERT_TRUE(handler->addTagsForFiles(data));
+
+    for (int count : { 1000, 10000, 100000 }) {
+        const QStringList &urls = paths.mid(0, count);
+        QElapsedTimer timer;
+        timer.start();
+        EXPECT_EQ(handler->getTagsByUrls(urls).size(), count);
+        const qint64 batchMs = timer.elapsed();
+
+        // 逐个文件查询只测 1k，更大规模下耗时过长
+        qint64 singleMs = -1;
+        if (count == 1000) {
+            timer.restart();
+            for (const QString &url : urls)
+                handler->getTagsByUrls({ url });
+            singleMs = timer.elapsed();
+        }
+
+        std::cout << "[ LOOKUP   ] files: " << count
+                  << " batched(ms): " << batchMs
+                  << " per-file(ms): " << singleMs << std::endl;
+    }
+
+    handler.reset();
+    QLoggingCategory::setFilterRules(QString());
+    qputenv("HOME", oldHome);
+}
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "tagdbhandler.h"
+
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+DAEMONPTAG_USE_NAMESPACE
+
+class UT_TagDbHandler : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // 数据库位于 ~/.config 下，每个用例使用独立的 HOME
+        ASSERT_TRUE(tmp.isValid());
+        oldHome = qgetenv("HOME");
+        qputenv("HOME", tmp.path().toLocal8Bit());
+        handler = new TagDbHandler;
+    }
+    void TearDown() override
+    {
+        delete handler;
+        handler = nullptr;
+        qputenv("HOME", oldHome);
+    }
+
+    QStringList tagsOf(const QString &path)
+    {
+        return handler->getTagsByUrls({ path }).value(path).toStringList();
+    }
+
+    QTemporaryDir tmp;
+    QByteArray oldHome;
+    TagDbHandler *handler { nullptr };
+};
+
+TEST_F(UT_TagDbHandler, RenameDirectoryMovesNestedTags)
+{
+    ASSERT_TRUE(handler->addTagsForFiles({ { "/a/b", QStringList { "red" } },
+                                           { "/a/b/x", QStringList { "red", "blue" } },
+                                           { "/a/b/c/y", QStringList { "green" } },
+                                           { "/a/bc", QStringList { "red" } },
+                                           { "/a/bc/z", QStringList { "blue" } },
+                                           { "/a/b0", QStringList { "green" } } }));
+
+    ASSERT_TRUE(handler->changeFilePaths({ { "/a/b", "/a/renamed" } }));
+
+    // 目录本身及各级子路径的前缀都被替换，标记保持原有顺序
+    EXPECT_EQ(tagsOf("/a/renamed"), QStringList { "red" });
+    EXPECT_EQ(tagsOf("/a/renamed/x"), (QStringList { "red", "blue" }));
+    EXPECT_EQ(tagsOf("/a/renamed/c/y"), QStringList { "green" });
+    EXPECT_TRUE(handler->getTagsByUrls({ "/a/b", "/a/b/x", "/a/b/c/y" }).isEmpty());
+
+    // 共享前缀的兄弟路径不受影响
+    EXPECT_EQ(tagsOf("/a/bc"), QStringList { "red" });
+    EXPECT_EQ(tagsOf("/a/bc/z"), QStringList { "blue" });
+    EXPECT_EQ(tagsOf("/a/b0"), QStringList { "green" });
+}
+
+TEST_F(UT_TagDbHandler, RenameWithTrailingSlash)
+{
+    ASSERT_TRUE(handler->addTagsForFiles({ { "/a/b/x", QStringList { "red" } },
+                                           { "/a/bc", QStringList { "blue" } } }));
+
+    ASSERT_TRUE(handler->changeFilePaths({ { "/a/b/", "/a/z" } }));
+    EXPECT_EQ(tagsOf("/a/z/x"), QStringList { "red" });
+    EXPECT_EQ(tagsOf("/a/bc"), QStringList { "blue" });
+}
+
+TEST_F(UT_TagDbHandler, RenameFromAndToRoot)
+{
+    ASSERT_TRUE(handler->addTagsForFiles({ { "/x", QStringList { "red" } },
+                                           { "/x/y", QStringList { "blue" } } }));
+
+    // 根目录的子路径不能拼成 "//x"
+    ASSERT_TRUE(handler->changeFilePaths({ { "/", "/mnt" } }));
+    EXPECT_EQ(tagsOf("/mnt/x"), QStringList { "red" });
+    EXPECT_EQ(tagsOf("/mnt/x/y"), QStringList { "blue" });
+
+    ASSERT_TRUE(handler->changeFilePaths({ { "/mnt", "/" } }));
+    EXPECT_EQ(tagsOf("/x"), QStringList { "red" });
+    EXPECT_EQ(tagsOf("/x/y"), QStringList { "blue" });
+}
+
+TEST_F(UT_TagDbHandler, PathsWithQuotes)
+{
+    const QString dir { "/home/it's \"dir\"" };
+    const QString renamed { "/home/O'Neil's %_files" };
+    ASSERT_TRUE(handler->addTagsForFiles({ { dir, QStringList { "red" } },
+                                           { dir + "/it's.txt", QStringList { "blue" } },
+                                           { "/home/it's \"dir\"s", QStringList { "green" } } }));
+    EXPECT_EQ(tagsOf(dir + "/it's.txt"), QStringList { "blue" });
+    EXPECT_EQ(handler->getFilesByTag({ "blue" }).value("blue").toStringList(), QStringList { dir + "/it's.txt" });
+
+    ASSERT_TRUE(handler->changeFilePaths({ { dir, renamed } }));
+    EXPECT_EQ(tagsOf(renamed), QStringList { "red" });
+    EXPECT_EQ(tagsOf(renamed + "/it's.txt"), QStringList { "blue" });
+    EXPECT_EQ(tagsOf("/home/it's \"dir\"s"), QStringList { "green" });
+
+    ASSERT_TRUE(handler->deleteFiles({ renamed + "/it's.txt" }));
+    EXPECT_TRUE(tagsOf(renamed + "/it's.txt").isEmpty());
+    EXPECT_EQ(tagsOf(renamed), QStringList { "red" });
+}
+
+TEST_F(UT_TagDbHandler, BatchedQueriesAcrossBatchSize)
+{
+    // 超过单批 500 个参数，查询和删除需要拆分为多条语句
+    constexpr int kCount = 1203;
+    QVariantMap data;
+    QStringList paths;
+    for (int i = 0; i < kCount; ++i) {
+        const QString &path = QString("/home/user/dir_%1/file_%2").arg(i / 100).arg(i);
+        paths.append(path);
+        data.insert(path, i % 2 ? QStringList { "odd", "all" } : QStringList { "even", "all" });
+    }
+    ASSERT_TRUE(handler->addTagsForFiles(data));
+
+    QStringList query { paths };
+    query.append("/home/user/untagged");
+    const QVariantMap &fileTags = handler->getTagsByUrls(query);
+    ASSERT_EQ(fileTags.size(), kCount);
+    EXPECT_EQ(fileTags.value(paths.at(0)).toStringList(), (QStringList { "even", "all" }));
+    EXPECT_EQ(fileTags.value(paths.at(kCount - 2)).toStringList(), (QStringList { "odd", "all" }));
+    EXPECT_FALSE(fileTags.contains("/home/user/untagged"));
+
+    const QVariantMap &tagFiles = handler->getFilesByTag({ "all", "odd", "even", "unused" });
+    EXPECT_EQ(tagFiles.value("all").toStringList().size(), kCount);
+    EXPECT_EQ(tagFiles.value("odd").toStringList().size(), kCount / 2);
+    EXPECT_EQ(tagFiles.value("even").toStringList().size(), kCount - kCount / 2);
+    // 没有文件的标记返回空列表
+    ASSERT_TRUE(tagFiles.contains("unused"));
+    EXPECT_TRUE(tagFiles.value("unused").toStringList().isEmpty());
+
+    // 删除前 1100 个，跨越两个批次边界
+    ASSERT_TRUE(handler->deleteFiles(paths.mid(0, 1100)));
+    const QVariantMap &remaining = handler->getTagsByUrls(paths);
+    EXPECT_EQ(remaining.size(), kCount - 1100);
+    EXPECT_FALSE(remaining.contains(paths.at(1099)));
+    EXPECT_TRUE(remaining.contains(paths.at(1100)));
+    QStringList allFiles { handler->getFilesByTag({ "all" }).value("all").toStringList() };
+    QStringList expected { paths.mid(1100) };
+    allFiles.sort();
+    expected.sort();
+    EXPECT_EQ(allFiles, expected);
+}
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_localiterationengine.cpp - 大目录树的首个结果延迟与总耗时
+
+#include "searchmanager/searcher/iterator/localiterationengine.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+// 生成 dirCount 个目录，每个目录 fileCount 个文件，每 10 个目录嵌套一层
+void createTree(const QString &root, int dirCount, int fileCount)
+{
+    QString parent = root;
+    for (int i = 0; i < dirCount; ++i) {
+        if (i % 10 == 0 && i > 0)
+            parent = root + QString("/level_%1").arg(i);
+        const QString dirPath = parent + QString("/dir_%1").arg(i);
+        QDir().mkpath(dirPath);
+        for (int j = 0; j < fileCount; ++j) {
+            QFile file(dirPath + QString("/file_%1_%2.txt").arg(i).arg(j));
+            file.open(QIODevice::WriteOnly);
+        }
+    }
+    QFile hidden(root + "/.hidden_key.txt");
+    hidden.open(QIODevice::WriteOnly);
+}
+}   // namespace
+
+class BM_LocalIterationEngine : public testing::Test
+{
+protected:
+    void runSearch(LocalIterationEngine &engine, const QString &root, const QString &key)
+    {
+        engine.setMatchFunction([key](const QString &fileName, const QString &) {
+            return fileName.contains(key);
+        });
+        QObject::connect(&engine, &LocalIterationEngine::matched, &engine, [this](const QList<QUrl> &urls) {
+            QMutexLocker lk(&mutex);
+            if (firstResultMs < 0)
+                firstResultMs = timer.elapsed();
+            results.append(urls);
+        }, Qt::DirectConnection);
+
+        timer.start();
+        ASSERT_TRUE(engine.start(root));
+        while (engine.isRunning())
+            QThread::msleep(5);
+        totalMs = timer.elapsed();
+    }
+
+    QMutex mutex;
+    QList<QUrl> results;
+    QElapsedTimer timer;
+    qint64 firstResultMs { -1 };
+    qint64 totalMs { -1 };
+};
+
+TEST_F(BM_LocalIterationEngine, LargeTreeTiming)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    createTree(tmp.path(), 200, 100);
+
+    LocalIterationEngine engine;
+    runSearch(engine, tmp.path(), "file_1");
+
+    std::cout << "[ TIMING   ] entries: " << 200 * 101
+              << " first result(ms): " << firstResultMs
+              << " total(ms): " << totalMs << std::endl;
+    EXPECT_GT(results.size(), 0);
+    EXPECT_GE(firstResultMs, 0);
+}
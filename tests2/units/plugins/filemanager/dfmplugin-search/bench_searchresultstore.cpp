@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_searchresultstore.cpp - 大结果集的增量合并与消费耗时
+
+#include "searchmanager/searcher/searchresultstore.h"
+
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DPSEARCH_USE_NAMESPACE
+
+static DFMSearchResult makeResult(const QString &path, double score, const QString &content = QString())
+{
+    DFMSearchResult result(QUrl::fromLocalFile(path), content);
+    result.setMatchScore(score);
+    return result;
+}
+
+TEST(BM_SearchResultStore, StreamLargeResultSet)
+{
+    constexpr int kTotal = 500000;
+    constexpr int kBatchSize = 200;
+
+    SearchResultStore store;
+    quint64 consumed = 0;
+    int delivered = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kTotal; i += kBatchSize) {
+        DFMSearchResultMap batch;
+        for (int j = i; j < i + kBatchSize; ++j) {
+            const QString &path = QString("/tmp/search/file_%1").arg(j);
+            batch.insert(QUrl::fromLocalFile(path), makeResult(path, 1.0));
+        }
+        store.merge(batch);
+        delivered += store.resultsSince(consumed, &consumed).size();
+    }
+
+    std::cout << "[ STREAM   ] results: " << kTotal
+              << " merge+consume(ms): " << timer.elapsed() << std::endl;
+    EXPECT_EQ(delivered, kTotal);
+    EXPECT_EQ(store.count(), kTotal);
+}
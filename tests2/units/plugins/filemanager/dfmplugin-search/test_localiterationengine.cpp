@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchmanager/searcher/iterator/localiterationengine.h"
+
+#include <QDir>
+#include <QFile>
+#include <QMutex>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <gtest/gtest.h>
+
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+// 生成 dirCount 个目录，每个目录 fileCount 个文件，每 10 个目录嵌套一层
+void createTree(const QString &root, int dirCount, int fileCount)
+{
+    QString parent = root;
+    for (int i = 0; i < dirCount; ++i) {
+        if (i % 10 == 0 && i > 0)
+            parent = root + QString("/level_%1").arg(i);
+        const QString dirPath = parent + QString("/dir_%1").arg(i);
+        QDir().mkpath(dirPath);
+        for (int j = 0; j < fileCount; ++j) {
+            QFile file(dirPath + QString("/file_%1_%2.txt").arg(i).arg(j));
+            file.open(QIODevice::WriteOnly);
+        }
+    }
+    // 隐藏文件和隐藏目录下的文件同样能匹配关键字，只因为隐藏而不应出现在结果中
+    QFile hidden(root + "/.hidden_7.txt");
+    hidden.open(QIODevice::WriteOnly);
+    QDir().mkpath(root + "/.hidden_dir");
+    QFile hiddenChild(root + "/.hidden_dir/visible_7.txt");
+    hiddenChild.open(QIODevice::WriteOnly);
+}
+}   // namespace
+
+class UT_LocalIterationEngine : public testing::Test
+{
+protected:
+    void runSearch(LocalIterationEngine &engine, const QString &root, const QString &key)
+    {
+        engine.setMatchFunction([key](const QString &fileName, const QString &) {
+            return fileName.contains(key);
+        });
+        QObject::connect(&engine, &LocalIterationEngine::matched, &engine, [this](const QList<QUrl> &urls) {
+            QMutexLocker lk(&mutex);
+            results.append(urls);
+        }, Qt::DirectConnection);
+
+        ASSERT_TRUE(engine.start(root));
+        while (engine.isRunning())
+            QThread::msleep(5);
+    }
+
+    QMutex mutex;
+    QList<QUrl> results;
+};
+
+TEST_F(UT_LocalIterationEngine, FindsAllMatches)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    createTree(tmp.path(), 30, 10);
+
+    LocalIterationEngine engine;
+    engine.setThreadCount(4);
+    runSearch(engine, tmp.path(), "_7.txt");
+
+    // 每个目录中 file_x_7.txt 命中一次，隐藏文件和隐藏目录不参与搜索
+    EXPECT_EQ(results.size(), 30);
+    EXPECT_FALSE(results.contains(QUrl::fromLocalFile(tmp.path() + "/.hidden_7.txt")));
+    EXPECT_FALSE(results.contains(QUrl::fromLocalFile(tmp.path() + "/.hidden_dir/visible_7.txt")));
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchmanager/searcher/searchresultstore.h"
+
+#include <gtest/gtest.h>
+
+DPSEARCH_USE_NAMESPACE
+
+static DFMSearchResult makeResult(const QString &path, double score, const QString &content = QString())
+{
+    DFMSearchResult result(QUrl::fromLocalFile(path), content);
+    result.setMatchScore(score);
+    return result;
+}
+
+TEST(UT_SearchResultStore, ResultsSince)
+{
+    SearchResultStore store;
+    DFMSearchResultMap batch;
+    batch.insert(QUrl::fromLocalFile("/a"), makeResult("/a", 1.0));
+    batch.insert(QUrl::fromLocalFile("/b"), makeResult("/b", 1.0));
+    EXPECT_EQ(store.merge(batch), 2u);
+
+    quint64 latest = 0;
+    EXPECT_EQ(store.resultsSince(0, &latest).size(), 2);
+    EXPECT_EQ(latest, 2u);
+    EXPECT_TRUE(store.resultsSince(latest).isEmpty());
+
+    // 分数更低的重复结果被忽略，更高的作为更新重新出现在增量中
+    batch.clear();
+    batch.insert(QUrl::fromLocalFile("/a"), makeResult("/a", 0.5));
+    batch.insert(QUrl::fromLocalFile("/b"), makeResult("/b", 2.0, "content"));
+    batch.insert(QUrl::fromLocalFile("/c"), makeResult("/c", 1.0));
+    store.merge(batch);
+
+    const auto &delta = store.resultsSince(latest, &latest);
+    ASSERT_EQ(delta.size(), 2);
+    EXPECT_EQ(delta.at(0).url(), QUrl::fromLocalFile("/b"));
+    EXPECT_EQ(delta.at(0).highlightedContent(), QString("content"));
+    EXPECT_EQ(delta.at(1).url(), QUrl::fromLocalFile("/c"));
+
+    // 全量获取时被取代的旧记录不再出现
+    EXPECT_EQ(store.resultsSince(0).size(), 3);
+    EXPECT_EQ(store.count(), 3);
+    EXPECT_DOUBLE_EQ(store.results().value(QUrl::fromLocalFile("/b")).matchScore(), 2.0);
+}
+
+TEST(UT_SearchResultStore, StreamLargeResultSet)
+{
+    constexpr int kTotal = 20000;
+    constexpr int kBatchSize = 200;
+
+    SearchResultStore store;
+    quint64 consumed = 0;
+    int delivered = 0;
+
+    for (int i = 0; i < kTotal; i += kBatchSize) {
+        DFMSearchResultMap batch;
+        for (int j = i; j < i + kBatchSize; ++j) {
+            const QString &path = QString("/tmp/search/file_%1").arg(j);
+            batch.insert(QUrl::fromLocalFile(path), makeResult(path, 1.0));
+        }
+        store.merge(batch);
+        delivered += store.resultsSince(consumed, &consumed).size();
+    }
+
+    EXPECT_EQ(delivered, kTotal);
+    EXPECT_EQ(store.count(), kTotal);
+}
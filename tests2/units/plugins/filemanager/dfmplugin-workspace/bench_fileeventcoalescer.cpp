@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_fileeventcoalescer.cpp - 突发文件事件的合并延迟与CPU占用
+
+#include "utils/fileeventcoalescer.h"
+
+#include <gtest/gtest.h>
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <ctime>
+#include <iostream>
+
+DPWORKSPACE_USE_NAMESPACE
+
+static QUrl testUrl(int index)
+{
+    return QUrl::fromLocalFile(QString("/tmp/coalescer/file_%1").arg(index));
+}
+
+TEST(BM_FileEventCoalescer, BurstStress)
+{
+    constexpr int kFileCount = 50000;
+    FileEventCoalescer coalescer;
+
+    // 10 万个事件：每个文件先创建再更新，模拟解压大量文件到当前目录
+    const std::clock_t cpuStart = std::clock();
+    QElapsedTimer latency;
+    latency.start();
+    QThread *producer = QThread::create([&coalescer]() {
+        for (int i = 0; i < kFileCount; ++i) {
+            coalescer.enqueue(testUrl(i), FileEventCoalescer::kAddFile);
+            coalescer.enqueue(testUrl(i), FileEventCoalescer::kUpdateFile);
+        }
+    });
+    producer->start();
+
+    qint64 firstBatchMs = -1;
+    int adds = 0;
+    int updates = 0;
+    forever {
+        const auto &batch = coalescer.takeBatch(2000, 200, 500);
+        if (batch.isEmpty())
+            break;
+        if (firstBatchMs < 0)
+            firstBatchMs = latency.elapsed();
+        adds += batch.adds.size();
+        updates += batch.updates.size();
+    }
+    producer->wait();
+    delete producer;
+
+    const double cpuMs = 1000.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    std::cout << "[ BURST    ] events: " << kFileCount * 2
+              << " first batch(ms): " << firstBatchMs
+              << " total(ms): " << latency.elapsed()
+              << " cpu(ms): " << cpuMs << std::endl;
+
+    EXPECT_EQ(adds, kFileCount);
+    EXPECT_EQ(updates, 0);
+    EXPECT_GE(firstBatchMs, 0);
+}
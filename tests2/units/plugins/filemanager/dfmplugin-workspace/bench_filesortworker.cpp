@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_filesortworker.cpp - 大目录首批排序结果的耗时：逐个插入排序与线程池分块排序加归并
+// 排序结果即首批显示的数据，两种方式的结果必须完全一致
+
+#include "utils/filesortworker.h"
+#include "models/fileitemdata.h"
+
+#include "dfm-test-app.h"
+#include "stubext.h"
+
+#include <dfm-base/interfaces/sortfileinfo.h>
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+DPWORKSPACE_USE_NAMESPACE
+
+namespace {
+
+// 模拟相机导出和编译输出目录：大量同前缀文件，少量子目录
+QList<QUrl> fillChildren(FileSortWorker &worker, const QUrl &dir, int count)
+{
+    static const QStringList kStems { "IMG_", "DSC", "main.o.", "mail-", "Screenshot_" };
+    QRandomGenerator generator(42);
+
+    QList<QUrl> urls;
+    urls.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const QString &name = kStems.at(generator.bounded(kStems.size())) + QString::number(generator.bounded(count * 2));
+        const QUrl &url = QUrl::fromLocalFile(QString("%1/%2_%3").arg(dir.path(), name).arg(i));
+
+        SortInfoPointer info(new SortFileInfo);
+        info->setUrl(url);
+        info->setDir(i % 50 == 0);
+        info->setFile(i % 50 != 0);
+        info->setSize(generator.bounded(1 << 20));
+        info->markAsCompleted();
+        worker.childrenDataMap.insert(url, FileItemDataPointer(new FileItemData(info)));
+        urls.append(url);
+    }
+    return urls;
+}
+
+}   // namespace
+
+TEST(BM_FileSortWorker, ParallelSortLargeDirectory)
+{
+    DFMTest::ensureApplication();
+    stub_ext::StubExt stub;
+    stub.set_lamda(&Application::appAttribute, [] { __DBG_STUB_INVOKE__ return QVariant(false); });
+
+    const QUrl &dir = QUrl::fromLocalFile("/bench/large");
+    const QList<QPair<Global::ItemRoles, const char *>> roles {
+        { Global::ItemRoles::kItemFileDisplayNameRole, "name" },
+        { Global::ItemRoles::kItemFileSizeRole, "size" }
+    };
+
+    for (int count : { 50000, 200000 }) {
+        for (const auto &role : roles) {
+            for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder }) {
+                QList<QUrl> results[2];
+                qint64 costs[2] = { 0, 0 };
+                for (int parallel : { 0, 1 }) {
+                    FileSortWorker worker(dir, "bench");
+                    worker.orgSortRole = role.first;
+                    worker.sortOrder = order;
+                    worker.parallelSortThreshold = parallel;   // 0 关闭并行排序，1 总是并行
+                    const QList<QUrl> &urls = fillChildren(worker, dir, count);
+
+                    QElapsedTimer timer;
+                    timer.start();
+                    results[parallel] = worker.sortTreeFiles(urls);
+                    costs[parallel] = timer.elapsed();
+                }
+
+                EXPECT_EQ(results[0].size(), count);
+                EXPECT_EQ(results[0], results[1]);
+                std::cout << "[ SORT     ] files: " << count
+                          << " role: " << role.second
+                          << " order: " << (order == Qt::AscendingOrder ? "asc" : "desc")
+                          << " serial(ms): " << costs[0]
+                          << " parallel(ms): " << costs[1]
+                          << " threads: " << QThreadPool::globalInstance()->maxThreadCount() << std::endl;
+            }
+        }
+    }
+}
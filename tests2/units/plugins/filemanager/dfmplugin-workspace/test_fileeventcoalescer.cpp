@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/fileeventcoalescer.h"
+
+#include <gtest/gtest.h>
+
+#include <QElapsedTimer>
+#include <QThread>
+
+DPWORKSPACE_USE_NAMESPACE
+
+static QUrl testUrl(int index)
+{
+    return QUrl::fromLocalFile(QString("/tmp/coalescer/file_%1").arg(index));
+}
+
+TEST(UT_FileEventCoalescer, LastStateWins)
+{
+    FileEventCoalescer coalescer;
+    EXPECT_TRUE(coalescer.enqueue(testUrl(1), FileEventCoalescer::kAddFile));
+    EXPECT_FALSE(coalescer.enqueue(testUrl(1), FileEventCoalescer::kUpdateFile));
+    coalescer.enqueue(testUrl(2), FileEventCoalescer::kUpdateFile);
+    coalescer.enqueue(testUrl(3), FileEventCoalescer::kAddFile);
+    coalescer.enqueue(testUrl(3), FileEventCoalescer::kRmFile);
+    coalescer.enqueue(testUrl(4), FileEventCoalescer::kRmFile);
+    coalescer.enqueue(testUrl(4), FileEventCoalescer::kAddFile);
+
+    const auto &batch = coalescer.takeBatch(100, 0, 0);
+    EXPECT_EQ(batch.adds, (QList<QUrl> { testUrl(1), testUrl(4) }));
+    EXPECT_EQ(batch.updates, QList<QUrl> { testUrl(2) });
+    EXPECT_EQ(batch.removes, QList<QUrl> { testUrl(3) });
+    EXPECT_FALSE(coalescer.hasPendingEvents());
+}
+
+TEST(UT_FileEventCoalescer, BatchSizeBounded)
+{
+    FileEventCoalescer coalescer;
+    for (int i = 0; i < 25; ++i)
+        coalescer.enqueue(testUrl(i), FileEventCoalescer::kAddFile);
+
+    EXPECT_EQ(coalescer.takeBatch(10, 0, 0).adds.size(), 10);
+    EXPECT_EQ(coalescer.pendingCount(), 15);
+    EXPECT_EQ(coalescer.takeBatch(10, 0, 0).adds.first(), testUrl(10));
+}
+
+TEST(UT_FileEventCoalescer, IdleConsumerRestarts)
+{
+    FileEventCoalescer coalescer;
+    EXPECT_TRUE(coalescer.enqueue(testUrl(1), FileEventCoalescer::kAddFile));
+    EXPECT_FALSE(coalescer.takeBatch(10, 0, 0).isEmpty());
+
+    // 空闲超时后消费者结束，新的事件需要重新启动消费者
+    EXPECT_TRUE(coalescer.takeBatch(10, 0, 0).isEmpty());
+    EXPECT_TRUE(coalescer.enqueue(testUrl(2), FileEventCoalescer::kAddFile));
+}
+
+TEST(UT_FileEventCoalescer, InterruptWakesConsumer)
+{
+    FileEventCoalescer coalescer;
+    coalescer.enqueue(testUrl(1), FileEventCoalescer::kAddFile);
+    coalescer.takeBatch(10, 0, 0);
+
+    QElapsedTimer timer;
+    timer.start();
+    QThread *thread = QThread::create([&coalescer]() {
+        QThread::msleep(20);
+        coalescer.interrupt();
+    });
+    thread->start();
+    EXPECT_TRUE(coalescer.takeBatch(10, 0, 10000).isEmpty());
+    EXPECT_LT(timer.elapsed(), 5000);
+    thread->wait();
+    delete thread;
+
+    EXPECT_FALSE(coalescer.enqueue(testUrl(2), FileEventCoalescer::kAddFile));
+}
+
+TEST(UT_FileEventCoalescer, BurstFromProducerThread)
+{
+    constexpr int kFileCount = 5000;
+    FileEventCoalescer coalescer;
+
+    // 每个文件先创建再更新，合并后只剩创建事件
+    QThread *producer = QThread::create([&coalescer]() {
+        for (int i = 0; i < kFileCount; ++i) {
+            coalescer.enqueue(testUrl(i), FileEventCoalescer::kAddFile);
+            coalescer.enqueue(testUrl(i), FileEventCoalescer::kUpdateFile);
+        }
+    });
+    producer->start();
+
+    int adds = 0;
+    int updates = 0;
+    forever {
+        const auto &batch = coalescer.takeBatch(2000, 200, 500);
+        EXPECT_LE(batch.adds.size() + batch.updates.size() + batch.removes.size(), 2000);
+        if (batch.isEmpty())
+            break;
+        adds += batch.adds.size();
+        updates += batch.updates.size();
+    }
+    producer->wait();
+    delete producer;
+
+    EXPECT_EQ(adds, kFileCount);
+    EXPECT_EQ(updates, 0);
+}
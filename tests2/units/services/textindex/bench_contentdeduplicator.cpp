@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_contentdeduplicator.cpp - 含 30% 重复文件的语料在去重开关前后的建索引耗时与索引大小
+
+#include "textindex-bench.h"
+
+#include "utils/contentdeduplicator.h"
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+TEST(BM_ContentDeduplicator, DuplicateCorpus)
+{
+    constexpr int kFiles = 3000;
+    constexpr int kFileSize = 64 * 1024;
+    constexpr int kDuplicatePercent = 30;
+
+    TextIndexBench::Environment env;
+    ASSERT_TRUE(env.tmp.isValid());
+    const qint64 corpusBytes = TextIndexBench::generateCorpus(env.corpusDir, kFiles, kFileSize, kDuplicatePercent);
+    env.setWorkerCount(4);
+
+    for (bool deduplicate : { false, true }) {
+        env.removeIndex();
+        env.setDeduplication(deduplicate);
+
+        const qint64 cost = env.run(TaskHandlers::CreateIndexHandler(), env.corpusDir);
+        ASSERT_GE(cost, 0);
+        const qint64 indexBytes = TextIndexBench::directorySize(env.indexDir);
+
+        std::cout << "[ DEDUP    ] files: " << kFiles << " duplicates(%): " << kDuplicatePercent
+                  << " corpus(MB): " << corpusBytes / (1024 * 1024)
+                  << " dedup: " << (deduplicate ? "on" : "off")
+                  << " elapsed(ms): " << cost
+                  << " index(MB): " << indexBytes / (1024.0 * 1024.0) << std::endl;
+
+        if (deduplicate) {
+            bool collected = false;
+            const auto &stats = ContentDeduplicator::instance().statistics(&collected);
+            EXPECT_TRUE(collected);
+            EXPECT_EQ(stats.uniqueContents + stats.duplicateDocuments, kFiles);
+            std::cout << "[ DEDUP    ] unique contents: " << stats.uniqueContents
+                      << " duplicate documents: " << stats.duplicateDocuments
+                      << " saved(MB): " << stats.bytesSaved / (1024.0 * 1024.0) << std::endl;
+        }
+    }
+}
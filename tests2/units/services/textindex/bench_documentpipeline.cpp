@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_documentpipeline.cpp - 不同提取线程数下创建全文索引的吞吐量
+
+#include "textindex-bench.h"
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+TEST(BM_DocumentPipeline, CreateIndexThroughput)
+{
+    constexpr int kFiles = 2000;
+    constexpr int kFileSize = 32 * 1024;
+
+    TextIndexBench::Environment env;
+    ASSERT_TRUE(env.tmp.isValid());
+    const qint64 corpusBytes = TextIndexBench::generateCorpus(env.corpusDir, kFiles, kFileSize);
+
+    for (int workers : { 1, 2, 4, 8 }) {
+        env.removeIndex();
+        env.setWorkerCount(workers);
+
+        const qint64 cost = env.run(TaskHandlers::CreateIndexHandler(), env.corpusDir);
+        ASSERT_GE(cost, 0);
+        const double seconds = qMax<qint64>(cost, 1) / 1000.0;
+
+        std::cout << "[ PIPELINE ] files: " << kFiles
+                  << " workers: " << workers
+                  << " elapsed(ms): " << cost
+                  << " docs/s: " << kFiles / seconds
+                  << " MB/s: " << corpusBytes / (1024.0 * 1024.0) / seconds << std::endl;
+    }
+}
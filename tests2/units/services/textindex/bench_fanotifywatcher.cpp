@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_fanotifywatcher.cpp - 50 万目录的目录树上两种监控后端的启动耗时与内核占用
+// inotify 的启动耗时取监视数量停止增长的时刻，内核内存按每个 watch 约 1KB 估算
+// fanotify 需要 CAP_SYS_ADMIN，没有权限时只输出 inotify 的结果
+
+#include "fsmonitor/fsmonitor.h"
+#include "fsmonitor/fsmonitor_p.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+namespace {
+
+// 内核中一个 inotify watch（inotify_inode_mark 及其 fsnotify 结构）约占 1KB
+constexpr qint64 kInotifyWatchBytes = 1080;
+
+void ensureCoreApplication()
+{
+    if (QCoreApplication::instance())
+        return;
+    static int argc = 1;
+    static char name[] = "bench_fanotifywatcher";
+    static char *argv[] = { name, nullptr };
+    new QCoreApplication(argc, argv);
+}
+
+// 三层目录，每层最多 100 个子目录
+int generateTree(const QString &root, int count)
+{
+    int created = 0;
+    for (int i = 0; created < count; ++i) {
+        for (int j = 0; j < 100 && created < count; ++j) {
+            const QString &dir = QString("%1/d%2/d%3").arg(root).arg(i / 100).arg(i % 100);
+            if (QDir().mkpath(QString("%1/d%2").arg(dir).arg(j)))
+                ++created;
+        }
+    }
+    return created;
+}
+
+// 从 /proc/self/fdinfo 统计本进程注册的 inotify watch 和 fanotify mark
+void countKernelMarks(int *inotifyWatches, int *fanotifyMarks)
+{
+    *inotifyWatches = 0;
+    *fanotifyMarks = 0;
+    const QStringList &fds = QDir("/proc/self/fdinfo").entryList(QDir::Files);
+    for (const QString &fd : fds) {
+        QFile file("/proc/self/fdinfo/" + fd);
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        for (const QByteArray &line : file.readAll().split('\n')) {
+            if (line.startsWith("inotify wd:"))
+                ++*inotifyWatches;
+            else if (line.startsWith("fanotify ino:") || line.startsWith("fanotify mnt_id:") || line.startsWith("fanotify sdev:"))
+                ++*fanotifyMarks;
+        }
+    }
+}
+
+// 启动监控并等待 inotify 监视数量稳定，返回耗时（毫秒）
+qint64 startMonitor(FSMonitor &monitor)
+{
+    QElapsedTimer timer;
+    timer.start();
+    if (!monitor.start())
+        return -1;
+
+    int lastCount = -1;
+    qint64 stableSince = timer.elapsed();
+    qint64 settledAt = timer.elapsed();
+    while (timer.elapsed() - stableSince < 2000) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        QThread::msleep(10);
+        const int count = monitor.currentWatchCount();
+        if (count != lastCount) {
+            lastCount = count;
+            stableSince = timer.elapsed();
+            settledAt = stableSince;
+        }
+    }
+    return settledAt;
+}
+
+}   // namespace
+
+TEST(BM_FanotifyWatcher, StartupAndKernelMemory)
+{
+    constexpr int kDirCount = 500000;
+
+    ensureCoreApplication();
+    QLoggingCategory::setFilterRules("org.deepin.dde.filemanager.*.debug=false\n"
+                                     "org.deepin.dde.filemanager.*.info=false");
+
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    ASSERT_EQ(generateTree(tmp.path(), kDirCount), kDirCount);
+
+    FSMonitor &monitor = FSMonitor::instance();
+    FSMonitorPrivate *d = monitor.d_ptr.data();
+    ASSERT_TRUE(monitor.initialize({ tmp.path() }));
+    monitor.setMaxResourceUsage(1.0);
+
+    for (bool fanotify : { false, true }) {
+        d->useFanotify = fanotify;
+        const qint64 cost = startMonitor(monitor);
+        ASSERT_GE(cost, 0);
+
+        if (fanotify && !d->fanotifyActive) {
+            monitor.stop();
+            std::cout << "[ FANOTIFY ] backend unavailable (needs CAP_SYS_ADMIN and CAP_DAC_READ_SEARCH), skipped" << std::endl;
+            continue;
+        }
+
+        int inotifyWatches = 0;
+        int fanotifyMarks = 0;
+        countKernelMarks(&inotifyWatches, &fanotifyMarks);
+        std::cout << "[ FANOTIFY ] dirs: " << kDirCount
+                  << " backend: " << (fanotify ? "fanotify" : "inotify")
+                  << " startup(ms): " << cost
+                  << " inotify watches: " << inotifyWatches
+                  << " fanotify marks: " << fanotifyMarks
+                  << " covered dirs: " << (fanotify ? kDirCount : monitor.currentWatchCount())
+                  << " kernel(KB, est.): " << inotifyWatches * kInotifyWatchBytes / 1024 << std::endl;
+        monitor.stop();
+    }
+
+    QLoggingCategory::setFilterRules(QString());
+}
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_fseventcollector.cpp - 大量文件系统事件合并与冗余项清理的耗时
+// 直接调用 FSEventCollectorPrivate 的事件处理函数，不启动文件系统监控
+
+#include "fsmonitor/fseventcollector.h"
+#include "fsmonitor/fseventcollector_p.h"
+
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+TEST(BM_FSEventCollector, PruneRedundantEvents)
+{
+    constexpr int kDirCount = 1000;
+    // 每条事件都会输出调试日志，关闭后只测事件处理本身
+    QLoggingCategory::setFilterRules("org.deepin.dde.filemanager.*.debug=false\n"
+                                     "org.deepin.dde.filemanager.*.info=false");
+
+    for (int count : { 10000, 100000 }) {
+        FSEventCollector collector(FSMonitor::instance());
+        FSEventCollectorPrivate *d = collector.d_ptr.data();
+        d->maxEvents = count * 2;
+
+        QStringList created;
+        QStringList modified;
+        QObject::connect(&collector, &FSEventCollector::filesCreated, [&](const QStringList &files) { created = files; });
+        QObject::connect(&collector, &FSEventCollector::filesModified, [&](const QStringList &files) { modified = files; });
+
+        // 文件分布在 1000 个目录的子目录中，一半新建一半修改，之后删除十分之一的顶层目录
+        int expectedModified = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < count; ++i) {
+            const QString &dir = QString("/bench/dir_%1/sub_%2").arg(i % kDirCount).arg(i / kDirCount);
+            const QString &name = QString("file_%1.txt").arg(i);
+            if (i % 2) {
+                d->handleFileCreated(dir, name);
+            } else {
+                d->handleFileModified(dir, name);
+                expectedModified += (i % kDirCount) % 10 != 0;
+            }
+        }
+        for (int i = 0; i < kDirCount; i += 10)
+            d->handleDirectoryDeleted("/bench", QString("dir_%1").arg(i));
+        const qint64 collectMs = timer.elapsed();
+
+        timer.restart();
+        d->flushCollectedEvents();
+        const qint64 flushMs = timer.elapsed();
+
+        // 被删除目录下的修改事件在清理时去除
+        EXPECT_EQ(created.size(), count / 2);
+        EXPECT_EQ(modified.size(), expectedModified);
+
+        std::cout << "[ EVENTS   ] events: " << count
+                  << " collect(ms): " << collectMs
+                  << " flush(ms): " << flushMs << std::endl;
+    }
+
+    QLoggingCategory::setFilterRules(QString());
+}
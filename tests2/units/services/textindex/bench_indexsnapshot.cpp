@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// bench_indexsnapshot.cpp - 未变化的 10 万文件目录树上增量更新的耗时
+// "before" 按旧实现为每个文件构造 IndexSearcher 和 TermQuery，"after" 使用一次加载的 IndexSnapshot
+
+#include "textindex-bench.h"
+
+#include "task/indexsnapshot.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+using namespace Lucene;
+
+namespace {
+
+QStringList listFiles(const QString &dir)
+{
+    QStringList files;
+    QDirIterator it(dir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        files.append(it.next());
+    return files;
+}
+
+// 旧实现：每个文件一次查询
+int diffPerFileSearcher(const IndexReaderPtr &reader, const QStringList &files)
+{
+    int changed = 0;
+    for (const QString &file : files) {
+        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
+        TermQueryPtr query = newLucene<TermQuery>(newLucene<Term>(L"path", file.toStdWString()));
+        TopDocsPtr topDocs = searcher->search(query, 1);
+        if (topDocs->totalHits == 0) {
+            ++changed;
+            continue;
+        }
+        DocumentPtr doc = searcher->doc(topDocs->scoreDocs[0]->doc);
+        const QString &modifyEpoch = QString::number(QFileInfo(file).lastModified().toSecsSinceEpoch());
+        if (modifyEpoch.toStdWString() != doc->get(L"modified"))
+            ++changed;
+    }
+    return changed;
+}
+
+int diffSnapshot(const IndexReaderPtr &reader, const QStringList &files)
+{
+    TaskState state;
+    state.start();
+    IndexSnapshot snapshot;
+    if (!snapshot.load(reader, state))
+        return -1;
+
+    int changed = 0;
+    for (const QString &file : files) {
+        qint64 storeTime = 0;
+        if (!snapshot.lookup(file, &storeTime) || QFileInfo(file).lastModified().toSecsSinceEpoch() != storeTime)
+            ++changed;
+    }
+    return changed;
+}
+
+}   // namespace
+
+TEST(BM_IndexSnapshot, UnchangedTreeUpdate)
+{
+    constexpr int kFiles = 100000;
+    constexpr int kFileSize = 256;
+
+    TextIndexBench::Environment env;
+    ASSERT_TRUE(env.tmp.isValid());
+    TextIndexBench::generateCorpus(env.corpusDir, kFiles, kFileSize);
+    env.setWorkerCount(4);
+    ASSERT_GE(env.run(TaskHandlers::CreateIndexHandler(), env.corpusDir), 0);
+
+    const QStringList &files = listFiles(env.corpusDir);
+    ASSERT_EQ(files.size(), kFiles);
+
+    IndexReaderPtr reader = IndexReader::open(FSDirectory::open(env.indexDir.toStdWString()), true);
+    ASSERT_EQ(reader->numDocs(), kFiles);
+
+    QElapsedTimer timer;
+    timer.start();
+    const int beforeChanged = diffPerFileSearcher(reader, files);
+    const qint64 beforeCost = timer.restart();
+    const int afterChanged = diffSnapshot(reader, files);
+    const qint64 afterCost = timer.elapsed();
+    reader->close();
+
+    // 目录树没有变化，两种方式都不应产生更新
+    EXPECT_EQ(beforeChanged, 0);
+    EXPECT_EQ(afterChanged, 0);
+
+    const qint64 handlerCost = env.run(TaskHandlers::UpdateIndexHandler(), env.corpusDir);
+    ASSERT_GE(handlerCost, 0);
+
+    std::cout << "[ SNAPSHOT ] files: " << kFiles
+              << " before(ms): " << beforeCost
+              << " after(ms): " << afterCost
+              << " speedup: " << double(beforeCost) / qMax<qint64>(afterCost, 1)
+              << " UpdateIndexHandler(ms): " << handlerCost << std::endl;
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/contentdeduplicator.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <gtest/gtest.h>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+using namespace Lucene;
+
+class UT_ContentDeduplicator : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory = newLucene<RAMDirectory>();
+        writer = newLucene<IndexWriter>(directory, newLucene<StandardAnalyzer>(LuceneVersion::LUCENE_CURRENT),
+                                        true, IndexWriter::MaxFieldLengthUNLIMITED);
+    }
+    void TearDown() override
+    {
+        ContentDeduplicator::instance().endSession();
+        writer->close();
+    }
+
+    static DocumentPtr pathDocument(const QString &path, const QString &contents)
+    {
+        DocumentPtr doc = newLucene<Document>();
+        doc->add(newLucene<Field>(L"path", path.toStdWString(), Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
+        ContentDeduplicator::addContentFields(doc, contents);
+        return doc;
+    }
+
+    static QString longText(const QString &word) { return QString("%1 ").arg(word).repeated(8 * 1024); }
+
+    RAMDirectoryPtr directory;
+    IndexWriterPtr writer;
+};
+
+TEST_F(UT_ContentDeduplicator, ShortTextIsStoredInPlace)
+{
+    const DocumentPtr &doc = pathDocument("/a.txt", "short text");
+    EXPECT_TRUE(doc->get(L"content_hash").empty());
+    EXPECT_EQ(doc->get(L"contents"), L"short text");
+}
+
+TEST_F(UT_ContentDeduplicator, LongTextKeepsStoredSnippet)
+{
+    const QString &contents = longText("alpha");
+    const DocumentPtr &doc = pathDocument("/a.txt", contents);
+
+    // 存储的片段用于搜索结果高亮，键是索引文本的哈希
+    EXPECT_EQ(QString::fromStdWString(doc->get(L"content_hash")).toLatin1(),
+              ContentDeduplicator::computeContentKey(contents));
+    const QString &snippet = QString::fromStdWString(doc->get(L"contents"));
+    EXPECT_FALSE(snippet.isEmpty());
+    EXPECT_LT(snippet.size(), contents.size());
+    EXPECT_TRUE(contents.startsWith(snippet));
+}
+
+TEST_F(UT_ContentDeduplicator, ContentDocumentWrittenOnce)
+{
+    ContentDeduplicator::instance().beginSession(nullptr, writer);
+
+    const QString &contents = longText("alpha");
+    for (const QString &path : { "/a.txt", "/copy/a.txt" }) {
+        const DocumentPtr &doc = pathDocument(path, contents);
+        ContentDeduplicator::instance().prepareDocument(doc);
+        writer->addDocument(doc);
+    }
+    writer->commit();
+
+    IndexReaderPtr reader = writer->getReader();
+    EXPECT_EQ(reader->numDocs(), 3);
+    EXPECT_EQ(ContentDeduplicator::contentDocumentCount(reader), 1);
+
+    // 读回的文档可以还原出全文
+    SearcherPtr searcher = newLucene<IndexSearcher>(reader);
+    TopDocsPtr topDocs = searcher->search(newLucene<TermQuery>(newLucene<Term>(L"path", L"/copy/a.txt")), 1);
+    ASSERT_EQ(topDocs->totalHits, 1);
+    DocumentPtr doc = searcher->doc(topDocs->scoreDocs[0]->doc);
+    ContentDeduplicator::restoreContents(doc, searcher);
+    bool restored = false;
+    for (const FieldablePtr &field : doc->getFieldables(L"contents"))
+        restored = restored || (field->isIndexed() && QString::fromStdWString(field->stringValue()) == contents);
+    EXPECT_TRUE(restored);
+    reader->close();
+}
+
+TEST_F(UT_ContentDeduplicator, FullTextKeptWithoutWriter)
+{
+    // 没有会话时内容文档无法写入，路径文档不能留下引用
+    const QString &contents = longText("beta");
+    const DocumentPtr &doc = pathDocument("/b.txt", contents);
+    ContentDeduplicator::instance().prepareDocument(doc);
+
+    EXPECT_TRUE(doc->get(L"content_hash").empty());
+    EXPECT_EQ(QString::fromStdWString(doc->get(L"contents")), contents);
+}
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fsmonitor/fanotifywatcher.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+class UT_FanotifyWatcher : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        watcher.rootPaths = { "/home/user" };
+        watcher.cacheDirectory("docs", "/home/user/docs", true);
+        watcher.cacheDirectory("x", "/home/user/docs/x", true);
+        watcher.cacheDirectory("y", "/home/user/docs/x/y", true);
+        watcher.cacheDirectory("docs2", "/home/user/docs2", true);
+        watcher.cacheDirectory("other", "/home/user/other", true);
+        watcher.cacheDirectory("tmp", "/tmp", false);
+    }
+
+    QStringList cachedKeys() const
+    {
+        QStringList keys;
+        for (const QByteArray &key : watcher.directoryCache.keys())
+            keys.append(QString::fromLatin1(key));
+        keys.sort();
+        return keys;
+    }
+
+    FanotifyWatcher watcher;
+};
+
+TEST_F(UT_FanotifyWatcher, EvictRenamedDirectoryAndDescendants)
+{
+    watcher.evictDirectory("/home/user", "docs");
+
+    // 共享前缀的兄弟目录和监控范围外的目录不受影响
+    EXPECT_EQ(cachedKeys(), (QStringList { "docs2", "other", "tmp" }));
+    EXPECT_EQ(watcher.cachedPaths.keys(), (QStringList { "/home/user/docs2", "/home/user/other" }));
+}
+
+TEST_F(UT_FanotifyWatcher, EvictUnwatchedDirectories)
+{
+    watcher.evictUnwatchedDirectories();
+    EXPECT_EQ(cachedKeys(), (QStringList { "docs", "docs2", "other", "x", "y" }));
+}
+
+TEST_F(UT_FanotifyWatcher, RenameOutsideRoots)
+{
+    // 与根路径同名但不在其上级路径中的目录改名不影响缓存
+    watcher.evictDirectory("/tmp", "user");
+    watcher.evictDirectory("/srv/home", "user");
+    EXPECT_EQ(cachedKeys().size(), 6);
+
+    // 父目录已无法解析
+    watcher.evictDirectory(QString(), "user");
+    EXPECT_EQ(cachedKeys().size(), 6);
+}
+
+TEST_F(UT_FanotifyWatcher, RenameAncestorOfRoot)
+{
+    // 根路径的上级目录改名后所有路径都可能失效
+    watcher.evictDirectory("/", "home");
+    EXPECT_TRUE(watcher.directoryCache.isEmpty());
+    EXPECT_TRUE(watcher.cachedPaths.isEmpty());
+}
+
+TEST_F(UT_FanotifyWatcher, LeastRecentlyUsedEviction)
+{
+    watcher.directoryCache.setMaxCost(6);
+    watcher.directoryCache.object("docs");
+    watcher.cacheDirectory("new", "/home/user/new", true);
+
+    // 缓存满时只淘汰最久未使用的句柄
+    EXPECT_EQ(watcher.directoryCache.size(), 6);
+    EXPECT_TRUE(watcher.directoryCache.contains("docs"));
+    EXPECT_TRUE(watcher.directoryCache.contains("new"));
+    EXPECT_FALSE(watcher.directoryCache.contains("x"));
+}
+
+TEST(UT_FanotifyWatcherRoots, CanonicalRootPaths)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    ASSERT_TRUE(QDir(tmp.path()).mkdir("real"));
+    ASSERT_TRUE(QFile::link(tmp.filePath("real"), tmp.filePath("link")));
+
+    FanotifyWatcher watcher;
+    if (!watcher.start({ tmp.filePath("link") + "/" }))
+        GTEST_SKIP() << "fanotify requires CAP_SYS_ADMIN";
+
+    // 句柄解析出的路径不含符号链接
+    EXPECT_EQ(watcher.rootPaths, QStringList { QFileInfo(tmp.filePath("real")).canonicalFilePath() });
+    EXPECT_TRUE(watcher.isWatchedPath(QFileInfo(tmp.filePath("real")).canonicalFilePath() + "/sub"));
+}
+
+TEST_F(UT_FanotifyWatcher, ReplaceHandleOfSamePath)
+{
+    // 目录被删除后同名目录重新创建，旧句柄不再保留
+    watcher.cacheDirectory("docs-new", "/home/user/docs");
+    EXPECT_FALSE(watcher.directoryCache.contains("docs"));
+    EXPECT_EQ(watcher.cachedPaths.value("/home/user/docs"), QByteArray("docs-new"));
+}
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fsmonitor/fseventcollector.h"
+#include "fsmonitor/fseventcollector_p.h"
+
+#include <QDir>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+class UT_FSEventCollector : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        collector.reset(new FSEventCollector(FSMonitor::instance()));
+        d = collector->d_ptr.data();
+    }
+
+    QScopedPointer<FSEventCollector> collector;
+    FSEventCollectorPrivate *d { nullptr };
+};
+
+TEST_F(UT_FSEventCollector, CreatedDirectoryPrunesCreatedChildren)
+{
+    d->handleFileCreated("/data/a", "one.txt");
+    d->handleFileCreated("/data/a/b", "two.txt");
+    d->handleFileCreated("/data", "ab.txt");
+    d->handleDirectoryCreated("/data", "a");
+
+    // 同名前缀的兄弟项 /data/ab.txt 不在 /data/a 之下
+    const QStringList &created = collector->createdFiles();
+    EXPECT_EQ(created.size(), 2);
+    EXPECT_TRUE(created.contains("/data/a"));
+    EXPECT_TRUE(created.contains("/data/ab.txt"));
+    EXPECT_TRUE(d->createdIndex.contains("/data/a"));
+    EXPECT_FALSE(d->createdIndex.contains("/data/a/one.txt"));
+    EXPECT_FALSE(d->createdIndex.contains("/data/a/b/two.txt"));
+}
+
+TEST_F(UT_FSEventCollector, ModifiedExistingDirectoryIgnored)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    ASSERT_TRUE(QDir(tmp.path()).mkdir("docs.txt"));
+
+    // 目录没有出现在本周期的新建或删除列表中，需要查询文件系统
+    EXPECT_TRUE(d->isDirectory(tmp.filePath("docs.txt")));
+    d->handleFileModified(tmp.path(), "docs.txt");
+    EXPECT_EQ(collector->modifiedFilesCount(), 0);
+}
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// textindex-bench.h - 全文索引基准测试共用的语料生成与运行环境
+// 索引写入临时目录，文件遍历不经过 ANYTHING，提取线程数和去重开关由基准测试指定
+
+#pragma once
+
+#include "stubext.h"
+
+#include "task/taskhandler.h"
+#include "utils/indexutility.h"
+#include "utils/textindexconfig.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+
+namespace TextIndexBench {
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+/**
+ * @brief 生成文本语料
+ * @param dir 语料目录，每 100 个文件一个子目录
+ * @param count 文件数量
+ * @param fileSize 每个文件的字节数
+ * @param duplicatePercent 与之前某个文件内容完全相同的文件比例
+ * @return 语料总字节数
+ */
+inline qint64 generateCorpus(const QString &dir, int count, int fileSize, int duplicatePercent = 0)
+{
+    static const QStringList kWords { "index", "search", "document", "content", "deepin", "manager",
+                                      "lucene", "pipeline", "writer", "extract", "文件", "索引" };
+    qint64 total = 0;
+    int uniqueCount = 0;
+    for (int i = 0; i < count; ++i) {
+        const QString &subDir = QString("%1/dir_%2").arg(dir).arg(i / 100);
+        QDir().mkpath(subDir);
+
+        // 按比例复用之前生成的内容，模拟备份目录和重复下载
+        const bool duplicate = uniqueCount > 0 && (i * duplicatePercent) / 100 != ((i + 1) * duplicatePercent) / 100;
+        const int seed = duplicate ? (i * 7919) % uniqueCount : uniqueCount++;
+
+        QByteArray content;
+        content.reserve(fileSize + 32);
+        for (int w = 0; content.size() < fileSize; ++w)
+            content += kWords.at((seed + w * 31 + w / 7) % kWords.size()).toUtf8() + ' ' + QByteArray::number(seed * 131 + w) + (w % 12 == 11 ? '\n' : ' ');
+        content.truncate(fileSize);
+
+        QFile file(QString("%1/file_%2.txt").arg(subDir).arg(i));
+        if (file.open(QIODevice::WriteOnly))
+            total += file.write(content);
+    }
+    return total;
+}
+
+inline qint64 directorySize(const QString &dir)
+{
+    qint64 size = 0;
+    QDirIterator it(dir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        size += it.fileInfo().size();
+    }
+    return size;
+}
+
+/**
+ * @brief 基准测试的索引运行环境，析构时恢复所有打桩和日志设置
+ */
+class Environment
+{
+public:
+    Environment()
+    {
+        indexDir = tmp.filePath("index");
+        corpusDir = tmp.filePath("corpus");
+        QDir().mkpath(corpusDir);
+
+        const QString dir = indexDir;
+        stub.set_lamda(&DFMSEARCH::Global::contentIndexDirectory, [dir]() { __DBG_STUB_INVOKE__ return dir; });
+        stub.set_lamda(&IndexUtility::isIndexWithAnything, [] { __DBG_STUB_INVOKE__ return false; });
+        // 临时目录可能位于默认跳过的系统目录下
+        stub.set_lamda(&IndexUtility::isDefaultIndexedDirectory, [] { __DBG_STUB_INVOKE__ return true; });
+        setWorkerCount(1);
+        setDeduplication(false);
+
+        // 每个文件都会输出日志，关闭后只测索引本身
+        QLoggingCategory::setFilterRules("org.deepin.dde.filemanager.*.debug=false\n"
+                                         "org.deepin.dde.filemanager.*.info=false\n"
+                                         "org.deepin.dde.filemanager.*.warning=false");
+    }
+
+    ~Environment()
+    {
+        stub.clear();
+        QLoggingCategory::setFilterRules(QString());
+    }
+
+    void setWorkerCount(int count)
+    {
+        stub.set_lamda(&TextIndexConfig::indexWorkerCount, [count] { __DBG_STUB_INVOKE__ return count; });
+    }
+
+    void setDeduplication(bool enabled)
+    {
+        stub.set_lamda(&TextIndexConfig::contentDeduplication, [enabled] { __DBG_STUB_INVOKE__ return enabled; });
+    }
+
+    // 运行索引任务，返回耗时（毫秒），失败时返回 -1
+    qint64 run(const TaskHandler &handler, const QString &path)
+    {
+        TaskState state;
+        state.start();
+        QElapsedTimer timer;
+        timer.start();
+        const HandlerResult &result = handler(path, state);
+        return result.success ? timer.elapsed() : -1;
+    }
+
+    void removeIndex() { QDir(indexDir).removeRecursively(); }
+
+    QTemporaryDir tmp;
+    QString indexDir;
+    QString corpusDir;
+    stub_ext::StubExt stub;
+};
+
+}   // namespace TextIndexBench